@@ -11,16 +11,89 @@
 // API Konfiguration
 #define WEATHER_API_SERVER "weather.googleapis.com"
 #define POLLEN_API_SERVER "pollen.googleapis.com"
+#define API_MIN_UPDATE_INTERVAL 1 // Minuten, kürzere Intervalle aus der Konfiguration (z.B. 0) werden darauf angehoben
+// Jeder blockierende Schritt einer Abfrage ist begrenzt, damit die Netzwerk-Task einen Abbruch (ApiClient::cancel()) bemerkt
+#define API_CONNECT_TIMEOUT 5000         // TCP-Verbindungsaufbau in ms
+#define API_HANDSHAKE_TIMEOUT 10         // TLS-Handshake in s
+#define API_SOCKET_TIMEOUT 5             // Lesen und Schreiben auf dem Socket in s (auch Stream-Timeout für readString())
+#define API_RESPONSE_TIMEOUT 10000       // Warten auf den Beginn der Antwort in ms
 
-// LED Streifen Konfiguration
-#define LED_PIN         2 // Beispiel-Pin, passe dies an deinen ESP32 an (Wird nach GPIO nummeriert in der FastLED Library)
-#define NUM_LEDS      123 // Die Gesamtzahl deiner LEDs (123)
+// Pins, Adressen und verbaute Sensoren: siehe hardware/HardwareConfig.h
 
 // Hardware Tasten
-#define BUTTON_A 12 // Oberster Button
-#define BUTTON_B 11 // Mittlerer Button
-#define BUTTON_C 10 // Unterster Button
+#define BUTTON_DEBOUNCE_TIME 30     // So lange muss ein Pegel stabil sein (ms)
+#define BUTTON_LONG_PRESS_TIME 1000 // Langer Druck auf A öffnet und schliesst das Menü
+#define BUTTON_MULTI_PRESS_TIME 300 // Maximale Pause zwischen den Drücken eines Doppeldrucks
+
+// Menü auf der 7-Segment-Anzeige
+#define MENU_TIMEOUT 30000          // Ohne Eingabe schliesst sich das Menü nach 30 Sekunden
+#define MENU_BRIGHTNESS_STEP 10     // Schrittweite der Helligkeit in %
 
 // Sensor Konfiguration
 #define SENSOR_UPDATE_CYCLE 1000 // 1 Sekunde
-#define SENSOR_TEMPERATUR_CORRECTION -2 // 2°C Nach unten korrigieren
+#define INDOOR_EVENT_INTERVAL 5000 // Innenwerte und Luftqualität höchstens alle 5 Sekunden neu anzeigen (Zwischenwerte werden zusammengefasst)
+#define AIR_QUALITY_UPDATE_CYCLE 5000 // BME680 mit Gasheizung nur so oft messen, wie die Luftqualität angezeigt wird
+#define AIR_QUALITY_REDUCED_CYCLE 30000 // Dito bei zu starker Eigenerwärmung
+
+// Eigenerwärmung des SHT30 durch ESP32, LED-Streifen und Gasheizung (ersetzt die feste Korrektur von -2 °C).
+// Startwerte des Wärmemodells, die Koeffizienten werden im Betrieb angepasst.
+#define THERMAL_UPDATE_INTERVAL 60000     // Lasten messen und das Modell anpassen
+#define THERMAL_TIME_CONSTANT 600000      // Thermische Zeitkonstante zwischen Wärmequellen und Sensor (10 Minuten)
+#define THERMAL_IDLE_OFFSET 1.0f          // °C ohne Last (Spannungsregler, WLAN-Empfang)
+#define THERMAL_CPU_COEFFICIENT 2.0f      // °C bei voller CPU-Last auf beiden Kernen
+#define THERMAL_LED_COEFFICIENT 6.0f      // °C bei allen LEDs weiss mit voller Helligkeit
+#define THERMAL_HEATER_COEFFICIENT 4.0f   // °C bei dauernd eingeschalteter Gasheizung
+#define THERMAL_SELF_HEATING_LIMIT 2.5f   // Darüber Gasheizung und Helligkeit drosseln
+#define THERMAL_HYSTERESIS 0.5f           // Drosselung erst unter Grenze minus Hysterese aufheben
+#define THERMAL_BRIGHTNESS_LIMIT 60       // Höchste Helligkeit (%) im gedrosselten Zustand
+
+// Scheduler Konfiguration (Intervalle in Millisekunden)
+#define CLIENT_POLL_INTERVAL 10         // Webserver und CoAP-Anfragen bearbeiten
+#define CLIENT_POLL_IDLE_INTERVAL 100   // Dito im Ruhezustand (entspricht etwa dem Beacon-Intervall im Modem-Sleep)
+#define STATE_MACHINE_INTERVAL 100      // Zustandsautomat (WLAN) prüfen
+#define CLOCK_UPDATE_INTERVAL 1000      // NTP abfragen und Zeitanzeige aktualisieren
+#define DISPLAY_MESSAGE_INTERVAL 100    // Nachrichten an die Anzeige-Task verarbeiten (selten genug für den Light-Sleep)
+#define DISPLAY_MAX_FRAME_RATE 30       // Obergrenze der Frames pro Sekunde des LED-Streifens (ein Frame dauert ca. 3.7 ms)
+#define LED_DITHERING false             // Zeitliches Dithering bei geringer Helligkeit (sendet dann laufend, kein Light-Sleep)
+#define LED_DITHER_FRAME_RATE 120       // Frames pro Sekunde während dem Dithering (8 Stufen -> 15 Hz Zyklus)
+#define DISPLAY_CROSSFADE_TIME 600      // Überblendung bei einem neuen Bild (Minute, Wetter, Pollen), 0 = aus
+#define DISPLAY_FRAME_BUDGET 2000       // Zeitbudget eines Frames in µs, darüber wird ein Frame der Überblendung ausgelassen
+#define DISPLAY_SCROLL_INTERVAL 350     // Lauftext der 7-Segment-Anzeigen: eine Stelle weiter nach so vielen ms
+#define DISPLAY_MATRIX_SCROLL_INTERVAL 120 // Lauftext des Buchstabenrasters: eine Spalte weiter nach so vielen ms
+#define NETWORK_MESSAGE_INTERVAL 100    // Nachrichten an die Netzwerk-Task verarbeiten
+#define SCHEDULER_STATS_INTERVAL 900000 // Job- und Task-Statistik alle 15 Minuten ausgeben
+#define POWER_POLICY_INTERVAL 250       // Energiezustand neu bestimmen
+#define WARM_BOOT_SAVE_INTERVAL 1000    // Anzeigezustand für einen Warmstart sichern (nur bei Änderungen)
+#define HEALTH_CHECK_INTERVAL 1000      // Subsysteme prüfen und Task-Watchdog bedienen (Watchdog-Timeout 5 s)
+#define HEALTH_MP3_CHECK_INTERVAL 300000 // DFPlayer alle 5 Minuten abfragen
+
+// Health-Supervisor: Störungserkennung pro Subsystem
+#define HEALTH_NETWORK_STALL_TIMEOUT 60000 // Über der längsten Abfrage (Verbindung, Handshake, Antwort- und Lese-Timeouts)
+#define HEALTH_DISPLAY_STALL_TIMEOUT 10000
+#define HEALTH_API_FAILURE_THRESHOLD 3
+#define HEALTH_SENSOR_FAILURE_THRESHOLD 5
+#define HEALTH_MP3_FAILURE_THRESHOLD 2
+
+// Energieverwaltung
+#define POWER_MAX_CPU_FREQ_MHZ 240
+#define POWER_MIN_CPU_FREQ_MHZ 80       // Untergrenze für DFS, darunter läuft der WLAN-Stack nicht zuverlässig
+#define POWER_CLIENT_ACTIVE_TIME 30000  // Nach einer Webserver- oder CoAP-Anfrage so lange nicht schlafen
+
+// Tasks (FreeRTOS). Kern 0 teilt sich die Netzwerk-Task mit dem WLAN-Stack,
+// die Anzeige-Task auf Kern 1 hat die höhere Priorität.
+#define NETWORK_TASK_CORE 0
+#define NETWORK_TASK_PRIORITY 2
+#define NETWORK_TASK_STACK_SIZE 12288   // TLS-Handshakes der APIs benötigen viel Stack
+#define DISPLAY_TASK_CORE 1
+#define DISPLAY_TASK_PRIORITY 3
+#define DISPLAY_TASK_STACK_SIZE 6144
+#define DISPLAY_QUEUE_LENGTH 8          // Nachrichten von der Netzwerk- an die Anzeige-Task
+#define HEALTH_TASK_CORE 1
+#define HEALTH_TASK_PRIORITY 4          // Über der Anzeige-Task, damit eine hängende Task den Supervisor nicht aufhält
+#define HEALTH_TASK_STACK_SIZE 4096
+#define BOOT_TASK_PRIORITY 1            // Parallele Boot-Schritte (gleich wie setup())
+#define BOOT_TASK_STACK_SIZE 6144
+#define NETWORK_QUEUE_LENGTH 4          // Nachrichten von der Anzeige- an die Netzwerk-Task (Menü)
+
+// WLAN Konfiguration
+#define WIFI_CONNECT_TIMEOUT 15000 // Timeout pro Netzwerk in ms, wenn keines erreichbar ist: Konfigurations-AP
@@ -0,0 +1,118 @@
+#include "BootSequence.h"
+#include "../logger/Logger.h"
+
+BootSequence::BootSequence(uint32_t parallelStackSize, UBaseType_t parallelPriority)
+  : _stepCount(0), _parallelStackSize(parallelStackSize), _parallelPriority(parallelPriority),
+    _done(nullptr), _startMs(0), _endMs(0) {}
+
+BootStepId BootSequence::add(const char* name, BootStepFunction function, BootStepMode mode, uint32_t dependsOn) {
+    if (_stepCount >= BOOT_MAX_STEPS || function == nullptr) {
+        Logger::log(LogLevel::Error, "Boot-Schritt " + String(name) + " konnte nicht angemeldet werden!");
+        return BOOT_INVALID_STEP;
+    }
+    Step& step = _steps[_stepCount];
+    step.name = name;
+    step.function = function;
+    step.mode = mode;
+    step.dependsOn = dependsOn;
+    step.owner = this;
+    step.id = _stepCount;
+    return _stepCount++;
+}
+
+bool BootSequence::run() {
+    _startMs = millis();
+    _done = xEventGroupCreate();
+    if (_done == nullptr) {
+        // Ohne Event-Group alles nacheinander in der angemeldeten Reihenfolge
+        Logger::log(LogLevel::Error, "Boot: Event-Group konnte nicht erstellt werden, starte alle Schritte nacheinander.");
+        for (int i = 0; i < _stepCount; i++) {
+            runStep(_steps[i]);
+        }
+        _endMs = millis();
+        return true;
+    }
+
+    uint32_t all = (1UL << _stepCount) - 1;
+    uint32_t started = 0;
+    bool ok = true;
+    while (started != all) {
+        uint32_t done = (uint32_t)xEventGroupGetBits(_done);
+
+        // Zuerst alle bereiten parallelen Schritte starten, damit sie während der Inline-Schritte laufen
+        for (int i = 0; i < _stepCount; i++) {
+            Step& step = _steps[i];
+            if (step.mode != BOOT_STEP_PARALLEL || (started & after(i)) || (step.dependsOn & done) != step.dependsOn) {
+                continue;
+            }
+            started |= after(i);
+            if (xTaskCreate(runParallel, step.name, _parallelStackSize, &step, _parallelPriority, nullptr) != pdPASS) {
+                Logger::log(LogLevel::Error, "Boot: Task für " + String(step.name) + " konnte nicht gestartet werden, führe ihn direkt aus.");
+                runStep(step);
+                done = (uint32_t)xEventGroupGetBits(_done);
+            }
+        }
+
+        // Danach den ersten bereiten Inline-Schritt ausführen
+        bool ranInline = false;
+        for (int i = 0; i < _stepCount && !ranInline; i++) {
+            Step& step = _steps[i];
+            if (step.mode != BOOT_STEP_INLINE || (started & after(i)) || (step.dependsOn & done) != step.dependsOn) {
+                continue;
+            }
+            started |= after(i);
+            runStep(step);
+            ranInline = true;
+        }
+        if (ranInline) {
+            continue;
+        }
+
+        // Nichts bereit: auf das Ende eines laufenden parallelen Schritts warten
+        uint32_t running = started & ~done;
+        if (running == 0) {
+            Logger::log(LogLevel::Error, "Boot: Abhängigkeiten nicht erfüllbar, nicht gestartete Schritte werden übersprungen!");
+            ok = false;
+            break;
+        }
+        xEventGroupWaitBits(_done, running, pdFALSE, pdFALSE, portMAX_DELAY);
+    }
+
+    // Auf die noch laufenden parallelen Schritte warten
+    if (started != 0) {
+        xEventGroupWaitBits(_done, started, pdFALSE, pdTRUE, portMAX_DELAY);
+    }
+    vEventGroupDelete(_done);
+    _done = nullptr;
+    _endMs = millis();
+    return ok;
+}
+
+void BootSequence::runStep(Step& step) {
+    step.timing.core = xPortGetCoreID();
+    step.timing.startMs = millis();
+    step.function();
+    step.timing.endMs = millis();
+    if (_done != nullptr) {
+        xEventGroupSetBits(_done, after(step.id));
+    }
+}
+
+void BootSequence::runParallel(void* parameter) {
+    Step* step = static_cast<Step*>(parameter);
+    step->owner->runStep(*step);
+    vTaskDelete(nullptr);
+}
+
+void BootSequence::logProfile() const {
+    unsigned long sequentialMs = 0;
+    for (int i = 0; i < _stepCount; i++) {
+        const Step& step = _steps[i];
+        unsigned long durationMs = step.timing.endMs - step.timing.startMs;
+        sequentialMs += durationMs;
+        Logger::log(LogLevel::Info, "Boot-Profil: " + String(step.name) + " ab " + String(step.timing.startMs) + " ms, Dauer " +
+                    String(durationMs) + " ms, Kern " + String(step.timing.core) + (step.mode == BOOT_STEP_PARALLEL ? " (parallel)" : ""));
+    }
+    Logger::log(LogLevel::Info, "Boot-Profil: Ablauf " + String(_endMs - _startMs) + " ms (nacheinander " + String(sequentialMs) +
+                " ms), fertig " + String(_endMs) + " ms nach dem Reset.");
+}
@@ -0,0 +1,74 @@
+#ifndef BOOT_SEQUENCE_H
+#define BOOT_SEQUENCE_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/event_groups.h>
+
+typedef int BootStepId;
+typedef void (*BootStepFunction)();
+
+const BootStepId BOOT_INVALID_STEP = -1;
+const int BOOT_MAX_STEPS = 16;          // Ein Bit pro Schritt in der Event-Group (max. 24)
+
+enum BootStepMode {
+    BOOT_STEP_INLINE,                   // Läuft im Aufrufer von run() (setup), in der Reihenfolge von add()
+    BOOT_STEP_PARALLEL                  // Läuft in einer eigenen Task, sobald alle Abhängigkeiten erfüllt sind
+};
+
+// Gemessene Zeiten eines Schritts in Millisekunden seit dem Reset
+struct BootStepTiming {
+    unsigned long startMs = 0;
+    unsigned long endMs = 0;
+    int core = -1;
+};
+
+// Führt die Initialisierungsschritte beim Start anhand ihrer Abhängigkeiten aus.
+// Unabhängige Schritte mit langen Wartezeiten (Handshakes, Sensor-Initialisierung) laufen
+// parallel in eigenen Tasks, die übrigen nacheinander im Aufrufer. Ein Schritt beginnt erst,
+// wenn alle Schritte aus dependsOn beendet sind. run() kehrt zurück, wenn alle Schritte fertig sind,
+// danach liefert logProfile() die Zeiten pro Schritt.
+class BootSequence {
+public:
+    BootSequence(uint32_t parallelStackSize, UBaseType_t parallelPriority);
+
+    // Meldet einen Schritt an. dependsOn ist eine Maske aus after(), z.B. after(a) | after(b).
+    BootStepId add(const char* name, BootStepFunction function, BootStepMode mode, uint32_t dependsOn = 0);
+
+    // Maske für die Abhängigkeit von einem Schritt
+    static uint32_t after(BootStepId step) { return step == BOOT_INVALID_STEP ? 0 : (1UL << step); }
+
+    // Führt alle Schritte aus. false, wenn Abhängigkeiten nicht erfüllbar sind (unbekannter Schritt oder Zyklus).
+    bool run();
+
+    // Gibt Start, Dauer und Kern jedes Schritts sowie die Gesamtzeit aus.
+    void logProfile() const;
+
+    const BootStepTiming& getTiming(BootStepId step) const { return _steps[step].timing; }
+    unsigned long getEndMs() const { return _endMs; }   // Ende von run() seit dem Reset
+
+private:
+    struct Step {
+        const char* name;
+        BootStepFunction function;
+        BootStepMode mode;
+        uint32_t dependsOn;
+        BootStepTiming timing;
+        BootSequence* owner;
+        BootStepId id;
+    };
+
+    Step _steps[BOOT_MAX_STEPS];
+    int _stepCount;
+    uint32_t _parallelStackSize;
+    UBaseType_t _parallelPriority;
+    EventGroupHandle_t _done;           // Bit gesetzt = Schritt beendet
+    unsigned long _startMs;
+    unsigned long _endMs;
+
+    void runStep(Step& step);
+    static void runParallel(void* parameter);
+};
+
+#endif // BOOT_SEQUENCE_H
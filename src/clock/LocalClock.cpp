@@ -0,0 +1,101 @@
+#include "LocalClock.h"
+
+int32_t LocalClock::sync(uint32_t epochTime, uint32_t nowMs) {
+    // Die wahre Zeit liegt irgendwo in der abgeschnittenen Sekunde, im Mittel in deren Mitte
+    uint64_t sampleMs = (uint64_t)epochTime * 1000 + LOCAL_CLOCK_SYNC_ERROR_MS;
+
+    if (!_synced) {
+        // Erste Synchronisation (evtl. nach einem Warmstart): übernehmen und ein Messfenster beginnen
+        int32_t correction = _valid ? (int32_t)((int64_t)sampleMs - (int64_t)nowEpochMs(nowMs)) : 0;
+        _valid = true;
+        _synced = true;
+        setBase(sampleMs, nowMs, LOCAL_CLOCK_SYNC_ERROR_MS);
+        startWindow(sampleMs, nowMs);
+        return correction;
+    }
+
+    uint64_t predictedMs = nowEpochMs(nowMs);
+    int64_t correction = (int64_t)sampleMs - (int64_t)predictedMs;
+    uint32_t expectedMs = errorMs(nowMs) + LOCAL_CLOCK_SYNC_ERROR_MS;
+    uint32_t thresholdMs = 2 * expectedMs > LOCAL_CLOCK_STEP_THRESHOLD_MS ? 2 * expectedMs : LOCAL_CLOCK_STEP_THRESHOLD_MS;
+    if (correction > (int64_t)thresholdMs || correction < -(int64_t)thresholdMs) {
+        // Sprung (z.B. andere Zeitzone oder falsche Zeit vom Server): die Messung passt nicht mehr zur Uhr
+        _driftPpb = 0;
+        _driftUncertaintyPpb = LOCAL_CLOCK_UNKNOWN_DRIFT_PPB;
+        _driftMeasured = false;
+        setBase(sampleMs, nowMs, LOCAL_CLOCK_SYNC_ERROR_MS);
+        startWindow(sampleMs, nowMs);
+        return (int32_t)correction;
+    }
+
+    // Gangabweichung über das ganze Messfenster: je länger, desto kleiner der Einfluss der ganzen Sekunden
+    uint32_t windowMs = nowMs - _windowLocalMs;
+    if (windowMs >= LOCAL_CLOCK_DRIFT_WINDOW_MS) {
+        int64_t gainedMs = (int64_t)(sampleMs - _windowEpochMs) - (int64_t)windowMs;
+        int64_t driftPpb = gainedMs * 1000000000LL / (int64_t)windowMs;
+        if (driftPpb > LOCAL_CLOCK_MAX_DRIFT_PPB) driftPpb = LOCAL_CLOCK_MAX_DRIFT_PPB;
+        if (driftPpb < -LOCAL_CLOCK_MAX_DRIFT_PPB) driftPpb = -LOCAL_CLOCK_MAX_DRIFT_PPB;
+        _driftPpb = (int32_t)driftPpb;
+        _driftUncertaintyPpb = (int32_t)(2LL * LOCAL_CLOCK_SYNC_ERROR_MS * 1000000000LL / windowMs) + LOCAL_CLOCK_DRIFT_WANDER_PPB;
+        _driftMeasured = true;
+        if (windowMs >= LOCAL_CLOCK_MAX_WINDOW_MS) {
+            startWindow(sampleMs, nowMs);
+        }
+    }
+
+    // Nur die halbe Korrektur übernehmen: die ganzen Sekunden von NTP streuen um ±0.5 s,
+    // die Uhr soll diesem Rauschen nicht folgen
+    setBase((uint64_t)((int64_t)predictedMs + correction / 2), nowMs, LOCAL_CLOCK_SYNC_ERROR_MS);
+    return (int32_t)correction;
+}
+
+void LocalClock::seed(uint32_t epochTime, uint32_t nowMs, uint32_t errorMs) {
+    _valid = true;
+    _synced = false;
+    _driftPpb = 0;
+    _driftUncertaintyPpb = LOCAL_CLOCK_UNKNOWN_DRIFT_PPB;
+    _driftMeasured = false;
+    setBase((uint64_t)epochTime * 1000, nowMs, errorMs);
+}
+
+uint64_t LocalClock::nowEpochMs(uint32_t nowMs) const {
+    uint32_t elapsedMs = nowMs - _baseLocalMs;
+    int64_t driftMs = (int64_t)elapsedMs * _driftPpb / 1000000000LL;
+    return _baseEpochMs + elapsedMs + driftMs;
+}
+
+uint32_t LocalClock::errorMs(uint32_t nowMs) const {
+    uint32_t elapsedMs = nowMs - _baseLocalMs;
+    return _baseErrorMs + (uint32_t)((int64_t)elapsedMs * _driftUncertaintyPpb / 1000000000LL);
+}
+
+ClockQuality LocalClock::getQuality(uint32_t nowMs) const {
+    ClockQuality quality;
+    quality.valid = _valid;
+    quality.synced = _synced;
+    quality.driftMeasured = _driftMeasured;
+    if (_valid) {
+        quality.secondsSinceSync = (nowMs - _baseLocalMs) / 1000;
+        quality.driftPpm = _driftPpb / 1000.0f;
+        quality.estimatedErrorMs = errorMs(nowMs);
+    }
+    return quality;
+}
+
+bool LocalClock::operator==(const LocalClock& other) const {
+    return _valid == other._valid && _synced == other._synced && _driftMeasured == other._driftMeasured &&
+           _baseEpochMs == other._baseEpochMs && _baseLocalMs == other._baseLocalMs && _baseErrorMs == other._baseErrorMs &&
+           _driftPpb == other._driftPpb && _driftUncertaintyPpb == other._driftUncertaintyPpb &&
+           _windowEpochMs == other._windowEpochMs && _windowLocalMs == other._windowLocalMs;
+}
+
+void LocalClock::setBase(uint64_t epochMs, uint32_t nowMs, uint32_t errorMs) {
+    _baseEpochMs = epochMs;
+    _baseLocalMs = nowMs;
+    _baseErrorMs = errorMs;
+}
+
+void LocalClock::startWindow(uint64_t epochMs, uint32_t nowMs) {
+    _windowEpochMs = epochMs;
+    _windowLocalMs = nowMs;
+}
@@ -0,0 +1,73 @@
+#ifndef LOCAL_CLOCK_H
+#define LOCAL_CLOCK_H
+
+#include <stdint.h>
+
+// Fehler einer einzelnen Synchronisation: NTPTimeSync liefert abgeschnittene ganze Sekunden
+const uint32_t LOCAL_CLOCK_SYNC_ERROR_MS = 500;
+// Angenommene Gangabweichung, solange keine gemessen wurde (Quarz des ESP32 inkl. Temperatur), in ppb
+const int32_t LOCAL_CLOCK_UNKNOWN_DRIFT_PPB = 50000;
+// Zusätzliche Unsicherheit einer gemessenen Gangabweichung (Temperatur, Alterung), in ppb
+const int32_t LOCAL_CLOCK_DRIFT_WANDER_PPB = 2000;
+// Grösste plausible Gangabweichung, grössere Messwerte werden begrenzt
+const int32_t LOCAL_CLOCK_MAX_DRIFT_PPB = 200000;
+// Die Gangabweichung wird erst über mindestens so lange Zeit gemessen (±0.5 s über 6 h entspricht ±23 ppm)
+const uint32_t LOCAL_CLOCK_DRIFT_WINDOW_MS = 6UL * 3600UL * 1000UL;
+// Danach beginnt ein neues Messfenster, lange bevor millis() nach 49 Tagen überläuft
+const uint32_t LOCAL_CLOCK_MAX_WINDOW_MS = 30UL * 24UL * 3600UL * 1000UL;
+// Korrekturen bis hierhin (bzw. bis zum doppelten erwarteten Fehler) werden eingeregelt, grössere übernommen
+const uint32_t LOCAL_CLOCK_STEP_THRESHOLD_MS = 2000;
+
+// Qualität der lokalen Uhr für Anzeige und Schnittstellen
+struct ClockQuality {
+    bool valid = false;             // Zeit bekannt
+    bool synced = false;            // Per NTP gestellt (sonst z.B. beim Warmstart wiederhergestellt)
+    bool driftMeasured = false;     // Gangabweichung gemessen und korrigiert
+    uint32_t secondsSinceSync = 0;  // Seit der letzten Synchronisation bzw. Wiederherstellung
+    float driftPpm = 0.0f;          // Korrigierte Gangabweichung von millis() (positiv = millis() läuft zu langsam)
+    uint32_t estimatedErrorMs = 0;  // Geschätzter Fehler der aktuellen Zeit
+};
+
+// Lokale Uhr auf Basis von millis(), gestellt durch NTP. Zwischen den Synchronisationen und ohne WLAN
+// läuft sie selbständig weiter. Aus den Synchronisationen eines Messfensters wird die Gangabweichung
+// bestimmt und korrigiert, der geschätzte Fehler wächst mit der Zeit seit der letzten Synchronisation.
+// Trivial kopierbar, damit sie als Wert über ein Topic verteilt werden kann: jede Task rechnet mit ihrer Kopie.
+// Reine Logik ohne Arduino-Abhängigkeit, die Zeit (millis()) wird von aussen übergeben.
+class LocalClock {
+public:
+    // Stellt die Uhr aus einer Synchronisation: epochTime (ganze Sekunden) galt zum Zeitpunkt nowMs.
+    // Gibt die Korrektur gegenüber der bisherigen Zeit in ms zurück (0, wenn die Uhr noch nicht lief).
+    int32_t sync(uint32_t epochTime, uint32_t nowMs);
+
+    // Stellt die Uhr ohne Synchronisation (z.B. aus dem Warmstart) mit dem angegebenen Anfangsfehler.
+    void seed(uint32_t epochTime, uint32_t nowMs, uint32_t errorMs);
+
+    bool isValid() const { return _valid; }
+    bool isSynced() const { return _synced; }
+
+    // Aktuelle Zeit in Sekunden bzw. Millisekunden seit 1970 (lokale Zeit wie NTPTimeSync::getEpochTime())
+    uint32_t now(uint32_t nowMs) const { return (uint32_t)(nowEpochMs(nowMs) / 1000); }
+    uint64_t nowEpochMs(uint32_t nowMs) const;
+
+    ClockQuality getQuality(uint32_t nowMs) const;
+
+    bool operator==(const LocalClock& other) const;
+
+private:
+    bool _valid = false;
+    bool _synced = false;
+    bool _driftMeasured = false;
+    uint64_t _baseEpochMs = 0;      // Zeit zum Zeitpunkt _baseLocalMs
+    uint32_t _baseLocalMs = 0;
+    uint32_t _baseErrorMs = 0;      // Fehler zum Zeitpunkt _baseLocalMs
+    int32_t _driftPpb = 0;
+    int32_t _driftUncertaintyPpb = LOCAL_CLOCK_UNKNOWN_DRIFT_PPB;
+    uint64_t _windowEpochMs = 0;    // Erste Synchronisation des laufenden Messfensters
+    uint32_t _windowLocalMs = 0;
+
+    uint32_t errorMs(uint32_t nowMs) const;
+    void setBase(uint64_t epochMs, uint32_t nowMs, uint32_t errorMs);
+    void startWindow(uint64_t epochMs, uint32_t nowMs);
+};
+
+#endif // LOCAL_CLOCK_H
@@ -0,0 +1,71 @@
+#ifndef CROSSFADE_H
+#define CROSSFADE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+const uint16_t CROSSFADE_ONE = 256;     // Mischfaktor 1.0 (8 Bit Nachkommastellen)
+
+// Überblendet linear von einem Frame zum nächsten. Ein Frame sind Channels Bytes (z.B. LEDs * 3 für RGB).
+// Der Mischfaktor ergibt sich aus der Zeit seit dem Start, nicht aus der Anzahl Frames: fallen Frames aus
+// (Last, Frame-Obergrenze), springt die Überblendung entsprechend weiter und endet trotzdem pünktlich.
+// Reine Logik ohne Arduino-Abhängigkeit, die Zeit wird von aussen übergeben.
+template <size_t Channels>
+class Crossfade {
+public:
+    Crossfade() : _startMs(0), _durationMs(0), _active(false) {}
+
+    // Überblendung von from nach to über durationMs starten. from darf der Ausgabepuffer von blend() sein.
+    void start(const uint8_t* from, const uint8_t* to, unsigned long durationMs, unsigned long nowMs) {
+        memmove(_from, from, Channels);
+        memcpy(_to, to, Channels);
+        _startMs = nowMs;
+        _durationMs = durationMs;
+        _active = durationMs > 0;
+    }
+
+    // Kanäle ab first sofort auf values setzen (Start und Ziel), die Überblendung der übrigen läuft weiter
+    void setChannels(size_t first, size_t count, const uint8_t* values) {
+        memcpy(_from + first, values, count);
+        memcpy(_to + first, values, count);
+    }
+
+    // Überblendung beenden, blend() liefert danach das Ziel
+    void finish() { _active = false; }
+
+    bool isActive() const { return _active; }
+
+    // Mischfaktor 0-CROSSFADE_ONE zum Zeitpunkt nowMs
+    uint16_t alphaAt(unsigned long nowMs) const {
+        if (!_active) return CROSSFADE_ONE;
+        unsigned long elapsedMs = nowMs - _startMs;
+        if (elapsedMs >= _durationMs) return CROSSFADE_ONE;
+        return (uint16_t)((uint32_t)elapsedMs * CROSSFADE_ONE / _durationMs);
+    }
+
+    // Frame zum Zeitpunkt nowMs nach out schreiben. Gibt false zurück, sobald das Ziel erreicht ist.
+    bool blend(unsigned long nowMs, uint8_t* out) {
+        uint16_t alpha = alphaAt(nowMs);
+        if (alpha >= CROSSFADE_ONE) {
+            memcpy(out, _to, Channels);
+            _active = false;
+            return false;
+        }
+        // out = from + (to - from) * alpha, pro Kanal in Festkomma
+        for (size_t i = 0; i < Channels; i++) {
+            int16_t delta = (int16_t)_to[i] - (int16_t)_from[i];
+            out[i] = (uint8_t)(_from[i] + ((delta * (int32_t)alpha) >> 8));
+        }
+        return true;
+    }
+
+private:
+    uint8_t _from[Channels];
+    uint8_t _to[Channels];
+    unsigned long _startMs;
+    unsigned long _durationMs;
+    bool _active;
+};
+
+#endif // CROSSFADE_H
@@ -0,0 +1,64 @@
+#ifndef DISPLAY_PALETTES_H
+#define DISPLAY_PALETTES_H
+
+#include <stdint.h>
+
+// Farbverläufe der Anzeige als Tabellen, beim Übersetzen aus denselben Stützpunkten berechnet wie zuvor
+// mit map() zur Laufzeit. Beim Zeichnen bleibt ein Tabellenzugriff.
+
+struct PaletteColor {
+    uint8_t r, g, b;
+};
+
+// Ganzzahlige Interpolation wie Arduino map()
+constexpr long paletteMap(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// Luftqualität (IAQ 0-255, ganzzahlig): bis 50 Rot, bis 73 Rot nach Gelb, bis 96 Gelb nach Grün, darüber Grün
+struct AirQualityPalette {
+    PaletteColor colors[256];
+};
+
+constexpr AirQualityPalette buildAirQualityPalette() {
+    AirQualityPalette palette = {};
+    for (int iaq = 0; iaq < 256; iaq++) {
+        PaletteColor color = {};
+        if (iaq <= 50) {
+            color = { 255, 0, 0 };
+        } else if (iaq >= 96) {
+            color = { 0, 255, 0 };
+        } else if (iaq <= 73) {
+            color = { 255, (uint8_t)paletteMap(iaq, 50, 73, 0, 255), 0 };
+        } else {
+            color = { (uint8_t)paletteMap(iaq, 73, 96, 255, 0), 255, 0 };
+        }
+        palette.colors[iaq] = color;
+    }
+    return palette;
+}
+
+constexpr AirQualityPalette AIR_QUALITY_PALETTE = buildAirQualityPalette();
+
+// Pollenbelastung 0-5: Grün nach Rot
+const int POLLEN_LEVEL_MAX = 5;
+
+struct PollenPalette {
+    PaletteColor colors[POLLEN_LEVEL_MAX + 1];
+};
+
+constexpr PollenPalette buildPollenPalette() {
+    PollenPalette palette = {};
+    for (int level = 0; level <= POLLEN_LEVEL_MAX; level++) {
+        palette.colors[level] = { (uint8_t)paletteMap(level, 0, POLLEN_LEVEL_MAX, 0, 255),
+                                  (uint8_t)paletteMap(level, 0, POLLEN_LEVEL_MAX, 255, 0), 0 };
+    }
+    return palette;
+}
+
+constexpr PollenPalette POLLEN_PALETTE = buildPollenPalette();
+
+static_assert(AIR_QUALITY_PALETTE.colors[73].r == 255 && AIR_QUALITY_PALETTE.colors[73].g == 255, "Luftqualität: 73 ist Gelb");
+static_assert(POLLEN_PALETTE.colors[0].g == 255 && POLLEN_PALETTE.colors[POLLEN_LEVEL_MAX].r == 255, "Pollen: Grün nach Rot");
+
+#endif // DISPLAY_PALETTES_H
@@ -0,0 +1,67 @@
+#ifndef FRAME_COMPOSITOR_H
+#define FRAME_COMPOSITOR_H
+
+#include <FastLED.h>
+#include "led/led_strip/LedMask.h"
+
+// Setzt das Bild des LED-Streifens aus unabhängigen Ebenen zusammen. Jede Ebene besitzt die LEDs ihrer Maske,
+// eine höhere Ebene verdeckt an diesen Stellen die tieferen (auch mit Schwarz). LEDs, die keine
+// Ebene besitzt, bleiben aus. Die Ebenen ändern nur ihren eigenen Puffer, compose() erzeugt daraus ein Frame.
+template <uint16_t Count, uint8_t Layers>
+class FrameCompositor {
+public:
+    static_assert(Count <= LED_MASK_BITS, "Mehr LEDs als Bits in LedMask");
+
+    // Ebene leeren: sie besitzt danach keine LEDs mehr und verdeckt nichts
+    void clear(uint8_t layer) {
+        _masks[layer] = LedMask();
+    }
+
+    void set(uint8_t layer, uint16_t index, const CRGB& color) {
+        if (index < Count) {
+            _masks[layer] = _masks[layer] | LedMask::range(index, 1);
+            _colors[layer][index] = color;
+        }
+    }
+
+    void setRange(uint8_t layer, uint16_t first, uint16_t count, const CRGB& color) {
+        setMask(layer, LedMask::range(first, count), color);
+    }
+
+    void setMask(uint8_t layer, const LedMask& mask, const CRGB& color) {
+        _masks[layer] = _masks[layer] | mask;
+        for (uint16_t i = 0; i < Count; i++) {
+            if (mask.test(i)) {
+                _colors[layer][i] = color;
+            }
+        }
+    }
+
+    // Frame von der untersten zur obersten Ebene in frame schreiben. true, wenn sich frame dabei geändert hat,
+    // die geänderten LEDs landen in changedLeds (falls angegeben).
+    bool compose(CRGB (&frame)[Count], LedMask* changedLeds = nullptr) const {
+        bool changed = false;
+        for (uint16_t i = 0; i < Count; i++) {
+            CRGB color = CRGB::Black;
+            for (int layer = 0; layer < Layers; layer++) {
+                if (_masks[layer].test(i)) {
+                    color = _colors[layer][i];
+                }
+            }
+            if (frame[i] != color) {
+                frame[i] = color;
+                changed = true;
+                if (changedLeds != nullptr) {
+                    changedLeds->set(i);
+                }
+            }
+        }
+        return changed;
+    }
+
+private:
+    LedMask _masks[Layers];
+    CRGB _colors[Layers][Count];
+};
+
+#endif // FRAME_COMPOSITOR_H
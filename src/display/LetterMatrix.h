@@ -0,0 +1,87 @@
+#ifndef LETTER_MATRIX_H
+#define LETTER_MATRIX_H
+
+#include <stdint.h>
+#include "WordClockLayout.h"
+#include "led/led_strip/LedMask.h"
+
+// Buchstabenraster der Wortuhr als Koordinaten: 11 Spalten (von links) und 10 Zeilen (von oben) ab
+// WORD_CLOCK_FIRST_LED. Der Streifen läuft in Schlangenlinien: Zeile 0 von rechts nach links, Zeile 1 von links
+// nach rechts usw. (Bild in LedStrip.h). Die Zuordnung steht beim Übersetzen als Tabelle fest.
+
+const uint8_t LETTER_MATRIX_COLUMNS = 11;
+const uint8_t LETTER_MATRIX_ROWS = 10;
+
+// LED-Index des Buchstabens in Zeile row, Spalte column
+constexpr uint8_t letterMatrixLed(int row, int column) {
+    return WORD_CLOCK_FIRST_LED + row * LETTER_MATRIX_COLUMNS +
+           (row % 2 == 0 ? LETTER_MATRIX_COLUMNS - 1 - column : column);
+}
+
+struct LetterMatrixLeds {
+    uint8_t leds[LETTER_MATRIX_ROWS][LETTER_MATRIX_COLUMNS];
+};
+
+constexpr LetterMatrixLeds buildLetterMatrix() {
+    LetterMatrixLeds matrix = {};
+    for (int row = 0; row < LETTER_MATRIX_ROWS; row++) {
+        for (int column = 0; column < LETTER_MATRIX_COLUMNS; column++) {
+            matrix.leds[row][column] = letterMatrixLed(row, column);
+        }
+    }
+    return matrix;
+}
+
+constexpr LetterMatrixLeds LETTER_MATRIX = buildLetterMatrix();
+
+// Maske der Zeilen first bis first + count - 1
+constexpr LedMask letterMatrixRows(int first, int count) {
+    LedMask mask;
+    for (int row = first; row < first + count && row < LETTER_MATRIX_ROWS; row++) {
+        for (int column = 0; column < LETTER_MATRIX_COLUMNS; column++) {
+            mask.set(LETTER_MATRIX.leds[row][column]);
+        }
+    }
+    return mask;
+}
+
+// --- Prüfungen des Rasters ---
+
+// Jede LED des Rasters kommt genau einmal vor, alle liegen im Bereich der Wortuhr
+constexpr bool letterMatrixValid() {
+    LedMask used;
+    for (int row = 0; row < LETTER_MATRIX_ROWS; row++) {
+        for (int column = 0; column < LETTER_MATRIX_COLUMNS; column++) {
+            uint8_t led = LETTER_MATRIX.leds[row][column];
+            if (led < WORD_CLOCK_FIRST_LED || led >= WORD_CLOCK_FIRST_LED + WORD_CLOCK_LED_COUNT || used.test(led)) {
+                return false;
+            }
+            used.set(led);
+        }
+    }
+    return true;
+}
+
+// Jedes Wort liegt in einer Zeile (sonst stimmt die Schlangenlinie nicht mit den Wörtern überein)
+constexpr bool letterMatrixWordsInRows() {
+    for (int word = 0; word < WORD_COUNT; word++) {
+        int first = WORD_CLOCK_WORDS[word].first - WORD_CLOCK_FIRST_LED;
+        int last = first + WORD_CLOCK_WORDS[word].count - 1;
+        if (first / LETTER_MATRIX_COLUMNS != last / LETTER_MATRIX_COLUMNS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(LETTER_MATRIX_ROWS * LETTER_MATRIX_COLUMNS <= WORD_CLOCK_LED_COUNT, "Raster grösser als die Wortuhr");
+static_assert(letterMatrixValid(), "Raster: LED doppelt oder ausserhalb der Wortuhr");
+static_assert(letterMatrixWordsInRows(), "Raster: Wort über zwei Zeilen");
+static_assert(LETTER_MATRIX.leds[0][0] == 22 && LETTER_MATRIX.leds[0][10] == 12 && LETTER_MATRIX.leds[1][0] == 23 &&
+              LETTER_MATRIX.leds[9][10] == 121, "Raster: Schlangenlinie");
+// "ES" beginnt oben links (E = LED 22), "ZWÖUFI" liegt in der untersten Zeile
+static_assert(LETTER_MATRIX.leds[0][0] == WORD_CLOCK_WORDS[WORD_ES].first + 1 &&
+              (WORD_CLOCK_WORDS[WORD_ZWOEUFI].first - WORD_CLOCK_FIRST_LED) / LETTER_MATRIX_COLUMNS == 9,
+              "Raster: Lage der Wörter");
+
+#endif // LETTER_MATRIX_H
@@ -0,0 +1,198 @@
+#ifndef MATRIX_FONT_H
+#define MATRIX_FONT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Zeichensatz für Text auf dem Buchstabenraster (LetterMatrix.h), beim Übersetzen berechnet. Die Zeichen sind
+// als Bild in Zeilen beschrieben ('#' = an) und unterschiedlich breit. Daraus entsteht pro Zeichen eine Folge
+// von Spalten (ein Byte pro Spalte, Bit r = Zeile r), beim Zeichnen werden nur noch Spalten kopiert.
+
+const uint8_t MATRIX_FONT_HEIGHT = 7;
+const uint8_t MATRIX_FONT_MAX_WIDTH = 5;
+const uint8_t MATRIX_FONT_SPACING = 1;          // Leere Spalten zwischen zwei Zeichen
+const uint8_t MATRIX_FONT_FIRST_CHAR = 32;      // Leerzeichen
+const uint8_t MATRIX_FONT_CHAR_COUNT = 96;      // Bis einschliesslich 127
+const size_t MATRIX_FONT_MAX_COLUMNS = 256;     // Spalten aller Zeichen zusammen
+
+struct MatrixGlyph {
+    char character;
+    const char* rows[MATRIX_FONT_HEIGHT];
+};
+
+// Darstellbare Zeichen. Kleinbuchstaben werden als Grossbuchstaben gezeichnet, unbekannte Zeichen als '?'.
+constexpr MatrixGlyph MATRIX_GLYPHS[] = {
+    { '0', { ".###.", "#...#", "#..##", "#.#.#", "##..#", "#...#", ".###." } },
+    { '1', { ".#.", "##.", ".#.", ".#.", ".#.", ".#.", "###" } },
+    { '2', { ".###.", "#...#", "....#", "...#.", "..#..", ".#...", "#####" } },
+    { '3', { "#####", "...#.", "..#..", "...#.", "....#", "#...#", ".###." } },
+    { '4', { "...#.", "..##.", ".#.#.", "#..#.", "#####", "...#.", "...#." } },
+    { '5', { "#####", "#....", "####.", "....#", "....#", "#...#", ".###." } },
+    { '6', { "..##.", ".#...", "#....", "####.", "#...#", "#...#", ".###." } },
+    { '7', { "#####", "....#", "...#.", "..#..", ".#...", ".#...", ".#..." } },
+    { '8', { ".###.", "#...#", "#...#", ".###.", "#...#", "#...#", ".###." } },
+    { '9', { ".###.", "#...#", "#...#", ".####", "....#", "...#.", ".##.." } },
+    { 'A', { ".###.", "#...#", "#...#", "#####", "#...#", "#...#", "#...#" } },
+    { 'B', { "####.", "#...#", "#...#", "####.", "#...#", "#...#", "####." } },
+    { 'C', { ".###.", "#...#", "#....", "#....", "#....", "#...#", ".###." } },
+    { 'D', { "###..", "#..#.", "#...#", "#...#", "#...#", "#..#.", "###.." } },
+    { 'E', { "#####", "#....", "#....", "####.", "#....", "#....", "#####" } },
+    { 'F', { "#####", "#....", "#....", "####.", "#....", "#....", "#...." } },
+    { 'G', { ".###.", "#...#", "#....", "#.###", "#...#", "#...#", ".####" } },
+    { 'H', { "#...#", "#...#", "#...#", "#####", "#...#", "#...#", "#...#" } },
+    { 'I', { "###", ".#.", ".#.", ".#.", ".#.", ".#.", "###" } },
+    { 'J', { "..###", "...#.", "...#.", "...#.", "...#.", "#..#.", ".##.." } },
+    { 'K', { "#...#", "#..#.", "#.#..", "##...", "#.#..", "#..#.", "#...#" } },
+    { 'L', { "#....", "#....", "#....", "#....", "#....", "#....", "#####" } },
+    { 'M', { "#...#", "##.##", "#.#.#", "#.#.#", "#...#", "#...#", "#...#" } },
+    { 'N', { "#...#", "#...#", "##..#", "#.#.#", "#..##", "#...#", "#...#" } },
+    { 'O', { ".###.", "#...#", "#...#", "#...#", "#...#", "#...#", ".###." } },
+    { 'P', { "####.", "#...#", "#...#", "####.", "#....", "#....", "#...." } },
+    { 'Q', { ".###.", "#...#", "#...#", "#...#", "#.#.#", "#..#.", ".##.#" } },
+    { 'R', { "####.", "#...#", "#...#", "####.", "#.#..", "#..#.", "#...#" } },
+    { 'S', { ".####", "#....", "#....", ".###.", "....#", "....#", "####." } },
+    { 'T', { "#####", "..#..", "..#..", "..#..", "..#..", "..#..", "..#.." } },
+    { 'U', { "#...#", "#...#", "#...#", "#...#", "#...#", "#...#", ".###." } },
+    { 'V', { "#...#", "#...#", "#...#", "#...#", "#...#", ".#.#.", "..#.." } },
+    { 'W', { "#...#", "#...#", "#...#", "#.#.#", "#.#.#", "#.#.#", ".#.#." } },
+    { 'X', { "#...#", "#...#", ".#.#.", "..#..", ".#.#.", "#...#", "#...#" } },
+    { 'Y', { "#...#", "#...#", ".#.#.", "..#..", "..#..", "..#..", "..#.." } },
+    { 'Z', { "#####", "....#", "...#.", "..#..", ".#...", "#....", "#####" } },
+    { ' ', { "...", "...", "...", "...", "...", "...", "..." } },
+    { '.', { ".", ".", ".", ".", ".", ".", "#" } },
+    { ':', { ".", ".", "#", ".", "#", ".", "." } },
+    { '-', { "...", "...", "...", "###", "...", "...", "..." } },
+    { '+', { ".....", "..#..", "..#..", "#####", "..#..", "..#..", "....." } },
+    { '/', { ".....", "....#", "...#.", "..#..", ".#...", "#....", "....." } },
+    { '%', { "##...", "##..#", "...#.", "..#..", ".#...", "#..##", "...##" } },
+    { '!', { "#", "#", "#", "#", "#", ".", "#" } },
+    { '?', { ".###.", "#...#", "....#", "...#.", "..#..", ".....", "..#.." } },
+    { '*', { "###", "#.#", "###", "...", "...", "...", "..." } }, // * als Gradzeichen
+};
+
+const char MATRIX_FONT_FALLBACK = '?';
+
+struct MatrixFont {
+    uint8_t columns[MATRIX_FONT_MAX_COLUMNS];           // Spalten aller Zeichen hintereinander
+    uint8_t first[MATRIX_FONT_CHAR_COUNT];              // Erste Spalte des Zeichens in columns
+    uint8_t width[MATRIX_FONT_CHAR_COUNT];              // 0 = nicht beschrieben
+    uint16_t used;                                      // Belegte Spalten
+};
+
+constexpr size_t matrixGlyphRowWidth(const MatrixGlyph& glyph) {
+    size_t width = 0;
+    while (glyph.rows[0][width] != '\0') {
+        width++;
+    }
+    return width;
+}
+
+// Zeilen eines Zeichens in width Spalten nach columns umsetzen
+constexpr void rasterizeMatrixGlyph(const MatrixGlyph& glyph, uint8_t* columns, size_t width) {
+    for (size_t column = 0; column < width; column++) {
+        uint8_t bits = 0;
+        for (uint8_t row = 0; row < MATRIX_FONT_HEIGHT; row++) {
+            if (glyph.rows[row][column] == '#') {
+                bits |= 1 << row;
+            }
+        }
+        columns[column] = bits;
+    }
+}
+
+constexpr MatrixFont buildMatrixFont() {
+    MatrixFont font = {};
+    for (const MatrixGlyph& glyph : MATRIX_GLYPHS) {
+        size_t index = glyph.character - MATRIX_FONT_FIRST_CHAR;
+        size_t width = matrixGlyphRowWidth(glyph);
+        font.first[index] = font.used;
+        font.width[index] = width;
+        rasterizeMatrixGlyph(glyph, &font.columns[font.used], width);
+        font.used += width;
+    }
+    return font;
+}
+
+constexpr MatrixFont MATRIX_FONT = buildMatrixFont();
+
+// Index des Zeichens in MATRIX_FONT: Kleinbuchstaben wie Grossbuchstaben, sonst MATRIX_FONT_FALLBACK
+constexpr size_t matrixFontIndex(char c) {
+    if (c >= 'a' && c <= 'z') {
+        c = c - 'a' + 'A';
+    }
+    size_t index = (uint8_t)c - MATRIX_FONT_FIRST_CHAR;
+    if ((uint8_t)c < MATRIX_FONT_FIRST_CHAR || index >= MATRIX_FONT_CHAR_COUNT || MATRIX_FONT.width[index] == 0) {
+        return MATRIX_FONT_FALLBACK - MATRIX_FONT_FIRST_CHAR;
+    }
+    return index;
+}
+
+constexpr uint8_t matrixGlyphWidth(char c) {
+    return MATRIX_FONT.width[matrixFontIndex(c)];
+}
+
+// Spalte column (0 = links) eines Zeichens
+constexpr uint8_t matrixGlyphColumn(char c, uint8_t column) {
+    return MATRIX_FONT.columns[MATRIX_FONT.first[matrixFontIndex(c)] + column];
+}
+
+// Breite eines Texts in Spalten mit Abstand zwischen den Zeichen
+constexpr size_t matrixTextWidth(const char* text) {
+    size_t width = 0;
+    for (size_t i = 0; text[i] != '\0'; i++) {
+        width += (i > 0 ? MATRIX_FONT_SPACING : 0) + matrixGlyphWidth(text[i]);
+    }
+    return width;
+}
+
+// Erste Spalte des Zeichens index in einem Text (z.B. um einen Lauftext dort zu beginnen)
+constexpr size_t matrixTextColumn(const char* text, size_t index) {
+    size_t column = 0;
+    for (size_t i = 0; i < index && text[i] != '\0'; i++) {
+        column += matrixGlyphWidth(text[i]) + MATRIX_FONT_SPACING;
+    }
+    return column;
+}
+
+// --- Prüfungen des Zeichensatzes ---
+
+// Jedes Zeichen höchstens einmal beschrieben, im Bereich der Tabelle und mit gleich breiten Zeilen
+constexpr bool matrixGlyphsValid() {
+    size_t count = sizeof(MATRIX_GLYPHS) / sizeof(MATRIX_GLYPHS[0]);
+    size_t columns = 0;
+    for (size_t i = 0; i < count; i++) {
+        const MatrixGlyph& glyph = MATRIX_GLYPHS[i];
+        char c = glyph.character;
+        if ((uint8_t)c < MATRIX_FONT_FIRST_CHAR || (uint8_t)c >= MATRIX_FONT_FIRST_CHAR + MATRIX_FONT_CHAR_COUNT ||
+            (c >= 'a' && c <= 'z')) {
+            return false;
+        }
+        size_t width = matrixGlyphRowWidth(glyph);
+        if (width == 0 || width > MATRIX_FONT_MAX_WIDTH) return false;
+        for (uint8_t row = 0; row < MATRIX_FONT_HEIGHT; row++) {
+            for (size_t column = 0; column < width; column++) {
+                char pixel = glyph.rows[row][column];
+                if (pixel != '#' && pixel != '.') return false;
+            }
+            if (glyph.rows[row][width] != '\0') return false;
+        }
+        for (size_t j = i + 1; j < count; j++) {
+            if (MATRIX_GLYPHS[j].character == c) return false;
+        }
+        columns += width;
+    }
+    return columns <= MATRIX_FONT_MAX_COLUMNS;
+}
+
+static_assert(matrixGlyphsValid(), "Raster-Zeichensatz: Zeichen doppelt, ungültig oder Tabelle zu klein");
+static_assert(MATRIX_FONT_HEIGHT <= 8, "Raster-Zeichensatz: Spalte passt nicht in ein Byte");
+// Rasterung: "1" von links nach rechts, Bit 0 = oberste Zeile
+static_assert(matrixGlyphWidth('1') == 3 && matrixGlyphColumn('1', 0) == 0x42 && matrixGlyphColumn('1', 1) == 0x7F &&
+              matrixGlyphColumn('1', 2) == 0x40, "Raster-Zeichensatz: Spalten");
+static_assert(matrixGlyphColumn('.', 0) == 0x40 && matrixGlyphColumn(' ', 1) == 0, "Raster-Zeichensatz: Punkt, Leerzeichen");
+static_assert(matrixFontIndex('e') == matrixFontIndex('E') && matrixFontIndex('~') == matrixFontIndex('?') &&
+              matrixFontIndex('\n') == matrixFontIndex('?'), "Raster-Zeichensatz: Schreibweisen und Ersatzzeichen");
+static_assert(matrixTextWidth("21") == 9 && matrixTextWidth("") == 0 && matrixTextColumn("21.4", 3) == 12,
+              "Raster-Zeichensatz: Textbreite");
+
+#endif // MATRIX_FONT_H
@@ -0,0 +1,107 @@
+#ifndef MATRIX_TEXT_H
+#define MATRIX_TEXT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "LetterMatrix.h"
+#include "MatrixFont.h"
+
+const size_t MATRIX_TEXT_MAX_COLUMNS = 192;     // Längster Text in Spalten (ca. 30 Zeichen)
+const uint8_t MATRIX_TEXT_GAP = 4;              // Leere Spalten zwischen Ende und Anfang eines Lauftexts
+const uint8_t MATRIX_TEXT_TOP = 1;              // Oberste Zeile des Texts im Raster
+
+static_assert(MATRIX_TEXT_TOP + MATRIX_FONT_HEIGHT <= LETTER_MATRIX_ROWS, "Text höher als das Raster");
+
+// LEDs, die ein Text belegt (auch dort, wo er dunkel ist)
+constexpr LedMask MATRIX_TEXT_AREA = letterMatrixRows(MATRIX_TEXT_TOP, MATRIX_FONT_HEIGHT);
+
+// Text auf dem Buchstabenraster. setText() legt die Spalten des ganzen Texts einmal aus dem Zeichensatz ab,
+// ein Bild ist danach nur noch ein Ausschnitt von LETTER_MATRIX_COLUMNS Spalten ab einer Spalte (Offset).
+// Ein schmaler Text steht in der Mitte, ein breiterer läuft von rechts nach links durch. Der Offset ergibt sich
+// aus der Zeit seit start(), nicht aus der Anzahl Frames: fallen Frames aus, springt der Text weiter.
+// Reine Logik ohne Arduino-Abhängigkeit, die Zeit wird von aussen übergeben.
+class MatrixText {
+public:
+    MatrixText() : _width(0), _startMs(0), _intervalMs(0), _startColumn(0) {}
+
+    // Spalten des Texts ablegen, Zeichen über MATRIX_TEXT_MAX_COLUMNS hinaus werden weggelassen
+    void setText(const char* text) {
+        _width = 0;
+        for (size_t i = 0; text[i] != '\0'; i++) {
+            uint8_t width = matrixGlyphWidth(text[i]);
+            size_t spacing = i > 0 ? MATRIX_FONT_SPACING : 0;
+            if (_width + spacing + width > MATRIX_TEXT_MAX_COLUMNS) {
+                break;
+            }
+            for (size_t s = 0; s < spacing; s++) {
+                _columns[_width++] = 0;
+            }
+            for (uint8_t column = 0; column < width; column++) {
+                _columns[_width++] = matrixGlyphColumn(text[i], column);
+            }
+        }
+    }
+
+    // Lauftext ab nowMs bei Spalte startColumn beginnen und alle intervalMs um eine Spalte weiterrücken,
+    // 0 = Text bleibt stehen
+    void start(unsigned long nowMs, unsigned long intervalMs, size_t startColumn = 0) {
+        _startMs = nowMs;
+        _intervalMs = intervalMs;
+        _startColumn = startColumn;
+    }
+
+    size_t width() const { return _width; }
+
+    bool scrolls() const { return _width > LETTER_MATRIX_COLUMNS && _intervalMs > 0; }
+
+    // Spalte des Texts am linken Rand zum Zeitpunkt nowMs. Negativ, wenn der Text eingerückt ist.
+    int offsetAt(unsigned long nowMs) const {
+        if (_width <= LETTER_MATRIX_COLUMNS) {
+            return -(int)((LETTER_MATRIX_COLUMNS - _width) / 2);
+        }
+        size_t period = _width + MATRIX_TEXT_GAP;
+        if (_intervalMs == 0) {
+            return (int)(_startColumn % period);
+        }
+        return (int)((_startColumn + (nowMs - _startMs) / _intervalMs) % period);
+    }
+
+    // Wartezeit in ms bis zur nächsten Spalte, 0 = Text steht
+    unsigned long waitAt(unsigned long nowMs) const {
+        if (!scrolls()) {
+            return 0;
+        }
+        return _intervalMs - (nowMs - _startMs) % _intervalMs;
+    }
+
+    // Leuchtende LEDs des Ausschnitts ab Spalte offset (innerhalb von MATRIX_TEXT_AREA)
+    LedMask mask(int offset) const {
+        LedMask mask;
+        int period = _width + MATRIX_TEXT_GAP;
+        for (int column = 0; column < LETTER_MATRIX_COLUMNS; column++) {
+            int textColumn = offset + column;
+            if (_width > LETTER_MATRIX_COLUMNS) {
+                textColumn %= period;
+            }
+            if (textColumn < 0 || textColumn >= (int)_width) {
+                continue;
+            }
+            uint8_t bits = _columns[textColumn];
+            for (uint8_t row = 0; bits != 0; row++, bits >>= 1) {
+                if (bits & 1) {
+                    mask.set(LETTER_MATRIX.leds[MATRIX_TEXT_TOP + row][column]);
+                }
+            }
+        }
+        return mask;
+    }
+
+private:
+    uint8_t _columns[MATRIX_TEXT_MAX_COLUMNS];  // Bit r = Zeile MATRIX_TEXT_TOP + r
+    size_t _width;
+    unsigned long _startMs;
+    unsigned long _intervalMs;
+    size_t _startColumn;
+};
+
+#endif // MATRIX_TEXT_H
@@ -1,132 +1,302 @@
+#ifndef UPDATE_DISPLAY_H
+#define UPDATE_DISPLAY_H
+
 // Logger
 #include "logger/Logger.h"
 #include "logger/LogLevel.h"
 
+#include "hardware/HardwareConfig.h"
+#include "WordClockLayout.h"
+#include "FrameCompositor.h"
+#include "DisplayPalettes.h"
+#include "Crossfade.h"
+#include "MatrixText.h"
 #include "i2cbus/seven_segment/SevenSegmentDisplay.h"
 
 #include "led/led_strip/LedStrip.h"
+#include "webservice/api/weather/WeatherData.h"
 #include <mp3player/Mp3Player.h>
 
-// Sieben Segment Anzeigen
-SevenSegmentDisplay* sevenSegmentDisplays[5]; 
-const uint8_t PCF_ADDRESSES[5] = {0x20, 0x21, 0x22, 0x23, 0x24};
+// Die Wortuhr belegt die LEDs bis Index 122, die Zahlen verteilen sich auf fünf Anzeigen
+static_assert(NUM_LEDS >= WORD_CLOCK_FIRST_LED + WORD_CLOCK_LED_COUNT, "LED-Streifen zu kurz für die Wortuhr");
+static_assert(SEVEN_SEGMENT_COUNT == 5, "Temperatur und Feuchtigkeit benötigen fünf 7-Segment-Anzeigen");
+static_assert(sizeof(CRGB) == 3, "Überblendung erwartet CRGB als drei Bytes");
+
+const int DISPLAY_REGION_UNKNOWN = INT32_MIN;  // Bereich neu zeichnen, unabhängig vom Eingangswert
+const size_t DISPLAY_TEXT_MAX_CELLS = 32;       // Längster Text der 7-Segment-Anzeigen in Stellen
+const size_t DISPLAY_SCROLL_GAP = 3;            // Leere Stellen zwischen Ende und Anfang eines Lauftexts
+const size_t DISPLAY_MENU_FIELD = 3;            // Stellen des Menüwerts (Temperaturanzeige)
+const size_t DISPLAY_TEMPERATURE_FIELD = 3;     // Textfelder ab dieser Stelle überdecken die Feuchtigkeit
+
+// Ebenen des LED-Streifens, von unten nach oben
+enum DisplayLayer {
+    LAYER_TIME,             // Wortuhr
+    LAYER_WEATHER,          // Wettersymbole (LED 2-7)
+    LAYER_POLLEN,           // Pollenbalken (LED 9-11)
+    LAYER_AIR_QUALITY,      // Luftqualität (LED 0)
+    LAYER_MARKERS,          // Innen/Aussen bei Temperatur (LED 1) und Feuchtigkeit (LED 8)
+    LAYER_STATUS,           // Überlagerung, z.B. das Menü
+    LAYER_TEXT,             // Text auf dem Buchstabenraster (MatrixText.h)
+    LAYER_COUNT
+};
+
+// Innen/Aussen-Marker (LAYER_MARKERS) wechseln mit jedem Umschalten der Werte und erscheinen ohne Überblendung
+constexpr LedMask DISPLAY_INSTANT_LEDS = LedMask::range(1, 1) | LedMask::range(8, 1);
+
+// Wartezeit bis zum erneuten Senden, wenn eine 7-Segment-Anzeige nicht geschrieben werden konnte
+const unsigned long DISPLAY_SEGMENT_RETRY_MS = 1000;
+
+// Zähler der Anzeige: neu berechnete und unveränderte Bereiche, gesendete und verworfene Frames des LED-Streifens
+struct DisplayRenderStats {
+    uint32_t rendered;          // Eingangswert geändert, Bereich neu berechnet
+    uint32_t skipped;           // Eingangswert unverändert, Bereich nicht angefasst
+    uint32_t frames;            // Zusammengesetzte Frames
+    uint32_t shown;             // Frames an den LED-Streifen gesendet
+    uint32_t unchanged;         // Frames nicht gesendet, da identisch mit dem letzten
+    uint64_t totalFrameMicros;  // Zusammensetzen und Übergabe an die Ausgabe
+    uint32_t maxFrameMicros;
+    uint32_t dropped;           // Frames verworfen, da die Ausgabe noch belegt war
+    uint64_t blockedMicros;     // Zeit, welche die Ausgabe die Anzeige-Task blockiert hat
+    uint32_t maxBlockedMicros;
+    uint32_t blends;            // Überblendete Frames
+    uint64_t totalBlendMicros;
+    uint32_t maxBlendMicros;
+    uint32_t budgetOverruns;    // Frames über dem Zeitbudget
+    uint32_t skippedFrames;     // Deshalb ausgelassene Frames der Überblendung
+    SevenSegmentStats segments; // Summe über alle 7-Segment-Anzeigen
+};
+
+// Wird aufgerufen, sobald ein Frame aussteht (z.B. um einen Job einzuplanen, der renderFrame() aufruft)
+typedef void (*FrameRequestHandler)();
+
+// Anzeige aus LED-Streifen und 7-Segment-Anzeigen. Besitzt die Treiber selbst und wird statisch angelegt,
+// der Konstruktor greift nicht auf die Hardware zu.
+// Jeder Bereich (Wortuhr, Wetter, Pollen, ...) merkt sich den Eingangswert, mit dem er zuletzt gezeichnet wurde,
+// und wird nur bei einem anderen Wert neu berechnet. Die LED-Bereiche zeichnen in ihre eigene Ebene und fordern
+// ein Frame an. renderFrame() setzt die Ebenen zusammen und sendet höchstens ein Frame pro Frame-Intervall,
+// mehrere Änderungen dazwischen landen im selben Frame. Ein neues Bild wird über die eingestellte Zeit
+// eingeblendet (Crossfade), das Menü und die Innen/Aussen-Marker erscheinen und verschwinden sofort.
+// Texte auf den 7-Segment-Anzeigen laufen durch, wenn sie länger als ihr Feld sind (renderFrame() rückt sie weiter).
+// Ebenso Texte auf dem Buchstabenraster, die breiter als 11 Spalten sind.
+class UpdateDisplay {
+    public:
+        UpdateDisplay() : _segments(SEVEN_SEGMENT_ADDRESSES), _colorTime(CRGB::Blue), _rendered(0), _skipped(0),
+          _frameRequestHandler(nullptr), _frameIntervalMs(0), _ditherIntervalMs(0), _framePending(false), _lastFrameMs(0),
+          _frames(0), _totalFrameMicros(0), _maxFrameMicros(0), _crossfadeMs(0), _frameBudgetMicros(0),
+          _instantFrame(false), _skipFadeFrame(false), _blends(0), _totalBlendMicros(0), _maxBlendMicros(0),
+          _budgetOverruns(0), _skippedFrames(0), _segmentRetry(false), _segmentFailedMs(0), _textCells(0), _textField(0),
+          _textOffset(0), _scrolling(false), _scrollIntervalMs(0), _nextScrollMs(0), _matrixShown(false),
+          _shownMatrixOffset(DISPLAY_REGION_UNKNOWN), _matrixScrollIntervalMs(0) {
+            invalidateLEDs();
+            invalidateTemperature();
+            invalidateHumidity();
+        }
 
-// LED
-LedStrip* myLedStrip;
+        // 7-Segment-Anzeigen (nach dem i2c Bus) und LED-Streifen starten
+        void begin() {
+            _segments.begin();
+            _ledStrip.begin();
+            _layers.set(LAYER_MARKERS, 1, CRGB(255, 0, 0)); // °C
+            _layers.set(LAYER_MARKERS, 8, CRGB(0, 0, 255)); // %
+            showFrame();
+        }
 
-// Variablen
-float lastTemp = 0;
-CRGB displayColorTime = CRGB::Blue;
+        // Ausstehende Frames meldet die Anzeige über handler (nur aus der Task, die auch renderFrame() aufruft)
+        void setFrameRequestHandler(FrameRequestHandler handler) {
+            _frameRequestHandler = handler;
+        }
 
-boolean songPlayed = false;
+        // Obergrenze der Frames pro Sekunde, 0 = unbegrenzt
+        void setMaxFrameRate(int framesPerSecond) {
+            _frameIntervalMs = framesPerSecond > 0 ? 1000 / framesPerSecond : 0;
+        }
+
+        // Zeitliches Dithering bei geringer Helligkeit: solange es wirkt, wird mit framesPerSecond
+        // laufend neu gesendet (verhindert dann den Light-Sleep)
+        void setDithering(bool enable, int framesPerSecond) {
+            _ledStrip.setDithering(enable);
+            _ditherIntervalMs = framesPerSecond > 0 ? 1000 / framesPerSecond : 0;
+        }
+
+        // Überblendung zwischen zwei Bildern über durationMs (0 = sofort). Braucht ein Frame länger als
+        // budgetMicros, wird das nächste Frame der Überblendung ausgelassen.
+        void setCrossfade(unsigned long durationMs, uint32_t budgetMicros) {
+            _crossfadeMs = durationMs;
+            _frameBudgetMicros = budgetMicros;
+        }
+
+        // Schrittweite eines Lauftexts, 0 = Text bleibt am Anfang stehen
+        void setScrollInterval(unsigned long intervalMs) {
+            _scrollIntervalMs = intervalMs;
+        }
+
+        // Spaltenweise Schrittweite eines Texts auf dem Buchstabenraster, 0 = Text bleibt am Anfang stehen
+        void setMatrixScrollInterval(unsigned long intervalMs) {
+            _matrixScrollIntervalMs = intervalMs;
+        }
+
+        // Lauftexte weiterrücken und ausstehendes Frame zusammensetzen und senden, sobald das Frame-Intervall seit
+        // dem letzten abgelaufen ist. Gibt 0 zurück, wenn nichts mehr aussteht, sonst die Wartezeit in ms bis zum
+        // nächsten Aufruf.
+        unsigned long renderFrame(unsigned long nowMs) {
+            unsigned long waitMs = earliestWait(scrollText(nowMs), retrySegments(nowMs));
+            waitMs = earliestWait(waitMs, scrollMatrix(nowMs));
+            return earliestWait(waitMs, renderPendingFrame(nowMs));
+        }
+
+        // Frame sofort zusammensetzen und senden, ohne Frame-Intervall (Start, Tests).
+        // Wartet nur, falls das vorherige Frame noch gesendet wird, nicht auf das Ende der Übertragung.
+        void showFrame() {
+            _ledStrip.waitIdle();
+            unsigned long start = micros();
+            unsigned long nowMs = millis();
+            _framePending = false;
+            _lastFrameMs = nowMs;
+
+            // 7-Segment-Anzeigen: nur geänderte Bytes, alle in diesem Frame. Eine fehlgeschlagene Anzeige
+            // bleibt markiert und wird mit einem späteren Frame erneut gesendet, auch wenn sich nichts mehr ändert.
+            _segmentRetry = !_segments.flush();
+            if (_segmentRetry) {
+                _segmentFailedMs = nowMs;
+            }
+
+            // Neues Bild: vom gerade gezeigten Frame aus überblenden
+            LedMask changed;
+            if (_layers.compose(_target, &changed)) {
+                if (_instantFrame || _frames == 0 || _crossfadeMs == 0) {
+                    _fade.finish();
+                    memcpy(_frame, _target, sizeof(_frame));
+                } else if ((changed & DISPLAY_INSTANT_LEDS) == changed) {
+                    // Nur die Marker: sofort übernehmen, eine laufende Überblendung der übrigen LEDs läuft weiter
+                    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+                        if (changed.test(i)) {
+                            _frame[i] = _target[i];
+                            _fade.setChannels(i * 3, 3, (const uint8_t*)&_target[i]);
+                        }
+                    }
+                } else {
+                    _fade.start((const uint8_t*)_frame, (const uint8_t*)_target, _crossfadeMs, nowMs);
+                }
+            }
+            _instantFrame = false;
+            if (_fade.isActive()) {
+                unsigned long blendStart = micros();
+                _fade.blend(nowMs, (uint8_t*)_frame);
+                uint32_t blendMicros = micros() - blendStart;
+                _blends++;
+                _totalBlendMicros += blendMicros;
+                if (blendMicros > _maxBlendMicros) {
+                    _maxBlendMicros = blendMicros;
+                }
+            }
+            _ledStrip.setFrame(_frame);
+            _ledStrip.show();
+
+            uint32_t frameMicros = micros() - start;
+            _frames++;
+            _totalFrameMicros += frameMicros;
+            if (frameMicros > _maxFrameMicros) {
+                _maxFrameMicros = frameMicros;
+            }
+            if (_frameBudgetMicros > 0 && frameMicros > _frameBudgetMicros) {
+                _budgetOverruns++;
+                _skipFadeFrame = true;
+            }
+            if (_fade.isActive() || _ledStrip.isDithering()) {
+                requestFrame(); // Nächster Schritt der Überblendung bzw. des Ditherings
+            }
+        }
 
-class UpdateDisplay {
-    public:
         // Wert von Temperatur an die Anzeige übergeben.
+        // Innen- und Aussenwert wechseln sich ab, verglichen wird deshalb der angezeigte Wert (Zehntelgrad).
         void updateTemperature(float temperature) {
-            if(abs(lastTemp - temperature) > 0.1){
-
-                Logger::log(LogLevel::Debug, "Temperatur: " + String(temperature, 2) + "°C"); // 2 Nachkommastellen
-                
-                // Temperatur Anzeigen auf 7 Segment Anzeige
-                int temp = temperature * 10; // Eine Komma Stelle soll angezeigt werden
-                lastTemp = static_cast<float>(temp) / 10; // Temperatur in Float umrechnen, aber mit nur einer Komma Zahl.
-                if (temp >= 0) {
-                    sevenSegmentDisplays[0]->displayDigit(temp         % 10);
-                    sevenSegmentDisplays[1]->displayDigit((temp /  10) % 10, true);
-                    
-                    if(temp >= 100) {
-                        sevenSegmentDisplays[2]->displayDigit((temp / 100) % 10);
-                    }
-                    else {
-                        sevenSegmentDisplays[2]->allSegmentsOff();
-                    }
+            int temp = lroundf(temperature * 10); // Eine Komma Stelle soll angezeigt werden
+            if (!regionChanged(_shownTemperature, temp)) {
+                return;
+            }
+            _scrolling = false;
+            Logger::log(LogLevel::Debug, "Temperatur: " + String(temperature, 2) + "°C"); // 2 Nachkommastellen
+
+            // Temperatur Anzeigen auf 7 Segment Anzeige
+            if (temp >= 0) {
+                _segments[0].displayDigit(temp         % 10);
+                _segments[1].displayDigit((temp /  10) % 10, true);
+
+                if(temp >= 100) {
+                    _segments[2].displayDigit((temp / 100) % 10);
                 }
                 else {
-                    sevenSegmentDisplays[2]->displayMinus();
-                    temp = abs(temp);
-                    if (temp <= 99) {
-                        sevenSegmentDisplays[0]->displayDigit(temp         % 10);
-                        sevenSegmentDisplays[1]->displayDigit((temp /  10) % 10, true);
-                    }
-                    else {
-                        sevenSegmentDisplays[0]->displayDigit((temp /  10) % 10);
-                        sevenSegmentDisplays[1]->displayDigit((temp / 100) % 10);
-                    }
+                    _segments[2].allSegmentsOff();
+                }
+            }
+            else {
+                _segments[2].displayMinus();
+                temp = abs(temp);
+                if (temp <= 99) {
+                    _segments[0].displayDigit(temp         % 10);
+                    _segments[1].displayDigit((temp /  10) % 10, true);
+                }
+                else {
+                    _segments[0].displayDigit((temp /  10) % 10);
+                    _segments[1].displayDigit((temp / 100) % 10);
                 }
-            }   
+            }
+            requestFrame();
         }
 
         // Wert von Feuchtigkeit an die Anzeige übergeben
         void updateHumidity(float humidity) {
-            
+            int humi = humidity;
+            if (!regionChanged(_shownHumidity, humi)) {
+                return;
+            }
+            if (_textField > DISPLAY_TEMPERATURE_FIELD) {
+                _scrolling = false;
+            }
             Logger::log(LogLevel::Debug, "Feuchtigkeit: " + String(humidity, 2) + "%"); // 2 Nachkommastellen
 
             // Luftfeuchtigkeit Anzeigen auf 7 Segment Anzeige
-            int humi = humidity;
 
-            sevenSegmentDisplays[3]->displayDigit(humi % 10);
+            _segments[3].displayDigit(humi % 10);
 
             if (humi >= 10) {
-                sevenSegmentDisplays[4]->displayDigit((humi / 10) % 10);
+                _segments[4].displayDigit((humi / 10) % 10);
             }
             else {
-                sevenSegmentDisplays[4]->allSegmentsOff();
+                _segments[4].allSegmentsOff();
             }
+            requestFrame();
             
 
         }
 
         // Wert der Luftqualität an die Anzeige übergeben.
         void updateAirQuality(float airQuality){
-
-            Logger::log(LogLevel::Debug, "Feuchtigkeit: " + String(airQuality, 2) + "%"); // 2 Nachkommastellen
-
-            // Farben definieren
-            uint8_t r, g, b;
-
-            if (airQuality <= 50.0) {
-                // IAQ von 0 bis 50: Immer Rot
-                r = 255;
-                g = 0;
-                b = 0;
-
-            } else if (airQuality >= 96.0) {
-                // IAQ von 96 bis 100: Immer Grün
-                r = 0;
-                g = 255;
-                b = 0;
-
-            } else if (airQuality <= 73.0) { // Angepasster Mittelpunkt für den Gelb-Übergang
-                // IAQ von 50 bis 73: Rot nach Gelb
-                // IAQ 50  -> Rot (255, 0, 0)
-                // IAQ 73  -> Gelb (255, 255, 0)
-                r = 255;
-                g = (uint8_t)map(airQuality, 50, 73, 0, 255);
-                b = 0;
-
-            } else {
-                // IAQ von 73 bis 96: Gelb nach Grün
-                // IAQ 73  -> Gelb (255, 255, 0)
-                // IAQ 96 -> Grün (0, 255, 0)
-                r = (uint8_t)map(airQuality, 73, 96, 255, 0);
-                g = 255;
-                b = 0;
+            if (!regionChanged(_shownAirQuality, lroundf(airQuality * 10))) {
+                return;
             }
-            myLedStrip->setSingleLED(0, r, g, b);
+            Logger::log(LogLevel::Debug, "Luftqualität: " + String(airQuality, 2) + "%"); // 2 Nachkommastellen
 
+            // Farbverlauf Rot - Gelb - Grün aus AIR_QUALITY_PALETTE (wie map(): auf ganze IAQ abgeschnitten)
+            int iaq = airQuality <= 0.0f ? 0 : (airQuality >= 255.0f ? 255 : (int)airQuality);
+            const PaletteColor& color = AIR_QUALITY_PALETTE.colors[iaq];
+            _layers.set(LAYER_AIR_QUALITY, 0, CRGB(color.r, color.g, color.b));
+            requestFrame();
         }
 
         // Wert des Wetters an die Anzeige übergeben.
         void updateWeather(WeatherConditionType weather) {
-            myLedStrip->clearGroupLEDs(2, 6, false);
+            if (!regionChanged(_shownWeather, (int)weather)) {
+                return;
+            }
+            _layers.clear(LAYER_WEATHER);
             switch(weather){
                 // case WeatherConditionType::TYPE_UNSPECIFIED: ; break;
-                case WeatherConditionType::CLEAR: myLedStrip->setSingleLED(7, 255, 255, 0); break;
+                case WeatherConditionType::CLEAR: _layers.set(LAYER_WEATHER, 7, CRGB(255, 255, 0)); break;
                 // case WeatherConditionType::MOSTLY_CLEAR: ; break;
-                case WeatherConditionType::PARTLY_CLOUDY: myLedStrip->setSingleLED(6, 143, 139, 102); break;
+                case WeatherConditionType::PARTLY_CLOUDY: _layers.set(LAYER_WEATHER, 6, CRGB(143, 139, 102)); break;
                 // case WeatherConditionType::MOSTLY_CLOUDY: ; break;
-                case WeatherConditionType::CLOUDY: myLedStrip->setSingleLED(5, 128, 128, 128); break;
+                case WeatherConditionType::CLOUDY: _layers.set(LAYER_WEATHER, 5, CRGB(128, 128, 128)); break;
                 // case WeatherConditionType::WINDY: ; break;
                 // case WeatherConditionType::WIND_AND_RAIN: ; break;
                 // case WeatherConditionType::LIGHT_RAIN_SHOWERS: ; break;
@@ -136,7 +306,7 @@ class UpdateDisplay {
                 // case WeatherConditionType::HEAVY_RAIN_SHOWERS: ; break;
                 // case WeatherConditionType::LIGHT_TO_MODERATE_RAIN: ; break;
                 // case WeatherConditionType::MODERATE_TO_HEAVY_RAIN: ; break;
-                case WeatherConditionType::RAIN: myLedStrip->setSingleLED(4, 0, 0, 255); break;
+                case WeatherConditionType::RAIN: _layers.set(LAYER_WEATHER, 4, CRGB(0, 0, 255)); break;
                 // case WeatherConditionType::LIGHT_RAIN: ; break;
                 // case WeatherConditionType::HEAVY_RAIN: ; break;
                 // case WeatherConditionType::RAIN_PERIODICALLY_HEAVY: ; break;
@@ -147,7 +317,7 @@ class UpdateDisplay {
                 // case WeatherConditionType::HEAVY_SNOW_SHOWERS: ; break;
                 // case WeatherConditionType::LIGHT_TO_MODERATE_SNOW: ; break;
                 // case WeatherConditionType::MODERATE_TO_HEAVY_SNOW: ; break;
-                case WeatherConditionType::SNOW: myLedStrip->setSingleLED(2, 255, 255, 255); break;
+                case WeatherConditionType::SNOW: _layers.set(LAYER_WEATHER, 2, CRGB(255, 255, 255)); break;
                 // case WeatherConditionType::LIGHT_SNOW: ; break;
                 // case WeatherConditionType::HEAVY_SNOW: ; break;
                 // case WeatherConditionType::SNOWSTORM: ; break;
@@ -157,200 +327,233 @@ class UpdateDisplay {
                 // case WeatherConditionType::RAIN_AND_SNOW: ; break;
                 // case WeatherConditionType::HAIL: ; break;
                 // case WeatherConditionType::HAIL_SHOWERS: ; break;
-                case WeatherConditionType::THUNDERSTORM: myLedStrip->setSingleLED(3, 255, 255, 0); break;
+                case WeatherConditionType::THUNDERSTORM: _layers.set(LAYER_WEATHER, 3, CRGB(255, 255, 0)); break;
                 // case WeatherConditionType::THUNDERSHOWER: ; break;
                 // case WeatherConditionType::LIGHT_THUNDERSTORM_RAIN: ; break;
                 // case WeatherConditionType::SCATTERED_THUNDERSTORMS: ; break;
                 // case WeatherConditionType::HEAVY_THUNDERSTORM: ; break;
-                case WeatherConditionType::UNKNOWN: myLedStrip->clearGroupLEDs(2, 6); break; // Fallback -> Nichts anzeigen break;
+                case WeatherConditionType::UNKNOWN: break; // Fallback -> Nichts anzeigen
             }
+            requestFrame();
         }
 
         // Wert der Pollen an die Anzeige übergeben.
         void updatePollen(int maxPollenLevel) {
-            if(maxPollenLevel >= 0 || maxPollenLevel <= 5){
-
-                int r, g, b; 
-                r = map(maxPollenLevel, 0, 5, 0, 255); // Rotanteil steigt von 0 (Grün) auf 255 (Rot)
-                g = map(maxPollenLevel, 0, 5, 255, 0); // Grünanteil sinkt von 255 (Grün) auf 0 (Rot)
-                b = 0;                                 // Blau ist immer 0
-                myLedStrip->setGroupLEDs(9, 3, r, g, b);
+            if (!regionChanged(_shownPollen, maxPollenLevel)) {
+                return;
+            }
+            if(maxPollenLevel >= 0 && maxPollenLevel <= POLLEN_LEVEL_MAX){
+                // Grün (0) nach Rot (5) aus POLLEN_PALETTE
+                const PaletteColor& color = POLLEN_PALETTE.colors[maxPollenLevel];
+                _layers.setRange(LAYER_POLLEN, 9, 3, CRGB(color.r, color.g, color.b));
 
             } else{
-                myLedStrip->clearGroupLEDs(9, 3);
+                _layers.clear(LAYER_POLLEN);
             }
+            requestFrame();
         }
 
         // Wert der Zeit an die Anzeige übergeben.
-        void updateTime(int hour, int min, boolean enableSound = true) {
-
-            int r, g, b;
-            r = displayColorTime.r;
-            g = displayColorTime.g;
-            b = displayColorTime.b;
-
-            // Alle LEDs erst Lichter ausstellen
-            myLedStrip->clearGroupLEDs(12, 111, false);
-            // ES ISCH
-            myLedStrip->setGroupLEDs(21, 2, r, g, b, false); // ES
-            myLedStrip->setGroupLEDs(16, 4, r, g, b, false); // ISCH
-
-            // Minuten in fünfer Schritten anzeigen
-            if ((min >= 5 && min <= 9) || (min >= 25 && min <= 29) || (min >= 35 && min <= 39) || (min >= 55 && min <= 59)) {
-                myLedStrip->setGroupLEDs(12, 3, r, g, b, false);                       // FÜF
-            }
-            else if ((min >= 10 && min <= 14) || (min >= 50 && min <= 54)) {
-                myLedStrip->setGroupLEDs(23, 3, r, g, b, false);                       // ZÄÄ
-            }
-            else if ((min >= 15 && min <= 19) || (min >= 45 && min <= 49)) {
-                myLedStrip->setGroupLEDs(27, 6, r, g, b, false);                       // VIERTU
-            }
-            else if ((min >= 20 && min <= 24) || (min >= 40 && min <= 44)) {
-                myLedStrip->setGroupLEDs(38, 6, r, g, b, false);                       // ZWÄNZG
-            }
-            if (min >= 25 && min <= 39) {
-                myLedStrip->setGroupLEDs(50, 5, r, g, b, false);                       // HAUBI
-            }
-            
-
-            // AB, VOR oder keines von beiden
-            if((min >= 5 && min <= 24) || (min >= 35 && min <= 39)) {
-                myLedStrip->setGroupLEDs(34, 2, r, g, b, false);                       // AB    
-            }
-            else if ((min >= 25 && min <= 29) || (min >= 40 && min <= 59)) {
-                myLedStrip->setGroupLEDs(45, 3, r, g, b, false);                       // VOR
-            }
-            else {
-                                                                                // Haubi und Punkt
-            }
-            
-            
-            //Stunden anzeigen
-
-            // Ab der 25. Minute wird die nachfolgende Stunde angezeigt ( z.B. 6:35 ist FÜF AB HALBI SIBNI)
-            if (min >= 25) {
-                hour += 1;
-            }
-
-            // Wir zeigen die Stunden 1 - 12 an, deshalb für alle zahlen ab 13 werden -12
-            if (hour > 12) {
-                hour -= 12;
-            }
-
-            // 0 Uhr wird als 12 Uhr angezeigt
-            if (hour == 0) {
-                hour += 12;
+        // Die Wörter stehen als Maske pro Stunde und Fünfminutenschritt in WORD_CLOCK_MASKS (WordClockLayout.h).
+        void updateTime(int hour, int min) {
+            // Die Wörter ändern sich nur alle fünf Minuten
+            if (!regionChanged(_shownTime, wordClockHour(hour, min) * WORD_CLOCK_SLOTS + min / 5)) {
+                return;
             }
+            _layers.clear(LAYER_TIME);
+            _layers.setMask(LAYER_TIME, wordClockMask(hour, min), _colorTime);
+            requestFrame();
+        }
 
-            if      (hour == 1)      myLedStrip->setGroupLEDs(59, 3, r, g, b);   // EIS
-            else if (hour == 2)      myLedStrip->setGroupLEDs(63, 4, r, g, b);   // ZWÖI
-            else if (hour == 3)      myLedStrip->setGroupLEDs(56, 3, r, g, b);   // DRÜ
-            else if (hour == 4)      myLedStrip->setGroupLEDs(72, 5, r, g, b);   // VIERI
-            else if (hour == 5)      myLedStrip->setGroupLEDs(67, 4, r, g, b);   // FÜFI
-            else if (hour == 6)      myLedStrip->setGroupLEDs(78, 6, r, g, b);   // SÄCHSI
-            else if (hour == 7)      myLedStrip->setGroupLEDs(84, 5, r, g, b);   // SIBNI
-            else if (hour == 8)      myLedStrip->setGroupLEDs(95, 5, r, g, b);   // ACHTI
-            else if (hour == 9)      myLedStrip->setGroupLEDs(91, 4, r, g, b);   // NÜNI
-            else if (hour == 10)     myLedStrip->setGroupLEDs(101, 4, r, g, b);  // ZÄNI
-            else if (hour == 11)     myLedStrip->setGroupLEDs(106, 4, r, g, b);  // EUFI
-            else if (hour == 12)     myLedStrip->setGroupLEDs(115, 6, r, g, b);  // ZWÖUFI
-
-            // Soundausgabe
-            if (min == 0 && songPlayed == false) {
-                playSound(hour, enableSound);
-                songPlayed = true;
-            }
-            else if (min > 0) {
-                songPlayed = false;
-            }
-            
+        // Stundenschlag abspielen (Titel 1-12 wie die angezeigte Stunde)
+        void playHourChime(int hour, boolean enableSound = true) {
+            playSound(wordClockHour(hour, 0), enableSound);
         }
 
         // Farbe der Zeitanzeige einstellen
+        // Die Wortuhr wird mit dem nächsten updateTime() in der neuen Farbe gezeichnet.
         void setColorTime(int r, int g, int b){
-            displayColorTime = CRGB(r, g, b);
+            CRGB color = CRGB(r, g, b);
+            if (color != _colorTime) {
+                _colorTime = color;
+                _shownTime = DISPLAY_REGION_UNKNOWN;
+            }
         }
 
         // Helligkeit alles LED einstellen
-        // Erwartet Wert von 0-100 und mappt ihn nach 0-255 um
+        // Erwartet die wahrgenommene Helligkeit 0-100, die Gammakurve steht in LED_BRIGHTNESS_TABLE (LedTables.h)
         void setBrightness(int brightness){
-            brightness = map(brightness, 0, 100, 0, 255);
-            myLedStrip->setBrightness(brightness);
+            brightness = constrain(brightness, 0, 100);
+            _ledStrip.setBrightness(LED_BRIGHTNESS_TABLE.scale[brightness]);
+            requestFrame(); // Gesendet wird nur, wenn sich die Helligkeit geändert hat
         }
         
         //
         void updateTempLED(boolean isIndoor) {
+            if (!regionChanged(_shownTempLED, isIndoor)) {
+                return;
+            }
             if(isIndoor) {
-                myLedStrip->setSingleLED(1, 255, 255, 0);
+                _layers.set(LAYER_MARKERS, 1, CRGB(255, 255, 0));
             }
             else {
-                myLedStrip->setSingleLED(1, 255, 0, 0);
+                _layers.set(LAYER_MARKERS, 1, CRGB(255, 0, 0));
             }
+            requestFrame();
         }
 
         //
         void updateHumiLED(boolean isIndoor) {
+            if (!regionChanged(_shownHumiLED, isIndoor)) {
+                return;
+            }
             if(isIndoor) {
-                myLedStrip->setSingleLED(8, 255, 255, 0);
+                _layers.set(LAYER_MARKERS, 8, CRGB(255, 255, 0));
             }
             else {
-                myLedStrip->setSingleLED(8, 255, 0, 0);
+                _layers.set(LAYER_MARKERS, 8, CRGB(255, 0, 0));
             }
+            requestFrame();
         }
         
-        // Menu anzeigen
+        // Menu anzeigen: die Statusebene verdeckt alle LEDs bis auf die Menü-Anzeige
         void showMenu(){
-            myLedStrip->clearAll();
-            myLedStrip->setGroupLEDs(112, 4, displayColorTime.r, displayColorTime.g, displayColorTime.b);
+            _layers.clear(LAYER_STATUS);
+            _layers.setRange(LAYER_STATUS, 0, NUM_LEDS, CRGB::Black);
+            _layers.setRange(LAYER_STATUS, 112, 4, _colorTime);
+            _instantFrame = true;
+            requestFrame();
+        }
+
+        // 7-Segment-Anzeigen vollständig neu senden (z.B. nach einer Wiederherstellung des i2c Bus)
+        void refreshSegments() {
+            _segments.invalidate();
+            requestFrame();
+        }
+
+        // Übertragungen einer 7-Segment-Anzeige (Index wie SEVEN_SEGMENT_ADDRESSES)
+        const SevenSegmentStats& getSegmentStats(size_t index) const {
+            return _segments[index].getStats();
+        }
+
+        // Menu ausblenden, darunter erscheinen die Ebenen mit ihrem letzten Stand
+        void hideMenu() {
+            _scrolling = false;
+            _matrixShown = false;
+            _layers.clear(LAYER_STATUS);
+            _layers.clear(LAYER_TEXT);
+            _instantFrame = true;
+            requestFrame();
         }
 
         // Aktueller Menu Punkt anzeigen
         void showActMenuPoint(int menuPoint){
-            myLedStrip->clearSingleLED(8);
-            sevenSegmentDisplays[3]->displayDigit(menuPoint);
-            sevenSegmentDisplays[4]->allSegmentsOff();
+            _segments[3].displayDigit(menuPoint);
+            _segments[4].allSegmentsOff();
+            invalidateHumidity();
+            requestFrame();
         }
 
-        // IP-Adresse anzeigen
-        // Die IP Adresse muss in teilen zu je 3 Digits übergeben werden.
-        void showIPAddress(int ipAddressPart, boolean showPoint = true){
-            myLedStrip->clearSingleLED(1);
-            sevenSegmentDisplays[0]->displayDigit( ipAddressPart        % 10);
-            sevenSegmentDisplays[1]->displayDigit((ipAddressPart / 10)  % 10);
-            sevenSegmentDisplays[2]->displayDigit((ipAddressPart / 100) % 10, showPoint);
+        // Text auf den ersten fieldCells Stellen der Leserichtung (SEVEN_SEGMENT_TEXT_ORDER) anzeigen, linksbündig.
+        // Ein Punkt wird zum Dezimalpunkt der Stelle davor. Passt der Text nicht ins Feld, läuft er ab Stelle
+        // startCell durch, renderFrame() rückt ihn alle setScrollInterval() ms um eine Stelle weiter.
+        void showText(const char* text, size_t fieldCells = SEVEN_SEGMENT_COUNT, size_t startCell = 0) {
+            _textCells = sevenSegmentLayout(text, _text, DISPLAY_TEXT_MAX_CELLS);
+            _textField = fieldCells < SEVEN_SEGMENT_COUNT ? fieldCells : SEVEN_SEGMENT_COUNT;
+            _scrolling = _textCells > _textField;
+            _textOffset = _scrolling ? startCell % (_textCells + DISPLAY_SCROLL_GAP) : 0;
+            _nextScrollMs = millis() + _scrollIntervalMs;
+            drawText();
+            invalidateTemperature();
+            if (_textField > DISPLAY_TEMPERATURE_FIELD) {
+                invalidateHumidity();
+            }
+            requestFrame();
+        }
+
+        // Wert eines Menüpunkts (z.B. Helligkeit) rechtsbündig anzeigen
+        void showMenuValue(int value){
+            char text[12];
+            snprintf(text, sizeof(text), "%3d", value);
+            showText(text, DISPLAY_MENU_FIELD);
+        }
+
+        // Text als Wert eines Menüpunkts anzeigen, längere Texte (z.B. die IP-Adresse) laufen ab startCell durch
+        void showMenuText(const char* text, size_t startCell = 0){
+            showText(text, DISPLAY_MENU_FIELD, startCell);
+        }
+
+        // Wert eines Menüpunkts löschen (Menüpunkt ohne Wert)
+        void clearMenuValue(){
+            showText("", DISPLAY_MENU_FIELD);
+        }
+
+        // Text in der Farbe der Zeitanzeige auf dem Buchstabenraster (Zeilen MATRIX_TEXT_TOP bis
+        // MATRIX_TEXT_TOP + 6) über allen anderen Ebenen zeigen. Ein schmaler Text steht in der Mitte, ein breiterer
+        // läuft ab Spalte startColumn (matrixTextColumn()) durch, renderFrame() rückt ihn weiter.
+        void showMatrixText(const char* text, size_t startColumn = 0) {
+            unsigned long nowMs = millis();
+            _matrixText.setText(text);
+            _matrixText.start(nowMs, _matrixScrollIntervalMs, startColumn);
+            _matrixShown = true;
+            _shownMatrixOffset = DISPLAY_REGION_UNKNOWN;
+            drawMatrixText(nowMs);
+            requestFrame();
+        }
+
+        // Text auf dem Buchstabenraster ausblenden, darunter erscheinen die Ebenen mit ihrem letzten Stand
+        void hideMatrixText() {
+            if (!_matrixShown) {
+                return;
+            }
+            _matrixShown = false;
+            _layers.clear(LAYER_TEXT);
+            _instantFrame = true;
+            requestFrame();
         }
 
         // Testen der Sieben Segment Anzeige
-        void sevenSegmentTest(SevenSegmentDisplay displays){
+        void sevenSegmentTest(SevenSegmentDisplay& displays){
             for(int i = 0; i <= 10; i++){
                 if(i == 10){
                 displays.displayDigit(9, true);
+                displays.flush();
                 } else{
                 displays.displayDigit(i);
+                displays.flush();
                 }
                 delay(250);
             }
             delay(250);
             displays.allSegmentsOff();
+            displays.flush();
         }
 
         // Testen des LED Strip
+        // Steuert den Streifen direkt an, danach wird wieder das Frame der Ebenen gezeigt
         void ledStripTest(){
-            myLedStrip->clearAll();
+            _ledStrip.clearAll();
+            _ledStrip.show();
             delay(200);
-            for(int i = 0; i < NUM_LEDS; i++) {
+            for(int i = 0; i < _ledStrip.count(); i++) {
                 // LED-Streifen testen
-                myLedStrip->setSingleLED(i, 0, 0, 255); // Blaue LED
+                _ledStrip.setSingleLED(i, 0, 0, 255); // Blaue LED
+                _ledStrip.show();
                 delay(200);
-                myLedStrip->clearSingleLED(i); // LED wieder ausschalten
+                _ledStrip.clearSingleLED(i); // LED wieder ausschalten
             } 
+            showFrame();
         }
 
         // Testen der Zeitanzeige
         void textUhrTest(boolean enableSound){
             for(int hour = 0; hour <= 12; hour++){
                 for(int min = 0; min < 60; min = min + 5){
-                    updateTime(hour, min, enableSound);
+                    updateTime(hour, min);
+                    showFrame();
+                    if (min == 0) {
+                        playHourChime(hour, enableSound);
+                    }
                     delay(1000);
                 }
             }
@@ -368,4 +571,220 @@ class UpdateDisplay {
             Mp3Player::getInstance().setVolume(volume);
         }
 
-};
\ No newline at end of file
+        // Anteil des grössten LED-Stroms, 0-1 (Wärmemodell)
+        float getLedDriveLevel() const {
+            return _ledStrip.getDriveLevel();
+        }
+
+        DisplayRenderStats getRenderStats() const {
+            DisplayRenderStats stats;
+            stats.rendered = _rendered;
+            stats.skipped = _skipped;
+            stats.frames = _frames;
+            stats.shown = _ledStrip.getShownFrames();
+            stats.unchanged = _ledStrip.getUnchangedFrames();
+            stats.totalFrameMicros = _totalFrameMicros;
+            stats.maxFrameMicros = _maxFrameMicros;
+            stats.dropped = _ledStrip.getDroppedFrames();
+            stats.blockedMicros = _ledStrip.getBlockedMicros();
+            stats.maxBlockedMicros = _ledStrip.getMaxBlockedMicros();
+            stats.blends = _blends;
+            stats.totalBlendMicros = _totalBlendMicros;
+            stats.maxBlendMicros = _maxBlendMicros;
+            stats.budgetOverruns = _budgetOverruns;
+            stats.skippedFrames = _skippedFrames;
+            stats.segments = _segments.getStats();
+            return stats;
+        }
+
+    private:
+        LedStrip<LED_PIN, NUM_LEDS, LED_RMT_CHANNEL> _ledStrip;
+        FrameCompositor<NUM_LEDS, LAYER_COUNT> _layers;
+        CRGB _target[NUM_LEDS];         // Zusammengesetztes Bild der Ebenen
+        CRGB _frame[NUM_LEDS];          // Zuletzt an den Streifen übergebenes Frame (während der Überblendung gemischt)
+        Crossfade<NUM_LEDS * 3> _fade;
+        SevenSegmentArray<SEVEN_SEGMENT_COUNT> _segments;
+        CRGB _colorTime;              // Farbe der Zeitanzeige
+
+        // Eingangswerte, mit denen die Bereiche zuletzt gezeichnet wurden
+        int _shownTime;               // Angezeigte Stunde * 12 + Fünfminutenschritt
+        int _shownAirQuality;         // IAQ in Zehnteln
+        int _shownWeather;
+        int _shownPollen;
+        int _shownTempLED;
+        int _shownHumiLED;
+        int _shownTemperature;        // Zehntelgrad
+        int _shownHumidity;
+        uint32_t _rendered;
+        uint32_t _skipped;
+
+        FrameRequestHandler _frameRequestHandler;
+        unsigned long _frameIntervalMs;
+        unsigned long _ditherIntervalMs;
+        bool _framePending;
+        unsigned long _lastFrameMs;
+        uint32_t _frames;
+        uint64_t _totalFrameMicros;
+        uint32_t _maxFrameMicros;
+        unsigned long _crossfadeMs;
+        uint32_t _frameBudgetMicros;
+        bool _instantFrame;             // Nächstes Bild ohne Überblendung zeigen (Menü)
+        bool _skipFadeFrame;
+        uint32_t _blends;
+        uint64_t _totalBlendMicros;
+        uint32_t _maxBlendMicros;
+        uint32_t _budgetOverruns;
+        uint32_t _skippedFrames;
+        bool _segmentRetry;                 // 7-Segment-Anzeige konnte nicht geschrieben werden
+        unsigned long _segmentFailedMs;
+
+        // Text der 7-Segment-Anzeigen als Ausgangsbytes pro Stelle (SevenSegmentFont.h)
+        uint8_t _text[DISPLAY_TEXT_MAX_CELLS];
+        size_t _textCells;
+        size_t _textField;              // Stellen des Felds in Leserichtung
+        size_t _textOffset;             // Erste sichtbare Stelle des Lauftexts
+        bool _scrolling;
+        unsigned long _scrollIntervalMs;
+        unsigned long _nextScrollMs;
+
+        // Text des Buchstabenrasters
+        MatrixText _matrixText;
+        bool _matrixShown;
+        int _shownMatrixOffset;         // Gezeichnete Spalte am linken Rand
+        unsigned long _matrixScrollIntervalMs;
+
+        // Sichtbaren Ausschnitt des Texts in die Schattenregister schreiben. Ein Lauftext wiederholt sich
+        // nach DISPLAY_SCROLL_GAP leeren Stellen.
+        void drawText() {
+            size_t period = _textCells + DISPLAY_SCROLL_GAP;
+            for (size_t i = 0; i < _textField; i++) {
+                size_t cell = _scrolling ? (_textOffset + i) % period : i;
+                uint8_t glyph = cell < _textCells ? _text[cell] : SEVEN_SEGMENT_BLANK;
+                _segments[SEVEN_SEGMENT_TEXT_ORDER[i]].displayGlyph(glyph);
+            }
+        }
+
+        // Lauftext um eine Stelle weiterrücken, sobald fällig. 0 = kein Lauftext, sonst Wartezeit in ms.
+        unsigned long scrollText(unsigned long nowMs) {
+            if (!_scrolling || _scrollIntervalMs == 0) {
+                return 0;
+            }
+            long remainingMs = (long)(_nextScrollMs - nowMs);
+            if (remainingMs > 0) {
+                return remainingMs;
+            }
+            _textOffset = (_textOffset + 1) % (_textCells + DISPLAY_SCROLL_GAP);
+            _nextScrollMs = nowMs + _scrollIntervalMs;
+            drawText();
+            _framePending = true; // Aufruf aus renderFrame(), der Handler würde nur erneut einplanen
+            return _scrollIntervalMs;
+        }
+
+        // Nach einem Fehler beim Schreiben der 7-Segment-Anzeigen ein Frame einplanen (renderFrame()),
+        // 0 = kein Fehler, sonst Wartezeit in ms
+        unsigned long retrySegments(unsigned long nowMs) {
+            if (!_segmentRetry) {
+                return 0;
+            }
+            unsigned long elapsedMs = nowMs - _segmentFailedMs;
+            if (elapsedMs < DISPLAY_SEGMENT_RETRY_MS) {
+                return DISPLAY_SEGMENT_RETRY_MS - elapsedMs;
+            }
+            _segmentRetry = false;
+            _framePending = true; // Aufruf aus renderFrame(), der Handler würde nur erneut einplanen
+            return 0;
+        }
+
+        // Ausschnitt des Rasters zum Zeitpunkt nowMs in die Textebene zeichnen: dunkle Fläche mit dem Text darin.
+        // Der Text erscheint ohne Überblendung. false, wenn der Ausschnitt schon gezeichnet ist.
+        bool drawMatrixText(unsigned long nowMs) {
+            if (!regionChanged(_shownMatrixOffset, _matrixText.offsetAt(nowMs))) {
+                return false;
+            }
+            _layers.clear(LAYER_TEXT);
+            _layers.setMask(LAYER_TEXT, MATRIX_TEXT_AREA, CRGB::Black);
+            _layers.setMask(LAYER_TEXT, _matrixText.mask(_shownMatrixOffset), _colorTime);
+            _instantFrame = true;
+            return true;
+        }
+
+        // Text des Rasters um die seit dem letzten Aufruf fälligen Spalten weiterrücken.
+        // 0 = kein Lauftext, sonst Wartezeit in ms bis zur nächsten Spalte.
+        unsigned long scrollMatrix(unsigned long nowMs) {
+            if (!_matrixShown || !_matrixText.scrolls()) {
+                return 0;
+            }
+            if (drawMatrixText(nowMs)) {
+                _framePending = true; // Aufruf aus renderFrame(), der Handler würde nur erneut einplanen
+            }
+            return _matrixText.waitAt(nowMs);
+        }
+
+        // Kürzere von zwei Wartezeiten, 0 = nichts ausstehend
+        static unsigned long earliestWait(unsigned long a, unsigned long b) {
+            if (a == 0 || (b > 0 && b < a)) {
+                return b;
+            }
+            return a;
+        }
+
+        // Ausstehendes Frame senden (renderFrame()), 0 = nichts ausstehend, sonst Wartezeit in ms
+        unsigned long renderPendingFrame(unsigned long nowMs) {
+            if (!_framePending) {
+                return 0;
+            }
+            unsigned long elapsedMs = nowMs - _lastFrameMs;
+            unsigned long intervalMs = _ledStrip.isDithering() ? _ditherIntervalMs : _frameIntervalMs;
+            if (_frames > 0 && elapsedMs < intervalMs) {
+                return intervalMs - elapsedMs;
+            }
+            if (_skipFadeFrame && (_fade.isActive() || (_matrixShown && _matrixText.scrolls()))) {
+                // Das letzte Frame war über dem Budget: eines auslassen, Überblendung und Lauftext holen die Zeit auf
+                _skipFadeFrame = false;
+                _skippedFrames++;
+                _lastFrameMs = nowMs;
+                return intervalMs > 0 ? intervalMs : 1;
+            }
+            if (_ledStrip.isBusy()) {
+                return 1; // Das vorherige Frame wird noch gesendet
+            }
+            showFrame();
+            return 0;
+        }
+
+        void requestFrame() {
+            if (!_framePending) {
+                _framePending = true;
+                if (_frameRequestHandler != nullptr) {
+                    _frameRequestHandler();
+                }
+            }
+        }
+
+        // true und Wert übernehmen, wenn der Bereich mit value neu gezeichnet werden muss
+        bool regionChanged(int& shown, int value) {
+            if (shown == value) {
+                _skipped++;
+                return false;
+            }
+            shown = value;
+            _rendered++;
+            return true;
+        }
+
+        // LED-Bereiche beim nächsten Aufruf neu zeichnen
+        void invalidateLEDs() {
+            _shownTime = DISPLAY_REGION_UNKNOWN;
+            _shownAirQuality = DISPLAY_REGION_UNKNOWN;
+            _shownWeather = DISPLAY_REGION_UNKNOWN;
+            _shownPollen = DISPLAY_REGION_UNKNOWN;
+            _shownTempLED = DISPLAY_REGION_UNKNOWN;
+            _shownHumiLED = DISPLAY_REGION_UNKNOWN;
+        }
+
+        void invalidateTemperature() { _shownTemperature = DISPLAY_REGION_UNKNOWN; }
+        void invalidateHumidity() { _shownHumidity = DISPLAY_REGION_UNKNOWN; }
+
+};
+
+#endif // UPDATE_DISPLAY_H
@@ -0,0 +1,164 @@
+#ifndef WORD_CLOCK_LAYOUT_H
+#define WORD_CLOCK_LAYOUT_H
+
+#include <stdint.h>
+#include "led/led_strip/LedMask.h"
+
+// Buchstabenraster der Wortuhr (Schweizerdeutsch) als Beschreibung: Wörter mit ihren LEDs und pro
+// Fünfminutenschritt die Wörter der Minutenangabe. Daraus berechnet der Compiler für jede Stunde und jeden
+// Schritt die Maske der leuchtenden LEDs, beim Zeichnen bleibt ein Tabellenzugriff.
+
+// Wörter des Rasters
+enum WordClockWord {
+    WORD_ES, WORD_ISCH,
+    WORD_FUEF, WORD_ZAEAE, WORD_VIERTU, WORD_ZWAENZG, WORD_HAUBI, WORD_AB, WORD_VOR,
+    WORD_EIS, WORD_ZWOEI, WORD_DRUE, WORD_VIERI, WORD_FUEFI, WORD_SAECHSI,
+    WORD_SIBNI, WORD_ACHTI, WORD_NUENI, WORD_ZAENI, WORD_EUFI, WORD_ZWOEUFI,
+    WORD_COUNT
+};
+
+struct WordClockWordLeds {
+    uint8_t first;      // Erste LED
+    uint8_t count;      // Anzahl Buchstaben
+};
+
+// LEDs der Wörter, Reihenfolge wie WordClockWord
+constexpr WordClockWordLeds WORD_CLOCK_WORDS[WORD_COUNT] = {
+    { 21, 2 },  // ES
+    { 16, 4 },  // ISCH
+    { 12, 3 },  // FÜF
+    { 23, 3 },  // ZÄÄ
+    { 27, 6 },  // VIERTU
+    { 38, 6 },  // ZWÄNZG
+    { 50, 5 },  // HAUBI
+    { 34, 2 },  // AB
+    { 45, 3 },  // VOR
+    { 59, 3 },  // EIS
+    { 63, 4 },  // ZWÖI
+    { 56, 3 },  // DRÜ
+    { 72, 5 },  // VIERI
+    { 67, 4 },  // FÜFI
+    { 78, 6 },  // SÄCHSI
+    { 84, 5 },  // SIBNI
+    { 95, 5 },  // ACHTI
+    { 91, 4 },  // NÜNI
+    { 101, 4 }, // ZÄNI
+    { 106, 4 }, // EUFI
+    { 115, 6 }, // ZWÖUFI
+};
+
+const uint8_t WORD_CLOCK_FIRST_LED = 12;        // Von der Wortuhr belegter Bereich des Streifens
+const uint8_t WORD_CLOCK_LED_COUNT = 111;
+const uint8_t WORD_CLOCK_SLOTS = 12;            // Fünfminutenschritte pro Stunde
+const uint8_t WORD_CLOCK_HOURS = 12;
+const uint8_t WORD_CLOCK_NEXT_HOUR_SLOT = 5;    // Ab "FÜF VOR HAUBI" wird die nachfolgende Stunde angezeigt
+const uint8_t WORD_CLOCK_MAX_PHRASE = 3;
+
+// Wörter der Minutenangabe eines Fünfminutenschritts ("ES ISCH" und die Stunde kommen immer dazu)
+struct WordClockPhrase {
+    uint8_t count;
+    WordClockWord words[WORD_CLOCK_MAX_PHRASE];
+};
+
+constexpr WordClockPhrase WORD_CLOCK_PHRASES[WORD_CLOCK_SLOTS] = {
+    { 0, {} },                                      // :00
+    { 2, { WORD_FUEF, WORD_AB } },                  // :05 FÜF AB
+    { 2, { WORD_ZAEAE, WORD_AB } },                 // :10 ZÄÄ AB
+    { 2, { WORD_VIERTU, WORD_AB } },                // :15 VIERTU AB
+    { 2, { WORD_ZWAENZG, WORD_AB } },               // :20 ZWÄNZG AB
+    { 3, { WORD_FUEF, WORD_VOR, WORD_HAUBI } },     // :25 FÜF VOR HAUBI
+    { 1, { WORD_HAUBI } },                          // :30 HAUBI
+    { 3, { WORD_FUEF, WORD_AB, WORD_HAUBI } },      // :35 FÜF AB HAUBI
+    { 2, { WORD_ZWAENZG, WORD_VOR } },              // :40 ZWÄNZG VOR
+    { 2, { WORD_VIERTU, WORD_VOR } },               // :45 VIERTU VOR
+    { 2, { WORD_ZAEAE, WORD_VOR } },                // :50 ZÄÄ VOR
+    { 2, { WORD_FUEF, WORD_VOR } },                 // :55 FÜF VOR
+};
+
+// Stundenwörter 1-12
+constexpr WordClockWord WORD_CLOCK_HOUR_WORDS[WORD_CLOCK_HOURS] = {
+    WORD_EIS, WORD_ZWOEI, WORD_DRUE, WORD_VIERI, WORD_FUEFI, WORD_SAECHSI,
+    WORD_SIBNI, WORD_ACHTI, WORD_NUENI, WORD_ZAENI, WORD_EUFI, WORD_ZWOEUFI
+};
+
+constexpr LedMask wordClockWordMask(WordClockWord word) {
+    return LedMask::range(WORD_CLOCK_WORDS[word].first, WORD_CLOCK_WORDS[word].count);
+}
+
+// Angezeigte Stunde 1-12 zur Uhrzeit (0-23 Uhr, Minute 0-59)
+constexpr int wordClockHour(int hour, int min) {
+    if (min / 5 >= WORD_CLOCK_NEXT_HOUR_SLOT) {
+        hour += 1; // z.B. 6:35 ist FÜF AB HAUBI SIBNI
+    }
+    hour %= 12;
+    return hour == 0 ? 12 : hour; // 0 Uhr wird als 12 Uhr angezeigt
+}
+
+// Masken aller Stunden und Schritte: masks[angezeigte Stunde - 1][Fünfminutenschritt]
+struct WordClockMasks {
+    LedMask masks[WORD_CLOCK_HOURS][WORD_CLOCK_SLOTS];
+};
+
+constexpr WordClockMasks compileWordClock() {
+    WordClockMasks table;
+    for (int slot = 0; slot < WORD_CLOCK_SLOTS; slot++) {
+        LedMask phrase = wordClockWordMask(WORD_ES) | wordClockWordMask(WORD_ISCH);
+        for (int i = 0; i < WORD_CLOCK_PHRASES[slot].count; i++) {
+            phrase = phrase | wordClockWordMask(WORD_CLOCK_PHRASES[slot].words[i]);
+        }
+        for (int hour = 0; hour < WORD_CLOCK_HOURS; hour++) {
+            table.masks[hour][slot] = phrase | wordClockWordMask(WORD_CLOCK_HOUR_WORDS[hour]);
+        }
+    }
+    return table;
+}
+
+constexpr WordClockMasks WORD_CLOCK_MASKS = compileWordClock();
+
+// Maske zur Uhrzeit (0-23 Uhr, Minute 0-59)
+constexpr const LedMask& wordClockMask(int hour, int min) {
+    return WORD_CLOCK_MASKS.masks[wordClockHour(hour, min) - 1][min / 5];
+}
+
+// --- Prüfungen des Rasters ---
+
+// Alle Wörter liegen im Bereich der Wortuhr und überschneiden sich nicht
+constexpr bool wordClockWordsValid() {
+    LedMask used;
+    for (int word = 0; word < WORD_COUNT; word++) {
+        LedMask mask = wordClockWordMask((WordClockWord)word);
+        if (WORD_CLOCK_WORDS[word].count == 0 ||
+            WORD_CLOCK_WORDS[word].first < WORD_CLOCK_FIRST_LED ||
+            WORD_CLOCK_WORDS[word].first + WORD_CLOCK_WORDS[word].count > WORD_CLOCK_FIRST_LED + WORD_CLOCK_LED_COUNT ||
+            !(used & mask).empty()) {
+            return false;
+        }
+        used = used | mask;
+    }
+    return true;
+}
+
+// Jede Minutenangabe nennt ein Wort höchstens einmal und keine Stunde
+constexpr bool wordClockPhrasesValid() {
+    for (int slot = 0; slot < WORD_CLOCK_SLOTS; slot++) {
+        const WordClockPhrase& phrase = WORD_CLOCK_PHRASES[slot];
+        if (phrase.count > WORD_CLOCK_MAX_PHRASE) return false;
+        for (int i = 0; i < phrase.count; i++) {
+            if (phrase.words[i] < WORD_FUEF || phrase.words[i] > WORD_VOR) return false;
+            for (int j = i + 1; j < phrase.count; j++) {
+                if (phrase.words[i] == phrase.words[j]) return false;
+            }
+        }
+    }
+    return true;
+}
+
+static_assert(wordClockWordsValid(), "Wortuhr: Wort ausserhalb des Bereichs oder Wörter überschneiden sich");
+static_assert(wordClockPhrasesValid(), "Wortuhr: ungültige Minutenangabe");
+static_assert(wordClockHour(0, 0) == 12 && wordClockHour(6, 35) == 7 && wordClockHour(23, 25) == 12 && wordClockHour(11, 24) == 11,
+              "Wortuhr: Stundenzuordnung");
+static_assert(wordClockMask(6, 35) == (wordClockWordMask(WORD_ES) | wordClockWordMask(WORD_ISCH) | wordClockWordMask(WORD_FUEF) |
+                                       wordClockWordMask(WORD_AB) | wordClockWordMask(WORD_HAUBI) | wordClockWordMask(WORD_SIBNI)),
+              "Wortuhr: 6:35 ist ES ISCH FÜF AB HAUBI SIBNI");
+
+#endif // WORD_CLOCK_LAYOUT_H
@@ -0,0 +1,58 @@
+#include "EventBus.h"
+#include "../logger/Logger.h"
+
+TopicBase::TopicBase(const char* name) : _sequence(0), _name(name) {
+    _mutex = xSemaphoreCreateMutex();
+    EventBus::getInstance().add(this);
+}
+
+TopicStats TopicBase::getStats() const {
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    TopicStats stats = _stats;
+    xSemaphoreGive(_mutex);
+    return stats;
+}
+
+// Läuft während der statischen Initialisierung, deshalb ohne Logger
+void EventBus::add(TopicBase* topic) {
+    if (_topicCount < EVENT_MAX_TOPICS) {
+        _topics[_topicCount++] = topic;
+    }
+}
+
+void EventBus::logStats() {
+    unsigned long now = millis();
+    float seconds = (now - _lastLogMs) / 1000.0f;
+    for (int i = 0; i < _topicCount; i++) {
+        TopicStats stats = _topics[i]->getStats();
+        TopicStats& last = _loggedStats[i];
+        uint32_t published = stats.published - last.published;
+        uint32_t suppressed = stats.suppressed - last.suppressed;
+        uint32_t offered = published + suppressed;
+        Logger::log(LogLevel::Info, "Ereignisse " + String(_topics[i]->getName()) + ": " +
+                    String(seconds > 0 ? published / seconds : 0.0f, 3) + "/s veröffentlicht, " +
+                    String(suppressed) + " von " + String(offered) + " unverändert verworfen, " +
+                    String(stats.delivered - last.delivered) + " zugestellt, " +
+                    String(stats.coalesced - last.coalesced) + " zusammengefasst");
+        last = stats;
+    }
+    _lastLogMs = now;
+}
+
+void EventDispatcher::add(SubscriptionBase& subscription) {
+    if (_count >= EVENT_MAX_SUBSCRIPTIONS) {
+        Logger::log(LogLevel::Error, "EventDispatcher: zu viele Abonnements (EVENT_MAX_SUBSCRIPTIONS).");
+        return;
+    }
+    _subscriptions[_count++] = &subscription;
+}
+
+int EventDispatcher::dispatch() {
+    int delivered = 0;
+    for (int i = 0; i < _count; i++) {
+        if (_subscriptions[i]->dispatch()) {
+            delivered++;
+        }
+    }
+    return delivered;
+}
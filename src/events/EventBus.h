@@ -0,0 +1,57 @@
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <Arduino.h>
+#include "Topic.h"
+
+const int EVENT_MAX_TOPICS = 12;            // Maximale Anzahl Topics im ganzen Programm
+const int EVENT_MAX_SUBSCRIPTIONS = 8;      // Maximale Anzahl Abonnements pro EventDispatcher
+
+// Verzeichnis aller Topics. Die Topics selbst sind statische Objekte und melden sich beim Erstellen an,
+// der Bus kennt sie nur für die Statistik: wie viele Werte veröffentlicht, als unverändert verworfen,
+// zugestellt und zusammengefasst wurden.
+class EventBus {
+public:
+    // Statische Methode, um die einzige Instanz zu erhalten (Singleton-Muster).
+    static EventBus& getInstance() {
+        static EventBus instance;
+        return instance;
+    }
+
+    // Wird vom Konstruktor von TopicBase aufgerufen
+    void add(TopicBase* topic);
+
+    int getTopicCount() const { return _topicCount; }
+    const TopicBase* getTopic(int index) const { return _topics[index]; }
+
+    // Gibt pro Topic die Raten seit dem letzten Aufruf aus. Nur aus einer Task aufrufen.
+    void logStats();
+
+private:
+    EventBus() : _topicCount(0), _lastLogMs(0) {}
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    TopicBase* _topics[EVENT_MAX_TOPICS];
+    TopicStats _loggedStats[EVENT_MAX_TOPICS];   // Stand beim letzten logStats()
+    int _topicCount;
+    unsigned long _lastLogMs;
+};
+
+// Stellt die Werte mehrerer Abonnements in der aufrufenden Task zu.
+// Jede Task hat einen eigenen Dispatcher und ruft dispatch() regelmässig aus einem Job auf.
+class EventDispatcher {
+public:
+    EventDispatcher() : _count(0) {}
+
+    void add(SubscriptionBase& subscription);
+
+    // Ruft die Handler aller Abonnements mit neuen Werten auf. Gibt die Anzahl Zustellungen zurück.
+    int dispatch();
+
+private:
+    SubscriptionBase* _subscriptions[EVENT_MAX_SUBSCRIPTIONS];
+    int _count;
+};
+
+#endif // EVENT_BUS_H
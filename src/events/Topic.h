@@ -0,0 +1,180 @@
+#ifndef TOPIC_H
+#define TOPIC_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// Zähler eines Topics seit dem Start
+struct TopicStats {
+    uint32_t published = 0;     // Übernommene, d.h. geänderte Werte
+    uint32_t suppressed = 0;    // Verworfene Werte, weil sie dem aktuellen Wert entsprachen
+    uint32_t delivered = 0;     // An Abonnenten zugestellte Werte
+    uint32_t coalesced = 0;     // Werte, die ein Abonnent übersprungen hat, weil bereits ein neuerer vorlag
+};
+
+// Gemeinsamer Teil aller Topics: Name, Sequenznummer und Zähler.
+// Jedes Topic meldet sich beim Erstellen beim EventBus an (Statistik, CoAP).
+class TopicBase {
+public:
+    const char* getName() const { return _name; }
+    uint32_t getSequence() const { return _sequence; }
+    bool hasValue() const { return _sequence != 0; }
+    TopicStats getStats() const;
+
+protected:
+    explicit TopicBase(const char* name);
+
+    mutable SemaphoreHandle_t _mutex;
+    volatile uint32_t _sequence;        // 0 = noch kein Wert veröffentlicht
+    TopicStats _stats;
+
+private:
+    TopicBase(const TopicBase&) = delete;
+    TopicBase& operator=(const TopicBase&) = delete;
+
+    const char* _name;
+};
+
+template <typename T> class Subscription;
+
+// Typisiertes Topic mit dem jeweils neusten Wert. Produzenten veröffentlichen aus beliebigen Tasks,
+// übernommen wird ein Wert nur, wenn er sich vom aktuellen unterscheidet (Vergleich mit operator==).
+// Es gibt keine Warteschlange: ein Abonnent erhält immer den neusten Wert, verpasste Zwischenwerte
+// werden zusammengefasst. Wie bei der Mailbox schützt ein Mutex den Wert, der Speicher ist statisch.
+template <typename T>
+class Topic : public TopicBase {
+public:
+    explicit Topic(const char* name) : TopicBase(name) {}
+
+    // Übernimmt value, falls er sich vom aktuellen Wert unterscheidet. true, wenn der Wert neu ist.
+    bool publish(const T& value) {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        bool changed = _sequence == 0 || !(value == _value);
+        if (changed) {
+            _value = value;
+            _sequence++;
+            _stats.published++;
+        } else {
+            _stats.suppressed++;
+        }
+        xSemaphoreGive(_mutex);
+        return changed;
+    }
+
+    // Übernimmt value nur, solange noch kein Wert vorliegt (z.B. Werte aus dem Warmstart,
+    // die eine bereits geladene Konfiguration nicht ersetzen dürfen).
+    bool publishIfEmpty(const T& value) {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        bool empty = _sequence == 0;
+        if (empty) {
+            _value = value;
+            _sequence++;
+            _stats.published++;
+        }
+        xSemaphoreGive(_mutex);
+        return empty;
+    }
+
+    // Kopiert den aktuellen Wert. false, solange noch kein Wert veröffentlicht wurde.
+    bool read(T& value) const {
+        if (_sequence == 0) {
+            return false;
+        }
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        value = _value;
+        xSemaphoreGive(_mutex);
+        return true;
+    }
+
+private:
+    friend class Subscription<T>;
+
+    // Kopiert den Wert, falls er neuer als lastSequence ist (oder force gesetzt ist), und zählt die Zustellung.
+    bool fetch(T& value, uint32_t& lastSequence, bool force) {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        bool available = _sequence != 0 && (force || _sequence != lastSequence);
+        if (available) {
+            if (_sequence - lastSequence > 1) {
+                _stats.coalesced += _sequence - lastSequence - 1;
+            }
+            value = _value;
+            lastSequence = _sequence;
+            _stats.delivered++;
+        }
+        xSemaphoreGive(_mutex);
+        return available;
+    }
+
+    T _value;
+};
+
+// Gemeinsame Schnittstelle der Abonnements für den EventDispatcher
+class SubscriptionBase {
+public:
+    // Ruft den Handler auf, falls ein neuer Wert vorliegt. true, wenn zugestellt wurde.
+    virtual bool dispatch() = 0;
+
+protected:
+    ~SubscriptionBase() {}
+};
+
+// Abonnement eines Topics. Gehört genau einer Task und wird nur aus dieser abgefragt
+// (direkt mit poll() oder über einen EventDispatcher mit Handler).
+// Mit minIntervalMs > 0 wird höchstens einmal pro Intervall zugestellt, und zwar jeweils der neuste Wert.
+template <typename T>
+class Subscription : public SubscriptionBase {
+public:
+    typedef void (*Handler)(const T& value);
+
+    explicit Subscription(Topic<T>& topic, Handler handler = nullptr, unsigned long minIntervalMs = 0)
+      : _topic(topic), _handler(handler), _minIntervalMs(minIntervalMs), _sequence(0),
+        _lastDeliveryMs(0), _delivered(false), _redeliver(false) {}
+
+    // Kopiert den Wert, falls er sich seit der letzten Zustellung geändert hat.
+    bool poll(T& value) {
+        if (!_redeliver && _topic.getSequence() == _sequence) {
+            return false; // Ohne Mutex: die Sequenznummer genügt, um "nichts Neues" zu erkennen
+        }
+        unsigned long now = millis();
+        if (!_redeliver && _delivered && _minIntervalMs > 0 && now - _lastDeliveryMs < _minIntervalMs) {
+            return false; // Später zusammengefasst zustellen
+        }
+        if (!_topic.fetch(value, _sequence, _redeliver)) {
+            return false;
+        }
+        _redeliver = false;
+        _delivered = true;
+        _lastDeliveryMs = now;
+        return true;
+    }
+
+    // Stellt den aktuellen Wert beim nächsten poll() erneut zu, auch wenn er unverändert ist
+    // (z.B. nachdem das Menü die Anzeige überschrieben hat).
+    void redeliver() { _redeliver = true; }
+
+    bool dispatch() override {
+        T value;
+        if (!poll(value)) {
+            return false;
+        }
+        if (_handler != nullptr) {
+            _handler(value);
+        }
+        return true;
+    }
+
+private:
+    Subscription(const Subscription&) = delete;
+    Subscription& operator=(const Subscription&) = delete;
+
+    Topic<T>& _topic;
+    Handler _handler;
+    unsigned long _minIntervalMs;
+    uint32_t _sequence;             // Zuletzt zugestellte Sequenznummer
+    unsigned long _lastDeliveryMs;
+    bool _delivered;
+    bool _redeliver;
+};
+
+#endif // TOPIC_H
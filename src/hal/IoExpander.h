@@ -0,0 +1,15 @@
+#ifndef HAL_IO_EXPANDER_H
+#define HAL_IO_EXPANDER_H
+
+// 8-Bit-Ausgangsbaustein am i2c Bus je nach Plattform: auf dem Gerät der PCF8574 über Wire, auf dem PC der
+// Simulator (SimHardware). Beide bieten begin(), write8(value) und lastError() (0 = ohne Fehler).
+#ifdef ARDUINO
+#include <Wire.h>
+#include <PCF8574.h>
+typedef PCF8574 IoExpander;
+#else
+#include "hal/native/SimIoExpander.h"
+typedef SimIoExpander IoExpander;
+#endif
+
+#endif // HAL_IO_EXPANDER_H
@@ -0,0 +1,18 @@
+#ifndef HAL_LED_OUTPUT_H
+#define HAL_LED_OUTPUT_H
+
+#include <stdint.h>
+
+// Ausgabe des LED-Streifens je nach Plattform: auf dem Gerät über den RMT, auf dem PC in den Simulator
+// (SimHardware). Beide bieten begin(pin), write(leds, scale, dither), isBusy(), waitIdle() und dieselben Zähler.
+#ifdef ARDUINO
+#include "led/led_strip/RmtLedOutput.h"
+template <uint16_t Count>
+using LedOutput = RmtLedOutput<Count>;
+#else
+#include "hal/native/SimLedOutput.h"
+template <uint16_t Count>
+using LedOutput = SimLedOutput<Count>;
+#endif
+
+#endif // HAL_LED_OUTPUT_H
@@ -0,0 +1,58 @@
+#include "SimHardware.h"
+#include "hardware/HardwareConfig.h"
+
+#include <string.h>
+
+SimHardware::SimHardware() : _micros(0), _counts() {
+    memset(_i2cOutputs, 0xFF, sizeof(_i2cOutputs));
+    memset(_i2cFailures, 0, sizeof(_i2cFailures));
+}
+
+void SimHardware::advanceTo(uint64_t timeMicros) {
+    if (timeMicros > _micros) {
+        _micros = timeMicros;
+    }
+}
+
+void SimHardware::recordLedFrame(const uint8_t* grb, size_t bytes) {
+    _ledFrame.assign(grb, grb + bytes);
+    record(SIM_LED_FRAME, 0, 0, false);
+}
+
+bool SimHardware::recordI2cWrite(uint8_t address, uint8_t value) {
+    address %= SIM_I2C_ADDRESSES;
+    // Der Bus ist während der Übertragung belegt, der Aufrufer wartet darauf (wie Wire.endTransmission())
+    _micros += (uint64_t)SIM_I2C_BITS_PER_WRITE * 1000000UL / I2C_CLOCK;
+    bool failed = _i2cFailures[address] > 0;
+    if (failed) {
+        _i2cFailures[address]--;
+    } else {
+        _i2cOutputs[address] = value;
+    }
+    record(SIM_I2C_WRITE, address, value, failed);
+    return !failed;
+}
+
+void SimHardware::recordSound(int track) {
+    record(SIM_SOUND, 0, (uint16_t)track, false);
+}
+
+void SimHardware::failI2cWrites(uint8_t address, uint32_t count) {
+    _i2cFailures[address % SIM_I2C_ADDRESSES] = count;
+}
+
+void SimHardware::clearTransactions() {
+    _transactions.clear();
+    memset(_counts, 0, sizeof(_counts));
+}
+
+void SimHardware::record(SimTransactionType type, uint8_t address, uint16_t value, bool failed) {
+    SimTransaction transaction;
+    transaction.timeMicros = _micros;
+    transaction.type = type;
+    transaction.address = address;
+    transaction.value = value;
+    transaction.failed = failed;
+    _transactions.push_back(transaction);
+    _counts[type]++;
+}
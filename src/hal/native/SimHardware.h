@@ -0,0 +1,82 @@
+#ifndef SIM_HARDWARE_H
+#define SIM_HARDWARE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+// Art einer aufgezeichneten Übertragung an die Hardware
+enum SimTransactionType {
+    SIM_LED_FRAME,          // Frame an den LED-Streifen
+    SIM_I2C_WRITE,          // Byte an einen i2c-Baustein (PCF8574)
+    SIM_SOUND,              // Titel an den DFPlayer
+    SIM_TRANSACTION_TYPES
+};
+
+struct SimTransaction {
+    uint64_t timeMicros;    // Virtuelle Zeit
+    SimTransactionType type;
+    uint8_t address;        // i2c-Adresse (SIM_I2C_WRITE)
+    uint16_t value;         // Byte bzw. Titel
+    bool failed;            // Vom Simulator mit einem Fehler beantwortet
+};
+
+const uint8_t SIM_I2C_ADDRESSES = 128;
+const int SIM_I2C_ERROR = 2;                // Wie Wire: Adresse nicht bestätigt
+const uint32_t SIM_I2C_BITS_PER_WRITE = 20; // Start, Adresse + ACK, Byte + ACK, Stopp
+
+// Hardware des Simulators auf dem PC: virtuelle Zeit, letzter Zustand der Ausgänge und Aufzeichnung aller
+// Übertragungen. Die Zeit läuft nur weiter, wenn der Simulator sie vorstellt oder eine Übertragung bzw.
+// delay() Zeit braucht. Ein simulierter Tag dauert so nur so lange, wie das Rechnen der Frames.
+class SimHardware {
+public:
+    static SimHardware& getInstance() {
+        static SimHardware instance;
+        return instance;
+    }
+
+    // --- Virtuelle Zeit ---
+    uint64_t micros() const { return _micros; }
+    uint64_t millis() const { return _micros / 1000; }
+    void advanceMicros(uint64_t micros) { _micros += micros; }
+    // Zeit auf timeMicros vorstellen (nie zurück)
+    void advanceTo(uint64_t timeMicros);
+
+    // --- Übertragungen ---
+    // Frame in GRB-Reihenfolge mit Helligkeit, wie es an den LEDs ankommt
+    void recordLedFrame(const uint8_t* grb, size_t bytes);
+    // Byte an einen i2c-Baustein. false, wenn der Simulator die Übertragung fehlschlagen lässt.
+    bool recordI2cWrite(uint8_t address, uint8_t value);
+    void recordSound(int track);
+
+    // Die nächsten count Übertragungen an address schlagen fehl (Fehlerbehandlung prüfen)
+    void failI2cWrites(uint8_t address, uint32_t count);
+
+    // --- Zustand der Ausgänge ---
+    const std::vector<uint8_t>& getLedFrame() const { return _ledFrame; }
+    // Zuletzt erfolgreich an address übertragenes Byte, 0xFF (PCF8574 nach dem Einschalten) ohne Übertragung
+    uint8_t getI2cOutput(uint8_t address) const { return _i2cOutputs[address % SIM_I2C_ADDRESSES]; }
+
+    const std::vector<SimTransaction>& getTransactions() const { return _transactions; }
+    uint32_t getCount(SimTransactionType type) const { return _counts[type]; }
+
+    // Aufzeichnung und Zähler leeren, Zeit und Ausgänge bleiben
+    void clearTransactions();
+
+private:
+    SimHardware();
+
+    SimHardware(const SimHardware&) = delete;
+    SimHardware& operator=(const SimHardware&) = delete;
+
+    uint64_t _micros;
+    std::vector<uint8_t> _ledFrame;
+    uint8_t _i2cOutputs[SIM_I2C_ADDRESSES];
+    uint32_t _i2cFailures[SIM_I2C_ADDRESSES];
+    std::vector<SimTransaction> _transactions;
+    uint32_t _counts[SIM_TRANSACTION_TYPES];
+
+    void record(SimTransactionType type, uint8_t address, uint16_t value, bool failed);
+};
+
+#endif // SIM_HARDWARE_H
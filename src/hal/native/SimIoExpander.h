@@ -0,0 +1,33 @@
+#ifndef SIM_IO_EXPANDER_H
+#define SIM_IO_EXPANDER_H
+
+#include <stdint.h>
+#include "SimHardware.h"
+
+// PCF8574 im Simulator: jedes write8() wird als i2c-Übertragung in SimHardware aufgezeichnet
+class SimIoExpander {
+public:
+    explicit SimIoExpander(uint8_t address) : _address(address), _error(0) {}
+
+    // Wie die Bibliothek: alle Ausgänge auf High
+    bool begin(uint8_t value = 0xFF) {
+        write8(value);
+        return _error == 0;
+    }
+
+    void write8(uint8_t value) {
+        _error = SimHardware::getInstance().recordI2cWrite(_address, value) ? 0 : SIM_I2C_ERROR;
+    }
+
+    int lastError() {
+        int error = _error;
+        _error = 0;
+        return error;
+    }
+
+private:
+    uint8_t _address;
+    int _error;
+};
+
+#endif // SIM_IO_EXPANDER_H
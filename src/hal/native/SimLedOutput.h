@@ -0,0 +1,80 @@
+#ifndef SIM_LED_OUTPUT_H
+#define SIM_LED_OUTPUT_H
+
+#include <FastLED.h>
+#include "SimHardware.h"
+#include "led/led_strip/LedTables.h"
+
+const uint32_t SIM_LED_BIT_NANOS = 1250;        // WS2812B: 1.25 µs pro Bit
+const uint32_t SIM_LED_RESET_MICROS = 80;       // Wie RMT_LED_RESET_MICROS
+
+// LED-Ausgabe im Simulator mit derselben Schnittstelle wie RmtLedOutput. write() rechnet Helligkeit und
+// Dithering wie auf dem Gerät, zeichnet das Frame in SimHardware auf und ist danach so lange belegt, wie die
+// Übertragung an Count LEDs in virtueller Zeit dauern würde.
+template <uint16_t Count>
+class SimLedOutput {
+public:
+    explicit SimLedOutput(uint8_t channel)
+      : _channel(channel), _ditherStep(0), _ready(false), _endMicros(0),
+        _sent(0), _dropped(0), _blockedMicros(0), _maxBlockedMicros(0) {}
+
+    bool begin(uint8_t) {
+        _ready = true;
+        return true;
+    }
+
+    bool isBusy() const {
+        return SimHardware::getInstance().micros() < _endMicros;
+    }
+
+    bool write(const CRGB* leds, uint16_t scale, bool dither) {
+        if (!_ready || isBusy()) {
+            _dropped++;
+            return false;
+        }
+        uint8_t threshold = 255;
+        if (dither) {
+            threshold = LED_DITHER_THRESHOLDS[_ditherStep];
+            _ditherStep = (_ditherStep + 1) % LED_DITHER_STEPS;
+        }
+        uint8_t data[Count * 3];
+        ledEncodeGrb(leds, Count, scale, threshold, data);
+        SimHardware& hardware = SimHardware::getInstance();
+        hardware.recordLedFrame(data, sizeof(data));
+        _endMicros = hardware.micros() + (uint64_t)Count * 24 * SIM_LED_BIT_NANOS / 1000 + SIM_LED_RESET_MICROS;
+        _sent++;
+        return true;
+    }
+
+    // Virtuelle Zeit bis zum Ende der Übertragung vorstellen
+    void waitIdle() {
+        SimHardware& hardware = SimHardware::getInstance();
+        if (!isBusy()) {
+            return;
+        }
+        uint32_t blocked = (uint32_t)(_endMicros - hardware.micros());
+        hardware.advanceTo(_endMicros);
+        _blockedMicros += blocked;
+        if (blocked > _maxBlockedMicros) {
+            _maxBlockedMicros = blocked;
+        }
+    }
+
+    uint32_t getSentFrames() const { return _sent; }
+    uint32_t getCompletedFrames() const { return isBusy() ? _sent - 1 : _sent; }
+    uint32_t getDroppedFrames() const { return _dropped; }
+    uint64_t getBlockedMicros() const { return _blockedMicros; }
+    uint32_t getMaxBlockedMicros() const { return _maxBlockedMicros; }
+
+private:
+    uint8_t _channel;
+    uint8_t _ditherStep;
+    bool _ready;
+    uint64_t _endMicros;
+    uint32_t _sent;
+    uint32_t _dropped;
+    uint64_t _blockedMicros;
+    uint32_t _maxBlockedMicros;
+};
+
+#endif // SIM_LED_OUTPUT_H
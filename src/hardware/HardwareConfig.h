@@ -0,0 +1,85 @@
+#ifndef HARDWARE_CONFIG_H
+#define HARDWARE_CONFIG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Beschreibung der Hardware zur Kompilierzeit. Die Treiber werden mit diesen Werten als Template-Parameter
+// instanziiert und statisch angelegt, Fehler in der Beschreibung fallen beim Übersetzen auf (static_assert).
+// Einstellbare Zeiten und Grenzwerte bleiben in Settings.h.
+
+// LED-Streifen (WS2812B)
+constexpr uint8_t LED_PIN = 2;          // GPIO-Nummer
+constexpr uint16_t NUM_LEDS = 123;      // Gesamtzahl LEDs
+constexpr uint8_t LED_RMT_CHANNEL = 0;  // RMT-Sendekanal (ESP32-S3: 0-3)
+
+// i2c Bus (Sensoren und 7-Segment-Anzeigen)
+constexpr uint8_t I2C_SDA_PIN = 21;
+constexpr uint8_t I2C_SCL_PIN = 22;
+constexpr uint32_t I2C_CLOCK = 100000;  // 100 kHz
+
+// 7-Segment-Anzeigen, je ein PCF8574. Reihenfolge: Temperatur (Zehntel, Einer, Zehner), Feuchtigkeit (Einer, Zehner)
+constexpr uint8_t SEVEN_SEGMENT_ADDRESSES[] = { 0x20, 0x21, 0x22, 0x23, 0x24 };
+constexpr size_t SEVEN_SEGMENT_COUNT = sizeof(SEVEN_SEGMENT_ADDRESSES) / sizeof(SEVEN_SEGMENT_ADDRESSES[0]);
+// Leserichtung für Text: Index in SEVEN_SEGMENT_ADDRESSES von links nach rechts
+constexpr uint8_t SEVEN_SEGMENT_TEXT_ORDER[SEVEN_SEGMENT_COUNT] = { 2, 1, 0, 4, 3 };
+
+// Sensoren. Ein nicht verbauter Sensor (false) wird nicht angelegt, der Code dafür entfällt.
+constexpr bool TEMP_HUMI_PRESENT = true;        // SHT30
+constexpr uint8_t TEMP_HUMI_ADDRESS = 0x44;     // 0x45, wenn ADDR auf High liegt
+constexpr bool AIR_QUALITY_PRESENT = true;      // BME680
+constexpr uint8_t AIR_QUALITY_ADDRESS = 0x76;   // 0x77, wenn SDO auf High liegt
+
+// Hardware Tasten
+constexpr uint8_t BUTTON_A = 12;        // Oberster Button
+constexpr uint8_t BUTTON_B = 11;        // Mittlerer Button
+constexpr uint8_t BUTTON_C = 10;        // Unterster Button
+
+// --- Prüfungen ---
+
+// PCF8574 (0x20-0x27) bzw. PCF8574A (0x38-0x3F)
+constexpr bool isPcf8574Address(uint8_t address) {
+    return (address >= 0x20 && address <= 0x27) || (address >= 0x38 && address <= 0x3F);
+}
+
+// Kommt address in den Adressen der 7-Segment-Anzeigen ab Index first vor?
+constexpr bool usesSevenSegmentAddress(uint8_t address, size_t first = 0) {
+    for (size_t i = first; i < SEVEN_SEGMENT_COUNT; i++) {
+        if (SEVEN_SEGMENT_ADDRESSES[i] == address) return true;
+    }
+    return false;
+}
+
+constexpr bool sevenSegmentAddressesValid() {
+    for (size_t i = 0; i < SEVEN_SEGMENT_COUNT; i++) {
+        if (!isPcf8574Address(SEVEN_SEGMENT_ADDRESSES[i]) || usesSevenSegmentAddress(SEVEN_SEGMENT_ADDRESSES[i], i + 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Jede Anzeige kommt in der Leserichtung genau einmal vor
+constexpr bool sevenSegmentTextOrderValid() {
+    for (size_t i = 0; i < SEVEN_SEGMENT_COUNT; i++) {
+        if (SEVEN_SEGMENT_TEXT_ORDER[i] >= SEVEN_SEGMENT_COUNT) return false;
+        for (size_t j = i + 1; j < SEVEN_SEGMENT_COUNT; j++) {
+            if (SEVEN_SEGMENT_TEXT_ORDER[i] == SEVEN_SEGMENT_TEXT_ORDER[j]) return false;
+        }
+    }
+    return true;
+}
+
+static_assert(NUM_LEDS > 0, "LED-Streifen ohne LEDs");
+static_assert(LED_RMT_CHANNEL < 4, "ESP32-S3: RMT-Sendekanäle 0-3");
+static_assert(I2C_SDA_PIN != I2C_SCL_PIN, "SDA und SCL auf demselben Pin");
+static_assert(LED_PIN != I2C_SDA_PIN && LED_PIN != I2C_SCL_PIN, "LED-Streifen auf einem i2c-Pin");
+static_assert(sevenSegmentAddressesValid(), "7-Segment-Anzeigen: ungültige oder doppelte PCF8574-Adresse");
+static_assert(sevenSegmentTextOrderValid(), "7-Segment-Anzeigen: Leserichtung ist keine Reihenfolge aller Anzeigen");
+static_assert(TEMP_HUMI_ADDRESS == 0x44 || TEMP_HUMI_ADDRESS == 0x45, "SHT30: Adresse 0x44 oder 0x45");
+static_assert(AIR_QUALITY_ADDRESS == 0x76 || AIR_QUALITY_ADDRESS == 0x77, "BME680: Adresse 0x76 oder 0x77");
+static_assert(!TEMP_HUMI_PRESENT || !AIR_QUALITY_PRESENT || TEMP_HUMI_ADDRESS != AIR_QUALITY_ADDRESS,
+              "SHT30 und BME680 auf derselben Adresse");
+static_assert(BUTTON_A != BUTTON_B && BUTTON_A != BUTTON_C && BUTTON_B != BUTTON_C, "Zwei Tasten auf demselben Pin");
+
+#endif // HARDWARE_CONFIG_H
@@ -0,0 +1,32 @@
+#ifndef OPTIONAL_DEVICE_H
+#define OPTIONAL_DEVICE_H
+
+#include <utility>
+
+// Statisch angelegtes Gerät, das je nach Hardware-Beschreibung verbaut ist oder nicht.
+// Ist es nicht verbaut (Present = false), wird kein Objekt angelegt und get() liefert schon zur
+// Kompilierzeit nullptr: der Code hinter "if (T* device = x.get())" und die Bibliothek dazu entfallen.
+template <typename T, bool Present>
+class OptionalDevice {
+public:
+    template <typename... Args>
+    explicit OptionalDevice(Args&&... args) : _device(std::forward<Args>(args)...) {}
+
+    T* get() { return &_device; }
+    static constexpr bool isPresent() { return true; }
+
+private:
+    T _device;
+};
+
+template <typename T>
+class OptionalDevice<T, false> {
+public:
+    template <typename... Args>
+    explicit OptionalDevice(Args&&...) {}
+
+    constexpr T* get() const { return nullptr; }
+    static constexpr bool isPresent() { return false; }
+};
+
+#endif // OPTIONAL_DEVICE_H
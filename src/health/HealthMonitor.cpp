@@ -0,0 +1,62 @@
+#include "HealthMonitor.h"
+
+void HealthMonitor::begin(const HealthConfig& config, unsigned long nowMs) {
+    _config = config;
+    _stats = HealthStats();
+    _progressSince = nowMs;
+    _changed = false;
+}
+
+HealthAction HealthMonitor::update(const HealthCounters& counters, unsigned long nowMs) {
+    if (counters.progress != _lastProgress) {
+        _lastProgress = counters.progress;
+        _failureBaseline = counters.failures;
+        _progressSince = nowMs;
+        if (!_stats.healthy) {
+            _lastRecoveryMs = (uint32_t)(nowMs - _incidentStart);
+            _stats.healthy = true;
+            _stats.level = HEALTH_ACTION_NONE;
+            _stats.recoveries++;
+            _stats.totalRecoveryMs += _lastRecoveryMs;
+            if (_lastRecoveryMs > _stats.maxRecoveryMs) {
+                _stats.maxRecoveryMs = _lastRecoveryMs;
+            }
+            _changed = true;
+        }
+        return HEALTH_ACTION_NONE;
+    }
+
+    bool stalled = _config.stallTimeoutMs > 0 && nowMs - _progressSince >= _config.stallTimeoutMs;
+    bool failing = _config.failureThreshold > 0 && counters.failures - _failureBaseline >= _config.failureThreshold;
+    if (!stalled && !failing) {
+        return HEALTH_ACTION_NONE;
+    }
+
+    if (_stats.healthy) {
+        _stats.healthy = false;
+        _stats.incidents++;
+        _incidentStart = nowMs;
+        _changed = true;
+    }
+
+    // Erkennung neu starten, damit die Massnahme Zeit bekommt zu wirken
+    _failureBaseline = counters.failures;
+    _progressSince = nowMs;
+
+    HealthAction action = nextAction();
+    if (action == HEALTH_ACTION_NONE) {
+        return HEALTH_ACTION_NONE;
+    }
+    _stats.level = action;
+    _stats.actions[action]++;
+    return action;
+}
+
+HealthAction HealthMonitor::nextAction() const {
+    for (int action = _stats.level + 1; action < HEALTH_ACTION_COUNT; action++) {
+        if (_config.actions & healthActionBit((HealthAction)action)) {
+            return (HealthAction)action;
+        }
+    }
+    return _config.repeatLastAction ? _stats.level : HEALTH_ACTION_NONE;
+}
@@ -0,0 +1,76 @@
+#ifndef HEALTH_MONITOR_H
+#define HEALTH_MONITOR_H
+
+#include <stdint.h>
+
+// Wiederherstellungsmassnahmen, aufsteigend nach Tragweite
+enum HealthAction {
+    HEALTH_ACTION_NONE,
+    HEALTH_ACTION_RESET_CLIENT,         // Verbindung bzw. Gerät zurücksetzen (TLS-Client, Sensor, DFPlayer)
+    HEALTH_ACTION_REINIT_PERIPHERAL,    // Peripherie neu initialisieren (WLAN, i2c Bus, serielle Schnittstelle)
+    HEALTH_ACTION_REBOOT,               // Gerät neu starten
+    HEALTH_ACTION_COUNT
+};
+
+// Maske für HealthConfig::actions
+inline uint8_t healthActionBit(HealthAction action) { return (uint8_t)(1u << action); }
+
+// Überwachung eines Subsystems
+struct HealthConfig {
+    unsigned long stallTimeoutMs;       // Gestört, wenn so lange kein Fortschritt gemeldet wurde (0 = keine Prüfung)
+    uint32_t failureThreshold;          // Gestört nach so vielen Fehlern ohne Fortschritt dazwischen (0 = keine Prüfung)
+    uint8_t actions;                    // Erlaubte Massnahmen (healthActionBit), werden der Reihe nach eskaliert
+    bool repeatLastAction;              // Nach der letzten Stufe diese wiederholen, sonst nur noch abwarten
+};
+
+// Fortschritts- und Fehlerzähler, die das Subsystem selbst hochzählt
+struct HealthCounters {
+    uint32_t progress;
+    uint32_t failures;
+};
+
+// Statistik eines Subsystems seit dem Start
+struct HealthStats {
+    bool healthy = true;
+    HealthAction level = HEALTH_ACTION_NONE;    // Zuletzt ausgeführte Massnahme der laufenden Störung
+    uint32_t incidents = 0;                     // Erkannte Störungen
+    uint32_t recoveries = 0;                    // Davon behoben (wieder Fortschritt)
+    uint64_t totalRecoveryMs = 0;               // Summe der Zeiten von der Erkennung bis zur Behebung
+    uint32_t maxRecoveryMs = 0;
+    uint32_t actions[HEALTH_ACTION_COUNT] = {}; // Ausgeführte Massnahmen pro Stufe
+
+    uint32_t getMeanRecoveryMs() const { return recoveries > 0 ? (uint32_t)(totalRecoveryMs / recoveries) : 0; }
+};
+
+// Erkennt Störungen eines Subsystems anhand seiner Zähler und bestimmt die nächste Massnahme.
+// Jede Massnahme setzt die Erkennung zurück: Bleibt das Subsystem danach gestört (erneuter Stillstand
+// bzw. erneut failureThreshold Fehler), folgt die nächste erlaubte Stufe. Sobald wieder Fortschritt
+// gemeldet wird, gilt die Störung als behoben.
+// Reine Logik ohne Arduino-Abhängigkeit, die Zeit wird von aussen übergeben.
+class HealthMonitor {
+public:
+    void begin(const HealthConfig& config, unsigned long nowMs);
+
+    // Wertet die Zähler aus. Gibt die jetzt auszuführende Massnahme zurück (meistens HEALTH_ACTION_NONE).
+    HealthAction update(const HealthCounters& counters, unsigned long nowMs);
+
+    // true, wenn update() seit dem letzten Aufruf eine Störung erkannt oder behoben hat
+    bool takeChanged() { bool changed = _changed; _changed = false; return changed; }
+
+    const HealthStats& getStats() const { return _stats; }
+    uint32_t getLastRecoveryMs() const { return _lastRecoveryMs; }
+
+private:
+    HealthConfig _config = {};
+    HealthStats _stats;
+    uint32_t _lastProgress = 0;
+    uint32_t _failureBaseline = 0;      // Fehlerzähler beim letzten Fortschritt bzw. bei der letzten Massnahme
+    unsigned long _progressSince = 0;   // Letzter Fortschritt bzw. letzte Massnahme
+    unsigned long _incidentStart = 0;
+    uint32_t _lastRecoveryMs = 0;
+    bool _changed = false;
+
+    HealthAction nextAction() const;
+};
+
+#endif // HEALTH_MONITOR_H
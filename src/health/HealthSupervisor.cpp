@@ -0,0 +1,147 @@
+#include "HealthSupervisor.h"
+#include <esp_task_wdt.h>
+#include "../logger/Logger.h"
+
+// Überlebt einen Software-Reset, damit die Neustarts durch den Supervisor gezählt werden können
+struct HealthRebootRecord {
+    uint32_t magic;
+    uint32_t reboots;
+    uint8_t lastSubsystem;
+};
+static const uint32_t HEALTH_REBOOT_MAGIC = 0x48524254; // "HRBT"
+RTC_NOINIT_ATTR static HealthRebootRecord healthRebootRecord;
+
+HealthSupervisor::HealthSupervisor() : _watchdogSubscribed(false) {
+    for (int i = 0; i < HEALTH_SUBSYSTEM_COUNT; i++) {
+        _counters[i].progress.store(0);
+        _counters[i].failures.store(0);
+        _recover[i] = nullptr;
+        _enabled[i] = false;
+    }
+    if (healthRebootRecord.magic != HEALTH_REBOOT_MAGIC) {
+        healthRebootRecord.magic = HEALTH_REBOOT_MAGIC;
+        healthRebootRecord.reboots = 0;
+        healthRebootRecord.lastSubsystem = HEALTH_SUBSYSTEM_COUNT;
+    } else if (esp_reset_reason() == ESP_RST_SW && healthRebootRecord.lastSubsystem < HEALTH_SUBSYSTEM_COUNT) {
+        Logger::log(LogLevel::Info, "Health: Neustart durch den Supervisor wegen " +
+                    String(subsystemToString((HealthSubsystem)healthRebootRecord.lastSubsystem)) + ".");
+    }
+    healthRebootRecord.lastSubsystem = HEALTH_SUBSYSTEM_COUNT;
+    publishReport();
+}
+
+void HealthSupervisor::add(HealthSubsystem subsystem, const HealthConfig& config, HealthRecoveryFunction recover) {
+    _monitors[subsystem].begin(config, millis());
+    _recover[subsystem] = recover;
+    _enabled[subsystem] = true;
+}
+
+void HealthSupervisor::check() {
+    if (!_watchdogSubscribed) {
+        // Der Task-Watchdog ist vom Framework bereits initialisiert, die Supervisor-Task meldet sich nur an
+        _watchdogSubscribed = esp_task_wdt_add(nullptr) == ESP_OK;
+        if (!_watchdogSubscribed) {
+            Logger::log(LogLevel::Error, "Health: Anmeldung beim Task-Watchdog fehlgeschlagen!");
+        }
+    }
+    if (_watchdogSubscribed) {
+        esp_task_wdt_reset();
+    }
+
+    unsigned long now = millis();
+    bool changed = false;
+    for (int i = 0; i < HEALTH_SUBSYSTEM_COUNT; i++) {
+        if (!_enabled[i]) {
+            continue;
+        }
+        HealthSubsystem subsystem = (HealthSubsystem)i;
+        HealthMonitor& monitor = _monitors[i];
+        HealthCounters counters = { _counters[i].progress.load(std::memory_order_relaxed), _counters[i].failures.load(std::memory_order_relaxed) };
+        bool wasHealthy = monitor.getStats().healthy;
+        HealthAction action = monitor.update(counters, now);
+
+        if (monitor.takeChanged()) {
+            changed = true;
+            if (monitor.getStats().healthy) {
+                Logger::log(LogLevel::Info, "Health: " + String(subsystemToString(subsystem)) + " wiederhergestellt nach " +
+                            String(monitor.getLastRecoveryMs()) + " ms.");
+            } else if (wasHealthy) {
+                Logger::log(LogLevel::Error, "Health: " + String(subsystemToString(subsystem)) + " gestört.");
+            }
+        }
+        if (action == HEALTH_ACTION_NONE) {
+            continue;
+        }
+        changed = true;
+        Logger::log(LogLevel::Error, "Health: " + String(subsystemToString(subsystem)) + ", Massnahme: " + actionToString(action));
+        if (action == HEALTH_ACTION_REBOOT) {
+            reboot(subsystem);
+        } else if (_recover[i] != nullptr) {
+            _recover[i](subsystem, action);
+        }
+        if (_watchdogSubscribed) {
+            esp_task_wdt_reset(); // Massnahmen dürfen etwas dauern (z.B. i2c Bus befreien)
+        }
+    }
+
+    if (changed) {
+        publishReport();
+    }
+}
+
+void HealthSupervisor::publishReport() {
+    HealthReport report;
+    for (int i = 0; i < HEALTH_SUBSYSTEM_COUNT; i++) {
+        report.subsystems[i] = _monitors[i].getStats();
+    }
+    report.supervisorReboots = healthRebootRecord.reboots;
+    _report.publish(report);
+}
+
+void HealthSupervisor::reboot(HealthSubsystem subsystem) {
+    healthRebootRecord.reboots++;
+    healthRebootRecord.lastSubsystem = (uint8_t)subsystem;
+    Logger::log(LogLevel::Error, "Health: Alle Massnahmen für " + String(subsystemToString(subsystem)) + " ausgeschöpft, starte neu.");
+    Serial.flush();
+    esp_restart();
+}
+
+void HealthSupervisor::logStats() const {
+    HealthReport report = getReport();
+    for (int i = 0; i < HEALTH_SUBSYSTEM_COUNT; i++) {
+        if (!_enabled[i]) {
+            continue;
+        }
+        const HealthStats& stats = report.subsystems[i];
+        Logger::log(LogLevel::Info, "Health " + String(subsystemToString((HealthSubsystem)i)) + ": " +
+                    (stats.healthy ? "ok" : "gestört") + ", Störungen " + String(stats.incidents) +
+                    ", behoben " + String(stats.recoveries) + ", MTTR " + String(stats.getMeanRecoveryMs()) +
+                    " ms (max " + String(stats.maxRecoveryMs) + " ms), Massnahmen " +
+                    String(stats.actions[HEALTH_ACTION_RESET_CLIENT]) + "/" + String(stats.actions[HEALTH_ACTION_REINIT_PERIPHERAL]) + "/" +
+                    String(stats.actions[HEALTH_ACTION_REBOOT]));
+    }
+    Logger::log(LogLevel::Info, "Health: Neustarts durch den Supervisor: " + String(report.supervisorReboots));
+}
+
+const char* HealthSupervisor::subsystemToString(HealthSubsystem subsystem) {
+    switch (subsystem) {
+        case HEALTH_NETWORK_TASK: return "network";
+        case HEALTH_DISPLAY_TASK: return "display";
+        case HEALTH_WEATHER_API: return "weather";
+        case HEALTH_POLLEN_API: return "pollen";
+        case HEALTH_TEMP_SENSOR: return "sht30";
+        case HEALTH_AIR_SENSOR: return "bme680";
+        case HEALTH_MP3_PLAYER: return "mp3";
+        default: return "?";
+    }
+}
+
+const char* HealthSupervisor::actionToString(HealthAction action) {
+    switch (action) {
+        case HEALTH_ACTION_NONE: return "keine";
+        case HEALTH_ACTION_RESET_CLIENT: return "Client zurücksetzen";
+        case HEALTH_ACTION_REINIT_PERIPHERAL: return "Peripherie neu initialisieren";
+        case HEALTH_ACTION_REBOOT: return "Neustart";
+        default: return "?";
+    }
+}
@@ -0,0 +1,89 @@
+#ifndef HEALTH_SUPERVISOR_H
+#define HEALTH_SUPERVISOR_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "HealthMonitor.h"
+#include "../tasks/Mailbox.h"
+
+// Überwachte Subsysteme
+enum HealthSubsystem {
+    HEALTH_NETWORK_TASK,        // Netzwerk-Task (z.B. hängender TLS-Lesevorgang)
+    HEALTH_DISPLAY_TASK,        // Anzeige-Task
+    HEALTH_WEATHER_API,
+    HEALTH_POLLEN_API,
+    HEALTH_TEMP_SENSOR,         // SHT30 am i2c Bus
+    HEALTH_AIR_SENSOR,          // BME680 am i2c Bus
+    HEALTH_MP3_PLAYER,          // DFPlayer an Serial1
+    HEALTH_SUBSYSTEM_COUNT
+};
+
+// Führt eine Massnahme für ein Subsystem aus (im Kontext der Supervisor-Task).
+// HEALTH_ACTION_REBOOT übernimmt der Supervisor selbst.
+// Eine hängende Task wird nie gelöscht (sie könnte Mutexe, Sockets oder den NVS belegen): die Funktion
+// darf sie nur zum Abbruch auffordern, ohne auf sie zu warten.
+typedef void (*HealthRecoveryFunction)(HealthSubsystem subsystem, HealthAction action);
+
+// Stand aller Subsysteme für Schnittstellen und Statistik
+struct HealthReport {
+    HealthStats subsystems[HEALTH_SUBSYSTEM_COUNT];
+    uint32_t supervisorReboots = 0;     // Neustarts durch den Supervisor (über Resets hinweg)
+};
+
+// Überwacht die Subsysteme anhand ihrer Fortschritts- und Fehlerzähler und eskaliert bei Störungen
+// pro Subsystem schrittweise (Client zurücksetzen bzw. laufende Anfragen abbrechen, Peripherie neu initialisieren).
+// Der Neustart des Geräts ist immer die letzte Stufe, die Anzeige kommt danach aus dem Warmstart-Speicher zurück.
+// Die Zähler dürfen aus jeder Task gemeldet werden, check() läuft in einer eigenen Task mit hoher
+// Priorität, die selbst vom Task-Watchdog überwacht wird: Hängt der Supervisor, setzt der Watchdog das Gerät zurück.
+class HealthSupervisor {
+public:
+    // Statische Methode, um die einzige Instanz zu erhalten (Singleton-Muster).
+    static HealthSupervisor& getInstance() {
+        static HealthSupervisor instance;
+        return instance;
+    }
+
+    // Meldet ein Subsystem zur Überwachung an. Vor dem Start der Supervisor-Task aufrufen.
+    void add(HealthSubsystem subsystem, const HealthConfig& config, HealthRecoveryFunction recover);
+
+    // Zähler der Subsysteme (aus jeder Task)
+    void reportProgress(HealthSubsystem subsystem) { _counters[subsystem].progress.fetch_add(1, std::memory_order_relaxed); }
+    void reportFailure(HealthSubsystem subsystem) { _counters[subsystem].failures.fetch_add(1, std::memory_order_relaxed); }
+    // Für Subsysteme, die ihren Fortschritt selbst zählen (z.B. Durchläufe einer Task)
+    void setProgress(HealthSubsystem subsystem, uint32_t progress) { _counters[subsystem].progress.store(progress, std::memory_order_relaxed); }
+
+    // Prüft alle Subsysteme, führt fällige Massnahmen aus und bedient den Task-Watchdog.
+    // Nur aus der Supervisor-Task aufrufen.
+    void check();
+
+    // Aktueller Stand (aus jeder Task)
+    HealthReport getReport() const { return _report.read(); }
+
+    // Gibt Störungen, Behebungen und die mittlere Zeit bis zur Behebung pro Subsystem aus.
+    void logStats() const;
+
+    static const char* subsystemToString(HealthSubsystem subsystem);
+    static const char* actionToString(HealthAction action);
+
+private:
+    HealthSupervisor();
+    HealthSupervisor(const HealthSupervisor&) = delete;
+    HealthSupervisor& operator=(const HealthSupervisor&) = delete;
+
+    struct Counters {
+        std::atomic<uint32_t> progress;
+        std::atomic<uint32_t> failures;
+    };
+
+    Counters _counters[HEALTH_SUBSYSTEM_COUNT];
+    HealthMonitor _monitors[HEALTH_SUBSYSTEM_COUNT];
+    HealthRecoveryFunction _recover[HEALTH_SUBSYSTEM_COUNT];
+    bool _enabled[HEALTH_SUBSYSTEM_COUNT];
+    Mailbox<HealthReport> _report;
+    bool _watchdogSubscribed;
+
+    void publishReport();
+    void reboot(HealthSubsystem subsystem);
+};
+
+#endif // HEALTH_SUPERVISOR_H
@@ -0,0 +1,43 @@
+#ifndef I2C_BUS_RECOVERY_H
+#define I2C_BUS_RECOVERY_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// Befreit einen blockierten i2c Bus. Hält ein Slave SDA nach einer abgebrochenen Übertragung auf Low,
+// wird er mit bis zu neun Takten auf SCL zu Ende gelesen und danach mit einer STOP-Bedingung freigegeben.
+// Anschliessend wird der Treiber neu gestartet.
+class I2cBusRecovery {
+public:
+    // Gibt true zurück, wenn SDA danach wieder frei (High) ist.
+    static bool recover(TwoWire& wire, int sdaPin, int sclPin, uint32_t clockHz) {
+        wire.end();
+
+        pinMode(sdaPin, INPUT_PULLUP);
+        pinMode(sclPin, OUTPUT_OPEN_DRAIN);
+        digitalWrite(sclPin, HIGH);
+        for (int i = 0; i < 9 && digitalRead(sdaPin) == LOW; i++) {
+            digitalWrite(sclPin, LOW);
+            delayMicroseconds(5);
+            digitalWrite(sclPin, HIGH);
+            delayMicroseconds(5);
+        }
+
+        // STOP: SDA bei High-Pegel auf SCL von Low nach High
+        pinMode(sdaPin, OUTPUT_OPEN_DRAIN);
+        digitalWrite(sdaPin, LOW);
+        delayMicroseconds(5);
+        digitalWrite(sclPin, HIGH);
+        delayMicroseconds(5);
+        digitalWrite(sdaPin, HIGH);
+        delayMicroseconds(5);
+        pinMode(sdaPin, INPUT_PULLUP);
+        bool released = digitalRead(sdaPin) == HIGH;
+
+        wire.begin(sdaPin, sclPin);
+        wire.setClock(clockHz);
+        return released;
+    }
+};
+
+#endif // I2C_BUS_RECOVERY_H
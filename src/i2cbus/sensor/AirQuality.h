@@ -4,13 +4,17 @@
 
 #define SEALEVELPRESSURE_HPA (1013.25) // Standard Meeresspiegeldruck in hPa
 
+const uint16_t AIR_QUALITY_HEATER_TEMPERATURE = 320; // Temperatur der Gasheizung in °C
+const uint16_t AIR_QUALITY_HEATER_DURATION = 150;    // Heizdauer pro Messung in ms
+
 class AirQuality {
 public:
     // Konstruktor: Nimmt das Wire-Objekt und die I2C-Adresse entgegen
     AirQuality(TwoWire* wire, uint8_t addr) :
         bme(wire), // Initialisiert das Adafruit BME680 Objekt mit dem übergebenen Wire-Objekt
         _i2cAddress(addr),
-        _initialized(false) {}
+        _initialized(false),
+        _heaterOnMs(0) {}
 
     // Initialisiert den Sensor
     bool begin() {
@@ -25,7 +29,7 @@ public:
         bme.setHumidityOversampling(BME680_OS_2X);
         bme.setPressureOversampling(BME680_OS_4X);
         bme.setIIRFilterSize(BME680_FILTER_SIZE_3);
-        bme.setGasHeater(320, 150); // 320 C für 150 ms
+        bme.setGasHeater(AIR_QUALITY_HEATER_TEMPERATURE, AIR_QUALITY_HEATER_DURATION);
         _initialized = true;
         Serial.println("BME680 initialisiert.");
         return true;
@@ -37,6 +41,7 @@ public:
             Serial.println("Sensor nicht initialisiert.");
             return false;
         }
+        _heaterOnMs += AIR_QUALITY_HEATER_DURATION; // Die Heizung läuft bei jeder Messung, auch wenn sie scheitert
         if (!bme.performReading()) {
             Serial.println("Fehler beim Auslesen des BME680 Sensors!");
             return false;
@@ -44,6 +49,11 @@ public:
         return true;
     }
 
+    // Gesamte Einschaltdauer der Gasheizung in ms (für das Wärmemodell, nur Differenzen verwenden)
+    uint32_t getHeaterOnMs() const {
+        return _heaterOnMs;
+    }
+
     // Gibt die Temperatur in Grad Celsius zurück
     float getTemperature() {
         return bme.temperature;
@@ -93,6 +103,7 @@ private:
     Adafruit_BME680 bme;        // Adafruit BME680 Objekt
     uint8_t _i2cAddress;        // I2C Adresse des Sensors
     bool _initialized;          // Flag, ob der Sensor initialisiert wurde
+    uint32_t _heaterOnMs;       // Einschaltdauer der Gasheizung seit dem Start
 };
 
     // Serial.print("Temperatur = ");
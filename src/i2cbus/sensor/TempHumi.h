@@ -1,5 +1,4 @@
 #include <Wire.h> // Arduino I2C Bibliothek
-#include <Settings.h>
 
 #define SHT30_DEFAULT_ADDRESS 0x44 // Standard-I2C-Adresse für den SHT30 Sensor
                                    // Alternativ 0x45, je nach ADDR-Pin-Konfiguration
@@ -69,8 +68,8 @@ public:
         // Für eine robuste Anwendung sollte sie implementiert werden.
 
         // Berechne Temperatur in °C
+        // Rohwert: die Eigenerwärmung durch das Gerät korrigiert das ThermalModel
         temperature = -45.0f + 175.0f * ((float)tempRaw / 65535.0f);
-        temperature += SENSOR_TEMPERATUR_CORRECTION; // Korrektur, da er etwas zu warm misst
 
         // Berechne relative Feuchtigkeit in %
         humidity = 100.0f * ((float)humidityRaw / 65535.0f);
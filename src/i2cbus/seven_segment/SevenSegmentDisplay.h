@@ -1,5 +1,11 @@
-#include <Wire.h>
-#include <PCF8574.h>
+#ifndef SEVEN_SEGMENT_DISPLAY_H
+#define SEVEN_SEGMENT_DISPLAY_H
+
+#include <stddef.h>
+#include <utility>
+#include "hal/IoExpander.h"
+#include "SevenSegmentFont.h"
+#include <logger/Logger.h>
 #include <logger/LogLevel.h>
 
 /*
@@ -14,7 +20,7 @@ Original:
     |       |
      -- d --  o DP
 
-Anschluss auf Ausgangsmodul:
+Anschluss auf Ausgangsmodul (SEVEN_SEGMENT_PINS in SevenSegmentFont.h):
      -- 1 --
     |       |
     2       0
@@ -37,17 +43,61 @@ Binäre Wertigkeit:
      -- 64--  o 16
 */
 
+// Übertragungen einer Anzeige
+struct SevenSegmentStats {
+    uint32_t writes;        // Bytes an den PCF8574 gesendet
+    uint32_t suppressed;    // flush() ohne Änderung, keine Übertragung
+    uint32_t errors;        // Fehlgeschlagene Übertragungen
+};
+
+// Eine 7-Segment-Anzeige an einem PCF8574 mit Schattenregister: die Methoden setzen nur das gewünschte Byte,
+// flush() überträgt es und nur, wenn es sich vom zuletzt erfolgreich übertragenen unterscheidet.
 class SevenSegmentDisplay {
 public:
-    // Konstruktor: Nimmt die PCF8574 Instanz und die Zuordnung der Segmente entgegen.
-    // pinMap: Array [a,b,c,d,e,f,g]
-    // dpPin: Der PCF8574 Pin, an den der Dezimalpunkt (DP) angeschlossen ist.
-    SevenSegmentDisplay(uint8_t pcfAddress)
-      : _pcf(pcfAddress){
+    // Konstruktor: Nimmt die i2c Adresse des PCF8574 entgegen. Greift nicht auf den Bus zu,
+    // damit das Objekt statisch angelegt werden kann.
+    explicit SevenSegmentDisplay(uint8_t pcfAddress)
+      : _pcf(pcfAddress), _address(pcfAddress), _pending(0xFF), _written(0xFF), _writtenValid(false), _stats() {
+    }
+
+    // PCF8574 starten, nachdem der i2c Bus läuft
+    void begin() {
         _pcf.begin();
         allSegmentsOff(); // Erstmal alle Segmente ausschalten
+        invalidate();
+        flush();
+    }
+
+    // Byte übertragen, falls es sich geändert hat. true, wenn der PCF8574 danach das gewünschte Byte hat.
+    bool flush() {
+        if (_writtenValid && _pending == _written) {
+            _stats.suppressed++;
+            return true;
+        }
+        _pcf.write8(_pending);
+        _stats.writes++;
+
+        // Fehler Behandlung: das Byte gilt als nicht übertragen und wird beim nächsten flush() wiederholt
+        int error = _pcf.lastError();
+        if(error != 0){
+            if (_stats.errors == 0 || _writtenValid) {
+                Logger::log(LogLevel::Error, "Error beim übertragen der 7-Segment Anzeige 0x" + String(_address, HEX) + ": " + String(error));
+            }
+            _stats.errors++;
+            _writtenValid = false;
+            return false;
+        }
+        _written = _pending;
+        _writtenValid = true;
+        return true;
     }
 
+    // Inhalt des PCF8574 unbekannt (z.B. nach einer Wiederherstellung des i2c Bus): beim nächsten flush() neu senden
+    void invalidate() { _writtenValid = false; }
+
+    bool isDirty() const { return !_writtenValid || _pending != _written; }
+    const SevenSegmentStats& getStats() const { return _stats; }
+
     // Methode zum Anzeigen einer Ziffer (0-9) und Steuern des Dezimalpunkts
     // digit: Die anzuzeigende Ziffer (0-9).
     // showDecimalPoint: true, um den Dezimalpunkt anzuzeigen, false, um ihn auszublenden.
@@ -58,48 +108,118 @@ public:
             return;
         }
 
-        //                    Normal {231,  33, 203, 107,  45, 110, 238,  39, 239, 111}
-        // Invertieren der Ausgänge  [255 - Zahl]
-        uint8_t digitToSegment[10] = { 24, 222,  52, 148, 210, 145,  17, 216,  16, 144};
-
-        uint8_t outputByte = digitToSegment[digit];
+        uint8_t outputByte = sevenSegmentGlyph('0' + digit);
 
         if(showDecimalPoint){
             // Bit für den Dezimal Punkt einschalten
-            outputByte -= 16;
+            outputByte = sevenSegmentWithPoint(outputByte);
         }
 
         Logger::log(LogLevel::Debug, "Zahl: " + String(digit)); // Umwandlung zu String für Konkatenation
         Logger::log(LogLevel::Debug, "OutputByte: " + String(outputByte)); // Umwandlung zu String
 
-        write8(outputByte);
+        setByte(outputByte);
     }
 
     void displayMinus(){
-        uint8_t outputByte = 247; // Normal 8
+        uint8_t outputByte = sevenSegmentGlyph('-');
         Logger::log(LogLevel::Debug, "Minus Auf 7-Segment Anzeige Anzeigen");
-        write8(outputByte);
+        setByte(outputByte);
     }
     
     // Methode zum Ausschalten aller Segmente und des Dezimalpunkts
     // Bedeutet jetzt: Alle Ausgänge auf HIGH setzen, sodass kein Segment leuchtet.
     void allSegmentsOff() {
-        uint8_t outputByte = 0xFF; // Setze alle Bits auf 1 (HIGH), um alle Segmente auszuschalten (Common Anode)
+        uint8_t outputByte = SEVEN_SEGMENT_BLANK; // Setze alle Bits auf 1 (HIGH), um alle Segmente auszuschalten (Common Anode)
         Logger::log(LogLevel::Debug, "7-Segment Anzeige aus.");
-        write8(outputByte);
+        setByte(outputByte);
+    }
+
+    // Zeichen aus SevenSegmentFont.h anzeigen, nicht darstellbare Zeichen bleiben leer
+    void displayChar(char c, bool showDecimalPoint = false) {
+        uint8_t outputByte = sevenSegmentGlyph(c);
+        displayGlyph(showDecimalPoint ? sevenSegmentWithPoint(outputByte) : outputByte);
+    }
+
+    // Fertiges Ausgangsbyte anzeigen (z.B. eine Stelle aus sevenSegmentLayout())
+    void displayGlyph(uint8_t outputByte) {
+        setByte(outputByte);
     }
 
 private:
-    PCF8574 _pcf;           // Referenz auf die PCF8574 Instanz
+    IoExpander _pcf;        // PCF8574 (im Simulator SimIoExpander)
+    uint8_t _address;
+    uint8_t _pending;       // Schattenregister: gewünschter Zustand der Ausgänge
+    uint8_t _written;       // Zuletzt erfolgreich übertragen
+    bool _writtenValid;
+    SevenSegmentStats _stats;
 
-    void write8(uint8_t outputByte){
-        // Senden Sie das gesamte Byte an den PCF8574
-        _pcf.write8(outputByte);
+    void setByte(uint8_t outputByte){
+        _pending = outputByte;
+    }
+};
 
-        // Fehler Behandlung
-        int error = _pcf.lastError();
-        if(error != 0){
-            Logger::log(LogLevel::Error, "Error beim übertragen der 7-Segment Anzeige: " + String(error));
+// Feste Anzahl 7-Segment-Anzeigen, die Adressen kommen aus der Hardware-Beschreibung.
+// Die Anzeigen sind Teil des Objekts, es wird nichts auf dem Heap angelegt.
+// flush() überträgt alle geänderten Anzeigen auf einmal (einmal pro Frame der Anzeige).
+template <size_t Count>
+class SevenSegmentArray {
+public:
+    static_assert(Count > 0, "Keine 7-Segment-Anzeigen");
+
+    explicit SevenSegmentArray(const uint8_t (&addresses)[Count])
+      : SevenSegmentArray(addresses, std::make_index_sequence<Count>()) {}
+
+    void begin() {
+        for (size_t i = 0; i < Count; i++) {
+            _displays[i].begin();
+        }
+    }
+
+    // Geänderte Anzeigen übertragen. true, wenn alle Anzeigen aktuell sind.
+    bool flush() {
+        bool ok = true;
+        for (size_t i = 0; i < Count; i++) {
+            ok = _displays[i].flush() && ok;
+        }
+        return ok;
+    }
+
+    bool isDirty() const {
+        for (size_t i = 0; i < Count; i++) {
+            if (_displays[i].isDirty()) return true;
+        }
+        return false;
+    }
+
+    void invalidate() {
+        for (size_t i = 0; i < Count; i++) {
+            _displays[i].invalidate();
+        }
+    }
+
+    // Summe über alle Anzeigen
+    SevenSegmentStats getStats() const {
+        SevenSegmentStats total = {};
+        for (size_t i = 0; i < Count; i++) {
+            const SevenSegmentStats& stats = _displays[i].getStats();
+            total.writes += stats.writes;
+            total.suppressed += stats.suppressed;
+            total.errors += stats.errors;
         }
+        return total;
     }
-};
\ No newline at end of file
+
+    static constexpr size_t size() { return Count; }
+    SevenSegmentDisplay& operator[](size_t index) { return _displays[index]; }
+    const SevenSegmentDisplay& operator[](size_t index) const { return _displays[index]; }
+
+private:
+    template <size_t... Index>
+    SevenSegmentArray(const uint8_t (&addresses)[Count], std::index_sequence<Index...>)
+      : _displays{ SevenSegmentDisplay(addresses[Index])... } {}
+
+    SevenSegmentDisplay _displays[Count];
+};
+
+#endif // SEVEN_SEGMENT_DISPLAY_H
@@ -0,0 +1,156 @@
+#ifndef SEVEN_SEGMENT_FONT_H
+#define SEVEN_SEGMENT_FONT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Zeichensatz der 7-Segment-Anzeigen, beim Übersetzen berechnet. Die Zeichen sind als Segmente a-g
+// beschrieben (Bild in SevenSegmentDisplay.h), die Verdrahtung auf die Ausgänge des PCF8574 steht nur in
+// SEVEN_SEGMENT_PINS. Daraus entsteht pro ASCII-Zeichen das Byte für den PCF8574, invertiert, da die
+// Ausgänge die Segmente nach Masse schalten (gemeinsame Anode).
+
+const uint8_t SEVEN_SEGMENT_FIRST_CHAR = 32;    // Leerzeichen
+const uint8_t SEVEN_SEGMENT_CHAR_COUNT = 96;    // Bis einschliesslich 127
+const uint8_t SEVEN_SEGMENT_BLANK = 0xFF;       // Alle Segmente aus
+
+// Ausgang des PCF8574 pro Segment a, b, c, d, e, f, g und Dezimalpunkt
+constexpr uint8_t SEVEN_SEGMENT_PINS[8] = { 1, 0, 5, 6, 7, 2, 3, 4 };
+const uint8_t SEVEN_SEGMENT_DP_INDEX = 7;
+
+// Segmente als Text ("abcdef" = 0, "." = Dezimalpunkt) -> Bits der Ausgänge (nicht invertiert)
+constexpr uint8_t sevenSegmentPins(const char* segments) {
+    uint8_t pins = 0;
+    for (size_t i = 0; segments[i] != '\0'; i++) {
+        char segment = segments[i];
+        if (segment == '.') {
+            pins |= 1 << SEVEN_SEGMENT_PINS[SEVEN_SEGMENT_DP_INDEX];
+        } else if (segment >= 'a' && segment <= 'g') {
+            pins |= 1 << SEVEN_SEGMENT_PINS[segment - 'a'];
+        }
+    }
+    return pins;
+}
+
+// Ausgangsbyte mit eingeschaltetem Dezimalpunkt
+constexpr uint8_t sevenSegmentWithPoint(uint8_t glyph) {
+    return glyph & (uint8_t)~sevenSegmentPins(".");
+}
+
+struct SevenSegmentGlyph {
+    char character;
+    const char* segments;
+};
+
+// Darstellbare Zeichen. Buchstaben, die nur in einer Schreibweise vorkommen, gelten für beide
+// (z.B. "b" auch für "B"). K, M, V, W und X lassen sich nicht darstellen und bleiben leer.
+constexpr SevenSegmentGlyph SEVEN_SEGMENT_GLYPHS[] = {
+    { '0', "abcdef" }, { '1', "bc" },     { '2', "abdeg" },  { '3', "abcdg" },  { '4', "bcfg" },
+    { '5', "acdfg" },  { '6', "acdefg" }, { '7', "abcf" },   { '8', "abcdefg" }, { '9', "abcdfg" },
+    { 'A', "abcefg" }, { 'b', "cdefg" },  { 'C', "adef" },   { 'c', "deg" },    { 'd', "bcdeg" },
+    { 'E', "adefg" },  { 'F', "aefg" },   { 'G', "acdef" },  { 'H', "bcefg" },  { 'h', "cefg" },
+    { 'I', "ef" },     { 'i', "c" },      { 'J', "bcde" },   { 'L', "def" },    { 'n', "ceg" },
+    { 'O', "abcdef" }, { 'o', "cdeg" },   { 'P', "abefg" },  { 'q', "abcfg" },  { 'r', "eg" },
+    { 'S', "acdfg" },  { 't', "defg" },   { 'U', "bcdef" },  { 'u', "cde" },    { 'y', "bcdfg" },
+    { 'Z', "abdeg" },
+    { ' ', "" },       { '-', "g" },      { '_', "d" },      { '=', "dg" },     { '"', "bf" },
+    { '\'', "f" },     { '[', "adef" },   { ']', "abcd" },   { '?', "abeg" },   { '*', "abfg" }, // * als Gradzeichen
+};
+
+struct SevenSegmentFont {
+    uint8_t glyphs[SEVEN_SEGMENT_CHAR_COUNT];
+};
+
+constexpr char sevenSegmentOtherCase(char c) {
+    return (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : ((c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c);
+}
+
+constexpr SevenSegmentFont buildSevenSegmentFont() {
+    SevenSegmentFont font = {};
+    bool defined[SEVEN_SEGMENT_CHAR_COUNT] = {};
+    for (size_t i = 0; i < SEVEN_SEGMENT_CHAR_COUNT; i++) {
+        font.glyphs[i] = SEVEN_SEGMENT_BLANK;
+    }
+    for (const SevenSegmentGlyph& glyph : SEVEN_SEGMENT_GLYPHS) {
+        size_t index = glyph.character - SEVEN_SEGMENT_FIRST_CHAR;
+        font.glyphs[index] = (uint8_t)~sevenSegmentPins(glyph.segments);
+        defined[index] = true;
+    }
+    // Fehlende Schreibweise eines Buchstabens von der vorhandenen übernehmen
+    for (const SevenSegmentGlyph& glyph : SEVEN_SEGMENT_GLYPHS) {
+        size_t other = sevenSegmentOtherCase(glyph.character) - SEVEN_SEGMENT_FIRST_CHAR;
+        if (!defined[other]) {
+            font.glyphs[other] = (uint8_t)~sevenSegmentPins(glyph.segments);
+        }
+    }
+    return font;
+}
+
+constexpr SevenSegmentFont SEVEN_SEGMENT_FONT = buildSevenSegmentFont();
+
+// Ausgangsbyte eines Zeichens, nicht darstellbare Zeichen bleiben leer
+constexpr uint8_t sevenSegmentGlyph(char c) {
+    return ((uint8_t)c >= SEVEN_SEGMENT_FIRST_CHAR && (uint8_t)c < SEVEN_SEGMENT_FIRST_CHAR + SEVEN_SEGMENT_CHAR_COUNT)
+        ? SEVEN_SEGMENT_FONT.glyphs[(uint8_t)c - SEVEN_SEGMENT_FIRST_CHAR]
+        : SEVEN_SEGMENT_BLANK;
+}
+
+// Text in Stellen zerlegen: ein Punkt nach einem Zeichen wird dessen Dezimalpunkt, sonst eine eigene
+// Stelle (leer mit Punkt). Schreibt höchstens maxCells Bytes nach cells, gibt die Anzahl Stellen zurück.
+inline size_t sevenSegmentLayout(const char* text, uint8_t* cells, size_t maxCells) {
+    size_t count = 0;
+    bool pointFree = false; // Hat die letzte Stelle noch keinen Punkt?
+    for (size_t i = 0; text[i] != '\0' && count < maxCells; i++) {
+        if (text[i] == '.' && pointFree) {
+            cells[count - 1] = sevenSegmentWithPoint(cells[count - 1]);
+            pointFree = false;
+        } else if (text[i] == '.') {
+            cells[count++] = sevenSegmentWithPoint(SEVEN_SEGMENT_BLANK);
+        } else {
+            cells[count++] = sevenSegmentGlyph(text[i]);
+            pointFree = true;
+        }
+    }
+    return count;
+}
+
+// --- Prüfungen des Zeichensatzes ---
+
+// Jedes Zeichen höchstens einmal beschrieben und im Bereich der Tabelle
+constexpr bool sevenSegmentGlyphsValid() {
+    size_t count = sizeof(SEVEN_SEGMENT_GLYPHS) / sizeof(SEVEN_SEGMENT_GLYPHS[0]);
+    for (size_t i = 0; i < count; i++) {
+        char c = SEVEN_SEGMENT_GLYPHS[i].character;
+        if ((uint8_t)c < SEVEN_SEGMENT_FIRST_CHAR || (uint8_t)c >= SEVEN_SEGMENT_FIRST_CHAR + SEVEN_SEGMENT_CHAR_COUNT || c == '.') {
+            return false;
+        }
+        for (size_t j = i + 1; j < count; j++) {
+            if (SEVEN_SEGMENT_GLYPHS[j].character == c) return false;
+        }
+    }
+    return true;
+}
+
+// Jeder Ausgang genau einem Segment zugeordnet
+constexpr bool sevenSegmentPinsValid() {
+    uint8_t used = 0;
+    for (uint8_t pin : SEVEN_SEGMENT_PINS) {
+        if (pin > 7 || (used & (1 << pin))) return false;
+        used |= 1 << pin;
+    }
+    return used == 0xFF;
+}
+
+static_assert(sevenSegmentGlyphsValid(), "7-Segment: Zeichen doppelt oder ausserhalb der Tabelle");
+static_assert(sevenSegmentPinsValid(), "7-Segment: Ausgänge doppelt belegt");
+// Bisherige, von Hand invertierte Werte der Ziffern, des Minus und des Dezimalpunkts (Bit 4)
+static_assert(sevenSegmentGlyph('0') == 24 && sevenSegmentGlyph('1') == 222 && sevenSegmentGlyph('2') == 52 &&
+              sevenSegmentGlyph('3') == 148 && sevenSegmentGlyph('4') == 210 && sevenSegmentGlyph('5') == 145 &&
+              sevenSegmentGlyph('6') == 17 && sevenSegmentGlyph('7') == 216 && sevenSegmentGlyph('8') == 16 &&
+              sevenSegmentGlyph('9') == 144, "7-Segment: Ziffern");
+static_assert(sevenSegmentGlyph('-') == 247 && sevenSegmentGlyph(' ') == SEVEN_SEGMENT_BLANK &&
+              sevenSegmentWithPoint(sevenSegmentGlyph('8')) == 0, "7-Segment: Minus, Leerzeichen, Punkt");
+static_assert(sevenSegmentGlyph('B') == sevenSegmentGlyph('b') && sevenSegmentGlyph('e') == sevenSegmentGlyph('E') &&
+              sevenSegmentGlyph('c') != sevenSegmentGlyph('C') && sevenSegmentGlyph('M') == SEVEN_SEGMENT_BLANK,
+              "7-Segment: Schreibweisen");
+
+#endif // SEVEN_SEGMENT_FONT_H
@@ -0,0 +1,60 @@
+#include "ButtonDecoder.h"
+
+ButtonDecoder::ButtonDecoder(const ButtonTiming& timing)
+  : _timing(timing), _rawPressed(false), _rawEdgeMs(0), _burstMicros(0),
+    _stablePressed(false), _pressStartMs(0), _pressMicros(0), _longPressReported(false),
+    _pressCount(0), _lastReleaseMs(0) {}
+
+void ButtonDecoder::onEdge(bool pressed, unsigned long timeMs, unsigned long timeMicros) {
+    if (_rawPressed == _stablePressed) {
+        _burstMicros = timeMicros; // Beginn eines neuen (Prell-)Vorgangs
+    }
+    _rawPressed = pressed;
+    _rawEdgeMs = timeMs;
+}
+
+bool ButtonDecoder::update(unsigned long nowMs, ButtonEvent& event) {
+    if (_rawPressed != _stablePressed && nowMs - _rawEdgeMs >= _timing.debounceMs) {
+        _stablePressed = _rawPressed;
+        if (_stablePressed) {
+            _pressStartMs = _rawEdgeMs;
+            _pressMicros = _burstMicros;
+            _longPressReported = false;
+        } else if (!_longPressReported) {
+            // Kurzer Druck: beim Loslassen melden, damit ein langer Druck nicht zusätzlich als kurzer zählt
+            bool continues = _pressCount > 0 && _pressCount < UINT8_MAX && _pressStartMs - _lastReleaseMs <= _timing.multiPressMs;
+            _pressCount = continues ? _pressCount + 1 : 1;
+            _lastReleaseMs = _rawEdgeMs;
+            event.type = BUTTON_EVENT_PRESS;
+            event.count = _pressCount;
+            event.edgeMicros = _burstMicros;
+            return true;
+        } else {
+            _pressCount = 0; // Ein langer Druck beendet jeden Mehrfachdruck
+        }
+    }
+
+    if (_stablePressed && !_longPressReported && nowMs - _pressStartMs >= _timing.longPressMs) {
+        _longPressReported = true;
+        event.type = BUTTON_EVENT_LONG_PRESS;
+        event.count = 1;
+        // Die Latenz zählt ab dem Erreichen der Schwelle, nicht ab dem Drücken
+        event.edgeMicros = _pressMicros + _timing.longPressMs * 1000UL;
+        return true;
+    }
+    return false;
+}
+
+bool ButtonDecoder::nextUpdate(unsigned long nowMs, unsigned long& delayMs) const {
+    if (_rawPressed != _stablePressed) {
+        unsigned long elapsed = nowMs - _rawEdgeMs;
+        delayMs = elapsed >= _timing.debounceMs ? 0 : _timing.debounceMs - elapsed;
+        return true;
+    }
+    if (_stablePressed && !_longPressReported) {
+        unsigned long elapsed = nowMs - _pressStartMs;
+        delayMs = elapsed >= _timing.longPressMs ? 0 : _timing.longPressMs - elapsed;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,64 @@
+#ifndef BUTTON_DECODER_H
+#define BUTTON_DECODER_H
+
+#include <stdint.h>
+
+// Art eines Tastenereignisses
+enum ButtonEventType {
+    BUTTON_EVENT_PRESS,         // Kurzer Druck (beim Loslassen), count zählt schnell aufeinanderfolgende Drücke
+    BUTTON_EVENT_LONG_PRESS     // Taste länger als longPressMs gedrückt (noch während sie gehalten wird)
+};
+
+// Ereignis einer Taste
+struct ButtonEvent {
+    uint8_t button;             // Index der Taste (Reihenfolge bei ButtonInput::begin())
+    ButtonEventType type;
+    uint8_t count;              // 1 = einfacher, 2 = doppelter Druck usw. (bei LONG_PRESS immer 1)
+    unsigned long edgeMicros;   // Zeitpunkt der auslösenden Flanke (micros), für die Latenzmessung
+};
+
+// Zeitvorgaben für die Auswertung
+struct ButtonTiming {
+    unsigned long debounceMs;   // So lange muss ein Pegel stabil sein, bevor er gilt
+    unsigned long longPressMs;  // Ab dieser Dauer gilt ein Druck als langer Druck
+    unsigned long multiPressMs; // Maximale Pause zwischen Loslassen und erneutem Drücken bei einem Mehrfachdruck
+};
+
+// Wertet die rohen Flanken einer Taste aus: zeitbasierte Entprellung, langer Druck und Mehrfachdruck.
+// Reine Logik ohne Hardwarezugriff, die Zeiten werden von aussen übergeben (auf dem Host testbar).
+class ButtonDecoder {
+public:
+    // Ohne Zeitvorgaben nur als Platzhalter in statisch angelegten Tabellen (siehe ButtonInput)
+    explicit ButtonDecoder(const ButtonTiming& timing = ButtonTiming());
+
+    // Meldet eine rohe Flanke (auch Prellen), z.B. aus der Interrupt-Routine.
+    void onEdge(bool pressed, unsigned long timeMs, unsigned long timeMicros);
+
+    // Wertet den Zustand zum Zeitpunkt nowMs aus. Gibt true zurück, wenn ein Ereignis entstanden ist
+    // (button wird nicht gesetzt). Solange true zurückkommt, erneut aufrufen.
+    bool update(unsigned long nowMs, ButtonEvent& event);
+
+    // Gibt true und die Wartezeit bis zum nächsten nötigen update() zurück, wenn noch eine Auswertung
+    // aussteht (Entprellung oder langer Druck). Sonst false: erst die nächste Flanke ist wieder relevant.
+    bool nextUpdate(unsigned long nowMs, unsigned long& delayMs) const;
+
+    bool isPressed() const { return _stablePressed; }   // Entprellter Zustand
+    bool isRawPressed() const { return _rawPressed; }   // Zustand der letzten Flanke
+
+private:
+    ButtonTiming _timing;
+
+    bool _rawPressed;
+    unsigned long _rawEdgeMs;           // Letzte Flanke (Ende des Prellens abwarten)
+    unsigned long _burstMicros;         // Erste Flanke seit dem letzten stabilen Zustand (Latenz)
+
+    bool _stablePressed;
+    unsigned long _pressStartMs;
+    unsigned long _pressMicros;
+    bool _longPressReported;
+
+    uint8_t _pressCount;
+    unsigned long _lastReleaseMs;
+};
+
+#endif // BUTTON_DECODER_H
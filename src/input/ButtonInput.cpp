@@ -0,0 +1,84 @@
+#include "ButtonInput.h"
+#include <driver/gpio.h>
+
+ButtonInput::ButtonInput() : _count(0), _nextButton(0), _wakeFromIsr(nullptr), _handledDrops(0) {
+    for (int i = 0; i < BUTTON_MAX_COUNT; i++) {
+        _pins[i] = 0;
+    }
+}
+
+void ButtonInput::begin(const uint8_t* pins, int count, const ButtonTiming& timing, void (*wakeFromIsr)()) {
+    _wakeFromIsr = wakeFromIsr;
+    for (int i = 0; i < count && _count < BUTTON_MAX_COUNT; i++) {
+        _pins[_count] = pins[i];
+        _decoders[_count] = ButtonDecoder(timing);
+        pinMode(pins[i], INPUT_PULLUP);
+        // Zuerst auf LOW (gedrückt) warten. Ist die Taste beim Start schon gedrückt, löst der Interrupt sofort aus.
+        attachInterruptArg(pins[i], onInterrupt, (void*)(intptr_t)_count, ONLOW_WE);
+        _count++;
+    }
+}
+
+bool ButtonInput::poll(ButtonEvent& event) {
+    Edge edge;
+    while (_edges.pop(edge)) {
+        _decoders[edge.button].onEdge(edge.pressed, edge.timeMs, edge.timeMicros);
+    }
+    if (_edges.getDroppedCount() != _handledDrops) {
+        resync();
+    }
+
+    unsigned long now = millis();
+    for (int n = 0; n < _count; n++) {
+        int i = (_nextButton + n) % _count;
+        if (_decoders[i].update(now, event)) {
+            event.button = (uint8_t)i;
+            _nextButton = (i + 1) % _count;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ButtonInput::nextPoll(unsigned long& delayMs) const {
+    unsigned long now = millis();
+    bool pending = false;
+    for (int i = 0; i < _count; i++) {
+        unsigned long delay;
+        if (_decoders[i].nextUpdate(now, delay) && (!pending || delay < delayMs)) {
+            delayMs = delay;
+            pending = true;
+        }
+    }
+    return pending;
+}
+
+// Nach einer vollen Queue fehlen Flanken: den aktuellen Pegel als neue Flanke übernehmen,
+// damit keine Taste im Zustand "gedrückt" hängen bleibt.
+void ButtonInput::resync() {
+    _handledDrops = _edges.getDroppedCount();
+    for (int i = 0; i < _count; i++) {
+        bool pressed = digitalRead(_pins[i]) == LOW;
+        if (pressed != _decoders[i].isRawPressed()) {
+            _decoders[i].onEdge(pressed, millis(), micros());
+        }
+    }
+}
+
+// Interrupt-Routine. Der Interrupt ist nicht als IRAM-Interrupt registriert und wird während
+// Flash-Zugriffen (z.B. NVS) verzögert, deshalb ist kein IRAM_ATTR nötig.
+void ButtonInput::onInterrupt(void* arg) {
+    ButtonInput& input = getInstance();
+    int index = (int)(intptr_t)arg;
+    gpio_num_t pin = (gpio_num_t)input._pins[index];
+    bool pressed = gpio_get_level(pin) == 0;
+    // Auf den Gegenpegel umstellen, sonst löst der anliegende Pegel sofort wieder aus.
+    // gpio_wakeup_enable() setzt dabei auch den Interrupt-Typ.
+    gpio_wakeup_enable(pin, pressed ? GPIO_INTR_HIGH_LEVEL : GPIO_INTR_LOW_LEVEL);
+
+    Edge edge = { (uint8_t)index, pressed, millis(), micros() };
+    input._edges.push(edge);
+    if (input._wakeFromIsr != nullptr) {
+        input._wakeFromIsr();
+    }
+}
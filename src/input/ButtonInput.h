@@ -0,0 +1,63 @@
+#ifndef BUTTON_INPUT_H
+#define BUTTON_INPUT_H
+
+#include <Arduino.h>
+#include "ButtonDecoder.h"
+#include "../tasks/SpscQueue.h"
+
+// Maximale Anzahl Tasten
+const int BUTTON_MAX_COUNT = 4;
+
+// Rohe Flanken zwischen Interrupt und Task (Prellen eingeschlossen)
+const uint32_t BUTTON_EDGE_QUEUE_SIZE = 32;
+
+// Interrupt-gesteuerte Tasten (aktiv LOW mit Pull-up).
+// Jede Flanke wird in der Interrupt-Routine nur mit Zeitstempel in eine lock-freie Queue gelegt,
+// entprellt und ausgewertet wird in poll() in der konsumierenden Task.
+// Die Interrupts sind pegelgesteuert und werden nach jeder Flanke auf den Gegenpegel umgestellt.
+// So erkennen sie beide Flanken und wecken die CPU auch aus dem Light-Sleep (GPIO-Wakeup).
+class ButtonInput {
+public:
+    // Statische Methode, um die einzige Instanz zu erhalten (Singleton-Muster).
+    static ButtonInput& getInstance() {
+        static ButtonInput instance;
+        return instance;
+    }
+
+    // Richtet die Tasten und ihre Interrupts ein. wakeFromIsr wird in der Interrupt-Routine nach jeder
+    // Flanke aufgerufen (z.B. um die konsumierende Task zu wecken) und muss ISR-tauglich sein.
+    void begin(const uint8_t* pins, int count, const ButtonTiming& timing, void (*wakeFromIsr)());
+
+    // Liefert das nächste Ereignis. Nur aus einer Task aufrufen, solange true zurückkommt.
+    bool poll(ButtonEvent& event);
+
+    // Gibt true und die Wartezeit bis zum nächsten nötigen poll() zurück, wenn eine Auswertung aussteht.
+    bool nextPoll(unsigned long& delayMs) const;
+
+    uint32_t getDroppedEdgeCount() const { return _edges.getDroppedCount(); }
+
+private:
+    ButtonInput();
+    ButtonInput(const ButtonInput&) = delete;
+    ButtonInput& operator=(const ButtonInput&) = delete;
+
+    struct Edge {
+        uint8_t button;
+        bool pressed;
+        unsigned long timeMs;
+        unsigned long timeMicros;
+    };
+
+    uint8_t _pins[BUTTON_MAX_COUNT];
+    ButtonDecoder _decoders[BUTTON_MAX_COUNT];   // Statisch angelegt, begin() setzt die Zeitvorgaben
+    int _count;
+    int _nextButton;                // Reihum auswerten, damit keine Taste eine andere aushungert
+    void (*_wakeFromIsr)();
+    SpscQueue<Edge, BUTTON_EDGE_QUEUE_SIZE> _edges;
+    uint32_t _handledDrops;         // Verworfene Flanken, nach denen bereits neu synchronisiert wurde
+
+    void resync();
+    static void onInterrupt(void* arg);
+};
+
+#endif // BUTTON_INPUT_H
@@ -0,0 +1,57 @@
+#ifndef LED_MASK_H
+#define LED_MASK_H
+
+#include <stdint.h>
+
+const uint16_t LED_MASK_BITS = 128;     // Reicht für den ganzen Streifen (123 LEDs)
+
+// Menge von LEDs als Bitmaske (Bit i = LED i). Vollständig constexpr, damit ganze Tabellen
+// beim Übersetzen berechnet und im Flash abgelegt werden können.
+struct LedMask {
+    uint64_t bits[LED_MASK_BITS / 64];
+
+    constexpr LedMask() : bits{0, 0} {}
+
+    // Maske mit count aufeinanderfolgenden LEDs ab first
+    static constexpr LedMask range(uint16_t first, uint16_t count) {
+        LedMask mask;
+        for (uint16_t i = first; i < first + count && i < LED_MASK_BITS; i++) {
+            mask.bits[i / 64] |= (uint64_t)1 << (i % 64);
+        }
+        return mask;
+    }
+
+    constexpr void set(uint16_t index) {
+        if (index < LED_MASK_BITS) {
+            bits[index / 64] |= (uint64_t)1 << (index % 64);
+        }
+    }
+
+    constexpr bool test(uint16_t index) const {
+        return index < LED_MASK_BITS && (bits[index / 64] >> (index % 64)) & 1;
+    }
+
+    constexpr bool empty() const { return bits[0] == 0 && bits[1] == 0; }
+
+    constexpr LedMask operator|(const LedMask& other) const {
+        LedMask mask;
+        mask.bits[0] = bits[0] | other.bits[0];
+        mask.bits[1] = bits[1] | other.bits[1];
+        return mask;
+    }
+
+    constexpr LedMask operator&(const LedMask& other) const {
+        LedMask mask;
+        mask.bits[0] = bits[0] & other.bits[0];
+        mask.bits[1] = bits[1] & other.bits[1];
+        return mask;
+    }
+
+    constexpr bool operator==(const LedMask& other) const {
+        return bits[0] == other.bits[0] && bits[1] == other.bits[1];
+    }
+
+    constexpr bool operator!=(const LedMask& other) const { return !(*this == other); }
+};
+
+#endif // LED_MASK_H
@@ -1,5 +1,9 @@
+#ifndef LED_STRIP_H
+#define LED_STRIP_H
+
 #include <FastLED.h>
-#include "Settings.h"
+#include <string.h>
+#include "hal/LedOutput.h"
 
 /*
   ___________________________
@@ -32,17 +36,33 @@
   |   1             1      _ |
   |__________________________|
 
+  Zeilen und Spalten des Buchstabenrasters (11 x 10) auf dem Streifen: display/LetterMatrix.h
 */
 
-// Definiere die LED-Streifen-Variable
-CRGB leds[NUM_LEDS];
-
+// LED-Streifen (WS2812B) an Pin mit Count LEDs, ausgegeben über den RMT-Kanal Channel (im Simulator SimHardware).
+// Der Puffer ist Teil des Objekts, das Objekt wird statisch angelegt. Der Konstruktor greift nicht auf die
+// Hardware zu, erst begin() richtet die Ausgabe ein. Die Setter ändern nur den Puffer, show() übergibt ihn als ein
+// Frame an die Ausgabe und nur, wenn er sich seit dem letzten gesendeten Frame geändert hat (Vergleich mit einer
+// Kopie, inklusive Helligkeit). Die Ausgabe sendet im Hintergrund, show() wartet nicht auf das Ende.
+template <uint8_t Pin, uint16_t Count, uint8_t Channel>
 class LedStrip {
 public:
-    // Konstruktor: Initialisiert den LED-Streifen
-    LedStrip(int pin, int numLeds) {
-        FastLED.addLeds<WS2812B, LED_PIN, GRB>(leds, numLeds);
+    static_assert(Count > 0, "LED-Streifen ohne LEDs");
+
+    LedStrip() : _output(Channel) {}
+
+    static constexpr uint16_t count() { return Count; }
+
+    // Ausgabe einrichten und alle LEDs ausschalten
+    void begin() {
+        _output.begin(Pin);
         clearAll(); // Alle LEDs beim Start ausschalten
+        if (_output.write(_leds, _brightness, false)) {
+            _output.waitIdle();
+            memcpy(_shown, _leds, sizeof(_leds));
+            _shownBrightness = _brightness;
+            _shownFrames++;
+        }
     }
 
     // Methode zum Ansteuern einer einzelnen LED
@@ -51,9 +71,8 @@ public:
     // @param g: Grün-Wert (0-255)
     // @param b: Blau-Wert (0-255)
     void setSingleLED(int index, byte r, byte g, byte b) {
-        if (index >= 0 && index < NUM_LEDS) {
-            leds[index] = CRGB(r, g, b);
-            FastLED.show();
+        if (index >= 0 && index < Count) {
+            _leds[index] = CRGB(r, g, b);
         }
     }
 
@@ -63,16 +82,18 @@ public:
     // @param r: Rot-Wert (0-255)
     // @param g: Grün-Wert (0-255)
     // @param b: Blau-Wert (0-255)
-    void setGroupLEDs(int startIndex, int count, byte r, byte g, byte b, boolean show = true) {
+    void setGroupLEDs(int startIndex, int count, byte r, byte g, byte b) {
         for (int i = 0; i < count; i++) {
             int currentLEDIndex = startIndex + i;
-            if (currentLEDIndex >= 0 && currentLEDIndex < NUM_LEDS) {
-                leds[currentLEDIndex] = CRGB(r, g, b);
+            if (currentLEDIndex >= 0 && currentLEDIndex < Count) {
+                _leds[currentLEDIndex] = CRGB(r, g, b);
             }
         }
-        if(show) {
-            FastLED.show();
-        }
+    }
+
+    // Ganzes Frame (Count LEDs) in den Puffer übernehmen
+    void setFrame(const CRGB* frame) {
+        memcpy(_leds, frame, sizeof(_leds));
     }
 
     // Methode zum Ausschalten einer einzelnen LED
@@ -81,18 +102,76 @@ public:
     }
 
     // Methode zum Ausschalten einer Gruppe von LEDs
-    void clearGroupLEDs(int index, int count, boolean show = true){
-      setGroupLEDs(index, count, 0, 0, 0, show);
+    void clearGroupLEDs(int index, int count){
+      setGroupLEDs(index, count, 0, 0, 0);
     }
 
     // Methode zum Ausschalten aller LEDs
     void clearAll() {
-        FastLED.clear();
-        FastLED.show();
+        setGroupLEDs(0, Count, 0, 0, 0);
+    }
+
+    // Erwartet den Faktor der Helligkeit in 16 Bit (LED_BRIGHTNESS_TABLE). Wirkt mit dem nächsten show().
+    void setBrightness(uint16_t scale){
+        _brightness = scale;
+    }
+
+    // Zeitliches Dithering erlauben. Es wirkt nur bei geringer Helligkeit (unter LED_DITHER_SCALE_LIMIT).
+    void setDithering(bool enable) { _dithering = enable; }
+
+    // Wirkt das Dithering? Dann muss laufend neu gesendet werden, auch wenn der Puffer gleich bleibt.
+    bool isDithering() const {
+        return _dithering && _brightness > 0 && _brightness < LED_DITHER_SCALE_LIMIT;
+    }
+
+    // Übergibt den Puffer an die Ausgabe, falls er sich vom zuletzt gesendeten Frame unterscheidet.
+    // true, wenn eine Übertragung gestartet wurde. Ist die Ausgabe noch belegt, wird das Frame verworfen
+    // und beim nächsten show() erneut versucht (vorher isBusy() prüfen oder waitIdle() aufrufen).
+    bool show() {
+        bool dither = isDithering();
+        if (!dither && _brightness == _shownBrightness && memcmp(_shown, _leds, sizeof(_leds)) == 0) {
+            _unchangedFrames++;
+            return false;
+        }
+        if (!_output.write(_leds, _brightness, dither)) {
+            return false;
+        }
+        memcpy(_shown, _leds, sizeof(_leds));
+        _shownBrightness = _brightness;
+        _shownFrames++;
+        return true;
     }
 
-    // Erwartet eine Helligkeit von 0-255
-    void setBrightness(int brightness){
-        FastLED.setBrightness(brightness);
+    // Läuft noch eine Übertragung?
+    bool isBusy() const { return _output.isBusy(); }
+
+    // Auf das Ende der laufenden Übertragung warten
+    void waitIdle() { _output.waitIdle(); }
+
+    uint32_t getShownFrames() const { return _shownFrames; }         // Gesendete Frames
+    uint32_t getUnchangedFrames() const { return _unchangedFrames; } // Nicht gesendet, da identisch
+    uint32_t getDroppedFrames() const { return _output.getDroppedFrames(); }     // Ausgabe belegt
+    uint64_t getBlockedMicros() const { return _output.getBlockedMicros(); }     // Zeit in show() und waitIdle()
+    uint32_t getMaxBlockedMicros() const { return _output.getMaxBlockedMicros(); }
+
+    // Anteil des grössten LED-Stroms (alle LEDs weiss bei voller Helligkeit), 0-1. Für das Wärmemodell.
+    float getDriveLevel() const {
+        uint32_t sum = 0;
+        for (int i = 0; i < Count; i++) {
+            sum += _leds[i].r + _leds[i].g + _leds[i].b;
+        }
+        return (float)sum / (Count * 765.0f) * (_brightness / 65535.0f);
     }
+
+private:
+    CRGB _leds[Count];
+    CRGB _shown[Count];             // Zuletzt gesendetes Frame
+    uint16_t _brightness = 65535;
+    uint16_t _shownBrightness = 0;
+    bool _dithering = false;
+    LedOutput<Count> _output;
+    uint32_t _shownFrames = 0;
+    uint32_t _unchangedFrames = 0;
 };
+
+#endif // LED_STRIP_H
@@ -0,0 +1,80 @@
+#ifndef LED_TABLES_H
+#define LED_TABLES_H
+
+#include <stdint.h>
+
+// Helligkeit der LEDs als Tabellen, beim Übersetzen berechnet. Die Helligkeit wirkt als Faktor in 16 Bit
+// (0-65535 entspricht 0-1): so bleibt auch bei geringer Helligkeit ein Nachkommaanteil, den die Ausgabe
+// über mehrere Frames verteilen kann (zeitliches Dithering).
+
+const uint16_t LED_MIN_SCALE = 257;             // Kleinste Helligkeit > 0: ein Schritt bei voller Farbe (255 * 258 >> 16 = 1)
+const uint16_t LED_DITHER_SCALE_LIMIT = 16384;  // Unter 1/4 der Leistung sind die 8-Bit-Stufen sichtbar: dort dithern
+const uint8_t LED_DITHER_STEPS = 8;
+
+// x^(1/5) für 0 <= x <= 1 (Newton-Verfahren, da pow() nicht constexpr ist)
+constexpr double ledFifthRoot(double x) {
+    if (x <= 0.0) return 0.0;
+    double y = 1.0;
+    for (int i = 0; i < 60; i++) {
+        y = (4.0 * y + x / (y * y * y * y)) / 5.0;
+    }
+    return y;
+}
+
+// Gammakurve: wahrgenommene Helligkeit x (0-1) -> Leistung x^2.2 = x^2 * x^(1/5)
+constexpr double ledGamma(double x) {
+    return x * x * ledFifthRoot(x);
+}
+
+// Helligkeit 0-100 % (wahrgenommen) -> Faktor in 16 Bit
+struct LedBrightnessTable {
+    uint16_t scale[101];
+};
+
+constexpr LedBrightnessTable buildLedBrightnessTable() {
+    LedBrightnessTable table = {};
+    for (int percent = 0; percent <= 100; percent++) {
+        double value = ledGamma(percent / 100.0) * 65535.0 + 0.5;
+        uint16_t scale = (uint16_t)value;
+        if (percent > 0 && scale < LED_MIN_SCALE) {
+            scale = LED_MIN_SCALE;
+        }
+        table.scale[percent] = scale;
+    }
+    return table;
+}
+
+constexpr LedBrightnessTable LED_BRIGHTNESS_TABLE = buildLedBrightnessTable();
+
+// Schwellen des Ditherings pro Frame (0-255, bitumgekehrte Reihenfolge): der Nachkommaanteil eines
+// Kanals wird in so vielen der LED_DITHER_STEPS Frames aufgerundet, wie er gross ist
+constexpr uint8_t LED_DITHER_THRESHOLDS[LED_DITHER_STEPS] = { 16, 144, 80, 208, 48, 176, 112, 240 };
+
+// Kanal (0-255) mit Faktor (16 Bit) skalieren, der Nachkommaanteil wird mit der Schwelle gerundet
+// (threshold 255 = abschneiden)
+inline uint8_t ledScale(uint8_t value, uint16_t scale, uint8_t threshold) {
+    uint32_t scaled = (uint32_t)value * ((uint32_t)scale + 1);
+    uint8_t result = scaled >> 16;
+    uint8_t fraction = (scaled >> 8) & 0xFF;
+    if (fraction > threshold && result < 255) {
+        result++;
+    }
+    return result;
+}
+
+// Frame mit Faktor und Schwelle (siehe ledScale) in GRB-Reihenfolge nach out kodieren, 3 Bytes pro LED.
+// Pixel braucht die Kanäle r, g und b (z.B. CRGB), so kommt die Kodierung ohne FastLED aus.
+template <typename Pixel>
+inline void ledEncodeGrb(const Pixel* leds, uint16_t count, uint16_t scale, uint8_t threshold, uint8_t* out) {
+    for (uint16_t i = 0; i < count; i++) {
+        *out++ = ledScale(leds[i].g, scale, threshold);
+        *out++ = ledScale(leds[i].r, scale, threshold);
+        *out++ = ledScale(leds[i].b, scale, threshold);
+    }
+}
+
+static_assert(LED_BRIGHTNESS_TABLE.scale[0] == 0 && LED_BRIGHTNESS_TABLE.scale[100] == 65535, "Helligkeit: Endpunkte");
+static_assert(LED_BRIGHTNESS_TABLE.scale[1] == LED_MIN_SCALE, "Helligkeit: kleinste Stufe");
+static_assert(LED_BRIGHTNESS_TABLE.scale[50] > 14000 && LED_BRIGHTNESS_TABLE.scale[50] < 14300, "Helligkeit: 50 % ~ 0.5^2.2");
+
+#endif // LED_TABLES_H
@@ -0,0 +1,169 @@
+#ifndef RMT_LED_OUTPUT_H
+#define RMT_LED_OUTPUT_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <driver/rmt.h>
+#include "LedTables.h"
+
+// Logger
+#include "logger/Logger.h"
+#include "logger/LogLevel.h"
+
+// WS2812B-Timing in Takten des RMT (APB 80 MHz / RMT_LED_CLOCK_DIVIDER = 25 ns pro Takt)
+const uint8_t RMT_LED_CLOCK_DIVIDER = 2;
+const uint16_t RMT_LED_T0H = 16;            // 0.40 µs
+const uint16_t RMT_LED_T0L = 34;            // 0.85 µs
+const uint16_t RMT_LED_T1H = 32;            // 0.80 µs
+const uint16_t RMT_LED_T1L = 18;            // 0.45 µs
+const uint32_t RMT_LED_RESET_MICROS = 80;   // Pause nach einem Frame, damit die LEDs übernehmen (> 50 µs)
+const uint8_t RMT_LED_MEM_BLOCKS = 2;       // Speicherblöcke des Kanals (weniger Nachladen im Interrupt)
+
+// Übertragung eines Frames an WS2812B-LEDs über den RMT, ohne auf das Ende zu warten.
+// Zwei Puffer: der vordere wird gesendet (der RMT-Treiber übersetzt ihn im Interrupt nach und nach in Pulse),
+// der hintere nimmt das nächste Frame auf. write() kopiert das Frame mit Helligkeit in GRB-Reihenfolge in den
+// hinteren Puffer, startet die Übertragung und kehrt sofort zurück. Mit Dithering wird der Nachkommaanteil der
+// Helligkeit reihum über LED_DITHER_STEPS Frames aufgerundet. Das Ende meldet der Interrupt (isBusy()).
+// Während der Übertragung hält der RMT-Treiber selbst eine APB-Sperre, Takt und Light-Sleep stören also nicht.
+template <uint16_t Count>
+class RmtLedOutput {
+public:
+    explicit RmtLedOutput(uint8_t channel)
+      : _channel((rmt_channel_t)channel), _front(0), _ditherStep(0), _ready(false), _busy(false), _endMicros(0),
+        _sent(0), _completed(0), _dropped(0), _blockedMicros(0), _maxBlockedMicros(0) {}
+
+    // RMT-Kanal einrichten. Ohne Erfolg bleibt die Ausgabe aus (write() liefert false).
+    bool begin(uint8_t pin) {
+        rmt_config_t config = {};
+        config.rmt_mode = RMT_MODE_TX;
+        config.channel = _channel;
+        config.gpio_num = (gpio_num_t)pin;
+        config.clk_div = RMT_LED_CLOCK_DIVIDER;
+        config.mem_block_num = RMT_LED_MEM_BLOCKS;
+        config.tx_config.carrier_en = false;
+        config.tx_config.loop_en = false;
+        config.tx_config.idle_output_en = true;
+        config.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+
+        if (rmt_config(&config) != ESP_OK || rmt_driver_install(_channel, 0, 0) != ESP_OK ||
+            rmt_translator_init(_channel, translate) != ESP_OK) {
+            Logger::log(LogLevel::Error, "LED-Streifen: RMT-Kanal " + String((int)_channel) + " konnte nicht eingerichtet werden!");
+            return false;
+        }
+        _instance = this;
+        rmt_register_tx_end_callback(onTransmitEnd, nullptr);
+        _ready = true;
+        return true;
+    }
+
+    // Läuft noch eine Übertragung (inklusive Reset-Pause)?
+    bool isBusy() const {
+        return _busy || (uint32_t)(micros() - _endMicros) < RMT_LED_RESET_MICROS;
+    }
+
+    // Frame übergeben und die Übertragung starten. Ist der Kanal noch belegt, wird das Frame verworfen (false).
+    // scale: Helligkeit in 16 Bit (LedTables.h)
+    bool write(const CRGB* leds, uint16_t scale, bool dither) {
+        if (!_ready || isBusy()) {
+            _dropped++;
+            return false;
+        }
+        uint32_t start = micros();
+        uint8_t back = _front ^ 1;
+        uint8_t threshold = 255;
+        if (dither) {
+            threshold = LED_DITHER_THRESHOLDS[_ditherStep];
+            _ditherStep = (_ditherStep + 1) % LED_DITHER_STEPS;
+        }
+        ledEncodeGrb(leds, Count, scale, threshold, _buffers[back]);
+        _front = back;
+        _busy = true;
+        if (rmt_write_sample(_channel, _buffers[_front], sizeof(_buffers[_front]), false) != ESP_OK) {
+            _busy = false;
+            _dropped++;
+            return false;
+        }
+        _sent++;
+        addBlocked(micros() - start);
+        return true;
+    }
+
+    // Blockiert bis zum Ende der laufenden Übertragung (Start, Tests)
+    void waitIdle() {
+        if (!_ready || !isBusy()) {
+            return;
+        }
+        uint32_t start = micros();
+        rmt_wait_tx_done(_channel, portMAX_DELAY);
+        while (isBusy()) {
+            delayMicroseconds(10); // Reset-Pause
+        }
+        addBlocked(micros() - start);
+    }
+
+    uint32_t getSentFrames() const { return _sent; }
+    uint32_t getCompletedFrames() const { return _completed; }     // Vom Interrupt gemeldet
+    uint32_t getDroppedFrames() const { return _dropped; }         // Kanal belegt oder Fehler beim Start
+    uint64_t getBlockedMicros() const { return _blockedMicros; }   // Summe der Zeit in write() und waitIdle()
+    uint32_t getMaxBlockedMicros() const { return _maxBlockedMicros; }
+
+private:
+    rmt_channel_t _channel;
+    uint8_t _buffers[2][Count * 3];
+    uint8_t _front;                     // Puffer der laufenden bzw. letzten Übertragung
+    uint8_t _ditherStep;
+    bool _ready;
+    volatile bool _busy;
+    volatile uint32_t _endMicros;
+    uint32_t _sent;
+    volatile uint32_t _completed;
+    uint32_t _dropped;
+    uint64_t _blockedMicros;
+    uint32_t _maxBlockedMicros;
+
+    // Der Treiber kennt nur einen Callback für alle Kanäle, der LED-Streifen ist der einzige Nutzer des RMT
+    static RmtLedOutput* _instance;
+
+    void addBlocked(uint32_t micros) {
+        _blockedMicros += micros;
+        if (micros > _maxBlockedMicros) {
+            _maxBlockedMicros = micros;
+        }
+    }
+
+    // Interrupt: Übertragung beendet
+    static void IRAM_ATTR onTransmitEnd(rmt_channel_t channel, void*) {
+        RmtLedOutput* output = _instance;
+        if (output != nullptr && channel == output->_channel) {
+            output->_endMicros = micros();
+            output->_busy = false;
+            output->_completed++;
+        }
+    }
+
+    // Interrupt: Bytes in RMT-Pulse übersetzen (MSB zuerst), so viele wie der Treiber gerade Platz hat
+    static void IRAM_ATTR translate(const void* source, rmt_item32_t* destination, size_t sourceSize,
+                                    size_t wantedCount, size_t* translatedSize, size_t* itemCount) {
+        rmt_item32_t bit0 = {};
+        bit0.duration0 = RMT_LED_T0H; bit0.level0 = 1; bit0.duration1 = RMT_LED_T0L; bit0.level1 = 0;
+        rmt_item32_t bit1 = {};
+        bit1.duration0 = RMT_LED_T1H; bit1.level0 = 1; bit1.duration1 = RMT_LED_T1L; bit1.level1 = 0;
+
+        const uint8_t* bytes = (const uint8_t*)source;
+        size_t size = 0;
+        size_t count = 0;
+        while (size < sourceSize && count + 8 <= wantedCount) {
+            for (int bit = 7; bit >= 0; bit--) {
+                destination[count++].val = (bytes[size] & (1 << bit)) ? bit1.val : bit0.val;
+            }
+            size++;
+        }
+        *translatedSize = size;
+        *itemCount = count;
+    }
+};
+
+template <uint16_t Count>
+RmtLedOutput<Count>* RmtLedOutput<Count>::_instance = nullptr;
+
+#endif // RMT_LED_OUTPUT_H
@@ -1,27 +1,32 @@
 #include "Logger.h" // Eigenen Header inkludieren
-#include "../webservice/ntp/NTPTimeSync.h" // Hier ist die vollständige Definition von NTPTimeSync notwendig,
-                                      // da NTPTimeSync* _staticTimeSync tatsächlich verwendet wird (Methodenaufruf).
+#include <TimeLib.h>                          // Nur breakTime(), die globale Zeit von TimeLib wird nicht gesetzt
+#include "../events/Topic.h"                  // Hier ist die vollständige Definition von Topic notwendig,
+#include "../clock/LocalClock.h"              // da _clockTopic tatsächlich gelesen wird.
 
 // --- DEFINITION UND INITIALISIERUNG DER STATISCHEN MEMBER-VARIABLEN ---
-NTPTimeSync* Logger::_staticTimeSync = nullptr;
+const Topic<LocalClock>* Logger::_clockTopic = nullptr;
 LogLevel Logger::_outputLogLevel = LogLevel::Info; // Standardwert setzen, z.B. Info
 
-// Implementierung der setup() Methode (ohne TimeSync)
+// Schützt die Ausgabe, damit sich Zeilen aus verschiedenen Tasks nicht vermischen.
+static SemaphoreHandle_t loggerMutex = xSemaphoreCreateMutex();
+
+// Implementierung der setup() Methode (ohne Uhr)
 void Logger::setup(LogLevel outputLevel) {
   static bool serialInitialized = false;
   if (!serialInitialized) {
+    // Nicht auf den seriellen Monitor warten, das würde den Start verzögern.
+    // Im Debug-Modus wartet setup() vorher selbst darauf.
     Serial.begin(9600);
-    while (!Serial && millis() < 5000);
     serialInitialized = true;
   }
-  _staticTimeSync = nullptr; // Sicherstellen, dass es initial nullptr ist
+  _clockTopic = nullptr; // Sicherstellen, dass es initial nullptr ist
   Logger::setOutputLogLevel(outputLevel);
 }
 
-// Implementierung der setup() Methode (mit TimeSync)
-void Logger::setup(LogLevel outputLevel, NTPTimeSync* timeSync) {
+// Implementierung der setup() Methode (mit Uhr)
+void Logger::setup(LogLevel outputLevel, const Topic<LocalClock>& clockTopic) {
   Logger::setup(outputLevel); // Ruft die erste setup()-Methode auf, um Serial zu initialisieren (falls nötig)
-  _staticTimeSync = timeSync; // Setzt den TimeSync-Zeiger
+  _clockTopic = &clockTopic;  // Setzt den Zeiger auf die Uhr
 }
 
 // Implementierung der setOutputLogLevel() Methode
@@ -41,31 +46,38 @@ void Logger::log(LogLevel level, const String& message) {
     return; // Nachricht verwerfen
   }
 
-  if (_staticTimeSync != nullptr) {
-    _staticTimeSync->update(); // Zeit aktualisieren
-    time_t epochTime = _staticTimeSync->getEpochTime();
-    setTime(epochTime); // TimeLib's Zeit setzen
-
-    String dateString = "";
-    dateString += String(day());
-    dateString += ".";
-    dateString += String(month());
-    dateString += ".";
-    dateString += String(year());
-
-    String formattedTime = _staticTimeSync->getFormattedTime();
+  // Uhr vor dem Mutex lesen: Topic::read() nimmt selbst einen Mutex und ruft den Logger nie auf.
+  // Ungültig, solange weder NTP noch ein Warmstart eine Zeit geliefert hat.
+  LocalClock clock;
+  bool timeValid = _clockTopic != nullptr && _clockTopic->read(clock) && clock.isValid();
 
-    Serial.print(dateString);
-    Serial.print(" ");
-    Serial.print(formattedTime);
-    Serial.print(" - ");
+  // Die Zeile wird vollständig zusammengesetzt und mit einem einzigen Aufruf ausgegeben,
+  // damit sich Meldungen aus verschiedenen Tasks nicht vermischen.
+  String line;
+  if (timeValid) {
+    // Kein Zugriff auf NTPClient hier: Die Netzwerk-Task stellt die Uhr, die sie
+    // danach selbst mit millis() und der gemessenen Drift fortschreibt.
+    tmElements_t time;
+    breakTime(clock.now(millis()), time);
+    char stamp[24];
+    snprintf(stamp, sizeof(stamp), "%d.%d.%d %02d:%02d:%02d - ", time.Day, time.Month, tmYearToCalendar(time.Year),
+             time.Hour, time.Minute, time.Second);
+    line += stamp;
   } else {
-    Serial.print("[NO TIME] - ");
+    line += "[NO TIME] - ";
   }
 
-  Serial.print(Logger::getLevelName(level));
-  Serial.print(" : ");
-  Serial.println(message);
+  line += Logger::getLevelName(level);
+  line += " : ";
+  line += message;
+
+  if (loggerMutex != nullptr) {
+    xSemaphoreTake(loggerMutex, portMAX_DELAY);
+  }
+  Serial.println(line);
+  if (loggerMutex != nullptr) {
+    xSemaphoreGive(loggerMutex);
+  }
 }
 
 // Implementierung der getLevelName() Hilfsfunktion
@@ -2,21 +2,22 @@
 #define LOGGER_H
 
 #include <Arduino.h>
-#include <TimeLib.h>         // Für Datumsumrechnung aus Epoch-Zeit
 #include "LogLevel.h"        // Dein Enum LogLevel
 
-// --- FORWARD DECLARATION für die NTPTimeSync-Klasse ---
-// Da Logger nur einen Zeiger auf NTPTimeSync speichert und statische Methoden aufruft,
-// reicht eine Forward Declaration aus, um zirkuläre Abhängigkeiten zu vermeiden.
-class NTPTimeSync;
+// --- FORWARD DECLARATION für die Uhr ---
+// Logger speichert nur einen Zeiger auf das Topic mit der Uhr, eine Forward Declaration
+// reicht aus, um zirkuläre Abhängigkeiten (EventBus verwendet den Logger) zu vermeiden.
+class LocalClock;
+template <typename T> class Topic;
 
 class Logger {
 public:
   // Setup Methode bevor das NTPTimeSync vorhanden ist
   static void setup(LogLevel outputLevel);
 
-  // Setup Methode nachdem das NTPTimeSync vorhanden ist
-  static void setup(LogLevel outputLevel, NTPTimeSync* timeSync);
+  // Setup Methode mit Uhr für den Zeitstempel. Der Logger liest nur die Kopie aus dem Topic,
+  // da er aus allen Tasks aufgerufen wird und NTPClient bzw. TimeLib nicht threadsicher sind.
+  static void setup(LogLevel outputLevel, const Topic<LocalClock>& clockTopic);
 
   // Methode zum Setzen des maximalen LogLevels für die Ausgabe
   static void setOutputLogLevel(LogLevel level);
@@ -26,7 +27,7 @@ public:
 
 private:
   // Statische Member-Variable (kein Objekt wird erstellt)
-  static NTPTimeSync* _staticTimeSync;
+  static const Topic<LocalClock>* _clockTopic;
 
   // Statische Member-Variable für das globale Ausgabeloglevel
   static LogLevel _outputLogLevel;
@@ -6,23 +6,44 @@
 #include "logger/Logger.h"
 #include "logger/LogLevel.h"
 
+#include "hardware/HardwareConfig.h"
+#include "hardware/OptionalDevice.h"
 #include "i2cbus/sensor/TempHumi.h"
 #include "i2cbus/sensor/AirQuality.h"
 #include "webservice/api/weather/WeatherClient.h"
 #include "webservice/api/pollen/PollenClient.h"
 #include "webservice/configuration/ConfigurationPortal.h"
 #include "webservice/ntp/NTPTimeSync.h"
+#include "webservice/coap/CoapServer.h"
+#include "webservice/wifi/WifiManager.h"
+#include "status/DeviceStatus.h"
+#include "status/DeviceSnapshot.h"
+#include "status/WarmBootSnapshot.h"
+#include "boot/BootSequence.h"
+#include "health/HealthSupervisor.h"
+#include "i2cbus/I2cBusRecovery.h"
+#include "scheduler/Scheduler.h"
+#include "tasks/SchedulerTask.h"
+#include "tasks/Mailbox.h"
+#include "tasks/MessageQueue.h"
+#include "tasks/TaskMessages.h"
+#include "events/EventBus.h"
+#include "clock/LocalClock.h"
+#include "thermal/ThermalModel.h"
+#include "power/PowerManager.h"
+#include "input/ButtonInput.h"
+#include "menu/DeviceMenu.h"
 #include "display/UpdateDisplay.h"
 
-#include "Settings.h" // Enthält AP_SSID, AP_PASSWORD, BUTTON_A/B/C, PCF_ADDRESSES etc.
+#include "Settings.h" // Enthält AP_SSID, AP_PASSWORD, Intervalle etc.
 
-// Lokale Speicher für API-Daten
-WeatherData currentWeatherData;
-PollenData currentPollenData;
+// Fehlerzähler und Zeitstatus. Die Zähler der Sensoren schreibt die Anzeige-Task,
+// die Zähler der Netzwerkdienste die Netzwerk-Task, gelesen wird über CoAP und den Snapshot.
+Mailbox<DeviceStatus> deviceStatus;
 
-// Feuchtigkeitssensor
-TempHumi* tempHumi;
-AirQuality* airQuality;
+// Innensensoren, je nach Hardware-Beschreibung verbaut (siehe hardware/HardwareConfig.h)
+OptionalDevice<TempHumi, TEMP_HUMI_PRESENT> tempHumi(TEMP_HUMI_ADDRESS);
+OptionalDevice<AirQuality, AIR_QUALITY_PRESENT> airQuality(&Wire, AIR_QUALITY_ADDRESS);
 
 // Zustände des Geräts
 enum DeviceState {
@@ -35,140 +56,440 @@ enum DeviceState {
 
 DeviceState currentState = STATE_INITIALIZING; // Startzustand
 
-// Globale Konfigurationsinstanz, die alle Einstellungen enthält
-AppConfig currentDeviceConfig;
-
 // Anzeige auf dem Display
-UpdateDisplay* updateDisplay;
+UpdateDisplay updateDisplay;
+
+// --- Tasks ---
+// Netzwerk-Task auf Kern 0 (dort läuft auch der WLAN-Stack): Webserver, CoAP, WLAN, APIs und NTP.
+// Anzeige-Task auf Kern 1: I2C-Sensoren, 7-Segment-Anzeigen, LED-Streifen und MP3-Player.
+// Die Anzeige-Task hat die höhere Priorität, damit TLS-Handshakes oder Webanfragen die Anzeige nicht verzögern.
+// Jede Task hat einen eigenen Scheduler, Jobs werden nur innerhalb ihrer Task geplant.
+Scheduler networkScheduler(millis, micros);
+Scheduler displayScheduler(millis, micros);
+SchedulerTask networkTask("network", networkScheduler, NETWORK_TASK_STACK_SIZE, NETWORK_TASK_PRIORITY, NETWORK_TASK_CORE);
+SchedulerTask displayTask("display", displayScheduler, DISPLAY_TASK_STACK_SIZE, DISPLAY_TASK_PRIORITY, DISPLAY_TASK_CORE);
+Scheduler healthScheduler(millis, micros);
+SchedulerTask healthTask("health", healthScheduler, HEALTH_TASK_STACK_SIZE, HEALTH_TASK_PRIORITY, HEALTH_TASK_CORE);
+
+// Jobs der Netzwerk-Task
+JobId jobClientPoll = SCHEDULER_INVALID_JOB;      // Webserver und CoAP-Anfragen bearbeiten
+JobId jobStateMachine = SCHEDULER_INVALID_JOB;    // Zustandsautomat (WLAN)
+JobId jobTimeSync = SCHEDULER_INVALID_JOB;        // NTP aktualisieren und Uhrzeit bereitstellen
+JobId jobWeather = SCHEDULER_INVALID_JOB;         // Wetter-API
+JobId jobPollen = SCHEDULER_INVALID_JOB;          // Pollen-API
+JobId jobNetworkStats = SCHEDULER_INVALID_JOB;    // Statistik der Netzwerk-Task ausgeben
+JobId jobPower = SCHEDULER_INVALID_JOB;           // Energiezustand bestimmen
+JobId jobNetworkMessages = SCHEDULER_INVALID_JOB; // Nachrichten der Anzeige-Task (Menü) und Ereignisse verarbeiten
+
+// Jobs der Anzeige-Task
+JobId jobDisplayMessages = SCHEDULER_INVALID_JOB; // Nachrichten der Netzwerk-Task und Ereignisse verarbeiten
+JobId jobSensors = SCHEDULER_INVALID_JOB;         // Innensensoren auslesen
+JobId jobAirQuality = SCHEDULER_INVALID_JOB;      // Luftqualität messen (Gasheizung, Intervall vom Wärmemanagement)
+JobId jobThermal = SCHEDULER_INVALID_JOB;         // Eigenerwärmung schätzen und Wärmequellen drosseln
+JobId jobDisplayToggle = SCHEDULER_INVALID_JOB;   // Wechsel Innen-/Aussenwerte
+JobId jobClock = SCHEDULER_INVALID_JOB;           // Zeitanzeige
+JobId jobDisplayStats = SCHEDULER_INVALID_JOB;    // Statistik der Anzeige-Task ausgeben
+JobId jobButtons = SCHEDULER_INVALID_JOB;         // Tasten auswerten (wird vom Tasten-Interrupt geweckt)
+JobId jobWarmBoot = SCHEDULER_INVALID_JOB;        // Anzeigezustand im RTC-Speicher sichern
+JobId jobMp3Check = SCHEDULER_INVALID_JOB;        // DFPlayer auf Antwort prüfen
+JobId jobFrame = SCHEDULER_INVALID_JOB;           // Ausstehendes Frame des LED-Streifens senden
+
+// Jobs der Supervisor-Task
+JobId jobHealthCheck = SCHEDULER_INVALID_JOB;     // Subsysteme prüfen und Watchdog bedienen
+JobId jobHealthStats = SCHEDULER_INVALID_JOB;     // Störungen und MTTR ausgeben
+
+// --- Austausch zwischen den Tasks ---
+MessageQueue<DisplayMessage, DISPLAY_QUEUE_LENGTH> displayQueue; // Netzwerk -> Anzeige
+MessageQueue<NetworkMessage, NETWORK_QUEUE_LENGTH> networkQueue; // Anzeige (Menü) -> Netzwerk
+Mailbox<InputLatencyStats> inputLatency;                           // Latenz Taste -> Anzeige
+
+// --- Topics (siehe events/EventBus.h) ---
+// Produzenten veröffentlichen Werte, übernommen und zugestellt werden nur Änderungen.
+// Die Reihenfolge bestimmt die Ausgabe der Statistik und der CoAP-Ressource "events".
+Topic<DisplaySettings> displaySettingsTopic("settings");  // Konfiguration (Portal, Menü)
+Topic<ServiceSettings> serviceSettingsTopic("service");   // Konfiguration (Portal)
+Topic<IndoorClimate> indoorTopic("indoor");               // SHT30 (Anzeige-Task)
+Topic<uint8_t> airQualityTopic("air");                    // BME680, IAQ 0-100 (Anzeige-Task)
+Topic<OutdoorWeather> weatherTopic("weather");            // Wetter-API (Netzwerk-Task)
+Topic<PollenLevels> pollenTopic("pollen");                // Pollen-API (Netzwerk-Task)
+Topic<LocalClock> clockTopic("clock");                    // NTP (Netzwerk-Task) bzw. Warmstart
+Topic<ClockMinute> minuteTopic("minute");                 // Angezeigte Uhrzeit (Anzeige-Task)
+
+// Handler der Abonnements, laufen in der Task des Dispatchers
+void onDisplaySettings(const DisplaySettings& settings);
+void onServiceSettings(const ServiceSettings& settings);
+void onIndoorClimate(const IndoorClimate& climate);
+void onAirQuality(const uint8_t& iaq);
+void onWeather(const OutdoorWeather& weather);
+void onPollen(const PollenLevels& pollen);
+void onClockTime(const LocalClock& clock);
+void onClockMinute(const ClockMinute& minute);
+
+// Abonnements der Anzeige-Task. Innenwerte und Luftqualität schwanken um die letzte Stelle,
+// sie werden deshalb höchstens einmal pro Intervall neu angezeigt (jeweils der neuste Wert).
+Subscription<DisplaySettings> displaySettingsEvents(displaySettingsTopic, onDisplaySettings);
+Subscription<IndoorClimate> indoorEvents(indoorTopic, onIndoorClimate, INDOOR_EVENT_INTERVAL);
+Subscription<uint8_t> airQualityEvents(airQualityTopic, onAirQuality, INDOOR_EVENT_INTERVAL);
+Subscription<OutdoorWeather> weatherEvents(weatherTopic, onWeather);
+Subscription<PollenLevels> pollenEvents(pollenTopic, onPollen);
+Subscription<LocalClock> clockEvents(clockTopic, onClockTime);
+Subscription<ClockMinute> minuteEvents(minuteTopic, onClockMinute);
+EventDispatcher displayEvents;
+
+// Abonnements der Netzwerk-Task
+Subscription<ServiceSettings> serviceSettingsEvents(serviceSettingsTopic, onServiceSettings);
+EventDispatcher networkEvents;
+
+// --- Zustand der Netzwerk-Task (nur dort verwenden) ---
+LocalClock networkClock;                // Von NTP gestellte Uhr, wird über das Topic "clock" verteilt
+
+// --- Zustand der Anzeige-Task (nur dort verwenden) ---
+DisplaySettings displaySettings;        // Zuletzt empfangene Einstellungen
+bool displaySettingsValid = false;      // Einstellungen empfangen oder beim Warmstart wiederhergestellt
+LocalClock displayClock;                // Kopie der Uhr aus dem Topic "clock", läuft auch ohne WLAN weiter
+bool networkOnline = false;             // Normalbetrieb mit WLAN (Aussenwerte verfügbar)
+uint32_t displayIpAddress = 0;          // Für den Menüpunkt IP-Adresse
+WarmBootState warmBootState;            // Zuletzt im RTC-Speicher gesicherter Stand
+
+// Wärmemanagement: Eigenerwärmung des SHT30 aus CPU-Last, LED-Strom und Gasheizung
+ThermalModel thermalModel({ THERMAL_IDLE_OFFSET,
+                            { THERMAL_CPU_COEFFICIENT, THERMAL_LED_COEFFICIENT, THERMAL_HEATER_COEFFICIENT },
+                            THERMAL_TIME_CONSTANT });
+const ThermalPolicyConfig thermalPolicy = { THERMAL_SELF_HEATING_LIMIT, THERMAL_HYSTERESIS,
+                                            AIR_QUALITY_UPDATE_CYCLE, AIR_QUALITY_REDUCED_CYCLE, THERMAL_BRIGHTNESS_LIMIT };
+ThermalDecision thermalDecision = { THERMAL_MODE_NORMAL, AIR_QUALITY_UPDATE_CYCLE, 100 };
+float rawIndoorTemperature = 0.0f;      // Letzter Rohwert des SHT30
+bool rawIndoorTemperatureNew = false;   // Seit der letzten Beobachtung des Wärmemodells gemessen
+
+// Menü auf der 7-Segment-Anzeige (Tasten A: Menü/Auswahl, B: weniger, C: mehr/Doppeldruck: Aktualisieren)
+DeviceMenu deviceMenu(MENU_TIMEOUT, MENU_BRIGHTNESS_STEP);
+
+// Zeigt die 7-Segment Anzeige gerade die Innenwerte (true) oder die Aussenwerte (false)?
+boolean showingIndoor = true;
 
 // Forward Declarations für Methoden.
-bool connectToWiFi(); // Keine Parameter mehr, nutzt currentDeviceConfig
+void startWiFiConnection(); // Verbindungsaufbau im Hintergrund starten, nutzt die aktive Konfiguration
+void onWiFiConnected(); // Netzwerkdienste nach (erneutem) Verbindungsaufbau starten
+void startAccessPoint(); // Fallback in den Konfigurations-AP
 void onConfigSavedCallback(const AppConfig& config); // Callback für Portal
-void applyDeviceSettings(); // Funktion zum Anwenden der Einstellungen
-void updateSensorValues(unsigned long &lastApiCall, boolean forceUpdate = false); // Beibehalten
+void publishDeviceSettings(const AppConfig& config); // Einstellungen aus der Konfiguration veröffentlichen
+void updateSensorValues(); // Job: Innensensoren auslesen
+void updateAirQuality(); // Job: Luftqualität messen
+void updateThermalModel(); // Job: Eigenerwärmung schätzen und Wärmequellen drosseln
+void applyBrightness(); // Helligkeit der Einstellungen anwenden, begrenzt durch das Wärmemanagement
 void i2cBusScan(); // Beibehalten
 void initializeNetworkServices(); // Beibehalten
-void updateWeatherApi(unsigned long &lastApiCall, boolean forceUpdate = false); // Beibehalten
-void updatePollenApi(unsigned long &lastApiCall , boolean forceUpdate = false); // Beibehalten
+void updateWeatherApi(); // Job: Wetterdaten abfragen
+void updatePollenApi(); // Job: Pollendaten abfragen
+void setDeviceState(DeviceState state); // Zustand setzen und Anzeige-Task informieren
+void publishIpAddress(uint32_t ipAddress); // IP-Adresse an die Anzeige-Task (Menü) senden
+void handleClients(); // Job: Webserver und CoAP-Anfragen bearbeiten
+void runStateMachine(); // Job: Zustandsautomat
+void syncTime(); // Job: NTP abfragen und die lokale Uhr stellen
+void processDisplayMessages(); // Job: Nachrichten der Netzwerk-Task verarbeiten
+void processNetworkMessages(); // Job: Nachrichten der Anzeige-Task verarbeiten
+void processButtons(); // Job: Tastenereignisse an das Menü weitergeben
+void applyMenuAction(MenuAction action, bool wasActive); // Ergebnis des Menüs anzeigen bzw. ausführen
+void renderMenu(boolean opened); // Menüpunkt und Wert anzeigen
+void closeMenu(); // Geänderte Werte speichern und normale Anzeige wiederherstellen
+void recordInputLatency(unsigned long edgeMicros); // Latenz Taste -> Anzeige erfassen
+void wakeDisplayTask(); // Aus dem Tasten-Interrupt: Anzeige-Task wecken
+bool restoreWarmBoot(); // Anzeige nach einem Reset aus dem RTC-Speicher wiederherstellen
+void saveWarmBootState(); // Job: Anzeigezustand im RTC-Speicher sichern
+int maxPollenLevel(const PollenLevels& pollen); // Höchste der drei Belastungen, -1 = unbekannt
+void toggleIndoorOutdoor(); // Job: Wechsel zwischen Innen- und Aussenwerten
+void showOutdoorValues(const OutdoorWeather& weather); // Aussenwerte auf der Anzeige darstellen
+void updateClock(); // Job: Uhrzeit anzeigen
+void logNetworkStats(); // Job: Statistik der Netzwerk-Task ausgeben
+void logDisplayStats(); // Job: Statistik der Anzeige-Task ausgeben
+void renderDisplayFrame(); // Job: ausstehendes Frame des LED-Streifens senden
+void requestDisplayFrame(); // Frame-Anforderung der Anzeige: renderDisplayFrame einplanen
+void logTaskStats(SchedulerTask& task); // Laufzeit, Verspätung, CPU-Last und Stack einer Task ausgeben
+void updatePowerPolicy(); // Job: Energiezustand bestimmen
+void logPowerStats(); // Zeit pro Energiezustand ausgeben
+void registerJobs(); // Alle Jobs und Abonnements bei den Schedulern bzw. Dispatchern anmelden
+void registerCoapResources(); // Ressourcen des CoAP-Servers registrieren
+unsigned long apiIntervalMs(const char* api, int minutes); // Abfrage-Intervall aus der Konfiguration in ms
+DeviceSnapshot buildDeviceSnapshot(); // Aktuellen Gerätezustand zusammenstellen
+size_t encodeCurrentSnapshot(uint8_t* buffer, size_t bufferSize); // Snapshot als CBOR kodieren
+void bootStartWifi(); // Boot-Schritt: Konfiguration laden und WLAN-Aufbau starten
+void bootInitPower(); // Boot-Schritt: Energieverwaltung
+void bootInitI2c(); // Boot-Schritt: i2c Bus
+void bootInitDisplay(); // Boot-Schritt: Anzeige und Warmstart (parallel)
+void bootInitMp3(); // Boot-Schritt: DFPlayer (parallel)
+void bootInitSensors(); // Boot-Schritt: Innensensoren (parallel)
+void bootInitButtons(); // Boot-Schritt: Tasten
+void bootInitHealth(); // Boot-Schritt: Subsysteme beim Health-Supervisor anmelden
+void checkHealth(); // Job: Subsysteme prüfen (Supervisor-Task)
+void logHealthStats(); // Job: Health-Statistik ausgeben
+void recoverSubsystem(HealthSubsystem subsystem, HealthAction action); // Massnahme des Supervisors ausführen bzw. weiterleiten
+void recoverNetworkSubsystem(const HealthRecoveryRequest& request); // Massnahme in der Netzwerk-Task
+void recoverDisplaySubsystem(const HealthRecoveryRequest& request); // Massnahme in der Anzeige-Task
+void checkMp3Player(); // Job: DFPlayer abfragen
 
 
 void setup() {
-  // Eingänge für Buttons Initialisieren
-  pinMode(BUTTON_A, INPUT_PULLUP);
-  pinMode(BUTTON_B, INPUT_PULLUP);
-  pinMode(BUTTON_C, INPUT_PULLUP);
-
   Serial.begin(9600);
   if (LOG_LEVEL == LogLevel::Debug){
     while(!Serial);
-  } else{
-    delay(2000);
   }
 
-  Logger::setup(LOG_LEVEL); // Logger initialisieren (ohne NTP, da noch nicht verfügbar)
-  Logger::log(LogLevel::Info, "Programm gestartet und Logger initialisiert.");
-  Serial.println("Hallo vom Setup");
+  Logger::setup(LOG_LEVEL, clockTopic); // Logger initialisieren, Zeitstempel sobald NTP oder der Warmstart eine Zeit liefert
+  Logger::log(LogLevel::Info, "Programm gestartet und Logger initialisiert (Reset-Grund " + String((int)esp_reset_reason()) + ").");
+
+  // Initialisierung nach Abhängigkeiten: WLAN zuerst, damit der Verbindungsaufbau im Hintergrund
+  // während der übrigen Schritte läuft. Anzeige, DFPlayer und Sensoren warten auf ihre Hardware
+  // und laufen deshalb parallel in eigenen Tasks.
+  BootSequence boot(BOOT_TASK_STACK_SIZE, BOOT_TASK_PRIORITY);
+  BootStepId bootWifi = boot.add("wifi", bootStartWifi, BOOT_STEP_INLINE);
+  boot.add("power", bootInitPower, BOOT_STEP_INLINE);
+  BootStepId bootI2c = boot.add("i2c", bootInitI2c, BOOT_STEP_INLINE);
+  boot.add("display", bootInitDisplay, BOOT_STEP_PARALLEL, BootSequence::after(bootI2c));
+  boot.add("mp3", bootInitMp3, BOOT_STEP_PARALLEL);
+  boot.add("sensors", bootInitSensors, BOOT_STEP_PARALLEL, BootSequence::after(bootI2c));
+  boot.add("coap", registerCoapResources, BOOT_STEP_INLINE);
+  // Die Intervalle der APIs stammen aus der Konfiguration, die der WLAN-Schritt veröffentlicht
+  BootStepId bootJobs = boot.add("jobs", registerJobs, BOOT_STEP_INLINE, BootSequence::after(bootWifi));
+  boot.add("buttons", bootInitButtons, BOOT_STEP_INLINE, BootSequence::after(bootJobs));
+  boot.add("health", bootInitHealth, BOOT_STEP_INLINE, BootSequence::after(bootJobs));
+  boot.run();
+  boot.logProfile();
+
+  // Ab hier laufen alle Jobs in ihren Tasks
+  networkTask.start();
+  updateDisplay.setFrameRequestHandler(requestDisplayFrame); // Erst jetzt, während dem Boot läuft die Anzeige in einer eigenen Task
+  displayTask.start();
+  healthTask.start();
 
-  // Mp3Player initialisieren
-  Mp3Player::getInstance().begin(Serial1);
+  Logger::log(LogLevel::Info, "Ende vom Setup!");
+}
 
-  // Display Initialisieren
-  updateDisplay = new UpdateDisplay();
+// --- Boot-Schritte ---
 
+// Konfiguration laden und den WLAN-Aufbau (bzw. den Konfigurations-AP) starten
+void bootStartWifi() {
   // Initialisiere ConfigurationPortal Singleton, damit es Preferences öffnen kann
   ConfigurationPortal& portal = ConfigurationPortal::getInstance();
   // Setze den Callback, der aufgerufen wird, wenn die Konfiguration über das Webportal gespeichert wird.
   portal.onConfigSaved(onConfigSavedCallback);
+  // Snapshot für die Route "/snapshot" bereitstellen
+  portal.onSnapshotRequest(encodeCurrentSnapshot);
+
+  // WLAN-Ereignisse registrieren, die Verbindung wird danach nur noch im Hintergrund aufgebaut
+  WifiManager::getInstance().begin();
 
   // 1. Versuche, die gespeicherte Konfiguration aus NVS zu laden.
-  if (portal.loadConfig(currentDeviceConfig)) {
+  bool configLoaded = portal.loadActiveConfig();
+  // Auch ohne WLAN-Konfiguration gelten die Standardwerte für Anzeige und APIs.
+  // Wiederhergestellte Werte des Warmstarts ersetzen diese nicht (siehe restoreWarmBoot).
+  publishDeviceSettings(portal.getActiveConfig());
+  if (configLoaded) {
       Logger::log(LogLevel::Info, "Gespeicherte Konfiguration aus NVS geladen.");
       // Wenn eine Konfiguration geladen wurde, versuche, eine WLAN-Verbindung herzustellen.
-      currentState = STATE_CONNECTING_WIFI;
+      startWiFiConnection();
   } else {
       Logger::log(LogLevel::Info, "Keine gespeicherte Konfiguration gefunden. Starte Konfigurations-AP.");
       // Wenn keine Konfiguration gefunden wurde (z.B. erster Start),
       // starte den Access Point für die Erstkonfiguration.
-      currentState = STATE_AP_MODE;
+      setDeviceState(STATE_AP_MODE);
       portal.startAPAndWebServer(AP_SSID, AP_PASSWORD); // Verwendet AP_SSID/AP_PASSWORD aus Settings.h
+      publishIpAddress((uint32_t)WiFi.softAPIP());
   }
+}
 
-  // i2c Bus initialisieren
-  Logger::log(LogLevel::Info, "i2c Bus starten...");
-  Wire.begin(21, 22);
-  Wire.setClock(100000L); // "100000L" (100 kHz)
-  Logger::log(LogLevel::Info, "i2c Bus gestartet!");
+// DFS und Light-Sleep konfigurieren, bis zur ersten Auswertung der Policy läuft die CPU mit voller Leistung
+void bootInitPower() {
+  PowerManager::getInstance().begin(POWER_CLIENT_ACTIVE_TIME, CLIENT_POLL_INTERVAL, CLIENT_POLL_IDLE_INTERVAL);
+}
 
-  // 7-Segment Anzeige Initialisieren
-  for(int i = 0; i < 5; i++){
-    // Sieben Segment Anzeigen erstellen
-    sevenSegmentDisplays[i] = new SevenSegmentDisplay(PCF_ADDRESSES[i]);
+// i2c Bus initialisieren. Anzeige und Sensoren greifen danach parallel zu,
+// der Wire-Treiber sperrt den Bus pro Übertragung.
+void bootInitI2c() {
+  Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN);
+  Wire.setClock(I2C_CLOCK);
+  Logger::log(LogLevel::Info, "i2c Bus gestartet!");
+}
 
-    // Test
-    // updateDisplay->sevenSegmentTest(*sevenSegmentDisplays[i]);
+// Anzeige starten und nach einem Reset sofort den letzten Stand zeigen
+void bootInitDisplay() {
+  // 7-Segment Anzeigen und LED-Streifen sind statisch angelegt und werden hier gestartet
+  updateDisplay.setMaxFrameRate(DISPLAY_MAX_FRAME_RATE);
+  updateDisplay.setDithering(LED_DITHERING, LED_DITHER_FRAME_RATE);
+  updateDisplay.setCrossfade(DISPLAY_CROSSFADE_TIME, DISPLAY_FRAME_BUDGET);
+  updateDisplay.setScrollInterval(DISPLAY_SCROLL_INTERVAL);
+  updateDisplay.setMatrixScrollInterval(DISPLAY_MATRIX_SCROLL_INTERVAL);
+  updateDisplay.begin();
+  // updateDisplay.ledStripTest();
+
+  if (restoreWarmBoot()) {
+    updateDisplay.showFrame();
+    Logger::log(LogLevel::Info, "Warmstart: Anzeige aus dem RTC-Speicher wiederhergestellt.");
   }
+}
 
-  // LED-Streifen Initialisieren
-  myLedStrip = new LedStrip(LED_PIN, NUM_LEDS);
-  // updateDisplay->ledStripTest();
-  myLedStrip->setSingleLED(1, 255, 0, 0); // °C
-  myLedStrip->setSingleLED(8, 0, 0, 255); // %
+// Mp3Player initialisieren (die Antwort des DFPlayers prüft checkMp3Player())
+void bootInitMp3() {
+  Mp3Player::getInstance().begin(Serial1);
+}
 
-  // Sensoren
-  tempHumi = new TempHumi();
-  airQuality = new AirQuality(&Wire, 0x76);
+// Sensoren
+void bootInitSensors() {
+  if (TempHumi* sensor = tempHumi.get()) {
+    sensor->begin();
+  }
   // Versuche, den Sensor zu initialisieren
-  if (!airQuality->begin()) {
-    Logger::log(LogLevel::Error, "Air Qualitäts Sensor konnte nicht gestartet werden!");
+  if (AirQuality* sensor = airQuality.get()) {
+    if (!sensor->begin()) {
+      Logger::log(LogLevel::Error, "Air Qualitäts Sensor konnte nicht gestartet werden!");
+    }
   }
+}
 
-  // Wende die geladenen (oder Standard-)Einstellungen auf das Gerät an.
-  // Dies geschieht immer nach dem Laden der Konfiguration, unabhängig davon,
-  // ob es eine gespeicherte oder die Standardkonfiguration war.
-  // Dies ist der erste Punkt, an dem die Einstellungen angewendet werden.
-  applyDeviceSettings();
+// Tasten (Reihenfolge wie MenuButton). Jede Flanke weckt die Anzeige-Task, die sofort jobButtons ausführt.
+void bootInitButtons() {
+  const uint8_t buttonPins[] = { BUTTON_A, BUTTON_B, BUTTON_C };
+  const ButtonTiming buttonTiming = { BUTTON_DEBOUNCE_TIME, BUTTON_LONG_PRESS_TIME, BUTTON_MULTI_PRESS_TIME };
+  displayTask.setWakeJob(jobButtons);
+  ButtonInput::getInstance().begin(buttonPins, 3, buttonTiming, wakeDisplayTask);
+}
 
-  Logger::log(LogLevel::Info, "Ende vom Setup!");
+// Subsysteme beim Health-Supervisor anmelden. Die Tasks liefern ihren Fortschritt über die Anzahl Durchläufe,
+// die übrigen Subsysteme melden Erfolg und Fehler selbst.
+void bootInitHealth() {
+  HealthSupervisor& health = HealthSupervisor::getInstance();
+  // Eine hängende Abfrage wird abgebrochen, hilft das nicht, startet das Gerät neu (Anzeige aus dem Warmstart-Abbild)
+  const uint8_t networkActions = healthActionBit(HEALTH_ACTION_RESET_CLIENT) | healthActionBit(HEALTH_ACTION_REBOOT);
+  health.add(HEALTH_NETWORK_TASK, { HEALTH_NETWORK_STALL_TIMEOUT, 0, networkActions, true }, recoverSubsystem);
+  // i2c, RMT und UART haben eigene Timeouts, bleibt die Anzeige trotzdem stehen, hilft nur der Neustart
+  health.add(HEALTH_DISPLAY_TASK, { HEALTH_DISPLAY_STALL_TIMEOUT, 0, healthActionBit(HEALTH_ACTION_REBOOT), true }, recoverSubsystem);
+
+  // Ohne Internet scheitern die APIs ebenfalls, deshalb höchstens bis zum Neuaufbau des WLANs eskalieren
+  const uint8_t apiActions = healthActionBit(HEALTH_ACTION_RESET_CLIENT) | healthActionBit(HEALTH_ACTION_REINIT_PERIPHERAL);
+  health.add(HEALTH_WEATHER_API, { 0, HEALTH_API_FAILURE_THRESHOLD, apiActions, true }, recoverSubsystem);
+  health.add(HEALTH_POLLEN_API, { 0, HEALTH_API_FAILURE_THRESHOLD, apiActions, true }, recoverSubsystem);
+
+  // Ein fehlender Sensor soll das Gerät nicht neu starten
+  const uint8_t sensorActions = healthActionBit(HEALTH_ACTION_RESET_CLIENT) | healthActionBit(HEALTH_ACTION_REINIT_PERIPHERAL);
+  if (tempHumi.isPresent()) {
+    health.add(HEALTH_TEMP_SENSOR, { 0, HEALTH_SENSOR_FAILURE_THRESHOLD, sensorActions, true }, recoverSubsystem);
+  }
+  if (airQuality.isPresent()) {
+    health.add(HEALTH_AIR_SENSOR, { 0, HEALTH_SENSOR_FAILURE_THRESHOLD, sensorActions, true }, recoverSubsystem);
+  }
+
+  // Ein fehlender DFPlayer soll nicht endlos neu initialisiert werden
+  health.add(HEALTH_MP3_PLAYER, { 0, HEALTH_MP3_FAILURE_THRESHOLD, sensorActions, false }, recoverSubsystem);
 }
 
-void updateSensorValues(unsigned long &lastApiCall, boolean forceUpdate){
-  if (forceUpdate || millis() - lastApiCall >= SENSOR_UPDATE_CYCLE ) {
-    lastApiCall = millis();
+void updateSensorValues(){
+  // Das Menü belegt die 7-Segment-Anzeige, beim Schliessen wird sofort wieder gemessen
+  if (deviceMenu.isActive()) {
+    return;
+  }
 
-    // Temperatur und Luftfeuchtigkeit
-    float actTemperature;
-    float actHumidity;
-    if (tempHumi->readData(actTemperature, actHumidity)) {
-      // Temperatur Anzeigen auf 7 Segment Anzeige
-      updateDisplay->updateTemperature(actTemperature);
-      updateDisplay->updateTempLED(true);
+  // Im Normalbetrieb werden die Innensensoren nur gelesen, während die Innenwerte angezeigt werden
+  if (networkOnline && !showingIndoor) {
+    return;
+  }
 
-      // Luftfeuchtigkeit Anzeigen auf 7 Segment Anzeige
-      updateDisplay->updateHumidity(actHumidity);
-      updateDisplay->updateHumiLED(true);
+  TempHumi* sensor = tempHumi.get();
+  if (sensor == nullptr) {
+    return;
+  }
 
-    } else {
-      Logger::log(LogLevel::Error, "Fehler beim Lesen der SHT30(TempHumi) Daten.");
-    }
+  // Temperatur und Luftfeuchtigkeit
+  float actTemperature;
+  float actHumidity;
+  if (sensor->readData(actTemperature, actHumidity)) {
+    HealthSupervisor::getInstance().reportProgress(HEALTH_TEMP_SENSOR);
+    rawIndoorTemperature = actTemperature;
+    rawIndoorTemperatureNew = true;
+    // Eigenerwärmung abziehen und auf die angezeigte Auflösung runden, damit nur sichtbare Änderungen
+    // als Ereignis gelten. Angezeigt wird über onIndoorClimate.
+    IndoorClimate climate;
+    climate.temperature = roundf((actTemperature - thermalModel.getSelfHeating()) * 10.0f) / 10.0f;
+    climate.humidity = roundf(actHumidity * 10.0f) / 10.0f;
+    indoorTopic.publish(climate);
+  } else {
+    HealthSupervisor::getInstance().reportFailure(HEALTH_TEMP_SENSOR);
+    deviceStatus.update([](DeviceStatus& status) { status.tempHumiReadErrors++; });
+    Logger::log(LogLevel::Error, "Fehler beim Lesen der SHT30(TempHumi) Daten.");
+  }
+}
 
-    //Luftqualität
-    if (airQuality->readSensorData()) {
-      // Anzeigen der Luftqualität
-      float iaqValue = airQuality->getIAQ();
-      // Sicherstellen, dass der IAQ-Wert im gültigen Bereich liegt
-      if (iaqValue < 0.0) iaqValue = 0.0;
-      if (iaqValue > 100.0) iaqValue = 100.0;
+// Die Gasheizung des BME680 (320 °C) erwärmt den SHT30 daneben, deshalb nur im Intervall des Wärmemanagements messen
+void updateAirQuality() {
+  AirQuality* sensor = airQuality.get();
+  if (sensor == nullptr || deviceMenu.isActive() || (networkOnline && !showingIndoor)) {
+    return;
+  }
 
-      // Farben definieren
-      updateDisplay->updateAirQuality(iaqValue);
+  if (sensor->readSensorData()) {
+    HealthSupervisor::getInstance().reportProgress(HEALTH_AIR_SENSOR);
+    // Anzeigen der Luftqualität
+    float iaqValue = sensor->getIAQ();
+    // Sicherstellen, dass der IAQ-Wert im gültigen Bereich liegt
+    if (iaqValue < 0.0) iaqValue = 0.0;
+    if (iaqValue > 100.0) iaqValue = 100.0;
+    // Angezeigt wird über onAirQuality
+    airQualityTopic.publish((uint8_t)lroundf(iaqValue));
+  }
+  else {
+    HealthSupervisor::getInstance().reportFailure(HEALTH_AIR_SENSOR);
+    deviceStatus.update([](DeviceStatus& status) { status.airQualityReadErrors++; });
+    Logger::log(LogLevel::Error, "Fehler beim Lesen der Luftqualität Daten.");
+  }
+}
 
-    }
-    else {
-      Logger::log(LogLevel::Error, "Fehler beim Lesen der Luftqualität Daten.");
+// Misst die Lasten der Wärmequellen seit dem letzten Aufruf, passt das Wärmemodell mit dem letzten Rohwert
+// des SHT30 an und drosselt Gasheizung und Helligkeit, solange die geschätzte Eigenerwärmung zu hoch ist.
+// Die CPU-Last wird nur gemessen: die Netzwerk-Task schläft bereits über die Energieverwaltung.
+void updateThermalModel() {
+  static bool started = false;
+  static uint32_t lastBusyMicros = 0;
+  static uint32_t lastHeaterOnMs = 0;
+  static unsigned long lastMicros = 0;
+
+  uint32_t busyMicros = networkScheduler.getBusyMicros() + displayScheduler.getBusyMicros() + healthScheduler.getBusyMicros();
+  AirQuality* airSensor = airQuality.get();
+  uint32_t heaterOnMs = airSensor != nullptr ? airSensor->getHeaterOnMs() : 0;
+  unsigned long nowMicros = micros();
+  if (started) {
+    float elapsedMicros = (float)(unsigned long)(nowMicros - lastMicros);
+    float load[THERMAL_LOAD_COUNT];
+    load[THERMAL_LOAD_CPU] = (busyMicros - lastBusyMicros) / (2.0f * elapsedMicros); // Zwei Kerne
+    load[THERMAL_LOAD_LED] = updateDisplay.getLedDriveLevel();
+    load[THERMAL_LOAD_HEATER] = (heaterOnMs - lastHeaterOnMs) * 1000.0f / elapsedMicros;
+    thermalModel.addLoad(load, millis());
+  } else {
+    thermalModel.addLoad({ 0.0f, 0.0f, 0.0f }, millis());
+    started = true;
+  }
+  lastBusyMicros = busyMicros;
+  lastHeaterOnMs = heaterOnMs;
+  lastMicros = nowMicros;
+
+  if (rawIndoorTemperatureNew) {
+    thermalModel.observe(rawIndoorTemperature);
+    rawIndoorTemperatureNew = false;
+  }
+
+  ThermalDecision decision = decideThermalMode(thermalModel.getSelfHeating(), thermalDecision.mode, thermalPolicy);
+  if (decision.mode != thermalDecision.mode) {
+    Logger::log(LogLevel::Info, String("Wärmemanagement: ") + (decision.mode == THERMAL_MODE_REDUCED ? "gedrosselt" : "normal") +
+                ", Eigenerwärmung " + String(thermalModel.getSelfHeating(), 2) + " °C");
+    thermalDecision = decision;
+    displayScheduler.setInterval(jobAirQuality, decision.airQualityIntervalMs);
+    if (displaySettingsValid) {
+      applyBrightness(); // Sendet das Frame mit der neuen Helligkeit
     }
   }
 }
 
+void applyBrightness() {
+  updateDisplay.setBrightness(min(displaySettings.brightness, thermalDecision.brightnessLimit));
+}
+
 void i2cBusScan(){
   Serial.println("Scanning...");
 
@@ -216,72 +537,90 @@ void i2cBusScan(){
 // neue Konfigurationsdaten übermittelt hat.
 void onConfigSavedCallback(const AppConfig& config) {
   Logger::log(LogLevel::Info, "Hauptprogramm-Callback: Neue Konfiguration empfangen und gespeichert.");
-  currentDeviceConfig = config; // Aktualisiere die globale Konfiguration
 
-  // Wende die neuen Einstellungen auf das Gerät an.
-  applyDeviceSettings();
+  // Geänderte Einstellungen an die Abonnenten verteilen (das Portal hat sie bereits als aktive Konfiguration übernommen).
+  publishDeviceSettings(config);
 
   // WLAN neu verbinden, falls sich SSID/Passwort geändert haben oder um die Verbindung zu aktualisieren.
+  // Eine bestehende Verbindung wird dabei vom WifiManager getrennt.
   Logger::log(LogLevel::Info, "Versuche, WLAN neu zu verbinden mit neuer Konfiguration...");
-  // Trenne die bestehende Verbindung, falls vorhanden
-  if (WiFi.status() == WL_CONNECTED) {
-    WiFi.disconnect(true);
-    delay(100);
-  }
-  // Wechsle in den Zustand, in dem wir versuchen, uns mit dem WLAN zu verbinden
-  currentState = STATE_CONNECTING_WIFI;
-}
-
-// --- Funktion zum Verbinden mit WLAN ---
-// Diese Funktion kapselt die WLAN-Verbindungslogik.
-// Sie verwendet die global gespeicherte currentDeviceConfig.
-// Sie gibt true zurück, wenn die Verbindung erfolgreich war, sonst false.
-bool connectToWiFi() {
-    Logger::log(LogLevel::Info, "Versuche, mich mit WLAN zu verbinden: " + currentDeviceConfig.wifiSsid);
-
-    // Beende den SoftAP, falls er noch läuft und wir im STA-Modus sein wollen
-    if (WiFi.getMode() == WIFI_AP || WiFi.getMode() == WIFI_AP_STA) {
-        WiFi.softAPdisconnect(true);
-        Logger::log(LogLevel::Info, "SoftAP wurde deaktiviert.");
-    }
+  startWiFiConnection();
+}
 
-    // Setze den Wi-Fi-Modus auf Station (Client)
-    WiFi.mode(WIFI_STA);
-    WiFi.begin(currentDeviceConfig.wifiSsid.c_str(), currentDeviceConfig.wifiPassword.c_str());
+// --- WLAN-Verbindung ---
+// Startet den Verbindungsaufbau mit der aktiven Konfiguration des Portals.
+// Kehrt sofort zurück, das Ergebnis wertet runStateMachine() über WifiManager::update() aus.
+void startWiFiConnection() {
+    WifiManager::getInstance().connect(ConfigurationPortal::getInstance().getActiveConfig().wifiNetworks, WIFI_CONNECT_TIMEOUT);
+    setDeviceState(STATE_CONNECTING_WIFI);
+}
 
-    int attempts = 0;
-    const int MAX_WIFI_ATTEMPTS = 40; // 20 Sekunden Timeout (40 * 500ms)
-    while (WiFi.status() != WL_CONNECTED && attempts < MAX_WIFI_ATTEMPTS) {
-        delay(500);
-        Serial.print("."); // Visuelle Rückmeldung im Serial Monitor
-        attempts++;
+// Setzt den Gerätezustand. Beginnt oder endet dabei der Normalbetrieb, wird die Anzeige-Task informiert
+// (Aussenwerte und Uhrzeit werden nur im Normalbetrieb angezeigt).
+void setDeviceState(DeviceState state) {
+    bool wasOnline = currentState == STATE_NORMAL_OPERATION;
+    bool online = state == STATE_NORMAL_OPERATION;
+    currentState = state;
+    if (wasOnline != online) {
+        DisplayMessage message;
+        message.type = DISPLAY_MSG_ONLINE;
+        message.online = online;
+        displayQueue.send(message);
     }
-    Serial.println(); // Neue Zeile nach den Punkten
+}
 
-    if (WiFi.status() == WL_CONNECTED) {
-        Logger::log(LogLevel::Info, "WLAN erfolgreich verbunden!");
-        Logger::log(LogLevel::Info, "IP-Adresse: " + WiFi.localIP().toString());
-        return true;
-    } else {
-        Logger::log(LogLevel::Error, "WLAN-Verbindung fehlgeschlagen!");
-        return false;
+// Sendet die aktuelle IP-Adresse an die Anzeige-Task, damit sie im Menü angezeigt werden kann.
+void publishIpAddress(uint32_t ipAddress) {
+    DisplayMessage message;
+    message.type = DISPLAY_MSG_IP_ADDRESS;
+    message.ipAddress = ipAddress;
+    displayQueue.send(message);
+}
+
+// Wird nach jeder erfolgreichen (Wieder-)Verbindung aufgerufen.
+void onWiFiConnected() {
+    // Statische Variable, um sicherzustellen, dass initializeNetworkServices()
+    // nur einmal aufgerufen wird, auch wenn die Verbindung mehrmals neu aufgebaut wird.
+    static bool servicesInitialized = false;
+
+    if (!servicesInitialized) {
+        initializeNetworkServices();
+        // API das erste Mal aufrufen, um die aktuellen Daten zu erhalten.
+        networkScheduler.trigger(jobWeather);
+        networkScheduler.trigger(jobPollen);
+        servicesInitialized = true;
     }
+    // Starte den Webserver im Station-Modus, um weitere Einstellungen zu ermöglichen.
+    ConfigurationPortal::getInstance().startWebServerInStationMode();
+    CoapServer::getInstance().begin();
+
+    networkScheduler.trigger(jobTimeSync); // Zeit sofort bereitstellen
+    setDeviceState(STATE_NORMAL_OPERATION);
+    publishIpAddress((uint32_t)WiFi.localIP());
+}
+
+// Fallback, wenn keine Verbindung zustande kommt: Konfigurations-AP starten.
+void startAccessPoint() {
+    setDeviceState(STATE_AP_MODE);
+    WifiManager::getInstance().disconnect();
+    CoapServer::getInstance().stop();
+    ConfigurationPortal::getInstance().startAPAndWebServer(AP_SSID, AP_PASSWORD);
+    publishIpAddress((uint32_t)WiFi.softAPIP());
 }
 
 // --- Initialisierung der Netzwerkdienste (NTP, APIs) ---
 // Diese Funktion wird aufgerufen, sobald eine stabile WLAN-Verbindung besteht.
 void initializeNetworkServices() {
     Logger::log(LogLevel::Info, "Initialisiere Netzwerkdienste...");
+    const AppConfig& config = ConfigurationPortal::getInstance().getActiveConfig();
 
     // NTPTimeSync initialisieren (nutzt die bereits aktive WLAN-Verbindung)
-    // Verwendet die Werte aus currentDeviceConfig
+    // Verwendet die Werte aus der aktiven Konfiguration
     // Annahme: NTPTimeSync::getInstance() kann mit neuen Parametern re-initialisiert werden
     // oder die Parameter werden intern aktualisiert.
     // timeOffsetHours ist in h -> Die Methode benötigt aber Sekunden.
-    NTPTimeSync::getInstance(currentDeviceConfig.ntpServer.c_str(), (currentDeviceConfig.timeOffsetHours * 60 * 60), UPDATE_INTERVALL);
+    NTPTimeSync::getInstance(config.ntpServer.c_str(), (config.timeOffsetHours * 60 * 60), UPDATE_INTERVALL);
     if (NTPTimeSync::getInstance().begin()) {
-        // Zeit an Logger weitergeben, falls Logger eine NTP-Instanz zur Zeitstempelung benötigt
-        Logger::setup(LOG_LEVEL, &NTPTimeSync::getInstance());
         Logger::log(LogLevel::Info, "NTP-Synchronisation erfolgreich abgeschlossen.");
     } else {
         Logger::log(LogLevel::Error, "NTP-Synchronisation fehlgeschlagen!");
@@ -289,210 +628,1084 @@ void initializeNetworkServices() {
 
     // Weather API initialisieren
     // Die Koordinaten werden bei jedem API-Aufruf übergeben, daher ist hier keine Re-Initialisierung des Clients nötig.
-    WeatherClient::getInstance(WEATHER_API_SERVER, currentDeviceConfig.googleAccessToken.c_str());
+    WeatherClient::getInstance(WEATHER_API_SERVER, config.googleAccessToken.c_str());
     // Pollen API initialisieren
-    PollenClient::getInstance(POLLEN_API_SERVER, currentDeviceConfig.googleAccessToken.c_str());
+    PollenClient::getInstance(POLLEN_API_SERVER, config.googleAccessToken.c_str());
 
     Logger::log(LogLevel::Info, "Netzwerkdienste initialisiert.");
 }
 
-// Funktion zum Anwenden der geladenen/gespeicherten Einstellungen auf die Hardware/Dienste.
-void applyDeviceSettings() {
-    Logger::log(LogLevel::Info, "Wende Geräteeinstellungen an...");
+// Verteilt die Einstellungen aus der Konfiguration. Anwenden übernehmen die Abonnenten in ihrer eigenen Task
+// (onDisplaySettings, onServiceSettings), und zwar nur, wenn sich ihr Teil der Konfiguration geändert hat.
+void publishDeviceSettings(const AppConfig& config) {
+    Logger::log(LogLevel::Info, "NTP-Server gesetzt auf: " + config.ntpServer + " mit Zeitverschiebung: " + String(config.timeOffsetHours) + "h");
+
+    DisplaySettings display;
+    display.textColor = config.textColorCRGB;
+    display.brightness = config.ledBrightness;
+    display.volume = config.volume;
+    display.indoorTimeSec = config.indoorTempDisplayTimeSec;
+    display.outdoorTimeSec = config.outdoorTempDisplayTimeSec;
+    displaySettingsTopic.publish(display);
+
+    ServiceSettings service;
+    service.weatherUpdateIntervalMin = config.weatherUpdateIntervalMin;
+    service.pollenUpdateIntervalMin = config.pollenUpdateIntervalMin;
+    service.latitude = config.latitude;
+    service.longitude = config.longitude;
+    serviceSettingsTopic.publish(service);
+}
 
-    // Beispiel: NTP-Client initialisieren (nur wenn NTPTimeSync noch nicht initialisiert wurde oder neu initialisiert werden muss)
-    // Wenn NTPTimeSync.begin() im initializeNetworkServices() aufgerufen wird,
-    // ist dieser Aufruf hier redundant, es sei denn, die Einstellungen haben sich geändert.
-    // configTime(currentDeviceConfig.timeOffsetHours * 3600, 0, currentDeviceConfig.ntpServer.c_str());
-    Logger::log(LogLevel::Info, "NTP-Server gesetzt auf: " + currentDeviceConfig.ntpServer + " mit Zeitverschiebung: " + String(currentDeviceConfig.timeOffsetHours) + "h");
+// Abfrage-Intervalle der APIs übernehmen (Minuten -> Millisekunden). Läuft in der Netzwerk-Task.
+void onServiceSettings(const ServiceSettings& settings) {
+    Logger::log(LogLevel::Info, "Wende Einstellungen der Netzwerkdienste an...");
+    networkScheduler.setInterval(jobWeather, apiIntervalMs("Wetter", settings.weatherUpdateIntervalMin));
+    networkScheduler.setInterval(jobPollen, apiIntervalMs("Pollen", settings.pollenUpdateIntervalMin));
+}
 
-    // FastLED Textfarbe setzen
-    CRGB displayColor = CRGB(currentDeviceConfig.textColorCRGB);
-    updateDisplay->setColorTime(displayColor.r, displayColor.g, displayColor.b);
-    Logger::log(LogLevel::Info, "LED-Farbe auf 0x" + String(currentDeviceConfig.textColorCRGB, HEX) + " gesetzt.");
+// Ein ungültiges Intervall (leere Eingabe im Portal ergibt 0) würde die API ununterbrochen abfragen
+unsigned long apiIntervalMs(const char* api, int minutes) {
+    if (minutes < API_MIN_UPDATE_INTERVAL) {
+        Logger::log(LogLevel::Error, String(api) + "-Intervall " + String(minutes) + " min ungültig, verwende " +
+                    String(API_MIN_UPDATE_INTERVAL) + " min.");
+        minutes = API_MIN_UPDATE_INTERVAL;
+    }
+    return (unsigned long)minutes * 60 * 1000UL;
+}
 
-    updateDisplay->setBrightness(currentDeviceConfig.ledBrightness);
-    Logger::log(LogLevel::Info, "LED-Helligkeit auf: " + String(currentDeviceConfig.ledBrightness) + " gesetzt.");
+void updateWeatherApi(){
+    // Das Intervall wird vom Scheduler verwaltet (siehe onServiceSettings), abgefragt wird nur mit WLAN
+    if (currentState != STATE_NORMAL_OPERATION) {
+        return;
+    }
+    Logger::log(LogLevel::Info, "Abfrage von Wetterdaten...");
+    ServiceSettings service;
+    serviceSettingsTopic.read(service);
+
+    // Wetterdaten abrufen, nutze die konfigurierten Koordinaten (mit voller Leistung und ohne Modem-Sleep)
+    WeatherData weatherData;
+    PowerManager::getInstance().setApiRequestActive(true);
+    bool success = WeatherClient::getInstance().getCurrentConditions(service.latitude, service.longitude, weatherData);
+    PowerManager::getInstance().setApiRequestActive(false);
+    if (success) {
+        HealthSupervisor::getInstance().reportProgress(HEALTH_WEATHER_API);
+        OutdoorWeather weather;
+        weather.temperature = weatherData.temperature.degrees;
+        weather.humidity = weatherData.relativeHumidity;
+        weather.weatherType = (uint8_t)weatherData.weatherType;
+        bool changed = weatherTopic.publish(weather);
+        Logger::log(LogLevel::Info, String("Wetterdaten erfolgreich abgerufen") + (changed ? "." : " (unverändert)."));
+    } else {
+        HealthSupervisor::getInstance().reportFailure(HEALTH_WEATHER_API);
+        deviceStatus.update([](DeviceStatus& status) { status.weatherApiErrors++; });
+        Logger::log(LogLevel::Error, "Fehler beim Abrufen der Wetterdaten.");
+    }
+}
+
+void updatePollenApi(){
+    // Das Intervall wird vom Scheduler verwaltet (siehe onServiceSettings), abgefragt wird nur mit WLAN
+    if (currentState != STATE_NORMAL_OPERATION) {
+        return;
+    }
+    Logger::log(LogLevel::Info, "Abfrage von Pollendaten...");
+    ServiceSettings service;
+    serviceSettingsTopic.read(service);
+
+    // Pollen Daten abfragen, nutze die konfigurierten Koordinaten (mit voller Leistung und ohne Modem-Sleep)
+    PollenData pollenData;
+    PowerManager::getInstance().setApiRequestActive(true);
+    bool success = PollenClient::getInstance().getCurrentPollen(service.latitude, service.longitude, pollenData);
+    PowerManager::getInstance().setApiRequestActive(false);
+    if (success) {
+        HealthSupervisor::getInstance().reportProgress(HEALTH_POLLEN_API);
+        // Anzeigen übernimmt die Anzeige-Task (onPollen)
+        PollenLevels pollen;
+        pollen.grass = (int8_t)pollenData.grassPollenLevel;
+        pollen.tree = (int8_t)pollenData.treePollenLevel;
+        pollen.weed = (int8_t)pollenData.weedPollenLevel;
+        bool changed = pollenTopic.publish(pollen);
+        Logger::log(LogLevel::Info, String("Pollendaten erfolgreich abgerufen") + (changed ? "." : " (unverändert)."));
+    } else {
+        HealthSupervisor::getInstance().reportFailure(HEALTH_POLLEN_API);
+        deviceStatus.update([](DeviceStatus& status) { status.pollenApiErrors++; });
+        Logger::log(LogLevel::Error, "Fehler beim Abrufen der Pollendaten.");
+    }
+}
+
+// --- CoAP-Ressourcen ---
+// Kompakte JSON-Nutzdaten für die Überwachung. Die Handler schreiben direkt in den
+// Puffer des CoAP-Servers, es wird kein Heap-Speicher benötigt.
+// Messwerte werden aus den Topics gelesen, solange keiner vorliegt, bleibt die Antwort leer.
+// Längste Antworten der Ressourcen "recovery" und "events" (alle Zähler zehnstellig) müssen ganz in ein Paket passen,
+// eine abgeschnittene Antwort wäre kein gültiges JSON mehr.
+const size_t COAP_RECOVERY_MAX_LENGTH = (sizeof("{\"reboots\":4294967295,\"s\":[]}") - 1) +
+    HEALTH_SUBSYSTEM_COUNT * (sizeof(",[1,4294967295,4294967295,4294967295]") - 1);
+const size_t COAP_EVENTS_MAX_LENGTH = (sizeof("{\"e\":[]}") - 1) + EVENT_MAX_TOPICS * (sizeof(",[4294967295,4294967295,4294967295]") - 1);
+static_assert(COAP_RECOVERY_MAX_LENGTH <= COAP_PAYLOAD_SIZE - 1, "Ressource recovery passt nicht in ein CoAP-Paket");
+static_assert(COAP_EVENTS_MAX_LENGTH <= COAP_PAYLOAD_SIZE - 1, "Ressource events passt nicht in ein CoAP-Paket");
+
+void registerCoapResources() {
+    CoapServer& coap = CoapServer::getInstance();
+
+    coap.addResource("indoor", [](uint8_t* buffer, size_t size) -> size_t {
+        IndoorClimate climate;
+        if (!indoorTopic.read(climate)) return 0;
+        int n = snprintf((char*)buffer, size, "{\"t\":%.1f,\"h\":%.1f}", climate.temperature, climate.humidity);
+        return coapPayloadLength(n, size);
+    });
+
+    coap.addResource("outdoor", [](uint8_t* buffer, size_t size) -> size_t {
+        OutdoorWeather weather;
+        if (!weatherTopic.read(weather)) return 0;
+        int n = snprintf((char*)buffer, size, "{\"t\":%.1f,\"h\":%.1f,\"w\":\"%s\"}",
+                         weather.temperature, weather.humidity,
+                         WeatherData::weatherConditionTypeToString((WeatherConditionType)weather.weatherType).c_str());
+        return coapPayloadLength(n, size);
+    });
+
+    coap.addResource("pollen", [](uint8_t* buffer, size_t size) -> size_t {
+        PollenLevels pollen;
+        if (!pollenTopic.read(pollen)) return 0;
+        int n = snprintf((char*)buffer, size, "{\"grass\":%d,\"tree\":%d,\"weed\":%d}", pollen.grass, pollen.tree, pollen.weed);
+        return coapPayloadLength(n, size);
+    });
+
+    coap.addResource("air", [](uint8_t* buffer, size_t size) -> size_t {
+        uint8_t iaq;
+        if (!airQualityTopic.read(iaq)) return 0;
+        int n = snprintf((char*)buffer, size, "{\"iaq\":%d}", (int)iaq);
+        return coapPayloadLength(n, size);
+    });
+
+    coap.addResource("uptime", [](uint8_t* buffer, size_t size) -> size_t {
+        int n = snprintf((char*)buffer, size, "{\"s\":%lu}", millis() / 1000UL);
+        return coapPayloadLength(n, size);
+    });
+
+    // WLAN-Empfang und Verbindungszeiten (Median/90. Perzentil), getrennt nach Schnellweg und Scan
+    coap.addResource("wifi", [](uint8_t* buffer, size_t size) -> size_t {
+        const ConnectTimeStats& fast = WifiManager::getInstance().getFastConnectStats();
+        const ConnectTimeStats& scan = WifiManager::getInstance().getScanConnectStats();
+        int n = snprintf((char*)buffer, size, "{\"rssi\":%d,\"ch\":%d,\"fast\":[%lu,%lu,%lu],\"scan\":[%lu,%lu,%lu]}",
+                         (int)WiFi.RSSI(), (int)WiFi.channel(),
+                         (unsigned long)fast.getTotalCount(), (unsigned long)fast.percentile(50), (unsigned long)fast.percentile(90),
+                         (unsigned long)scan.getTotalCount(), (unsigned long)scan.percentile(50), (unsigned long)scan.percentile(90));
+        return coapPayloadLength(n, size);
+    });
+
+    // CPU-Last (Promille) und minimale Stack-Reserve (Bytes) der Tasks sowie verworfene Nachrichten
+    coap.addResource("tasks", [](uint8_t* buffer, size_t size) -> size_t {
+        int n = snprintf((char*)buffer, size, "{\"net\":[%lu,%lu],\"disp\":[%lu,%lu],\"drop\":%lu}",
+                         (unsigned long)networkTask.getLoadPermille(), (unsigned long)networkTask.getStackHighWaterMark(),
+                         (unsigned long)displayTask.getLoadPermille(), (unsigned long)displayTask.getStackHighWaterMark(),
+                         (unsigned long)displayQueue.getDroppedCount());
+        return coapPayloadLength(n, size);
+    });
+
+    // Zeit pro Energiezustand in Sekunden (aktiv, bereit, Light-Sleep), im Modem-Sleep und aktueller Zustand
+    coap.addResource("power", [](uint8_t* buffer, size_t size) -> size_t {
+        PowerManager& power = PowerManager::getInstance();
+        int n = snprintf((char*)buffer, size, "{\"s\":[%lu,%lu,%lu],\"modem\":%lu,\"mode\":%d,\"mhz\":%lu}",
+                         (unsigned long)(power.getTimeMs(POWER_MODE_ACTIVE) / 1000),
+                         (unsigned long)(power.getTimeMs(POWER_MODE_IDLE) / 1000),
+                         (unsigned long)(power.getTimeMs(POWER_MODE_LIGHT_SLEEP) / 1000),
+                         (unsigned long)(power.getModemSleepTimeMs() / 1000),
+                         (int)power.getDecision().mode, (unsigned long)getCpuFrequencyMhz());
+        return coapPayloadLength(n, size);
+    });
+
+    // Anzahl Tastenereignisse und Latenz von der Flanke bis zur fertigen Anzeige (Mittelwert/Maximum in µs)
+    coap.addResource("input", [](uint8_t* buffer, size_t size) -> size_t {
+        InputLatencyStats stats = inputLatency.read();
+        int n = snprintf((char*)buffer, size, "{\"n\":%lu,\"avgUs\":%lu,\"maxUs\":%lu,\"drop\":%lu}",
+                         (unsigned long)stats.events,
+                         (unsigned long)(stats.events > 0 ? stats.totalMicros / stats.events : 0),
+                         (unsigned long)stats.maxMicros,
+                         (unsigned long)ButtonInput::getInstance().getDroppedEdgeCount());
+        return coapPayloadLength(n, size);
+    });
+
+    // Wiederherstellungen des Health-Supervisors: pro Subsystem (Reihenfolge wie HealthSubsystem)
+    // [ok, Störungen, behoben, MTTR in ms] sowie die Neustarts durch den Supervisor
+    coap.addResource("recovery", [](uint8_t* buffer, size_t size) -> size_t {
+        HealthReport report = HealthSupervisor::getInstance().getReport();
+        int n = snprintf((char*)buffer, size, "{\"reboots\":%lu,\"s\":[", (unsigned long)report.supervisorReboots);
+        for (int i = 0; i < HEALTH_SUBSYSTEM_COUNT && n > 0 && (size_t)n < size; i++) {
+            const HealthStats& stats = report.subsystems[i];
+            n += snprintf((char*)buffer + n, size - n, "%s[%d,%lu,%lu,%lu]", i > 0 ? "," : "", stats.healthy ? 1 : 0,
+                          (unsigned long)stats.incidents, (unsigned long)stats.recoveries, (unsigned long)stats.getMeanRecoveryMs());
+        }
+        if (n > 0 && (size_t)n < size) {
+            n += snprintf((char*)buffer + n, size - n, "]}");
+        }
+        return coapPayloadLength(n, size);
+    });
+
+    // Ereignisse pro Topic (Reihenfolge wie die Topics in main.cpp) [veröffentlicht, unverändert verworfen, zusammengefasst]
+    coap.addResource("events", [](uint8_t* buffer, size_t size) -> size_t {
+        EventBus& bus = EventBus::getInstance();
+        int n = snprintf((char*)buffer, size, "{\"e\":[");
+        for (int i = 0; i < bus.getTopicCount() && n > 0 && (size_t)n < size; i++) {
+            TopicStats stats = bus.getTopic(i)->getStats();
+            n += snprintf((char*)buffer + n, size - n, "%s[%lu,%lu,%lu]", i > 0 ? "," : "",
+                          (unsigned long)stats.published, (unsigned long)stats.suppressed, (unsigned long)stats.coalesced);
+        }
+        if (n > 0 && (size_t)n < size) {
+            n += snprintf((char*)buffer + n, size - n, "]}");
+        }
+        return coapPayloadLength(n, size);
+    });
+
+    // Qualität der lokalen Uhr: per NTP gestellt, Sekunden seit der letzten Synchronisation,
+    // geschätzter Fehler in ms und korrigierte Gangabweichung in ppm (gemessen oder noch 0)
+    coap.addResource("time", [](uint8_t* buffer, size_t size) -> size_t {
+        LocalClock clock;
+        if (!clockTopic.read(clock)) return 0;
+        ClockQuality quality = clock.getQuality(millis());
+        int n = snprintf((char*)buffer, size, "{\"sync\":%d,\"age\":%lu,\"errMs\":%lu,\"ppm\":%.1f,\"drift\":%d}",
+                         quality.synced ? 1 : 0, (unsigned long)quality.secondsSinceSync,
+                         (unsigned long)quality.estimatedErrorMs, quality.driftPpm, quality.driftMeasured ? 1 : 0);
+        return n > 0 ? min((size_t)n, size - 1) : 0;
+    });
+
+    // Vollständiger Gerätezustand als CBOR (siehe DeviceSnapshot.h)
+    coap.addResource("snapshot", encodeCurrentSnapshot, COAP_FORMAT_CBOR);
+
+    // Fehlerzähler sowie Anzahl und mittlere Bearbeitungszeit der CoAP- und HTTP-Anfragen
+    coap.addResource("health", [](uint8_t* buffer, size_t size) -> size_t {
+        CoapServer& server = CoapServer::getInstance();
+        ConfigurationPortal& portal = ConfigurationPortal::getInstance();
+        DeviceStatus status = deviceStatus.read();
+        int n = snprintf((char*)buffer, size,
+                         "{\"shtErr\":%lu,\"bmeErr\":%lu,\"wxErr\":%lu,\"polErr\":%lu,\"wifiLost\":%lu,"
+                         "\"coapReq\":%lu,\"coapUs\":%lu,\"httpReq\":%lu,\"httpUs\":%lu,\"heap\":%lu}",
+                         (unsigned long)status.tempHumiReadErrors,
+                         (unsigned long)status.airQualityReadErrors,
+                         (unsigned long)status.weatherApiErrors,
+                         (unsigned long)status.pollenApiErrors,
+                         (unsigned long)status.wifiConnectionLosses,
+                         (unsigned long)server.getRequestCount(), (unsigned long)server.getAverageRequestMicros(),
+                         (unsigned long)portal.getRequestCount(), (unsigned long)portal.getAverageRequestMicros(),
+                         (unsigned long)ESP.getFreeHeap());
+        return coapPayloadLength(n, size);
+    });
+}
 
-    // Lautstärke einstellen (wenn du einen DAC/Verstärker hast)
-    // int mappedVolume = map(currentDeviceConfig.volume, 0, 30, 0, 255); // Beispiel-Mapping für 0-255 Bereich
-    // analogWrite(DAC_PIN, mappedVolume); // Annahme: DAC_PIN ist definiert und für Lautstärke zuständig
-    updateDisplay->updateVolume(currentDeviceConfig.volume);
-    Logger::log(LogLevel::Info, "Lautstärke auf " + String(currentDeviceConfig.volume) + " gesetzt.");
+// --- Geräte-Snapshot ---
+// Stellt alle Messwerte, den Zeitstatus und die Zähler typisiert zusammen.
+// Kann von jedem Transport (CoAP, HTTP, ...) über encodeCurrentSnapshot() ausgegeben werden.
+DeviceSnapshot buildDeviceSnapshot() {
+    DeviceSnapshot snapshot;
+    DeviceStatus status = deviceStatus.read();
+    snapshot.uptimeSec = millis() / 1000UL;
+
+    IndoorClimate climate;
+    snapshot.indoorValid = indoorTopic.read(climate);
+    snapshot.indoorTemperature = climate.temperature;
+    snapshot.indoorHumidity = climate.humidity;
+
+    OutdoorWeather weather;
+    snapshot.outdoorValid = weatherTopic.read(weather);
+    snapshot.outdoorTemperature = weather.temperature;
+    snapshot.outdoorHumidity = weather.humidity;
+    snapshot.weatherType = weather.weatherType;
+
+    PollenLevels pollen = { -1, -1, -1 };
+    pollenTopic.read(pollen);
+    snapshot.grassPollenLevel = pollen.grass;
+    snapshot.treePollenLevel = pollen.tree;
+    snapshot.weedPollenLevel = pollen.weed;
+
+    uint8_t iaq = 0;
+    snapshot.airQualityValid = airQualityTopic.read(iaq);
+    snapshot.airQualityIndex = iaq;
+
+    // Aus der lokalen Uhr, damit die Zeit auch ohne WLAN und nach einem Warmstart verfügbar ist
+    LocalClock clock;
+    clockTopic.read(clock);
+    snapshot.timeSynced = clock.isSynced();
+    snapshot.epochTime = clock.isValid() ? clock.now(millis()) : 0;
+
+    snapshot.counters[SNAPSHOT_COUNTER_TEMPHUMI_ERRORS] = status.tempHumiReadErrors;
+    snapshot.counters[SNAPSHOT_COUNTER_AIRQUALITY_ERRORS] = status.airQualityReadErrors;
+    snapshot.counters[SNAPSHOT_COUNTER_WEATHER_ERRORS] = status.weatherApiErrors;
+    snapshot.counters[SNAPSHOT_COUNTER_POLLEN_ERRORS] = status.pollenApiErrors;
+    snapshot.counters[SNAPSHOT_COUNTER_WIFI_LOSSES] = status.wifiConnectionLosses;
+    snapshot.counters[SNAPSHOT_COUNTER_COAP_REQUESTS] = CoapServer::getInstance().getRequestCount();
+    snapshot.counters[SNAPSHOT_COUNTER_HTTP_REQUESTS] = ConfigurationPortal::getInstance().getRequestCount();
+    return snapshot;
+}
+
+static_assert(DEVICE_SNAPSHOT_BUFFER_SIZE <= COAP_PAYLOAD_SIZE, "Snapshot passt nicht in ein CoAP-Paket");
+
+size_t encodeCurrentSnapshot(uint8_t* buffer, size_t bufferSize) {
+    return encodeDeviceSnapshot(buildDeviceSnapshot(), buffer, bufferSize);
+}
 
+// --- Jobs der Tasks ---
+
+// Meldet alle zeitgesteuerten Aufgaben und die Abonnements der Tasks an.
+// Die Intervalle der APIs stammen aus der Konfiguration und werden bei Änderungen in onServiceSettings() gesetzt.
+void registerJobs() {
+    ServiceSettings service;
+    serviceSettingsTopic.read(service);
+    unsigned long weatherIntervalMs = apiIntervalMs("Wetter", service.weatherUpdateIntervalMin);
+    unsigned long pollenIntervalMs = apiIntervalMs("Pollen", service.pollenUpdateIntervalMin);
+    DisplaySettings display = {};
+    displaySettingsTopic.read(display);
+
+    // Netzwerk-Task
+    jobClientPoll = networkScheduler.addPeriodic("clients", CLIENT_POLL_INTERVAL, handleClients);
+    jobStateMachine = networkScheduler.addPeriodic("state", STATE_MACHINE_INTERVAL, runStateMachine);
+    jobTimeSync = networkScheduler.addPeriodic("ntp", CLOCK_UPDATE_INTERVAL, syncTime);
+    jobWeather = networkScheduler.addPeriodic("weather", weatherIntervalMs, updateWeatherApi, weatherIntervalMs);
+    jobPollen = networkScheduler.addPeriodic("pollen", pollenIntervalMs, updatePollenApi, pollenIntervalMs);
+    jobNetworkStats = networkScheduler.addPeriodic("stats", SCHEDULER_STATS_INTERVAL, logNetworkStats, SCHEDULER_STATS_INTERVAL);
+    jobPower = networkScheduler.addPeriodic("power", POWER_POLICY_INTERVAL, updatePowerPolicy);
+    jobNetworkMessages = networkScheduler.addPeriodic("messages", NETWORK_MESSAGE_INTERVAL, processNetworkMessages);
+
+    // Anzeige-Task
+    jobDisplayMessages = displayScheduler.addPeriodic("messages", DISPLAY_MESSAGE_INTERVAL, processDisplayMessages);
+    jobSensors = displayScheduler.addPeriodic("sensors", SENSOR_UPDATE_CYCLE, updateSensorValues);
+    jobAirQuality = displayScheduler.addPeriodic("air", thermalDecision.airQualityIntervalMs, updateAirQuality);
+    jobThermal = displayScheduler.addPeriodic("thermal", THERMAL_UPDATE_INTERVAL, updateThermalModel);
+    jobDisplayToggle = displayScheduler.addOneShot("display", (unsigned long)display.indoorTimeSec * 1000UL, toggleIndoorOutdoor);
+    jobClock = displayScheduler.addPeriodic("clock", CLOCK_UPDATE_INTERVAL, updateClock);
+    jobDisplayStats = displayScheduler.addPeriodic("stats", SCHEDULER_STATS_INTERVAL, logDisplayStats, SCHEDULER_STATS_INTERVAL);
+    jobButtons = displayScheduler.addOneShot("buttons", 0, processButtons);
+    jobWarmBoot = displayScheduler.addPeriodic("warmboot", WARM_BOOT_SAVE_INTERVAL, saveWarmBootState, WARM_BOOT_SAVE_INTERVAL);
+    jobMp3Check = displayScheduler.addPeriodic("mp3", HEALTH_MP3_CHECK_INTERVAL, checkMp3Player, HEALTH_MP3_CHECK_INTERVAL);
+    jobFrame = displayScheduler.addOneShot("frame", 0, renderDisplayFrame);
+
+    // Supervisor-Task
+    jobHealthCheck = healthScheduler.addPeriodic("check", HEALTH_CHECK_INTERVAL, checkHealth);
+    jobHealthStats = healthScheduler.addPeriodic("stats", SCHEDULER_STATS_INTERVAL, logHealthStats, SCHEDULER_STATS_INTERVAL);
+
+    // Abonnements, zugestellt von processNetworkMessages() bzw. processDisplayMessages()
+    networkEvents.add(serviceSettingsEvents);
+    displayEvents.add(displaySettingsEvents);
+    displayEvents.add(clockEvents);
+    displayEvents.add(minuteEvents);
+    displayEvents.add(pollenEvents);
+    displayEvents.add(indoorEvents);
+    displayEvents.add(airQualityEvents);
+    displayEvents.add(weatherEvents);
+}
+
+// Muss regelmässig laufen, damit der Webserver und der CoAP-Server Anfragen verarbeiten können.
+void handleClients() {
+  ConfigurationPortal::getInstance().handleClient();
+  // CoAP-Anfragen verarbeiten (nicht blockierend, nur bereits empfangene Pakete)
+  CoapServer::getInstance().handleClient();
 }
 
-void updateWeatherApi(unsigned long &lastApiCall, boolean forceUpdate){
-    // Nutze das konfigurierte Update-Intervall in Minuten, um Millisekunden zu berechnen
-    unsigned long updateIntervalMs = (unsigned long)currentDeviceConfig.weatherUpdateIntervalMin * 60 * 1000UL;
-    if (forceUpdate || millis() - lastApiCall >= updateIntervalMs ) {
-        lastApiCall = millis();
-        Logger::log(LogLevel::Info, "Abfrage von Wetterdaten...");
+// NTP abfragen und mit jeder neuen Antwort die lokale Uhr stellen (nur im Normalbetrieb, da NTP eine WLAN-Verbindung benötigt).
+// Ohne WLAN läuft die Uhr in allen Tasks mit der zuletzt gemessenen Gangabweichung weiter.
+void syncTime() {
+  if (currentState != STATE_NORMAL_OPERATION) {
+    return;
+  }
+  NTPTimeSync& timeSync = NTPTimeSync::getInstance();
+  bool updated = timeSync.update();
+  if (!timeSync.isTimeSet()) {
+    return; // Noch keine gültige Zeit, eine wiederhergestellte Zeit bleibt bis dahin bestehen
+  }
+  // Zwischen den Antworten rechnet auch NTPClient nur mit millis() weiter, das wäre keine neue Messung
+  if (!updated && networkClock.isSynced()) {
+    return;
+  }
+  unsigned long now = millis();
+  int32_t correction = networkClock.sync((uint32_t)timeSync.getEpochTime(), now);
+  ClockQuality quality = networkClock.getQuality(now);
+  Logger::log(LogLevel::Debug, "Uhr per NTP gestellt: Korrektur " + String(correction) + " ms, Gangabweichung " +
+              String(quality.driftPpm, 1) + " ppm" + (quality.driftMeasured ? "" : " (noch nicht gemessen)"));
+  clockTopic.publish(networkClock);
+}
 
-        // Wetterdaten abrufen, nutze die konfigurierten Koordinaten
-        if (WeatherClient::getInstance().getCurrentConditions(currentDeviceConfig.latitude, currentDeviceConfig.longitude, currentWeatherData)) {
-            Logger::log(LogLevel::Info, "Wetterdaten erfolgreich abgerufen.");
-        } else {
-            Logger::log(LogLevel::Error, "Fehler beim Abrufen der Wetterdaten.");
+// Verarbeitet die Nachrichten der Netzwerk-Task und stellt neue Werte der Topics zu. Läuft in der Anzeige-Task,
+// damit alle Zugriffe auf I2C, LED-Streifen und MP3-Player aus derselben Task kommen.
+void processDisplayMessages() {
+  DisplayMessage message;
+  while (displayQueue.receive(message)) {
+    switch (message.type) {
+      case DISPLAY_MSG_ONLINE:
+        networkOnline = message.online;
+        if (networkOnline) {
+          displayScheduler.trigger(jobClock); // Zeit sofort anzeigen
         }
+        break;
+      case DISPLAY_MSG_IP_ADDRESS:
+        displayIpAddress = message.ipAddress;
+        break;
+      case DISPLAY_MSG_RECOVER:
+        recoverDisplaySubsystem(message.recover);
+        break;
+    }
+  }
+  displayEvents.dispatch();
+}
+
+// Verarbeitet die Nachrichten der Anzeige-Task (Menü) und stellt neue Werte der Topics zu.
+// Läuft in der Netzwerk-Task, da dort die Konfiguration und die API-Jobs liegen.
+void processNetworkMessages() {
+  NetworkMessage message;
+  while (networkQueue.receive(message)) {
+    switch (message.type) {
+      case NETWORK_MSG_REFRESH:
+        Logger::log(LogLevel::Info, "Aktualisierung über das Menü angefordert.");
+        networkScheduler.trigger(jobWeather);
+        networkScheduler.trigger(jobPollen);
+        networkScheduler.trigger(jobTimeSync);
+        break;
+      case NETWORK_MSG_DISPLAY_VALUES: {
+        AppConfig config = ConfigurationPortal::getInstance().getActiveConfig();
+        config.ledBrightness = message.brightness;
+        config.volume = message.volume;
+        ConfigurationPortal::getInstance().saveConfig(config);
+        publishDeviceSettings(config);
+        break;
+      }
+      case NETWORK_MSG_RECOVER:
+        recoverNetworkSubsystem(message.recover);
+        break;
     }
+  }
+  networkEvents.dispatch();
 }
 
-void updatePollenApi(unsigned long &lastApiCall , boolean forceUpdate){
-    // Nutze das konfigurierte Update-Intervall in Minuten, um Millisekunden zu berechnen
-    unsigned long updateIntervalMs = (unsigned long)currentDeviceConfig.pollenUpdateIntervalMin * 60 * 1000UL;
-    if (forceUpdate || millis() - lastApiCall >= updateIntervalMs) {
-        lastApiCall = millis();
-        Logger::log(LogLevel::Info, "Abfrage von Pollendaten...");
+// --- Health-Supervisor ---
 
-        // Pollen Daten abfragen, nutze die konfigurierten Koordinaten
-        if (PollenClient::getInstance().getCurrentPollen(currentDeviceConfig.latitude, currentDeviceConfig.longitude, currentPollenData)) {
-            Logger::log(LogLevel::Info, "Pollendaten erfolgreich abgerufen.");
+// Läuft in der Supervisor-Task
+void checkHealth() {
+  HealthSupervisor& health = HealthSupervisor::getInstance();
+  health.setProgress(HEALTH_NETWORK_TASK, networkTask.getLoopCount());
+  health.setProgress(HEALTH_DISPLAY_TASK, displayTask.getLoopCount());
+  health.check();
+}
 
-            // Anzeigen
-            int maxPollenLevel = max(currentPollenData.grassPollenLevel, max(currentPollenData.treePollenLevel, currentPollenData.weedPollenLevel));
-            updateDisplay->updatePollen(maxPollenLevel);
+void logHealthStats() {
+  HealthSupervisor::getInstance().logStats();
+  logTaskStats(healthTask);
+}
 
-        } else {
-            Logger::log(LogLevel::Error, "Fehler beim Abrufen der Pollendaten.");
-        }
+// Läuft in der Supervisor-Task. Eine hängende Netzwerk-Task kann ihre Queue nicht leeren, deshalb wird die
+// laufende Abfrage direkt abgebrochen. Alle anderen Massnahmen laufen in der Task, der das Subsystem gehört.
+void recoverSubsystem(HealthSubsystem subsystem, HealthAction action) {
+  HealthRecoveryRequest request = { (uint8_t)subsystem, (uint8_t)action };
+  switch (subsystem) {
+    case HEALTH_NETWORK_TASK:
+      WeatherClient::getInstance().cancel();
+      PollenClient::getInstance().cancel();
+      break;
+    case HEALTH_DISPLAY_TASK:
+      // Nur der Neustart ist angemeldet, den führt der Supervisor selbst aus
+      break;
+    case HEALTH_WEATHER_API:
+    case HEALTH_POLLEN_API: {
+      NetworkMessage message;
+      message.type = NETWORK_MSG_RECOVER;
+      message.recover = request;
+      networkQueue.send(message);
+      break;
+    }
+    default: {
+      DisplayMessage message;
+      message.type = DISPLAY_MSG_RECOVER;
+      message.recover = request;
+      displayQueue.send(message);
+      break;
+    }
+  }
+}
+
+void recoverNetworkSubsystem(const HealthRecoveryRequest& request) {
+  HealthSubsystem subsystem = (HealthSubsystem)request.subsystem;
+  if (request.action == HEALTH_ACTION_RESET_CLIENT) {
+    // TLS-Sitzung verwerfen, die nächste Abfrage baut die Verbindung neu auf
+    if (subsystem == HEALTH_WEATHER_API) {
+      WeatherClient::getInstance().resetConnection();
+    } else {
+      PollenClient::getInstance().resetConnection();
     }
+  } else if (request.action == HEALTH_ACTION_REINIT_PERIPHERAL && currentState == STATE_NORMAL_OPERATION) {
+    // WLAN-Verbindung neu aufbauen
+    WifiManager::getInstance().disconnect();
+    startWiFiConnection();
+  }
 }
 
+void recoverDisplaySubsystem(const HealthRecoveryRequest& request) {
+  HealthSubsystem subsystem = (HealthSubsystem)request.subsystem;
+  if (subsystem == HEALTH_MP3_PLAYER) {
+    if (request.action == HEALTH_ACTION_RESET_CLIENT) {
+      Mp3Player::getInstance().reset();
+    } else {
+      // Schnittstelle neu öffnen und den DFPlayer zurücksetzen, beides ohne auf ihn zu warten.
+      // Die Lautstärke stellt Mp3Player wieder ein, sobald er sich meldet.
+      Mp3Player::getInstance().begin(Serial1);
+      Mp3Player::getInstance().setVolume(displaySettings.volume);
+      Mp3Player::getInstance().reset();
+    }
+    return;
+  }
+  if (request.action == HEALTH_ACTION_REINIT_PERIPHERAL) {
+    // Hängenden i2c Bus befreien, danach die Sensoren wie beim Start initialisieren
+    if (!I2cBusRecovery::recover(Wire, I2C_SDA_PIN, I2C_SCL_PIN, I2C_CLOCK)) {
+      Logger::log(LogLevel::Error, "i2c Bus: SDA bleibt nach der Wiederherstellung auf Low.");
+    }
+    updateDisplay.refreshSegments(); // Stand der PCF8574 nach der Wiederherstellung unbekannt
+  }
+  if (subsystem == HEALTH_TEMP_SENSOR) {
+    if (TempHumi* sensor = tempHumi.get()) sensor->begin();
+  } else if (subsystem == HEALTH_AIR_SENSOR) {
+    if (AirQuality* sensor = airQuality.get()) sensor->begin();
+  }
+}
 
-void loop() {
-  // Muss immer in der loop() aufgerufen werden, damit der Webserver Anfragen verarbeiten kann.
-  ConfigurationPortal::getInstance().handleClient();
+// Läuft in der Anzeige-Task, da der DFPlayer auch dort angesteuert wird. Wartet nie auf den DFPlayer:
+// ausgewertet wird die Antwort auf die Abfrage des letzten Durchlaufs, dann geht die nächste Abfrage hinaus.
+void checkMp3Player() {
+  Mp3Player& player = Mp3Player::getInstance();
+  if (player.hasResponded()) {
+    HealthSupervisor::getInstance().reportProgress(HEALTH_MP3_PLAYER);
+  } else {
+    HealthSupervisor::getInstance().reportFailure(HEALTH_MP3_PLAYER);
+  }
+  player.requestState();
+}
+
+// --- Tasten und Menü (Anzeige-Task) ---
+
+// Läuft in der Interrupt-Routine der Tasten
+void wakeDisplayTask() {
+  displayTask.notifyFromIsr();
+}
 
-  // Statische Variable, um sicherzustellen, dass initializeNetworkServices()
-  // nur einmal aufgerufen wird, wenn currentState auf STATE_NORMAL_OPERATION wechselt.
-  static bool servicesInitializedInNormalOp = false;
-
-  // Letzter API Aufruf
-  static unsigned long lastApiCallWeather = 0;
-  static unsigned long lastApiCallPollen = 0;
-  // Sensoren
-  static unsigned long lastSensorCall = 0;
-  static unsigned long showDisplayValuesTimer = 0; // Umbenannt von showIndoorValues für Klarheit
-  static boolean showingIndoor = true; // Umbenannt von showIndoor
-
-  // Logik für die Anzeige der Innen-/Aussentemperatur
-  // Nutzt die konfigurierten Anzeigedauern
-  unsigned long indoorDisplayTimeMs = (unsigned long)currentDeviceConfig.indoorTempDisplayTimeSec * 1000UL;
-  unsigned long outdoorDisplayTimeMs = (unsigned long)currentDeviceConfig.outdoorTempDisplayTimeSec * 1000UL;
-
-  if (currentState == STATE_NORMAL_OPERATION) {
-    if (showingIndoor) {
-      updateSensorValues(lastSensorCall); // Zeigt Innentemperatur/Feuchtigkeit
-      if (millis() - showDisplayValuesTimer >= indoorDisplayTimeMs) {
-        showingIndoor = false;
-        showDisplayValuesTimer = millis(); // Timer für Aussentemperatur starten
+// Gibt die Tastenereignisse an das Menü weiter und plant sich selbst neu ein, solange eine
+// Auswertung (Entprellung, langer Druck) oder das automatische Schliessen des Menüs aussteht.
+// Sonst läuft der Job erst wieder, wenn ein Tasten-Interrupt die Task weckt.
+void processButtons() {
+  ButtonInput& buttons = ButtonInput::getInstance();
+  ButtonEvent event;
+  while (buttons.poll(event)) {
+    bool wasActive = deviceMenu.isActive();
+    deviceMenu.setValues(displaySettings.brightness, displaySettings.volume);
+    MenuAction action = deviceMenu.handle(event, millis());
+    applyMenuAction(action, wasActive);
+    // Gemessen wird nur, was die Anzeige verändert
+    if (action != MENU_ACTION_NONE && (wasActive || deviceMenu.isActive())) {
+      recordInputLatency(event.edgeMicros);
+    }
+  }
+  applyMenuAction(deviceMenu.checkTimeout(millis()), true);
+
+  unsigned long delayMs = 0;
+  bool pending = buttons.nextPoll(delayMs);
+  if (deviceMenu.isActive()) {
+    unsigned long timeoutMs = deviceMenu.timeUntilTimeout(millis());
+    if (!pending || timeoutMs < delayMs) {
+      delayMs = timeoutMs;
+      pending = true;
+    }
+  }
+  if (pending) {
+    displayScheduler.reschedule(jobButtons, delayMs);
+  }
+}
+
+void applyMenuAction(MenuAction action, bool wasActive) {
+  switch (action) {
+    case MENU_ACTION_OPENED:
+      renderMenu(true);
+      break;
+    case MENU_ACTION_CHANGED:
+      renderMenu(false);
+      break;
+    case MENU_ACTION_CLOSED:
+      closeMenu();
+      break;
+    case MENU_ACTION_REFRESH: {
+      if (wasActive) {
+        closeMenu();
       }
-    } else {
-      // Zeigt Aussentemperatur/Wetterdaten
-      updateDisplay->updateWeather(currentWeatherData.weatherType);
-      updateDisplay->updateTemperature(currentWeatherData.temperature.degrees);
-      updateDisplay->updateTempLED(false); // Annahme: false bedeutet Aussentemp-LED
-      updateDisplay->updateHumidity(currentWeatherData.relativeHumidity);
-      updateDisplay->updateHumiLED(false); // Annahme: false bedeutet Aussentemp-LED
-
-      if (millis() - showDisplayValuesTimer >= outdoorDisplayTimeMs) {
-        showingIndoor = true;
-        showDisplayValuesTimer = millis(); // Timer für Innentemperatur starten
+      NetworkMessage message;
+      message.type = NETWORK_MSG_REFRESH;
+      networkQueue.send(message);
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+// Zeigt den aktuellen Menüpunkt (1-4) und seinen Wert. Helligkeit und Lautstärke werden sofort angewendet.
+void renderMenu(boolean opened) {
+  if (opened) {
+    updateDisplay.showMenu();
+  }
+  updateDisplay.showActMenuPoint(deviceMenu.getPoint() + 1);
+  if (deviceMenu.getPoint() != MENU_POINT_IP_ADDRESS) {
+    updateDisplay.hideMatrixText();
+  }
+  switch (deviceMenu.getPoint()) {
+    case MENU_POINT_IP_ADDRESS: {
+      // Die ganze Adresse läuft durch, Auf/Ab springt zum Anfang des gewählten Oktetts.
+      // IPAddress speichert das erste Oktett im niederwertigsten Byte.
+      // Auf dem Buchstabenraster läuft sie zusätzlich in voller Grösse durch.
+      char text[16];
+      size_t length = 0;
+      size_t startCell = 0;
+      size_t startChar = 0;
+      for (int octet = 0; octet < 4; octet++) {
+        if (octet == deviceMenu.getIpOctet()) {
+          startCell = length - octet; // Die Punkte belegen keine eigene Stelle
+          startChar = length;
+        }
+        length += snprintf(text + length, sizeof(text) - length, octet < 3 ? "%d." : "%d",
+                           (int)((displayIpAddress >> (8 * octet)) & 0xFF));
       }
+      updateDisplay.showMenuText(text, startCell);
+      updateDisplay.showMatrixText(text, matrixTextColumn(text, startChar));
+      break;
     }
+    case MENU_POINT_BRIGHTNESS:
+      if (deviceMenu.getBrightness() != displaySettings.brightness) {
+        displaySettings.brightness = deviceMenu.getBrightness();
+        applyBrightness();
+      }
+      updateDisplay.showMenuValue(displaySettings.brightness);
+      break;
+    case MENU_POINT_VOLUME:
+      if (deviceMenu.getVolume() != displaySettings.volume) {
+        displaySettings.volume = deviceMenu.getVolume();
+        updateDisplay.updateVolume(displaySettings.volume);
+      }
+      updateDisplay.showMenuValue(displaySettings.volume);
+      break;
+    default:
+      updateDisplay.clearMenuValue();
+      break;
+  }
+}
+
+// Speichert geänderte Werte über die Netzwerk-Task und stellt die normale Anzeige sofort wieder her.
+void closeMenu() {
+  if (deviceMenu.hasChangedValues()) {
+    NetworkMessage message;
+    message.type = NETWORK_MSG_DISPLAY_VALUES;
+    message.brightness = displaySettings.brightness;
+    message.volume = displaySettings.volume;
+    networkQueue.send(message);
+  }
+
+  // Das Menü hat die 7-Segment-Anzeigen überschrieben und Werte verpasst: die aktuellen Werte erneut zustellen
+  updateDisplay.hideMenu();
+  showingIndoor = true;
+  indoorEvents.redeliver();
+  airQualityEvents.redeliver();
+  pollenEvents.redeliver();
+  minuteEvents.redeliver();
+  displayEvents.dispatch();
+  displayScheduler.trigger(jobSensors);
+  displayScheduler.trigger(jobClock);
+  displayScheduler.reschedule(jobDisplayToggle, (unsigned long)displaySettings.indoorTimeSec * 1000UL);
+}
+
+void recordInputLatency(unsigned long edgeMicros) {
+  uint32_t latency = (uint32_t)(micros() - edgeMicros);
+  inputLatency.update([latency](InputLatencyStats& stats) {
+    stats.events++;
+    stats.totalMicros += latency;
+    if (latency > stats.maxMicros) stats.maxMicros = latency;
+  });
+}
+
+// Wechselt zwischen der Anzeige der Innen- und Aussenwerte und plant sich mit der
+// jeweils konfigurierten Anzeigedauer selbst neu ein.
+void toggleIndoorOutdoor() {
+  // Während das Menü offen ist, pausiert der Wechsel. closeMenu() plant ihn neu ein.
+  if (deviceMenu.isActive()) {
+    return;
+  }
+  unsigned long indoorDisplayTimeMs = (unsigned long)displaySettings.indoorTimeSec * 1000UL;
+  unsigned long outdoorDisplayTimeMs = (unsigned long)displaySettings.outdoorTimeSec * 1000UL;
+
+  // Aussenwerte nur, wenn die Wetter-API (oder der Warmstart) bereits welche geliefert hat
+  if (networkOnline && showingIndoor && weatherTopic.hasValue()) {
+    showingIndoor = false;
+    weatherEvents.redeliver();
+    weatherEvents.dispatch(); // Aussenwerte sofort anzeigen
+    displayScheduler.reschedule(jobDisplayToggle, outdoorDisplayTimeMs);
   } else {
-    // Wenn nicht im Normalbetrieb, immer Innensensorwerte anzeigen oder nichts
-    updateSensorValues(lastSensorCall);
-    // Setze den Timer zurück, damit er beim Wechsel in NORMAL_OPERATION neu startet
-    showDisplayValuesTimer = millis();
+    // Wenn nicht im Normalbetrieb, immer Innensensorwerte anzeigen
     showingIndoor = true;
+    indoorEvents.redeliver();
+    indoorEvents.dispatch(); // Letzte Innenwerte sofort anzeigen
+    displayScheduler.trigger(jobSensors); // und neu messen
+    displayScheduler.reschedule(jobDisplayToggle, indoorDisplayTimeMs);
+  }
+}
+
+// Zeigt Aussentemperatur/Wetterdaten
+void showOutdoorValues(const OutdoorWeather& weather) {
+  updateDisplay.updateWeather((WeatherConditionType)weather.weatherType);
+  updateDisplay.updateTemperature(weather.temperature);
+  updateDisplay.updateTempLED(false); // Annahme: false bedeutet Aussentemp-LED
+  updateDisplay.updateHumidity(weather.humidity);
+  updateDisplay.updateHumiLED(false); // Annahme: false bedeutet Aussentemp-LED
+}
+
+// Berechnet die angezeigte Minute, sobald eine Uhrzeit vorliegt (per NTP oder beim Warmstart wiederhergestellt).
+// Zwischen den Synchronisationen und ohne WLAN läuft die lokale Uhr über millis() weiter.
+// Die Wortuhr wird nur bei einer neuen Minute gezeichnet (onClockMinute).
+void updateClock() {
+  if (!displayClock.isValid()) {
+    return;
+  }
+  uint32_t epochTime = displayClock.now(millis());
+  ClockMinute minute;
+  minute.hour = (uint8_t)((epochTime % 86400UL) / 3600UL);
+  minute.minute = (uint8_t)((epochTime % 3600UL) / 60UL);
+  bool hadMinute = minuteTopic.hasValue();
+  // Stundenschlag nur beim Wechsel auf die volle Stunde, nicht beim ersten Wert nach dem Start
+  // und nur, wenn die Lautstärke > 0 ist
+  if (minuteTopic.publish(minute) && hadMinute && minute.minute == 0) {
+    updateDisplay.playHourChime(minute.hour, displaySettings.volume > 0);
+  }
+  minuteEvents.dispatch();
+}
+
+// --- Handler der Anzeige-Task ---
+
+void onDisplaySettings(const DisplaySettings& settings) {
+  displaySettings = settings;
+  displaySettingsValid = true;
+  CRGB displayColor = CRGB(displaySettings.textColor);
+  updateDisplay.setColorTime(displayColor.r, displayColor.g, displayColor.b);
+  applyBrightness();
+  updateDisplay.updateVolume(displaySettings.volume);
+  minuteEvents.redeliver(); // Wortuhr in der neuen Farbe zeichnen
+  Logger::log(LogLevel::Info, "Anzeige: Farbe 0x" + String(displaySettings.textColor, HEX) +
+              ", Helligkeit " + String(displaySettings.brightness) + ", Lautstärke " + String(displaySettings.volume) + " gesetzt.");
+}
+
+// Das Menü belegt die 7-Segment-Anzeige, beim Schliessen werden die Werte erneut zugestellt
+void onIndoorClimate(const IndoorClimate& climate) {
+  if (deviceMenu.isActive() || !showingIndoor) {
+    return;
   }
+  updateDisplay.updateTemperature(climate.temperature);
+  updateDisplay.updateTempLED(true);
+  updateDisplay.updateHumidity(climate.humidity);
+  updateDisplay.updateHumiLED(true);
+}
 
+void onAirQuality(const uint8_t& iaq) {
+  if (deviceMenu.isActive()) {
+    return;
+  }
+  updateDisplay.updateAirQuality(iaq);
+}
+
+void onWeather(const OutdoorWeather& weather) {
+  if (deviceMenu.isActive() || showingIndoor) {
+    return;
+  }
+  showOutdoorValues(weather);
+}
+
+void onPollen(const PollenLevels& pollen) {
+  if (!deviceMenu.isActive() && maxPollenLevel(pollen) >= 0) {
+    updateDisplay.updatePollen(maxPollenLevel(pollen));
+  }
+}
+
+void onClockTime(const LocalClock& clock) {
+  if (clock.isSynced() && displayClock.isValid() && !displayClock.isSynced()) {
+    // Erste Zeit von NTP nach einem Warmstart: Abweichung der wiederhergestellten Zeit ausgeben
+    unsigned long now = millis();
+    long deviation = (long)((int64_t)clock.nowEpochMs(now) - (int64_t)displayClock.nowEpochMs(now));
+    Logger::log(LogLevel::Info, "Warmstart-Zeit durch NTP bestätigt, Abweichung " + String(deviation) + " ms.");
+  }
+  displayClock = clock;
+}
+
+void onClockMinute(const ClockMinute& minute) {
+  if (deviceMenu.isActive()) {
+    return;
+  }
+  updateDisplay.updateTime(minute.hour, minute.minute);
+}
+
+// Job: ausstehendes Frame senden, bei erreichter Frame-Obergrenze später erneut
+void renderDisplayFrame() {
+  unsigned long waitMs = updateDisplay.renderFrame(millis());
+  if (waitMs > 0) {
+    displayScheduler.reschedule(jobFrame, waitMs);
+  }
+}
+
+// Die Anzeige hat ein Frame angefordert (läuft in der Anzeige-Task)
+void requestDisplayFrame() {
+  displayScheduler.trigger(jobFrame);
+}
+
+int maxPollenLevel(const PollenLevels& pollen) {
+  return max(pollen.grass, max(pollen.tree, pollen.weed));
+}
+
+// --- Warmstart ---
+
+// Stellt die Anzeige nach einem Reset sofort aus dem RTC-Speicher wieder her (noch vor dem Start der Tasks).
+// Die Werte gelten, bis NTP, die APIs und die Konfiguration sie ersetzen. Ein Topic, das bereits einen
+// Wert hat (z.B. die schon geladene Konfiguration), behält diesen.
+bool restoreWarmBoot() {
+  WarmBootState state;
+  if (!WarmBootSnapshot::load(state)) {
+    return false;
+  }
+  memcpy(&warmBootState, &state, sizeof(state));
+
+  if (state.settingsValid) {
+    // Farbe und Helligkeit sofort, die Lautstärke setzt onDisplaySettings, sobald der DFPlayer bereit ist
+    displaySettingsTopic.publishIfEmpty(state.settings);
+    displaySettingsTopic.read(displaySettings);
+    displaySettingsValid = true;
+    CRGB displayColor = CRGB(displaySettings.textColor);
+    updateDisplay.setColorTime(displayColor.r, displayColor.g, displayColor.b);
+    applyBrightness();
+  }
+
+  if (state.timeValid) {
+    // millis() läuft seit dem Reset: mit der Referenz 0 wird die Zeit seit dem Start mitgezählt.
+    // Unberücksichtigt bleibt nur die Zeit zwischen der letzten Sicherung und dem Reset (Anfangsfehler).
+    LocalClock clock;
+    clock.seed(state.epochTime, 0, WARM_BOOT_SAVE_INTERVAL);
+    clockTopic.publishIfEmpty(clock);
+    clockEvents.dispatch();
+    updateClock();
+  }
+
+  if (state.weatherValid) {
+    OutdoorWeather weather;
+    weather.temperature = state.outdoorTemperature;
+    weather.humidity = state.outdoorHumidity;
+    weather.weatherType = state.weatherType;
+    weatherTopic.publishIfEmpty(weather);
+  }
+
+  if (maxPollenLevel(state.pollen) >= 0) {
+    pollenTopic.publishIfEmpty(state.pollen);
+    pollenEvents.dispatch();
+  }
+
+  displayIpAddress = state.ipAddress;
+  return true;
+}
+
+// Sichert den Anzeigezustand im RTC-Speicher, sobald sich etwas geändert hat (mit gültiger Zeit also jede Sekunde).
+// Läuft in der Anzeige-Task, damit es genau einen Schreiber gibt.
+void saveWarmBootState() {
+  OutdoorWeather weather;
+  PollenLevels pollen = { -1, -1, -1 };
+
+  WarmBootState state;
+  memcpy(&state, &warmBootState, sizeof(state)); // Auch die Füllbytes, damit der Vergleich stimmt
+  state.timeValid = displayClock.isValid();
+  state.epochTime = displayClock.isValid() ? displayClock.now(millis()) : 0;
+  state.weatherValid = weatherTopic.read(weather);
+  state.outdoorTemperature = weather.temperature;
+  state.outdoorHumidity = weather.humidity;
+  state.weatherType = weather.weatherType;
+  pollenTopic.read(pollen);
+  state.pollen = pollen;
+  state.settingsValid = displaySettingsValid;
+  state.settings = displaySettings;
+  state.ipAddress = displayIpAddress;
+
+  if (memcmp(&state, &warmBootState, sizeof(state)) == 0) {
+    return;
+  }
+  memcpy(&warmBootState, &state, sizeof(state));
+  WarmBootSnapshot::save(state);
+}
+
+void logNetworkStats() {
+  logTaskStats(networkTask);
+  logPowerStats();
+  EventBus::getInstance().logStats();
+}
+
+void logDisplayStats() {
+  logTaskStats(displayTask);
+  Logger::log(LogLevel::Info, "Eigenerwärmung " + String(thermalModel.getSelfHeating(), 2) + " °C (CPU " +
+              String(thermalModel.getContribution(THERMAL_LOAD_CPU), 2) + ", LED " +
+              String(thermalModel.getContribution(THERMAL_LOAD_LED), 2) + ", Heizung " +
+              String(thermalModel.getContribution(THERMAL_LOAD_HEATER), 2) + "), Koeffizienten " +
+              String(thermalModel.getCoefficient(THERMAL_LOAD_CPU), 2) + "/" +
+              String(thermalModel.getCoefficient(THERMAL_LOAD_LED), 2) + "/" +
+              String(thermalModel.getCoefficient(THERMAL_LOAD_HEATER), 2) + " °C, Restfehler RMS " +
+              String(thermalModel.getResidualRms(), 3) + " °C (" + String(thermalModel.getFitCount()) + " von " +
+              String(thermalModel.getObservationCount()) + " Beobachtungen angepasst)" +
+              (thermalDecision.mode == THERMAL_MODE_REDUCED ? ", gedrosselt" : ""));
+  if (displayClock.isValid()) {
+    ClockQuality quality = displayClock.getQuality(millis());
+    Logger::log(LogLevel::Info, String("Uhr: ") + (quality.synced ? "per NTP gestellt" : "wiederhergestellt") +
+                ", vor " + String(quality.secondsSinceSync) + " s, geschätzter Fehler " + String(quality.estimatedErrorMs) +
+                " ms, Gangabweichung " + String(quality.driftPpm, 1) + " ppm" + (quality.driftMeasured ? "" : " (noch nicht gemessen)"));
+  }
+  // Frames pro Sekunde seit der letzten Ausgabe
+  static DisplayRenderStats lastRender = {};
+  static unsigned long lastRenderMs = 0;
+  DisplayRenderStats render = updateDisplay.getRenderStats();
+  unsigned long nowMs = millis();
+  float seconds = (nowMs - lastRenderMs) / 1000.0f;
+  uint32_t frames = render.frames - lastRender.frames;
+  Logger::log(LogLevel::Info, "Anzeige: " + String(render.rendered) + " Bereiche neu berechnet, " + String(render.skipped) +
+              " unverändert übersprungen, " + String(render.shown) + " Frames gesendet, " + String(render.unchanged) +
+              " identische Frames verworfen; " + String(frames / seconds, 2) + " Frames/s, " +
+              String((render.shown - lastRender.shown) / seconds, 2) + " gesendet/s, Frame-Zeit Ø " +
+              String(frames > 0 ? (uint32_t)((render.totalFrameMicros - lastRender.totalFrameMicros) / frames) : 0) +
+              " µs / max " + String(render.maxFrameMicros) + " µs");
+  Logger::log(LogLevel::Info, "LED-Ausgabe: blockiert " +
+              String((uint32_t)((render.blockedMicros - lastRender.blockedMicros) / 1000)) + " ms (max " +
+              String(render.maxBlockedMicros) + " µs am Stück), " + String(render.dropped - lastRender.dropped) +
+              " Frames verworfen");
+  String segmentErrors;
+  for (size_t i = 0; i < SEVEN_SEGMENT_COUNT; i++) {
+    uint32_t errors = updateDisplay.getSegmentStats(i).errors;
+    if (errors > 0) {
+      segmentErrors += " 0x" + String(SEVEN_SEGMENT_ADDRESSES[i], HEX) + ":" + String(errors);
+    }
+  }
+  Logger::log(LogLevel::Info, "7-Segment: " + String(render.segments.writes - lastRender.segments.writes) + " i2c Übertragungen, " +
+              String(render.segments.suppressed - lastRender.segments.suppressed) + " ohne Änderung unterdrückt, Fehler seit dem Start " +
+              (segmentErrors.length() > 0 ? segmentErrors : String("keine")));
+  uint32_t blends = render.blends - lastRender.blends;
+  if (blends > 0) {
+    Logger::log(LogLevel::Info, "Überblendung: " + String(blends) + " Frames, Mischen Ø " +
+                String((uint32_t)((render.totalBlendMicros - lastRender.totalBlendMicros) / blends)) + " µs / max " +
+                String(render.maxBlendMicros) + " µs, " + String(render.budgetOverruns - lastRender.budgetOverruns) +
+                " Frames über dem Budget, " + String(render.skippedFrames - lastRender.skippedFrames) + " ausgelassen");
+  }
+  lastRender = render;
+  lastRenderMs = nowMs;
+  InputLatencyStats stats = inputLatency.read();
+  if (stats.events > 0) {
+    Logger::log(LogLevel::Info, "Tasten: " + String(stats.events) + " Ereignisse, Latenz bis zur Anzeige Ø " +
+                String((uint32_t)(stats.totalMicros / stats.events)) + " µs / max " + String(stats.maxMicros) + " µs");
+  }
+}
+
+// Gibt pro Job Anzahl Ausführungen, mittlere/maximale Laufzeit und Verspätung sowie
+// CPU-Last und Stack-Reserve der Task aus. Muss in der jeweiligen Task selbst laufen.
+void logTaskStats(SchedulerTask& task) {
+  Scheduler& taskScheduler = task.getScheduler();
+  for (JobId id = 0; id < taskScheduler.getJobCount(); id++) {
+    const JobStats* stats = taskScheduler.getStats(id);
+    if (stats == nullptr || stats->runs == 0) {
+      continue;
+    }
+    Logger::log(LogLevel::Info, "Job " + String(task.getName()) + "/" + String(taskScheduler.getJobName(id)) +
+                ": " + String(stats->runs) + " Läufe, Laufzeit Ø " + String((uint32_t)(stats->totalRunMicros / stats->runs)) +
+                " µs / max " + String(stats->maxRunMicros) +
+                " µs, Verspätung Ø " + String((uint32_t)(stats->totalLatenessMs / stats->runs)) +
+                " ms / max " + String(stats->maxLatenessMs) + " ms");
+  }
+  task.sampleStats();
+  Logger::log(LogLevel::Info, "Task " + String(task.getName()) + ": CPU-Last " + String(task.getLoadPermille() / 10.0f, 1) +
+              " %, freier Stack min. " + String(task.getStackHighWaterMark()) + " Bytes");
+}
+
+// Bestimmt den Energiezustand aus dem Geräte- und WLAN-Zustand. Solange ein Client aktiv ist,
+// werden Anfragen im kurzen Intervall bearbeitet, sonst im Ruhe-Intervall, damit die CPU dazwischen schlafen kann.
+void updatePowerPolicy() {
+  // Anfragen werden über die Zähler von Webserver und CoAP-Server erkannt
+  static uint32_t lastRequestCount = 0;
+  static unsigned long lastRequestMs = 0;
+  static bool requestSeen = false;
+  uint32_t requestCount = CoapServer::getInstance().getRequestCount() + ConfigurationPortal::getInstance().getRequestCount();
+  if (requestCount != lastRequestCount) {
+    lastRequestCount = requestCount;
+    lastRequestMs = millis();
+    requestSeen = true;
+  }
+
+  WifiState wifiState = WifiManager::getInstance().getState();
+  PowerInputs inputs;
+  inputs.stationConnected = wifiState == WIFI_STATE_CONNECTED;
+  inputs.wifiConnecting = wifiState == WIFI_STATE_CONNECTING || wifiState == WIFI_STATE_RECONNECTING;
+  inputs.accessPointActive = currentState == STATE_AP_MODE;
+  inputs.apiRequestActive = false; // Wird vom PowerManager selbst verwaltet (setApiRequestActive)
+  inputs.msSinceClientRequest = requestSeen ? millis() - lastRequestMs : ULONG_MAX;
+
+  const PowerDecision& decision = PowerManager::getInstance().update(inputs);
+  networkScheduler.setInterval(jobClientPoll, decision.clientPollMs);
+}
+
+// Gibt die Zeit pro Energiezustand seit dem Start aus
+void logPowerStats() {
+  PowerManager& power = PowerManager::getInstance();
+  String times;
+  for (int mode = 0; mode < POWER_MODE_COUNT; mode++) {
+    times += (mode > 0 ? ", " : "") + String(PowerManager::modeToString((PowerMode)mode)) + " " +
+             String((uint32_t)(power.getTimeMs((PowerMode)mode) / 1000)) + " s";
+  }
+  Logger::log(LogLevel::Info, "Energie: " + times + ", Modem-Sleep " + String((uint32_t)(power.getModemSleepTimeMs() / 1000)) +
+              " s, " + String(power.getTransitionCount()) + " Wechsel, aktuell " + String(getCpuFrequencyMhz()) + " MHz");
+}
+
+// Zustandsautomat für WLAN und Netzwerkdienste.
+// Blockiert nie: Verbindungsaufbau und Reconnect laufen im WLAN-Stack, hier werden nur
+// die von WifiManager gemeldeten Zustandswechsel umgesetzt.
+void runStateMachine() {
+  WifiTransition transition = WifiManager::getInstance().update();
 
   switch (currentState) {
     case STATE_INITIALIZING:
-      Logger::log(LogLevel::Info, "STATE_INITIALIZING: Versuche, WLAN-Konfiguration zu laden.");
       // Die Logik zum Laden der Konfiguration ist bereits im setup()
-      // und hat den currentState gesetzt. Hier passiert nichts, ausser warten auf den nächsten Loop-Durchlauf.
+      // und hat den currentState gesetzt.
       // Der Übergang zu STATE_CONNECTING_WIFI oder STATE_AP_MODE wurde bereits in setup() gehandhabt.
       break;
 
     case STATE_AP_MODE:
       // Der Webserver läuft und wartet auf Eingaben.
-      // handleClient() wird bereits am Anfang der loop() aufgerufen.
       // Der Übergang zu STATE_CONNECTING_WIFI erfolgt über den onConfigSavedCallback.
       break;
 
     case STATE_CONNECTING_WIFI:
-      Logger::log(LogLevel::Info, "STATE_CONNECTING_WIFI: Versuche zu verbinden.");
-      if (connectToWiFi()) { // Nutzt currentDeviceConfig
-          currentState = STATE_NORMAL_OPERATION;
-          // Da wir jetzt eine stabile WLAN-Verbindung haben, initialisiere die Dienste
-          if (!servicesInitializedInNormalOp) {
-              initializeNetworkServices();
-              // API das erste Mal aufrufen, um die aktuellen Daten zu erhalten.
-              updateWeatherApi(lastApiCallWeather, true);
-              updatePollenApi(lastApiCallPollen, true);
-              servicesInitializedInNormalOp = true; // Markiere, dass Dienste initialisiert wurden
-          }
-          // Starte den Webserver im Station-Modus, um weitere Einstellungen zu ermöglichen.
-          ConfigurationPortal::getInstance().startWebServerInStationMode();
-      } else {
+      if (transition == WIFI_TRANSITION_CONNECTED) {
+          onWiFiConnected();
+      } else if (transition == WIFI_TRANSITION_FAILED) {
           Logger::log(LogLevel::Error, "Verbindung fehlgeschlagen. Zurück zum AP-Modus.");
-          currentState = STATE_AP_MODE;
-          // AP neu starten, wenn Verbindung fehlschlägt
-          ConfigurationPortal::getInstance().startAPAndWebServer(AP_SSID, AP_PASSWORD);
+          startAccessPoint();
       }
       break;
 
     case STATE_NORMAL_OPERATION:
-      // Überprüfe kontinuierlich, ob die WLAN-Verbindung noch besteht
-      if (WiFi.status() != WL_CONNECTED) {
+      if (transition == WIFI_TRANSITION_LOST) {
           Logger::log(LogLevel::Error, "WLAN-Verbindung im Normalbetrieb verloren. Wechsel zu STATE_WIFI_CONNECTION_LOST.");
-          currentState = STATE_WIFI_CONNECTION_LOST;
-          servicesInitializedInNormalOp = false; // Dienste müssen eventuell neu initialisiert werden
-          break; // Sofortiger Wechsel des Zustands
+          setDeviceState(STATE_WIFI_CONNECTION_LOST);
+          deviceStatus.update([](DeviceStatus& status) { status.wifiConnectionLosses++; });
       }
-
-      // --- Dein normaler Betriebs-Code, der nur bei bestehender WLAN-Verbindung läuft ---
-      NTPTimeSync::getInstance().update(); // Zeit aktualisieren
-      updateDisplay->updateTime(NTPTimeSync::getInstance().getHour(), NTPTimeSync::getInstance().getMin(), currentDeviceConfig.volume > 0); // Den Song nur Abspielen, wenn die Lautstärke > 0 ist.
-
-      updateWeatherApi(lastApiCallWeather);
-      updatePollenApi(lastApiCallPollen);
-
-      // Optional: Zeit alle Sekunde ausgeben
-      // static unsigned long lastTimePrint = 0;
-      // if (millis() - lastTimePrint >= 1000) {
-      //     lastTimePrint = millis();
-      //     Serial.println("Mills: " + String(lastTimePrint));
-      //     Serial.println("Aktuelle Zeit: " + NTPTimeSync::getInstance().getFormattedTime());
-      //     delay(5000);
-      // }
+      // Der normale Betriebs-Code (Zeit, Wetter, Pollen) läuft als eigene Jobs im Scheduler
+      // (siehe updateClock, updateWeatherApi und updatePollenApi).
       break;
 
     case STATE_WIFI_CONNECTION_LOST:
-      Logger::log(LogLevel::Info, "STATE_WIFI_CONNECTION_LOST: Versuche erneut zu verbinden...");
-      if (connectToWiFi()) { // Nutzt currentDeviceConfig
+      // Der Reconnect läuft im Hintergrund, Anzeige und Sensoren laufen weiter.
+      if (transition == WIFI_TRANSITION_CONNECTED) {
           Logger::log(LogLevel::Info, "Erneute WLAN-Verbindung erfolgreich hergestellt.");
-          currentState = STATE_NORMAL_OPERATION;
-          // Dienste müssen hier nicht neu initialisiert werden, da die Instanzen erhalten bleiben.
-          // NTPClient.begin() wird bei jedem NTPTimeSync.begin() aufgerufen.
-          // APIs sind bereits initialisiert.
-          if (!servicesInitializedInNormalOp) { // Falls Dienste aus irgendeinem Grund nicht initialisiert wurden
-                initializeNetworkServices();
-                servicesInitializedInNormalOp = true;
-          }
-          ConfigurationPortal::getInstance().startWebServerInStationMode();
-      } else {
+          onWiFiConnected();
+      } else if (transition == WIFI_TRANSITION_FAILED) {
           Logger::log(LogLevel::Error, "Erneute WLAN-Verbindung fehlgeschlagen. Starte Konfigurations-AP.");
-          currentState = STATE_AP_MODE;
-          // AP neu starten
-          ConfigurationPortal::getInstance().startAPAndWebServer(AP_SSID, AP_PASSWORD);
+          startAccessPoint();
       }
       break;
   }
+}
 
-  delay(10); // Kurze Pause, um den Watchdog nicht auszulösen und andere Tasks zuzulassen
+void loop() {
+  // Alle Jobs laufen in networkTask und displayTask, die Arduino-Loop-Task wird nicht mehr benötigt.
+  vTaskDelete(nullptr);
 }
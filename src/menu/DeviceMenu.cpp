@@ -0,0 +1,88 @@
+#include "DeviceMenu.h"
+
+const int MENU_MAX_BRIGHTNESS = 100;
+const int MENU_MAX_VOLUME = 30;
+
+DeviceMenu::DeviceMenu(unsigned long timeoutMs, int brightnessStep)
+  : _timeoutMs(timeoutMs), _brightnessStep(brightnessStep), _active(false), _point(MENU_POINT_IP_ADDRESS),
+    _ipOctet(0), _brightness(0), _volume(0), _valuesChanged(false), _lastInputMs(0) {}
+
+void DeviceMenu::setValues(int brightness, int volume) {
+    if (!_active) {
+        _brightness = brightness;
+        _volume = volume;
+    }
+}
+
+MenuAction DeviceMenu::handle(const ButtonEvent& event, unsigned long nowMs) {
+    _lastInputMs = nowMs;
+
+    if (!_active) {
+        if (event.button == MENU_BUTTON_SELECT && event.type == BUTTON_EVENT_LONG_PRESS) {
+            _active = true;
+            _point = MENU_POINT_IP_ADDRESS;
+            _ipOctet = 0;
+            _valuesChanged = false;
+            return MENU_ACTION_OPENED;
+        }
+        if (event.button == MENU_BUTTON_UP && event.type == BUTTON_EVENT_PRESS && event.count == 2) {
+            return MENU_ACTION_REFRESH;
+        }
+        return MENU_ACTION_NONE;
+    }
+
+    if (event.button == MENU_BUTTON_SELECT) {
+        if (event.type == BUTTON_EVENT_LONG_PRESS) {
+            _active = false;
+            return MENU_ACTION_CLOSED;
+        }
+        _point = (MenuPoint)((_point + 1) % MENU_POINT_COUNT);
+        _ipOctet = 0;
+        return MENU_ACTION_CHANGED;
+    }
+    if (event.type != BUTTON_EVENT_PRESS) {
+        return MENU_ACTION_NONE;
+    }
+    return changeValue(event.button == MENU_BUTTON_UP ? 1 : -1);
+}
+
+MenuAction DeviceMenu::changeValue(int direction) {
+    switch (_point) {
+        case MENU_POINT_IP_ADDRESS:
+            _ipOctet = (_ipOctet + 4 + direction) % 4;
+            return MENU_ACTION_CHANGED;
+        case MENU_POINT_BRIGHTNESS: {
+            int brightness = _brightness + direction * _brightnessStep;
+            _brightness = brightness < 0 ? 0 : (brightness > MENU_MAX_BRIGHTNESS ? MENU_MAX_BRIGHTNESS : brightness);
+            _valuesChanged = true;
+            return MENU_ACTION_CHANGED;
+        }
+        case MENU_POINT_VOLUME: {
+            int volume = _volume + direction;
+            _volume = volume < 0 ? 0 : (volume > MENU_MAX_VOLUME ? MENU_MAX_VOLUME : volume);
+            _valuesChanged = true;
+            return MENU_ACTION_CHANGED;
+        }
+        case MENU_POINT_REFRESH:
+            if (direction > 0) {
+                _active = false;
+                return MENU_ACTION_REFRESH;
+            }
+            return MENU_ACTION_NONE;
+        default:
+            return MENU_ACTION_NONE;
+    }
+}
+
+MenuAction DeviceMenu::checkTimeout(unsigned long nowMs) {
+    if (_active && nowMs - _lastInputMs >= _timeoutMs) {
+        _active = false;
+        return MENU_ACTION_CLOSED;
+    }
+    return MENU_ACTION_NONE;
+}
+
+unsigned long DeviceMenu::timeUntilTimeout(unsigned long nowMs) const {
+    unsigned long elapsed = nowMs - _lastInputMs;
+    return elapsed >= _timeoutMs ? 0 : _timeoutMs - elapsed;
+}
@@ -0,0 +1,71 @@
+#ifndef DEVICE_MENU_H
+#define DEVICE_MENU_H
+
+#include <stdint.h>
+#include "../input/ButtonDecoder.h"
+
+// Tasten in der Reihenfolge, in der sie bei ButtonInput::begin() übergeben werden
+enum MenuButton {
+    MENU_BUTTON_SELECT,         // BUTTON_A (oben): Menü öffnen/schliessen (lang), nächster Menüpunkt (kurz)
+    MENU_BUTTON_DOWN,           // BUTTON_B (Mitte): Wert verringern
+    MENU_BUTTON_UP              // BUTTON_C (unten): Wert erhöhen bzw. bestätigen, doppelt ausserhalb des Menüs: Aktualisieren
+};
+
+// Menüpunkte (angezeigt als 1-4)
+enum MenuPoint {
+    MENU_POINT_IP_ADDRESS,      // IP-Adresse, Teil für Teil
+    MENU_POINT_BRIGHTNESS,      // Helligkeit 0-100
+    MENU_POINT_VOLUME,          // Lautstärke 0-30
+    MENU_POINT_REFRESH,         // Wetter, Pollen und Zeit sofort aktualisieren
+    MENU_POINT_COUNT
+};
+
+// Was der Aufrufer nach einem Ereignis tun muss
+enum MenuAction {
+    MENU_ACTION_NONE,
+    MENU_ACTION_OPENED,         // Menü anzeigen
+    MENU_ACTION_CHANGED,        // Menüpunkt oder Wert neu anzeigen
+    MENU_ACTION_CLOSED,         // Normale Anzeige wiederherstellen
+    MENU_ACTION_REFRESH         // Aktualisierung anstossen (ein offenes Menü ist danach geschlossen)
+};
+
+// Zustand des Menüs auf der 7-Segment-Anzeige. Reine Logik, die Anzeige übernimmt der Aufrufer.
+class DeviceMenu {
+public:
+    DeviceMenu(unsigned long timeoutMs, int brightnessStep);
+
+    // Übernimmt die aktuellen Werte, die beim nächsten Öffnen angezeigt werden.
+    void setValues(int brightness, int volume);
+
+    // Wertet ein Tastenereignis aus.
+    MenuAction handle(const ButtonEvent& event, unsigned long nowMs);
+
+    // Schliesst das Menü, wenn zu lange keine Taste gedrückt wurde.
+    MenuAction checkTimeout(unsigned long nowMs);
+
+    // Zeit bis zum automatischen Schliessen (nur bei offenem Menü sinnvoll)
+    unsigned long timeUntilTimeout(unsigned long nowMs) const;
+
+    bool isActive() const { return _active; }
+    MenuPoint getPoint() const { return _point; }
+    int getIpOctet() const { return _ipOctet; }           // 0-3
+    int getBrightness() const { return _brightness; }
+    int getVolume() const { return _volume; }
+    bool hasChangedValues() const { return _valuesChanged; } // Helligkeit oder Lautstärke seit dem Öffnen geändert
+
+private:
+    unsigned long _timeoutMs;
+    int _brightnessStep;
+
+    bool _active;
+    MenuPoint _point;
+    int _ipOctet;
+    int _brightness;
+    int _volume;
+    bool _valuesChanged;
+    unsigned long _lastInputMs;
+
+    MenuAction changeValue(int direction);
+};
+
+#endif // DEVICE_MENU_H
@@ -4,7 +4,10 @@
 #define MP3_RX_PIN D3
 #define MP3_TX_PIN D2
 
-Mp3Player::Mp3Player() {
+// Befehl "Status abfragen" im Protokoll des DFPlayers
+const uint8_t MP3_CMD_QUERY_STATE = 0x42;
+
+Mp3Player::Mp3Player() : mp3Serial(nullptr), _volume(-1), _volumePending(false), _responded(false) {
     // Der Konstruktor ist leer, die Initialisierung passiert in begin()
 }
 
@@ -15,15 +18,10 @@ bool Mp3Player::begin(HardwareSerial& serialPort) {
 
     Serial.println("Initialisiere DFPlayer Mini ...");
 
-    // Initialisiere die Bibliothek
-    if (!myDFPlayer.begin(*mp3Serial)) {
-        Serial.println("Verbindung zum DFPlayer Mini fehlgeschlagen!");
-        Serial.println("1. Bitte Verkabelung prüfen.");
-        Serial.println("2. Bitte SD-Karte einlegen und formatieren.");
-        return false;
-    }
-    Serial.println("DFPlayer Mini bereit.");
-
+    // Ohne Reset und ohne Bestätigung (ACK) wartet die Bibliothek bei keinem Befehl auf eine Antwort.
+    // Mit ACK würde jeder Befehl auf die Bestätigung des vorherigen warten (bis 500 ms, wenn der DFPlayer fehlt).
+    myDFPlayer.begin(*mp3Serial, false, false);
+    requestState();
     return true;
 }
 
@@ -53,8 +51,56 @@ void Mp3Player::play(int trackNumber) {
 //     myDFPlayer.previous();
 // }
 
+void Mp3Player::requestState() {
+    if (mp3Serial == nullptr) {
+        return;
+    }
+    readMessages(); // Ältere Meldungen zählen nicht als Antwort auf diese Abfrage
+    _responded = false;
+    sendCommand(MP3_CMD_QUERY_STATE, 0);
+}
+
+bool Mp3Player::hasResponded() {
+    readMessages();
+    return _responded;
+}
+
+void Mp3Player::readMessages() {
+    if (mp3Serial == nullptr) {
+        return;
+    }
+    // available() der Bibliothek liest nur, was bereits im Empfangspuffer liegt, und meldet jede gültige Meldung
+    while (myDFPlayer.available()) {
+        _responded = true;
+        if (_volumePending) {
+            _volumePending = false;
+            myDFPlayer.volume(_volume);
+        }
+    }
+}
+
+// Befehl ohne Bestätigung direkt senden: die Abfragen der Bibliothek (readState() usw.) warten auf die Antwort
+void Mp3Player::sendCommand(uint8_t command, uint16_t parameter) {
+    uint8_t frame[10] = { 0x7E, 0xFF, 0x06, command, 0x00, (uint8_t)(parameter >> 8), (uint8_t)parameter, 0, 0, 0xEF };
+    uint16_t checksum = 0;
+    for (int i = 1; i < 7; i++) {
+        checksum -= frame[i];
+    }
+    frame[7] = checksum >> 8;
+    frame[8] = checksum & 0xFF;
+    mp3Serial->write(frame, sizeof(frame));
+}
+
+void Mp3Player::reset() {
+    if (mp3Serial != nullptr) {
+        myDFPlayer.reset();
+        _volumePending = _volume >= 0;
+    }
+}
+
 void Mp3Player::setVolume(int volume) {
     if (volume < 0) volume = 0;
     if (volume > 30) volume = 30;
+    _volume = volume;
     myDFPlayer.volume(volume);
 }
\ No newline at end of file
@@ -12,7 +12,8 @@ public:
         return instance;
     }
 
-    // Initialisiert den Player mit einem seriellen Port
+    // Initialisiert den Player mit einem seriellen Port. Wartet nicht auf den DFPlayer: ob er antwortet,
+    // zeigt die Statusabfrage, die begin() gleich mitschickt (hasResponded()).
     bool begin(HardwareSerial& serialPort);
 
     // Grundlegende Steuerungsfunktionen
@@ -26,6 +27,17 @@ public:
     // Lautstärkeregelung (0-30)
     void setVolume(int volume);
 
+    // Statusabfrage senden, ohne auf die Antwort zu warten. Die Antwort wertet hasResponded() später aus
+    // (z.B. im nächsten Durchlauf eines periodischen Jobs).
+    void requestState();
+
+    // Liest die eingetroffenen Meldungen, ohne zu warten. true, wenn seit requestState() eine Meldung kam.
+    bool hasResponded();
+
+    // Setzt den DFPlayer zurück (Wiederherstellung, die serielle Schnittstelle bleibt offen).
+    // Die Lautstärke wird wieder eingestellt, sobald sich der DFPlayer danach meldet.
+    void reset();
+
 private:
     // Konstruktor
     Mp3Player();
@@ -39,6 +51,13 @@ private:
 
     // Ein Zeiger, um sich den seriellen Port zu merken
     HardwareSerial* mp3Serial;
+
+    int _volume;                // Zuletzt eingestellte Lautstärke, -1 = noch keine
+    bool _volumePending;        // Lautstärke nach einem Reset erneut senden
+    bool _responded;            // Meldung seit der letzten Statusabfrage erhalten
+
+    void readMessages();
+    void sendCommand(uint8_t command, uint16_t parameter);
 };
 
 #endif // MP3_PLAYER_H
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "PowerManager.h"
+#include <WiFi.h>
+#include <esp_sleep.h>
+#include "../logger/Logger.h"
+#include "../Settings.h"
+
+PowerManager::PowerManager()
+  : _config{ 0, 0, 0, false }, _inputs{ false, false, false, false, ULONG_MAX },
+    _decision{ POWER_MODE_ACTIVE, false, 0 }, _applied(false), _cpuMaxLock(nullptr), _noSleepLock(nullptr) {}
+
+void PowerManager::begin(unsigned long clientActiveMs, unsigned long activeClientPollMs, unsigned long idleClientPollMs) {
+    _config.clientActiveMs = clientActiveMs;
+    _config.activeClientPollMs = activeClientPollMs;
+    _config.idleClientPollMs = idleClientPollMs;
+    _decision.clientPollMs = activeClientPollMs;
+
+    // Arduino Nano ESP32 (ESP32-S3). Der Light-Sleep setzt ein Tickless-Idle im FreeRTOS voraus. Fehlt es in der verwendeten
+    // Plattform, meldet esp_pm_configure() ESP_ERR_NOT_SUPPORTED und es bleibt bei DFS.
+    esp_pm_config_esp32s3_t pmConfig = {};
+    pmConfig.max_freq_mhz = POWER_MAX_CPU_FREQ_MHZ;
+    pmConfig.min_freq_mhz = POWER_MIN_CPU_FREQ_MHZ;
+    pmConfig.light_sleep_enable = true;
+    esp_err_t result = esp_pm_configure(&pmConfig);
+    if (result == ESP_ERR_NOT_SUPPORTED) {
+        pmConfig.light_sleep_enable = false;
+        result = esp_pm_configure(&pmConfig);
+    }
+    if (result != ESP_OK) {
+        Logger::log(LogLevel::Error, "Energieverwaltung nicht verfügbar (Fehler " + String(result) + "), CPU läuft mit fester Frequenz.");
+        return;
+    }
+    _config.lightSleepSupported = pmConfig.light_sleep_enable;
+
+    if (esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "power_active", &_cpuMaxLock) != ESP_OK ||
+        esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "power_awake", &_noSleepLock) != ESP_OK) {
+        Logger::log(LogLevel::Error, "PM-Locks konnten nicht erstellt werden!");
+    }
+    configureWakeupSources();
+
+    // Bis zur ersten Auswertung der Policy mit voller Leistung laufen (Start, WLAN-Aufbau)
+    apply(_decision);
+    Logger::log(LogLevel::Info, "Energieverwaltung aktiv: " + String(POWER_MIN_CPU_FREQ_MHZ) + "-" + String(POWER_MAX_CPU_FREQ_MHZ) +
+                " MHz, Light-Sleep " + (_config.lightSleepSupported ? "aktiviert" : "nicht unterstützt") + ".");
+}
+
+void PowerManager::configureWakeupSources() {
+    // GPIO-Wakeup für die Tasten (die Pins selbst richtet ButtonInput ein).
+    // Timer und WLAN wecken im automatischen Light-Sleep ohne weitere Konfiguration.
+    esp_sleep_enable_gpio_wakeup();
+}
+
+const PowerDecision& PowerManager::update(const PowerInputs& inputs) {
+    bool apiRequestActive = _inputs.apiRequestActive; // Wird ausschliesslich über setApiRequestActive() gesetzt
+    _inputs = inputs;
+    _inputs.apiRequestActive = apiRequestActive;
+    apply(decidePowerMode(_inputs, _config));
+    return _decision;
+}
+
+void PowerManager::setApiRequestActive(bool active) {
+    _inputs.apiRequestActive = active;
+    apply(decidePowerMode(_inputs, _config));
+}
+
+void PowerManager::apply(const PowerDecision& decision) {
+    bool modeChanged = !_applied || decision.mode != _decision.mode;
+    bool modemChanged = !_applied || decision.modemSleep != _decision.modemSleep;
+    _decision.clientPollMs = decision.clientPollMs;
+    if (!modeChanged && !modemChanged) {
+        return;
+    }
+
+    if (modeChanged && _cpuMaxLock != nullptr && _noSleepLock != nullptr) {
+        // Locks sind Zähler: jeweils genau einmal halten bzw. freigeben
+        bool holdCpuMax = decision.mode == POWER_MODE_ACTIVE;
+        bool holdNoSleep = decision.mode != POWER_MODE_LIGHT_SLEEP;
+        bool heldCpuMax = _applied && _decision.mode == POWER_MODE_ACTIVE;
+        bool heldNoSleep = _applied && _decision.mode != POWER_MODE_LIGHT_SLEEP;
+        if (holdCpuMax && !heldCpuMax) esp_pm_lock_acquire(_cpuMaxLock);
+        if (!holdCpuMax && heldCpuMax) esp_pm_lock_release(_cpuMaxLock);
+        if (holdNoSleep && !heldNoSleep) esp_pm_lock_acquire(_noSleepLock);
+        if (!holdNoSleep && heldNoSleep) esp_pm_lock_release(_noSleepLock);
+    }
+
+    if (modemChanged) {
+        // Modem-Sleep: der Funk wacht nur zu den DTIM-Beacons des Access Points auf.
+        // Ohne Station merkt sich der WLAN-Stack die Einstellung für den nächsten Start.
+        WiFi.setSleep(decision.modemSleep ? WIFI_PS_MIN_MODEM : WIFI_PS_NONE);
+    }
+
+    if (modeChanged) {
+        Logger::log(LogLevel::Debug, "Energiezustand: " + String(modeToString(decision.mode)) +
+                    (decision.modemSleep ? " (Modem-Sleep)" : ""));
+    }
+    _times.enter(decision.mode, decision.modemSleep, millis());
+    _decision = decision;
+    _applied = true;
+}
+
+const char* PowerManager::modeToString(PowerMode mode) {
+    switch (mode) {
+        case POWER_MODE_ACTIVE: return "aktiv";
+        case POWER_MODE_IDLE: return "bereit";
+        case POWER_MODE_LIGHT_SLEEP: return "Light-Sleep";
+        default: return "unbekannt";
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+#include <esp_pm.h>
+#include "PowerPolicy.h"
+
+// Energieverwaltung des ESP32.
+// Aktiviert beim Start die dynamische Taktanpassung (DFS) und den automatischen Light-Sleep.
+// Ob die CPU tatsächlich schlafen darf, steuern zwei PM-Locks gemäss decidePowerMode():
+// im Zustand ACTIVE wird die volle Taktfrequenz gehalten, im Zustand IDLE nur der Light-Sleep verhindert.
+// Der WLAN-Funk wird zwischen den API-Abfragen in den Modem-Sleep versetzt.
+// Aus dem Light-Sleep wecken die Timer der Scheduler-Tasks, eingehende WLAN-Pakete und die Tasten.
+// update() und setApiRequestActive() dürfen nur aus der Netzwerk-Task aufgerufen werden.
+class PowerManager {
+public:
+    // Statische Methode, um die einzige Instanz zu erhalten (Singleton-Muster).
+    static PowerManager& getInstance() {
+        static PowerManager instance;
+        return instance;
+    }
+
+    // Konfiguriert DFS, Light-Sleep und die Weckquellen. Einmal in setup() aufrufen.
+    void begin(unsigned long clientActiveMs, unsigned long activeClientPollMs, unsigned long idleClientPollMs);
+
+    // Bestimmt den Energiezustand neu und wendet ihn bei Änderungen an.
+    const PowerDecision& update(const PowerInputs& inputs);
+
+    // Markiert den Beginn/das Ende einer API-Abfrage. Wechselt sofort in den Zustand ACTIVE bzw. zurück.
+    void setApiRequestActive(bool active);
+
+    const PowerDecision& getDecision() const { return _decision; }
+    bool isLightSleepSupported() const { return _config.lightSleepSupported; }
+
+    // Verbrachte Zeit pro Energiezustand und im Modem-Sleep seit dem Start
+    uint64_t getTimeMs(PowerMode mode) const { return _times.getTimeMs(mode, millis()); }
+    uint64_t getModemSleepTimeMs() const { return _times.getModemSleepTimeMs(millis()); }
+    uint32_t getTransitionCount() const { return _times.getTransitionCount(); }
+
+    static const char* modeToString(PowerMode mode);
+
+private:
+    PowerManager();
+    PowerManager(const PowerManager&) = delete;
+    PowerManager& operator=(const PowerManager&) = delete;
+
+    PowerPolicyConfig _config;
+    PowerInputs _inputs;
+    PowerDecision _decision;
+    PowerStateTimes _times;
+    bool _applied;
+
+    esp_pm_lock_handle_t _cpuMaxLock;       // Hält die volle Taktfrequenz (ACTIVE)
+    esp_pm_lock_handle_t _noSleepLock;      // Verhindert den Light-Sleep (ACTIVE, IDLE)
+
+    void apply(const PowerDecision& decision);
+    void configureWakeupSources();
+};
+
+#endif // POWER_MANAGER_H
@@ -0,0 +1,26 @@
+#include "PowerPolicy.h"
+
+PowerDecision decidePowerMode(const PowerInputs& inputs, const PowerPolicyConfig& config) {
+    PowerDecision decision;
+    bool clientActive = inputs.msSinceClientRequest < config.clientActiveMs;
+    decision.clientPollMs = (clientActive || inputs.accessPointActive) ? config.activeClientPollMs : config.idleClientPollMs;
+
+    if (inputs.apiRequestActive || inputs.wifiConnecting) {
+        // Verbindungsaufbau und TLS-Handshake so kurz wie möglich halten: volle Leistung, Funk immer an
+        decision.mode = POWER_MODE_ACTIVE;
+        decision.modemSleep = false;
+    } else if (inputs.accessPointActive) {
+        // Der SoftAP muss dauerhaft senden und empfangen, Light-Sleep und Modem-Sleep sind nicht möglich
+        decision.mode = POWER_MODE_IDLE;
+        decision.modemSleep = false;
+    } else if (clientActive) {
+        // Jemand bedient das Portal oder fragt CoAP ab: kurze Antwortzeiten statt Schlaf
+        decision.mode = POWER_MODE_IDLE;
+        decision.modemSleep = false;
+    } else {
+        // Nichts zu tun ausser den geplanten Jobs: zwischen den Deadlines schlafen
+        decision.mode = config.lightSleepSupported ? POWER_MODE_LIGHT_SLEEP : POWER_MODE_IDLE;
+        decision.modemSleep = inputs.stationConnected;
+    }
+    return decision;
+}
@@ -0,0 +1,90 @@
+#ifndef POWER_POLICY_H
+#define POWER_POLICY_H
+
+#include <stdint.h>
+#include <limits.h>
+
+// Energiezustand der CPU
+enum PowerMode {
+    POWER_MODE_ACTIVE,          // Volle Taktfrequenz, kein Light-Sleep (API-Abfragen, WLAN-Aufbau)
+    POWER_MODE_IDLE,            // Dynamische Taktfrequenz, kein Light-Sleep (Webserver reaktionsschnell)
+    POWER_MODE_LIGHT_SLEEP,     // Dynamische Taktfrequenz und automatischer Light-Sleep zwischen den Jobs
+    POWER_MODE_COUNT
+};
+
+// Momentaufnahme des Gerätezustands, aus der die Policy den Energiezustand ableitet
+struct PowerInputs {
+    bool stationConnected;              // Mit einem WLAN verbunden (Modem-Sleep möglich)
+    bool wifiConnecting;                // Verbindungsaufbau oder Reconnect läuft
+    bool accessPointActive;             // Konfigurations-AP läuft (Funk muss dauerhaft empfangen)
+    bool apiRequestActive;              // Wetter-/Pollen-Abfrage läuft (TLS-Handshake)
+    unsigned long msSinceClientRequest; // Zeit seit der letzten Webserver- oder CoAP-Anfrage (ULONG_MAX = noch keine)
+};
+
+// Feste Vorgaben der Policy (aus Settings.h bzw. den Fähigkeiten der Plattform)
+struct PowerPolicyConfig {
+    unsigned long clientActiveMs;       // So lange bleibt der Webserver nach einer Anfrage reaktionsschnell
+    unsigned long activeClientPollMs;   // Abfrageintervall für Anfragen, solange ein Client aktiv ist
+    unsigned long idleClientPollMs;     // Abfrageintervall im Ruhezustand
+    bool lightSleepSupported;           // Light-Sleep ist in der Plattform aktiviert
+};
+
+// Ergebnis der Policy
+struct PowerDecision {
+    PowerMode mode;
+    bool modemSleep;                    // Funk zwischen den Beacons abschalten
+    unsigned long clientPollMs;         // Intervall für den Job "clients"
+};
+
+// Bestimmt Energiezustand, Modem-Sleep und Abfrageintervall. Reine Funktion ohne Hardwarezugriff,
+// kann auf dem Host getestet werden.
+PowerDecision decidePowerMode(const PowerInputs& inputs, const PowerPolicyConfig& config);
+
+// Summiert die Zeit, die in jedem Energiezustand verbracht wurde.
+// Header-only und ohne Arduino-Abhängigkeit, die Zeit wird von aussen übergeben.
+class PowerStateTimes {
+public:
+    // Wechselt in einen neuen Zustand. Der erste Aufruf startet die Zählung.
+    void enter(PowerMode mode, bool modemSleep, unsigned long nowMs) {
+        if (_started) {
+            accumulate(nowMs);
+        }
+        _started = true;
+        _mode = mode;
+        _modemSleep = modemSleep;
+        _since = nowMs;
+    }
+
+    // Gesamte Zeit im Zustand, inklusive der laufenden Phase
+    uint64_t getTimeMs(PowerMode mode, unsigned long nowMs) const {
+        uint64_t time = _timeMs[mode];
+        if (_started && _mode == mode) time += (unsigned long)(nowMs - _since);
+        return time;
+    }
+
+    uint64_t getModemSleepTimeMs(unsigned long nowMs) const {
+        uint64_t time = _modemSleepMs;
+        if (_started && _modemSleep) time += (unsigned long)(nowMs - _since);
+        return time;
+    }
+
+    uint32_t getTransitionCount() const { return _transitions; }
+
+private:
+    uint64_t _timeMs[POWER_MODE_COUNT] = {};
+    uint64_t _modemSleepMs = 0;
+    uint32_t _transitions = 0;
+    PowerMode _mode = POWER_MODE_ACTIVE;
+    bool _modemSleep = false;
+    bool _started = false;
+    unsigned long _since = 0;
+
+    void accumulate(unsigned long nowMs) {
+        unsigned long elapsed = nowMs - _since;
+        _timeMs[_mode] += elapsed;
+        if (_modemSleep) _modemSleepMs += elapsed;
+        _transitions++;
+    }
+};
+
+#endif // POWER_POLICY_H
@@ -0,0 +1,233 @@
+#include "Scheduler.h"
+
+Scheduler::Scheduler(SchedulerClock millisClock, SchedulerClock microsClock)
+  : _millis(millisClock), _micros(microsClock), _jobCount(0), _heapSize(0), _statsStart(0), _busyMicros(0) {}
+
+JobId Scheduler::addPeriodic(const char* name, unsigned long intervalMs, JobFunction function, unsigned long firstDelayMs) {
+    if (intervalMs < SCHEDULER_MIN_INTERVAL_MS) {
+        intervalMs = SCHEDULER_MIN_INTERVAL_MS;
+    }
+    return addJob(name, intervalMs, function, firstDelayMs);
+}
+
+JobId Scheduler::addOneShot(const char* name, unsigned long delayMs, JobFunction function) {
+    return addJob(name, 0, function, delayMs);
+}
+
+JobId Scheduler::addJob(const char* name, unsigned long intervalMs, JobFunction function, unsigned long delayMs) {
+    if (_jobCount >= SCHEDULER_MAX_JOBS || function == nullptr) {
+        return SCHEDULER_INVALID_JOB;
+    }
+
+    JobId id = _jobCount++;
+    Job& job = _jobs[id];
+    job.name = name;
+    job.function = function;
+    job.intervalMs = intervalMs;
+    job.lastRun = _millis();
+    job.deadline = job.lastRun + delayMs;
+    job.active = true;
+    job.heapIndex = -1;
+    job.stats = JobStats();
+    heapPush(id);
+    return id;
+}
+
+void Scheduler::setInterval(JobId id, unsigned long intervalMs) {
+    if (!isValid(id)) {
+        return;
+    }
+    if (intervalMs < SCHEDULER_MIN_INTERVAL_MS) {
+        intervalMs = SCHEDULER_MIN_INTERVAL_MS;
+    }
+    Job& job = _jobs[id];
+    if (job.intervalMs == intervalMs) {
+        return;
+    }
+    job.intervalMs = intervalMs;
+    // Nur neu einplanen, wenn der Job aktuell im Heap liegt (nicht während seiner eigenen Ausführung)
+    if (job.active && job.heapIndex >= 0) {
+        heapRemove(id);
+        job.deadline = job.lastRun + intervalMs;
+        heapPush(id);
+    }
+}
+
+void Scheduler::reschedule(JobId id, unsigned long delayMs) {
+    if (!isValid(id)) {
+        return;
+    }
+    Job& job = _jobs[id];
+    if (job.heapIndex >= 0) {
+        heapRemove(id);
+    }
+    job.active = true;
+    job.deadline = _millis() + delayMs;
+    heapPush(id);
+}
+
+void Scheduler::cancel(JobId id) {
+    if (!isValid(id)) {
+        return;
+    }
+    Job& job = _jobs[id];
+    if (job.heapIndex >= 0) {
+        heapRemove(id);
+    }
+    job.active = false;
+}
+
+int Scheduler::runDue() {
+    int executed = 0;
+
+    // Höchstens so viele Ausführungen wie Jobs, damit ein Job mit Deadline "jetzt",
+    // der sich selbst neu einplant, die loop() nicht endlos festhält.
+    for (int i = 0; i < _jobCount && _heapSize > 0; i++) {
+        unsigned long now = _millis();
+        JobId id = _heap[0];
+        Job& job = _jobs[id];
+        if (isBefore(now, job.deadline)) {
+            break; // Nächste Deadline liegt in der Zukunft
+        }
+
+        heapRemove(id);
+
+        unsigned long lateness = now - job.deadline;
+        unsigned long startMicros = _micros ? _micros() : 0;
+
+        job.lastRun = now;
+        job.function();
+
+        uint32_t runMicros = _micros ? (uint32_t)(_micros() - startMicros) : 0;
+        job.stats.runs++;
+        job.stats.totalRunMicros += runMicros;
+        _busyMicros += runMicros;
+        if (runMicros > job.stats.maxRunMicros) job.stats.maxRunMicros = runMicros;
+        job.stats.totalLatenessMs += lateness;
+        if (lateness > job.stats.maxLatenessMs) job.stats.maxLatenessMs = lateness;
+        executed++;
+
+        // Der Job kann sich während der Ausführung selbst neu eingeplant oder beendet haben.
+        if (!job.active || job.heapIndex >= 0) {
+            continue;
+        }
+        if (job.intervalMs == 0) {
+            job.active = false; // One-Shot erledigt
+            continue;
+        }
+
+        // Feste Taktung ohne Drift: nächste Deadline ab der vorherigen Deadline.
+        // War der Job um mehr als ein Intervall zu spät, wird nicht nachgeholt, sondern neu aufgesetzt.
+        job.deadline += job.intervalMs;
+        unsigned long after = _millis();
+        if (!isBefore(after, job.deadline)) {
+            job.deadline = after + job.intervalMs;
+        }
+        heapPush(id);
+    }
+
+    return executed;
+}
+
+unsigned long Scheduler::timeUntilNext(unsigned long maxWaitMs) const {
+    if (_heapSize == 0) {
+        return maxWaitMs;
+    }
+    unsigned long now = _millis();
+    unsigned long deadline = _jobs[_heap[0]].deadline;
+    if (!isBefore(now, deadline)) {
+        return 0;
+    }
+    unsigned long wait = deadline - now;
+    return wait < maxWaitMs ? wait : maxWaitMs;
+}
+
+const char* Scheduler::getJobName(JobId id) const {
+    return isValid(id) ? _jobs[id].name : nullptr;
+}
+
+const JobStats* Scheduler::getStats(JobId id) const {
+    return isValid(id) ? &_jobs[id].stats : nullptr;
+}
+
+void Scheduler::resetStats() {
+    for (int i = 0; i < _jobCount; i++) {
+        _jobs[i].stats = JobStats();
+    }
+    _statsStart = _millis();
+}
+
+uint32_t Scheduler::getLoadPermille() const {
+    unsigned long windowMs = _millis() - _statsStart;
+    if (windowMs == 0) {
+        return 0;
+    }
+    uint64_t busyMicros = 0;
+    for (int i = 0; i < _jobCount; i++) {
+        busyMicros += _jobs[i].stats.totalRunMicros;
+    }
+    uint64_t permille = busyMicros / windowMs; // µs pro ms = Promille
+    return permille > 1000 ? 1000 : (uint32_t)permille;
+}
+
+// --- Min-Heap ---
+
+void Scheduler::heapPush(JobId id) {
+    int index = _heapSize++;
+    _heap[index] = id;
+    _jobs[id].heapIndex = index;
+    siftUp(index);
+}
+
+void Scheduler::heapRemove(JobId id) {
+    int index = _jobs[id].heapIndex;
+    int last = --_heapSize;
+    if (index != last) {
+        heapSwap(index, last);
+        // Das nachgerückte Element kann nach oben oder unten wandern
+        JobId moved = _heap[index];
+        siftUp(index);
+        if (_jobs[moved].heapIndex == index) {
+            siftDown(index);
+        }
+    }
+    _jobs[id].heapIndex = -1;
+}
+
+void Scheduler::heapSwap(int a, int b) {
+    JobId tmp = _heap[a];
+    _heap[a] = _heap[b];
+    _heap[b] = tmp;
+    _jobs[_heap[a]].heapIndex = a;
+    _jobs[_heap[b]].heapIndex = b;
+}
+
+void Scheduler::siftUp(int index) {
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!isBefore(_jobs[_heap[index]].deadline, _jobs[_heap[parent]].deadline)) {
+            break;
+        }
+        heapSwap(index, parent);
+        index = parent;
+    }
+}
+
+void Scheduler::siftDown(int index) {
+    while (true) {
+        int left = 2 * index + 1;
+        int right = left + 1;
+        int smallest = index;
+        if (left < _heapSize && isBefore(_jobs[_heap[left]].deadline, _jobs[_heap[smallest]].deadline)) {
+            smallest = left;
+        }
+        if (right < _heapSize && isBefore(_jobs[_heap[right]].deadline, _jobs[_heap[smallest]].deadline)) {
+            smallest = right;
+        }
+        if (smallest == index) {
+            break;
+        }
+        heapSwap(index, smallest);
+        index = smallest;
+    }
+}
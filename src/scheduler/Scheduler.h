@@ -0,0 +1,122 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Maximale Anzahl gleichzeitig registrierter Jobs (statisch alloziert)
+const int SCHEDULER_MAX_JOBS = 16;
+
+// Kürzestes Intervall periodischer Jobs. Kürzere Intervalle (auch 0) werden darauf angehoben,
+// ein Intervall von 0 würde den Job im selben runDue() endlos wiederholen.
+const unsigned long SCHEDULER_MIN_INTERVAL_MS = 1;
+
+// Kennung eines Jobs, SCHEDULER_INVALID_JOB bei Fehlern
+typedef int JobId;
+const JobId SCHEDULER_INVALID_JOB = -1;
+
+// Zeitquelle in Millisekunden bzw. Mikrosekunden (auf dem Gerät millis()/micros(),
+// auf dem Host eine virtuelle Uhr)
+typedef unsigned long (*SchedulerClock)();
+
+// Auszuführende Funktion eines Jobs
+typedef void (*JobFunction)();
+
+// Laufzeit-Statistik eines Jobs
+struct JobStats {
+    uint32_t runs = 0;                  // Anzahl Ausführungen
+    uint64_t totalRunMicros = 0;        // Summe der Laufzeiten in µs
+    uint32_t maxRunMicros = 0;          // Längste Laufzeit in µs
+    uint64_t totalLatenessMs = 0;       // Summe der Verspätungen gegenüber der Deadline in ms
+    uint32_t maxLatenessMs = 0;         // Grösste Verspätung in ms
+};
+
+// Deadline-basierter Scheduler für periodische und einmalige Jobs.
+// Die Jobs liegen in einem Min-Heap nach Deadline, die loop() kann dadurch genau
+// bis zur nächsten Deadline schlafen, statt in festen Abständen alle Bedingungen zu prüfen.
+// Hängt nicht vom Arduino-Framework ab: Die Zeit kommt ausschliesslich aus den übergebenen Uhren.
+class Scheduler {
+public:
+    // millisClock ist zwingend, microsClock ist optional (ohne wird keine Laufzeit gemessen).
+    Scheduler(SchedulerClock millisClock, SchedulerClock microsClock = nullptr);
+
+    // Registriert einen periodischen Job. Die erste Ausführung erfolgt nach firstDelayMs.
+    // intervalMs wird mindestens auf SCHEDULER_MIN_INTERVAL_MS gesetzt.
+    JobId addPeriodic(const char* name, unsigned long intervalMs, JobFunction function, unsigned long firstDelayMs = 0);
+
+    // Registriert einen Job, der genau einmal nach delayMs ausgeführt wird.
+    JobId addOneShot(const char* name, unsigned long delayMs, JobFunction function);
+
+    // Ändert das Intervall eines periodischen Jobs (mindestens SCHEDULER_MIN_INTERVAL_MS).
+    // Die nächste Deadline wird ab der letzten Ausführung neu berechnet.
+    void setInterval(JobId id, unsigned long intervalMs);
+
+    // Setzt die nächste Deadline des Jobs auf jetzt + delayMs (aktiviert auch beendete One-Shot-Jobs wieder).
+    void reschedule(JobId id, unsigned long delayMs);
+
+    // Führt den Job beim nächsten runDue() aus (z.B. erzwungene API-Abfrage).
+    void trigger(JobId id) { reschedule(id, 0); }
+
+    // Entfernt den Job aus der Planung. Mit reschedule() kann er wieder aktiviert werden.
+    void cancel(JobId id);
+
+    // Führt alle fälligen Jobs aus und gibt deren Anzahl zurück.
+    int runDue();
+
+    // Zeit in ms bis zur nächsten Deadline (0 = sofort fällig).
+    // Gibt maxWaitMs zurück, wenn kein Job geplant ist oder die Deadline weiter entfernt ist.
+    unsigned long timeUntilNext(unsigned long maxWaitMs = 1000) const;
+
+    // Statistik und Angaben zu den Jobs
+    int getJobCount() const { return _jobCount; }
+    const char* getJobName(JobId id) const;
+    const JobStats* getStats(JobId id) const;
+    void resetStats();
+
+    // Anteil der Laufzeit aller Jobs an der Zeit seit dem letzten resetStats() in Promille.
+    // Läuft der Scheduler in einer eigenen Task, entspricht das deren CPU-Last.
+    uint32_t getLoadPermille() const;
+
+    // Laufzeit aller Jobs seit dem Start in µs. Läuft nach etwa 71 Minuten über, nur Differenzen verwenden.
+    // Darf auch aus anderen Tasks gelesen werden (z.B. für das Wärmemodell).
+    uint32_t getBusyMicros() const { return _busyMicros; }
+
+private:
+    struct Job {
+        const char* name;
+        JobFunction function;
+        unsigned long intervalMs;   // 0 = One-Shot
+        unsigned long deadline;     // Nächste Ausführung (millis)
+        unsigned long lastRun;      // Letzte Ausführung (millis)
+        bool active;                // Geplant (im Heap oder gerade in Ausführung)
+        int heapIndex;              // Position im Heap, -1 = nicht im Heap
+        JobStats stats;
+    };
+
+    SchedulerClock _millis;
+    SchedulerClock _micros;
+
+    Job _jobs[SCHEDULER_MAX_JOBS];
+    int _jobCount;
+
+    // Min-Heap über die Job-Indizes, sortiert nach Deadline
+    JobId _heap[SCHEDULER_MAX_JOBS];
+    int _heapSize;
+
+    unsigned long _statsStart;      // Beginn des Statistik-Zeitraums (millis)
+    volatile uint32_t _busyMicros;  // Laufzeit aller Jobs seit dem Start, wird nicht zurückgesetzt
+
+    JobId addJob(const char* name, unsigned long intervalMs, JobFunction function, unsigned long delayMs);
+    bool isValid(JobId id) const { return id >= 0 && id < _jobCount; }
+
+    // Vergleich mit Überlaufbehandlung von millis() (ca. alle 49 Tage)
+    static bool isBefore(unsigned long a, unsigned long b) { return (long)(a - b) < 0; }
+
+    void heapPush(JobId id);
+    void heapRemove(JobId id);
+    void heapSwap(int a, int b);
+    void siftUp(int index);
+    void siftDown(int index);
+};
+
+#endif // SCHEDULER_H
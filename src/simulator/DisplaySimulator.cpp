@@ -0,0 +1,294 @@
+// Simulator der Anzeige auf dem PC (Linux). UpdateDisplay läuft mit dem Scheduler wie in der Anzeige-Task,
+// LED-Streifen, PCF8574, DFPlayer und die Zeit kommen aus SimHardware. Ein simulierter Tag dauert Sekunden,
+// danach stehen die gesendeten Frames und i2c-Übertragungen pro Stunde fest.
+//
+//   pio run -e simulator && .pio/build/simulator/program [Optionen]
+//
+//   --start HH:MM     Uhrzeit beim Start (Standard 00:00)
+//   --hours N         Simulierte Stunden (Standard 24)
+//   --show            Anzeige zu jeder vollen Stunde im Terminal ausgeben
+//   --ppm DIR         Bild pro Fünfminutenschritt als PPM-Datei in DIR
+//   --trace FILE      Alle Übertragungen als CSV
+//   --i2c-errors N    Die ersten N Übertragungen an die erste 7-Segment-Anzeige schlagen fehl
+//   --text TEXT       TEXT auf dem Buchstabenraster zeigen (läuft durch, wenn er breiter als das Raster ist)
+//   --tests           Vorher ledStripTest() und textUhrTest() laufen lassen (in virtueller Zeit)
+//   --verbose         Meldungen der Anzeige ausgeben
+
+#include <Arduino.h>
+#include <chrono>
+#include <vector>
+
+#include "logger/Logger.h"
+#include "hal/native/SimHardware.h"
+#include "scheduler/Scheduler.h"
+#include "display/UpdateDisplay.h"
+#include "Settings.h"
+#include "SimRenderer.h"
+
+const unsigned long SIM_INDOOR_TIME = 10000;    // Anzeigedauer der Innenwerte (ms)
+const unsigned long SIM_OUTDOOR_TIME = 5000;    // Anzeigedauer der Aussenwerte (ms)
+const unsigned long SIM_WEATHER_INTERVAL = 3600000;
+const unsigned long SIM_AIR_QUALITY_INTERVAL = 300000;
+const unsigned long SIM_SNAPSHOT_DELAY = DISPLAY_CROSSFADE_TIME + 100; // Bild nach der Überblendung
+const uint64_t SIM_HOUR_MICROS = 3600ULL * 1000000ULL;
+
+struct SimOptions {
+    int startMinutes = 0;
+    int hours = 24;
+    bool show = false;
+    const char* ppmDir = nullptr;
+    const char* traceFile = nullptr;
+    uint32_t i2cErrors = 0;
+    const char* text = nullptr;
+    bool tests = false;
+    bool verbose = false;
+};
+
+static SimOptions options;
+static UpdateDisplay updateDisplay;
+static Scheduler displayScheduler(millis, micros);
+static JobId jobFrame = SCHEDULER_INVALID_JOB;
+static JobId jobSnapshot = SCHEDULER_INVALID_JOB;
+static JobId jobToggle = SCHEDULER_INVALID_JOB;
+static bool showingIndoor = true;
+static int shownMinute = -1;
+static uint32_t snapshots = 0;
+static uint64_t dayStartMicros = 0;
+
+// Minute des Tages zur virtuellen Zeit
+static int dayMinute() {
+    return (int)((options.startMinutes + (millis() - dayStartMicros / 1000) / 60000UL) % 1440);
+}
+
+// Innenklima und Wetter als glatte Tageskurven
+static float dayPhase() {
+    return (float)dayMinute() / 1440.0f * 2.0f * (float)M_PI;
+}
+
+// --- Jobs wie in der Anzeige-Task (main.cpp) ---
+
+static void renderDisplayFrame() {
+    unsigned long waitMs = updateDisplay.renderFrame(millis());
+    if (waitMs > 0) {
+        displayScheduler.reschedule(jobFrame, waitMs);
+    }
+}
+
+static void requestDisplayFrame() {
+    displayScheduler.trigger(jobFrame);
+}
+
+static void updateClock() {
+    int minute = dayMinute();
+    if (minute == shownMinute) {
+        return;
+    }
+    bool hadMinute = shownMinute >= 0;
+    shownMinute = minute;
+    updateDisplay.updateTime(minute / 60, minute % 60);
+    if (hadMinute && minute % 60 == 0) {
+        updateDisplay.playHourChime(minute / 60);
+    }
+    if ((options.ppmDir != nullptr && minute % 5 == 0) || (options.show && minute % 60 == 0)) {
+        displayScheduler.reschedule(jobSnapshot, SIM_SNAPSHOT_DELAY);
+    }
+}
+
+static void updateSensorValues() {
+    if (!showingIndoor) {
+        return;
+    }
+    float phase = dayPhase();
+    updateDisplay.updateTemperature(21.5f + 1.5f * sinf(phase - 2.0f));
+    updateDisplay.updateTempLED(true);
+    updateDisplay.updateHumidity(45.0f + 6.0f * cosf(phase));
+    updateDisplay.updateHumiLED(true);
+}
+
+static void showOutdoorValues() {
+    float phase = dayPhase();
+    updateDisplay.updateTemperature(12.0f + 7.0f * sinf(phase - 2.0f));
+    updateDisplay.updateTempLED(false);
+    updateDisplay.updateHumidity(70.0f - 15.0f * sinf(phase - 2.0f));
+    updateDisplay.updateHumiLED(false);
+}
+
+static void toggleIndoorOutdoor() {
+    showingIndoor = !showingIndoor;
+    if (showingIndoor) {
+        updateSensorValues();
+    } else {
+        showOutdoorValues();
+    }
+    displayScheduler.reschedule(jobToggle, showingIndoor ? SIM_INDOOR_TIME : SIM_OUTDOOR_TIME);
+}
+
+static void updateWeather() {
+    static const WeatherConditionType WEATHER[] = {
+        WeatherConditionType::CLEAR, WeatherConditionType::PARTLY_CLOUDY, WeatherConditionType::CLOUDY,
+        WeatherConditionType::RAIN, WeatherConditionType::THUNDERSTORM, WeatherConditionType::SNOW,
+    };
+    int hour = dayMinute() / 60;
+    updateDisplay.updateWeather(WEATHER[(hour / 4) % (sizeof(WEATHER) / sizeof(WEATHER[0]))]);
+    updateDisplay.updatePollen((hour / 3) % (POLLEN_LEVEL_MAX + 1));
+}
+
+static void updateAirQuality() {
+    updateDisplay.updateAirQuality(90.0f + 60.0f * sinf(dayPhase() * 3.0f));
+}
+
+static void takeSnapshot() {
+    int minute = dayMinute();
+    if (options.show && minute % 60 == 0) {
+        printf("%02d:%02d\n%s\n", minute / 60, minute % 60, renderTerminal().c_str());
+    }
+    if (options.ppmDir != nullptr) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%04u_%02d%02d.ppm", options.ppmDir, snapshots, minute / 60, minute % 60);
+        if (!writePpm(path)) {
+            fprintf(stderr, "Bild %s konnte nicht geschrieben werden\n", path);
+        }
+    }
+    snapshots++;
+}
+
+// --- Auswertung ---
+
+static void printHourlyCounts() {
+    const std::vector<SimTransaction>& transactions = SimHardware::getInstance().getTransactions();
+    std::vector<uint32_t> counts((size_t)options.hours * 4, 0); // Pro Stunde: LED-Frames, i2c, Fehler, Töne
+    for (const SimTransaction& transaction : transactions) {
+        size_t hour = (size_t)((transaction.timeMicros - dayStartMicros) / SIM_HOUR_MICROS);
+        if (hour >= (size_t)options.hours) continue;
+        if (transaction.type == SIM_LED_FRAME) counts[hour * 4]++;
+        if (transaction.type == SIM_I2C_WRITE) counts[hour * 4 + (transaction.failed ? 2 : 1)]++;
+        if (transaction.type == SIM_SOUND) counts[hour * 4 + 3]++;
+    }
+    printf("Stunde  LED-Frames  i2c-Writes  i2c-Fehler  Töne\n");
+    for (int hour = 0; hour < options.hours; hour++) {
+        int clockHour = (options.startMinutes / 60 + hour) % 24;
+        printf("%02d:00   %10u  %10u  %10u  %4u\n", clockHour, counts[hour * 4], counts[hour * 4 + 1],
+               counts[hour * 4 + 2], counts[hour * 4 + 3]);
+    }
+}
+
+static void printRenderStats() {
+    DisplayRenderStats stats = updateDisplay.getRenderStats();
+    printf("Frames: %u zusammengesetzt, %u gesendet, %u unverändert, %u verworfen, %u überblendet\n",
+           stats.frames, stats.shown, stats.unchanged, stats.dropped, stats.blends);
+    printf("Bereiche: %u neu gezeichnet, %u unverändert\n", stats.rendered, stats.skipped);
+    printf("7-Segment: %u Übertragungen, %u unterdrückt, %u Fehler\n",
+           stats.segments.writes, stats.segments.suppressed, stats.segments.errors);
+}
+
+static bool writeTrace(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (file == nullptr) {
+        return false;
+    }
+    static const char* const TYPES[SIM_TRANSACTION_TYPES] = { "led", "i2c", "sound" };
+    fprintf(file, "time_us,type,address,value,failed\n");
+    for (const SimTransaction& transaction : SimHardware::getInstance().getTransactions()) {
+        fprintf(file, "%llu,%s,0x%02X,%u,%d\n", (unsigned long long)transaction.timeMicros, TYPES[transaction.type],
+                transaction.address, transaction.value, transaction.failed ? 1 : 0);
+    }
+    return fclose(file) == 0;
+}
+
+static bool parseOptions(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        String arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        int hour = 0;
+        int minute = 0;
+        if (arg == "--start" && hasValue && sscanf(argv[i + 1], "%d:%d", &hour, &minute) == 2) {
+            options.startMinutes = (hour % 24) * 60 + minute % 60;
+            i++;
+        } else if (arg == "--hours" && hasValue) {
+            options.hours = max(1, atoi(argv[++i]));
+        } else if (arg == "--show") {
+            options.show = true;
+        } else if (arg == "--ppm" && hasValue) {
+            options.ppmDir = argv[++i];
+        } else if (arg == "--trace" && hasValue) {
+            options.traceFile = argv[++i];
+        } else if (arg == "--i2c-errors" && hasValue) {
+            options.i2cErrors = (uint32_t)atoi(argv[++i]);
+        } else if (arg == "--text" && hasValue) {
+            options.text = argv[++i];
+        } else if (arg == "--tests") {
+            options.tests = true;
+        } else if (arg == "--verbose") {
+            options.verbose = true;
+        } else {
+            fprintf(stderr, "Aufruf: %s [--start HH:MM] [--hours N] [--show] [--ppm DIR] [--trace FILE] "
+                            "[--i2c-errors N] [--text TEXT] [--tests] [--verbose]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (!parseOptions(argc, argv)) {
+        return 2;
+    }
+    Logger::setup(options.verbose ? LogLevel::Info : LogLevel::Error);
+    SimHardware& hardware = SimHardware::getInstance();
+    auto wallStart = std::chrono::steady_clock::now();
+
+    // Wie bootInitDisplay()
+    updateDisplay.setMaxFrameRate(DISPLAY_MAX_FRAME_RATE);
+    updateDisplay.setDithering(LED_DITHERING, LED_DITHER_FRAME_RATE);
+    updateDisplay.setCrossfade(DISPLAY_CROSSFADE_TIME, DISPLAY_FRAME_BUDGET);
+    updateDisplay.setScrollInterval(DISPLAY_SCROLL_INTERVAL);
+    updateDisplay.setMatrixScrollInterval(DISPLAY_MATRIX_SCROLL_INTERVAL);
+    updateDisplay.begin();
+    updateDisplay.setBrightness(100);
+
+    if (options.tests) {
+        uint64_t testStart = hardware.micros();
+        updateDisplay.ledStripTest();
+        updateDisplay.textUhrTest(false);
+        printf("Tests: %.1f s virtuelle Zeit\n", (hardware.micros() - testStart) / 1e6);
+    }
+    // Die Auswertung beginnt mit dem simulierten Tag, auf eine volle Sekunde gelegt (Stundengrenzen)
+    hardware.advanceTo((hardware.micros() / 1000000 + 1) * 1000000);
+    hardware.clearTransactions();
+    dayStartMicros = hardware.micros();
+    if (options.i2cErrors > 0) {
+        hardware.failI2cWrites(SEVEN_SEGMENT_ADDRESSES[0], options.i2cErrors);
+    }
+
+    jobFrame = displayScheduler.addOneShot("frame", 0, renderDisplayFrame);
+    jobSnapshot = displayScheduler.addOneShot("snapshot", 0, takeSnapshot);
+    displayScheduler.cancel(jobSnapshot);
+    displayScheduler.addPeriodic("clock", CLOCK_UPDATE_INTERVAL, updateClock);
+    displayScheduler.addPeriodic("sensors", SENSOR_UPDATE_CYCLE, updateSensorValues);
+    displayScheduler.addPeriodic("weather", SIM_WEATHER_INTERVAL, updateWeather);
+    displayScheduler.addPeriodic("air", SIM_AIR_QUALITY_INTERVAL, updateAirQuality);
+    jobToggle = displayScheduler.addOneShot("display", SIM_INDOOR_TIME, toggleIndoorOutdoor);
+    updateDisplay.setFrameRequestHandler(requestDisplayFrame);
+    if (options.text != nullptr) {
+        updateDisplay.showMatrixText(options.text);
+    }
+
+    // Zeit immer bis zur nächsten Deadline vorstellen
+    uint64_t endMicros = dayStartMicros + (uint64_t)options.hours * SIM_HOUR_MICROS;
+    while (hardware.micros() < endMicros) {
+        displayScheduler.runDue();
+        unsigned long waitMs = displayScheduler.timeUntilNext(CLOCK_UPDATE_INTERVAL);
+        hardware.advanceTo(hardware.micros() + (uint64_t)waitMs * 1000);
+    }
+
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    printHourlyCounts();
+    printRenderStats();
+    printf("%d h simuliert in %.2f s\n", options.hours, wallSeconds);
+
+    if (options.traceFile != nullptr && !writeTrace(options.traceFile)) {
+        fprintf(stderr, "Aufzeichnung %s konnte nicht geschrieben werden\n", options.traceFile);
+        return 1;
+    }
+    return 0;
+}
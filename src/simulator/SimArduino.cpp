@@ -0,0 +1,20 @@
+#include <Arduino.h>
+#include "hal/native/SimHardware.h"
+
+// Zeitfunktionen des Arduino-Frameworks auf der virtuellen Zeit von SimHardware
+
+unsigned long millis() {
+    return (unsigned long)SimHardware::getInstance().millis();
+}
+
+unsigned long micros() {
+    return (unsigned long)SimHardware::getInstance().micros();
+}
+
+void delay(unsigned long ms) {
+    SimHardware::getInstance().advanceMicros((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+    SimHardware::getInstance().advanceMicros(us);
+}
@@ -0,0 +1,39 @@
+#include "logger/Logger.h"
+#include "hal/native/SimHardware.h"
+
+// Logger des Simulators: Ausgabe mit der virtuellen Zeit auf stderr, ohne Uhr und serielle Schnittstelle
+
+const Topic<LocalClock>* Logger::_clockTopic = nullptr;
+LogLevel Logger::_outputLogLevel = LogLevel::Info;
+
+void Logger::setup(LogLevel outputLevel) {
+  _clockTopic = nullptr;
+  _outputLogLevel = outputLevel;
+}
+
+void Logger::setup(LogLevel outputLevel, const Topic<LocalClock>& clockTopic) {
+  Logger::setup(outputLevel);
+  _clockTopic = &clockTopic;
+}
+
+void Logger::setOutputLogLevel(LogLevel level) {
+  _outputLogLevel = level;
+}
+
+void Logger::log(LogLevel level, const String& message) {
+  if (level > _outputLogLevel) {
+    return;
+  }
+  uint64_t ms = SimHardware::getInstance().millis();
+  fprintf(stderr, "[%8llu.%03llu] %s: %s\n", (unsigned long long)(ms / 1000), (unsigned long long)(ms % 1000),
+          getLevelName(level), message.c_str());
+}
+
+const char* Logger::getLevelName(LogLevel level) {
+  switch (level) {
+    case LogLevel::Error: return "ERROR";
+    case LogLevel::Info:  return "INFO";
+    case LogLevel::Debug: return "DEBUG";
+    default:              return "UNKNOWN";
+  }
+}
@@ -0,0 +1,27 @@
+#include "mp3player/Mp3Player.h"
+#include "hal/native/SimHardware.h"
+
+// DFPlayer im Simulator: gespielte Titel werden in SimHardware aufgezeichnet
+
+Mp3Player::Mp3Player() : mp3Serial(nullptr), _volume(-1), _volumePending(false), _responded(false) {}
+
+bool Mp3Player::begin(HardwareSerial& serialPort) {
+    mp3Serial = &serialPort;
+    return true;
+}
+
+void Mp3Player::play(int trackNumber) {
+    SimHardware::getInstance().recordSound(trackNumber);
+}
+
+void Mp3Player::setVolume(int) {}
+
+void Mp3Player::requestState() {
+    _responded = true;
+}
+
+bool Mp3Player::hasResponded() {
+    return _responded;
+}
+
+void Mp3Player::reset() {}
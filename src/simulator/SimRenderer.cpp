@@ -0,0 +1,197 @@
+#include "SimRenderer.h"
+#include "hal/native/SimHardware.h"
+#include "hardware/HardwareConfig.h"
+#include "display/WordClockLayout.h"
+#include "display/LetterMatrix.h"
+#include "i2cbus/seven_segment/SevenSegmentFont.h"
+
+#include <stdio.h>
+#include <vector>
+
+// Buchstaben der Wörter (ohne Umlaute), Reihenfolge wie WordClockWord
+static const char* const WORD_LETTERS[WORD_COUNT] = {
+    "ES", "ISCH",
+    "FUF", "ZAA", "VIERTU", "ZWANZG", "HAUBI", "AB", "VOR",
+    "EIS", "ZWOI", "DRU", "VIERI", "FUFI", "SACHSI",
+    "SIBNI", "ACHTI", "NUNI", "ZANI", "EUFI", "ZWOUFI",
+};
+
+static_assert(WORD_CLOCK_FIRST_LED + LETTER_MATRIX_ROWS * LETTER_MATRIX_COLUMNS <= NUM_LEDS,
+              "Raster länger als der LED-Streifen");
+
+// Buchstabe pro LED, LEDs ohne Wort sind Füllbuchstaben ('.')
+static std::vector<char> gridLetters() {
+    std::vector<char> letters(NUM_LEDS, '.');
+    for (int word = 0; word < WORD_COUNT; word++) {
+        const WordClockWordLeds& leds = WORD_CLOCK_WORDS[word];
+        int row = (leds.first - WORD_CLOCK_FIRST_LED) / LETTER_MATRIX_COLUMNS;
+        for (int i = 0; i < leds.count && WORD_LETTERS[word][i] != '\0'; i++) {
+            // In Zeilen von rechts nach links steht der erste Buchstabe auf der höchsten LED
+            int led = row % 2 == 0 ? leds.first + leds.count - 1 - i : leds.first + i;
+            letters[led] = WORD_LETTERS[word][i];
+        }
+    }
+    return letters;
+}
+
+struct SimColor {
+    uint8_t r, g, b;
+    bool lit() const { return r != 0 || g != 0 || b != 0; }
+};
+
+// Farbe der LED aus dem zuletzt gesendeten Frame (GRB)
+static SimColor ledColor(int led) {
+    const std::vector<uint8_t>& frame = SimHardware::getInstance().getLedFrame();
+    SimColor color = { 0, 0, 0 };
+    if ((size_t)(led * 3 + 2) < frame.size()) {
+        color.g = frame[led * 3];
+        color.r = frame[led * 3 + 1];
+        color.b = frame[led * 3 + 2];
+    }
+    return color;
+}
+
+// Segment 0-6 (a-g) bzw. 7 (Punkt) der Anzeige leuchtet (Ausgänge sind invertiert)
+static bool segmentLit(uint8_t output, int segment) {
+    return (output & (1 << SEVEN_SEGMENT_PINS[segment])) == 0;
+}
+
+static uint8_t segmentOutput(size_t textIndex) {
+    return SimHardware::getInstance().getI2cOutput(SEVEN_SEGMENT_ADDRESSES[SEVEN_SEGMENT_TEXT_ORDER[textIndex]]);
+}
+
+static void appendColored(std::string& out, const SimColor& color, const char* text) {
+    char escape[32];
+    if (color.lit()) {
+        snprintf(escape, sizeof(escape), "\x1b[1;38;2;%d;%d;%dm", color.r, color.g, color.b);
+    } else {
+        snprintf(escape, sizeof(escape), "\x1b[38;5;238m");
+    }
+    out += escape;
+    out += text;
+    out += "\x1b[0m";
+}
+
+std::string renderTerminal() {
+    std::string out;
+    out += "  ";
+    for (int led = 0; led < SIM_STATUS_LEDS; led++) {
+        appendColored(out, ledColor(led), "o ");
+    }
+    out += "\n";
+
+    std::vector<char> letters = gridLetters();
+    for (int row = 0; row < LETTER_MATRIX_ROWS; row++) {
+        out += "  ";
+        for (int column = 0; column < LETTER_MATRIX_COLUMNS; column++) {
+            int led = LETTER_MATRIX.leds[row][column];
+            char text[3] = { letters[led], ' ', '\0' };
+            appendColored(out, ledColor(led), text);
+        }
+        out += "\n";
+    }
+
+    // 7-Segment-Anzeigen in drei Zeilen, Leerraum zwischen Temperatur und Feuchtigkeit
+    const char* red = "\x1b[1;31m";
+    const char* reset = "\x1b[0m";
+    for (int line = 0; line < 3; line++) {
+        out += "  ";
+        for (size_t i = 0; i < SEVEN_SEGMENT_COUNT; i++) {
+            uint8_t output = segmentOutput(i);
+            if (i == 3) out += "   ";
+            out += red;
+            if (line == 0) {
+                out += segmentLit(output, 0) ? " _  " : "    ";
+            } else if (line == 1) {
+                out += segmentLit(output, 5) ? "|" : " ";
+                out += segmentLit(output, 6) ? "_" : " ";
+                out += segmentLit(output, 1) ? "| " : "  ";
+            } else {
+                out += segmentLit(output, 4) ? "|" : " ";
+                out += segmentLit(output, 3) ? "_" : " ";
+                out += segmentLit(output, 2) ? "|" : " ";
+                out += segmentLit(output, 7) ? "." : " ";
+            }
+            out += reset;
+        }
+        out += "\n";
+    }
+    return out;
+}
+
+// --- PPM ---
+
+const int PPM_CELL = 20;        // Seitenlänge einer LED
+const int PPM_MARGIN = 10;
+const int PPM_DIGIT_WIDTH = 24;
+const int PPM_DIGIT_HEIGHT = 40;
+
+struct PpmCanvas {
+    int width;
+    int height;
+    std::vector<uint8_t> pixels;
+
+    PpmCanvas(int w, int h) : width(w), height(h), pixels((size_t)w * h * 3, 0) {}
+
+    void fill(int x, int y, int w, int h, const SimColor& color) {
+        for (int py = y; py < y + h && py < height; py++) {
+            for (int px = x; px < x + w && px < width; px++) {
+                uint8_t* pixel = &pixels[((size_t)py * width + px) * 3];
+                pixel[0] = color.r;
+                pixel[1] = color.g;
+                pixel[2] = color.b;
+            }
+        }
+    }
+};
+
+static void drawLed(PpmCanvas& canvas, int x, int y, const SimColor& color) {
+    SimColor off = { 30, 30, 30 };
+    canvas.fill(x + 2, y + 2, PPM_CELL - 4, PPM_CELL - 4, color.lit() ? color : off);
+}
+
+static void drawDigit(PpmCanvas& canvas, int x, int y, uint8_t output) {
+    // Rechtecke der Segmente a-g und des Punkts: x, y, Breite, Höhe
+    static const int SEGMENTS[8][4] = {
+        { 4, 0, 14, 3 }, { 18, 3, 3, 16 }, { 18, 21, 3, 16 }, { 4, 37, 14, 3 },
+        { 1, 21, 3, 16 }, { 1, 3, 3, 16 }, { 4, 18, 14, 3 }, { 22, 37, 2, 3 },
+    };
+    SimColor on = { 255, 20, 20 };
+    SimColor off = { 45, 10, 10 };
+    for (int segment = 0; segment < 8; segment++) {
+        const int* rect = SEGMENTS[segment];
+        canvas.fill(x + rect[0], y + rect[1], rect[2], rect[3], segmentLit(output, segment) ? on : off);
+    }
+}
+
+bool writePpm(const char* path) {
+    int width = 2 * PPM_MARGIN + SIM_STATUS_LEDS * PPM_CELL;
+    int gridTop = PPM_MARGIN + PPM_CELL + PPM_MARGIN;
+    int digitsTop = gridTop + LETTER_MATRIX_ROWS * PPM_CELL + PPM_MARGIN;
+    int height = digitsTop + PPM_DIGIT_HEIGHT + PPM_MARGIN;
+    PpmCanvas canvas(width, height);
+
+    for (int led = 0; led < SIM_STATUS_LEDS; led++) {
+        drawLed(canvas, PPM_MARGIN + led * PPM_CELL, PPM_MARGIN, ledColor(led));
+    }
+    int gridLeft = (width - LETTER_MATRIX_COLUMNS * PPM_CELL) / 2;
+    for (int row = 0; row < LETTER_MATRIX_ROWS; row++) {
+        for (int column = 0; column < LETTER_MATRIX_COLUMNS; column++) {
+            drawLed(canvas, gridLeft + column * PPM_CELL, gridTop + row * PPM_CELL, ledColor(LETTER_MATRIX.leds[row][column]));
+        }
+    }
+    int x = gridLeft;
+    for (size_t i = 0; i < SEVEN_SEGMENT_COUNT; i++) {
+        if (i == 3) x += PPM_DIGIT_WIDTH;
+        drawDigit(canvas, x, digitsTop, segmentOutput(i));
+        x += PPM_DIGIT_WIDTH + 4;
+    }
+
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    fprintf(file, "P6\n%d %d\n255\n", canvas.width, canvas.height);
+    bool ok = fwrite(canvas.pixels.data(), 1, canvas.pixels.size(), file) == canvas.pixels.size();
+    return fclose(file) == 0 && ok;
+}
@@ -0,0 +1,18 @@
+#ifndef SIM_RENDERER_H
+#define SIM_RENDERER_H
+
+#include <string>
+
+// Darstellung des Simulators aus dem Zustand der Ausgänge in SimHardware: Status-LEDs, Buchstabenraster der
+// Wortuhr und 7-Segment-Anzeigen, so wie sie an der Hardware ankommen (Helligkeit, GRB, invertierte Segmente).
+
+// Das Raster der Wortuhr steht in display/LetterMatrix.h
+const int SIM_STATUS_LEDS = 12;     // LED 0-11: Luftqualität, Marker, Wetter, Pollen
+
+// Text für das Terminal mit ANSI-Farben (24 Bit)
+std::string renderTerminal();
+
+// Bild als PPM (P6) schreiben: Status-LEDs, Raster der Wortuhr, 7-Segment-Anzeigen. false bei einem Dateifehler.
+bool writePpm(const char* path);
+
+#endif // SIM_RENDERER_H
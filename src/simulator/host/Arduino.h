@@ -0,0 +1,85 @@
+#ifndef SIM_HOST_ARDUINO_H
+#define SIM_HOST_ARDUINO_H
+
+// Der Teil des Arduino-Frameworks, den die Anzeige braucht, für den Simulator auf dem PC.
+// Die Zeit kommt aus SimHardware, delay() stellt sie nur vor.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define IRAM_ATTR
+#define DEC 10
+#define HEX 16
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+template <typename T, typename L, typename H>
+T constrain(T value, L low, H high) {
+    return value < low ? (T)low : (value > high ? (T)high : value);
+}
+
+using std::min;
+using std::max;
+
+// Zeichenkette wie Arduino String, auf std::string aufgebaut
+class String {
+public:
+    String() {}
+    String(const char* text) : _text(text != nullptr ? text : "") {}
+    String(const std::string& text) : _text(text) {}
+    String(char c) : _text(1, c) {}
+    String(int value, int base = DEC) : _text(format((long)value, base)) {}
+    String(unsigned int value, int base = DEC) : _text(format((unsigned long)value, base)) {}
+    String(long value, int base = DEC) : _text(format(value, base)) {}
+    String(unsigned long value, int base = DEC) : _text(format(value, base)) {}
+    String(unsigned char value, int base = DEC) : _text(format((unsigned long)value, base)) {}
+    String(double value, int decimals = 2) {
+        char buffer[48];
+        snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+        _text = buffer;
+    }
+
+    const char* c_str() const { return _text.c_str(); }
+    size_t length() const { return _text.size(); }
+    bool operator==(const String& other) const { return _text == other._text; }
+    bool operator!=(const String& other) const { return _text != other._text; }
+
+    String& operator+=(const String& other) { _text += other._text; return *this; }
+    String& operator+=(const char* other) { _text += other; return *this; }
+    String& operator+=(char c) { _text += c; return *this; }
+
+    friend String operator+(const String& a, const String& b) { return String(a._text + b._text); }
+    friend String operator+(const String& a, const char* b) { return String(a._text + b); }
+    friend String operator+(const char* a, const String& b) { return String(a + b._text); }
+
+private:
+    std::string _text;
+
+    static std::string format(long value, int base) {
+        if (base == DEC) return std::to_string(value);
+        return format((unsigned long)value, base);
+    }
+
+    static std::string format(unsigned long value, int base) {
+        char buffer[24];
+        snprintf(buffer, sizeof(buffer), base == HEX ? "%lX" : "%lu", value);
+        return buffer;
+    }
+};
+
+// Serielle Schnittstelle (nur als Typ, z.B. für Mp3Player::begin())
+class HardwareSerial {};
+
+#endif // SIM_HOST_ARDUINO_H
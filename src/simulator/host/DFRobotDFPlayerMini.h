@@ -0,0 +1,7 @@
+#ifndef SIM_HOST_DFROBOT_DFPLAYER_MINI_H
+#define SIM_HOST_DFROBOT_DFPLAYER_MINI_H
+
+// Nur als Typ für Mp3Player.h, die Titel zeichnet SimMp3Player.cpp in SimHardware auf
+class DFRobotDFPlayerMini {};
+
+#endif // SIM_HOST_DFROBOT_DFPLAYER_MINI_H
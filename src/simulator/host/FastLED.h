@@ -0,0 +1,30 @@
+#ifndef SIM_HOST_FASTLED_H
+#define SIM_HOST_FASTLED_H
+
+#include <stdint.h>
+
+// CRGB wie in FastLED (drei Bytes r, g, b), für den Simulator auf dem PC
+struct CRGB {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+
+    enum HTMLColorCode : uint32_t {
+        Black = 0x000000,
+        Blue = 0x0000FF,
+        Green = 0x008000,
+        Red = 0xFF0000,
+        White = 0xFFFFFF,
+        Yellow = 0xFFFF00,
+    };
+
+    CRGB() : r(0), g(0), b(0) {}
+    CRGB(uint8_t red, uint8_t green, uint8_t blue) : r(red), g(green), b(blue) {}
+    CRGB(uint32_t colorCode) : r((colorCode >> 16) & 0xFF), g((colorCode >> 8) & 0xFF), b(colorCode & 0xFF) {}
+    CRGB(HTMLColorCode colorCode) : CRGB((uint32_t)colorCode) {}
+
+    bool operator==(const CRGB& other) const { return r == other.r && g == other.g && b == other.b; }
+    bool operator!=(const CRGB& other) const { return !(*this == other); }
+};
+
+#endif // SIM_HOST_FASTLED_H
@@ -0,0 +1,160 @@
+#ifndef CBOR_READER_H
+#define CBOR_READER_H
+
+#include "CborWriter.h"
+
+// Liest die von CborWriter erzeugte Teilmenge von CBOR.
+// Hängt nicht vom Arduino-Framework ab und kann daher auch auf dem Host
+// (z.B. in Testprogrammen oder Auswerte-Werkzeugen) verwendet werden.
+// Nach dem ersten Fehler liefern alle weiteren Aufrufe false.
+class CborReader {
+public:
+    CborReader(const uint8_t* data, size_t length) : _data(data), _length(length), _pos(0), _error(false) {}
+
+    bool readUint(uint32_t& value) { return readHeader(CBOR_MAJOR_UINT, value); }
+
+    // Wie readUint(), ein CBOR null wird als isNull = true zurückgegeben.
+    bool readUint(uint32_t& value, bool& isNull) {
+        if (!require(1)) return false;
+        isNull = _data[_pos] == CBOR_NULL;
+        if (isNull) {
+            _pos++;
+            return true;
+        }
+        return readUint(value);
+    }
+
+    bool readInt(int32_t& value) {
+        uint8_t major;
+        uint32_t argument;
+        if (!peekMajor(major) || (major != CBOR_MAJOR_UINT && major != CBOR_MAJOR_NEGINT)) {
+            return fail();
+        }
+        if (!readHeader(major, argument)) {
+            return false;
+        }
+        value = (major == CBOR_MAJOR_UINT) ? (int32_t)argument : -1 - (int32_t)argument;
+        return true;
+    }
+
+    // Liest einen Float32. Ein CBOR null wird als isNull = true zurückgegeben.
+    bool readFloat(float& value, bool& isNull) {
+        if (!require(1)) return false;
+        if (_data[_pos] == CBOR_NULL) {
+            _pos++;
+            isNull = true;
+            return true;
+        }
+        if (_data[_pos] != CBOR_FLOAT32 || !require(5)) {
+            return fail();
+        }
+        uint32_t bits = ((uint32_t)_data[_pos + 1] << 24) | ((uint32_t)_data[_pos + 2] << 16) |
+                        ((uint32_t)_data[_pos + 3] << 8) | _data[_pos + 4];
+        memcpy(&value, &bits, sizeof(value));
+        _pos += 5;
+        isNull = false;
+        return true;
+    }
+
+    bool readBool(bool& value) {
+        if (!require(1)) return false;
+        if (_data[_pos] == CBOR_TRUE) {
+            value = true;
+        } else if (_data[_pos] == CBOR_FALSE) {
+            value = false;
+        } else {
+            return fail();
+        }
+        _pos++;
+        return true;
+    }
+
+    bool readArray(uint32_t& count) { return readHeader(CBOR_MAJOR_ARRAY, count); }
+
+    bool readMap(uint32_t& count) { return readHeader(CBOR_MAJOR_MAP, count); }
+
+    // Überspringt einen beliebigen (nicht verschachtelten oder verschachtelten) Wert,
+    // damit unbekannte Felder neuerer Schema-Versionen ignoriert werden können.
+    bool skip() {
+        uint8_t major;
+        if (!peekMajor(major)) return false;
+        if (major == CBOR_MAJOR_SIMPLE) {
+            uint8_t initial = _data[_pos];
+            size_t size = initial == CBOR_FLOAT32 ? 5 : (initial == 0xF9 ? 3 : (initial == 0xFB ? 9 : 1));
+            if (!require(size)) return false;
+            _pos += size;
+            return true;
+        }
+        uint32_t argument;
+        if (!readHeader(major, argument)) return false;
+        if (major == CBOR_MAJOR_TEXT || major == 2) { // Text- oder Byte-String
+            if (!require(argument)) return false;
+            _pos += argument;
+        } else if (major == CBOR_MAJOR_ARRAY || major == CBOR_MAJOR_MAP) {
+            uint32_t items = (major == CBOR_MAJOR_MAP) ? argument * 2 : argument;
+            for (uint32_t i = 0; i < items; i++) {
+                if (!skip()) return false;
+            }
+        }
+        return true;
+    }
+
+    size_t position() const { return _pos; }
+    bool atEnd() const { return _pos == _length; }
+    bool hasError() const { return _error; }
+
+private:
+    const uint8_t* _data;
+    size_t _length;
+    size_t _pos;
+    bool _error;
+
+    bool fail() {
+        _error = true;
+        return false;
+    }
+
+    bool require(size_t count) {
+        if (_error || _pos + count > _length) {
+            return fail();
+        }
+        return true;
+    }
+
+    bool peekMajor(uint8_t& major) {
+        if (!require(1)) return false;
+        major = _data[_pos] >> 5;
+        return true;
+    }
+
+    bool readHeader(uint8_t expectedMajor, uint32_t& value) {
+        if (!require(1)) return false;
+        uint8_t initial = _data[_pos];
+        if ((initial >> 5) != expectedMajor) {
+            return fail();
+        }
+        uint8_t info = initial & 0x1F;
+        if (info < 24) {
+            value = info;
+            _pos += 1;
+        } else if (info == 24) {
+            if (!require(2)) return false;
+            value = _data[_pos + 1];
+            _pos += 2;
+        } else if (info == 25) {
+            if (!require(3)) return false;
+            value = ((uint32_t)_data[_pos + 1] << 8) | _data[_pos + 2];
+            _pos += 3;
+        } else if (info == 26) {
+            if (!require(5)) return false;
+            value = ((uint32_t)_data[_pos + 1] << 24) | ((uint32_t)_data[_pos + 2] << 16) |
+                    ((uint32_t)_data[_pos + 3] << 8) | _data[_pos + 4];
+            _pos += 5;
+        } else {
+            return fail(); // 64-Bit-Werte und unbestimmte Längen werden nicht verwendet
+        }
+        return true;
+    }
+};
+
+#endif // CBOR_READER_H
@@ -0,0 +1,130 @@
+#ifndef CBOR_WRITER_H
+#define CBOR_WRITER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// CBOR Major Types (RFC 8949, Kapitel 3.1)
+const uint8_t CBOR_MAJOR_UINT   = 0;
+const uint8_t CBOR_MAJOR_NEGINT = 1;
+const uint8_t CBOR_MAJOR_TEXT   = 3;
+const uint8_t CBOR_MAJOR_ARRAY  = 4;
+const uint8_t CBOR_MAJOR_MAP    = 5;
+const uint8_t CBOR_MAJOR_SIMPLE = 7;
+
+// Einfache Werte und Gleitkomma-Kennung in Major Type 7
+const uint8_t CBOR_FALSE   = 0xF4;
+const uint8_t CBOR_TRUE    = 0xF5;
+const uint8_t CBOR_NULL    = 0xF6;
+const uint8_t CBOR_FLOAT32 = 0xFA;
+
+// Anzahl Bytes, die ein Kopf mit dem Argument 'value' belegt.
+// constexpr, damit Puffergrössen bereits beim Kompilieren geprüft werden können.
+constexpr size_t cborHeaderSize(uint64_t value) {
+    return value < 24 ? 1 : (value <= 0xFF ? 2 : (value <= 0xFFFF ? 3 : (value <= 0xFFFFFFFFULL ? 5 : 9)));
+}
+
+// Maximale Grösse eines vorzeichenbehafteten Werts im Bereich [minValue, maxValue]
+constexpr size_t cborIntSize(int64_t minValue, int64_t maxValue) {
+    return cborHeaderSize((uint64_t)(-1 - minValue)) > cborHeaderSize((uint64_t)maxValue)
+        ? cborHeaderSize((uint64_t)(-1 - minValue))
+        : cborHeaderSize((uint64_t)maxValue);
+}
+
+const size_t CBOR_FLOAT32_SIZE = 5;
+const size_t CBOR_SIMPLE_SIZE = 1;
+
+// Schreibt CBOR in einen vom Aufrufer bereitgestellten Puffer.
+// Es wird kein Heap-Speicher verwendet. Reicht der Puffer nicht aus, wird
+// nichts mehr geschrieben und hasOverflow() liefert true.
+class CborWriter {
+public:
+    CborWriter(uint8_t* buffer, size_t size) : _buffer(buffer), _size(size), _pos(0), _overflow(false) {}
+
+    void writeUint(uint32_t value) { writeHeader(CBOR_MAJOR_UINT, value); }
+
+    void writeInt(int32_t value) {
+        if (value >= 0) {
+            writeHeader(CBOR_MAJOR_UINT, (uint32_t)value);
+        } else {
+            // Negative Zahlen werden als -1 - n kodiert
+            writeHeader(CBOR_MAJOR_NEGINT, (uint32_t)(-1 - value));
+        }
+    }
+
+    void writeFloat(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        if (!reserve(5)) return;
+        _buffer[_pos++] = CBOR_FLOAT32;
+        _buffer[_pos++] = (uint8_t)(bits >> 24);
+        _buffer[_pos++] = (uint8_t)(bits >> 16);
+        _buffer[_pos++] = (uint8_t)(bits >> 8);
+        _buffer[_pos++] = (uint8_t)bits;
+    }
+
+    void writeBool(bool value) { writeByte(value ? CBOR_TRUE : CBOR_FALSE); }
+
+    void writeNull() { writeByte(CBOR_NULL); }
+
+    void writeText(const char* text) {
+        size_t length = strlen(text);
+        writeHeader(CBOR_MAJOR_TEXT, (uint32_t)length);
+        if (!reserve(length)) return;
+        memcpy(_buffer + _pos, text, length);
+        _pos += length;
+    }
+
+    void beginArray(uint32_t count) { writeHeader(CBOR_MAJOR_ARRAY, count); }
+
+    void beginMap(uint32_t count) { writeHeader(CBOR_MAJOR_MAP, count); }
+
+    size_t length() const { return _pos; }
+    bool hasOverflow() const { return _overflow; }
+
+private:
+    uint8_t* _buffer;
+    size_t _size;
+    size_t _pos;
+    bool _overflow;
+
+    bool reserve(size_t count) {
+        if (_overflow || _pos + count > _size) {
+            _overflow = true;
+            return false;
+        }
+        return true;
+    }
+
+    void writeByte(uint8_t value) {
+        if (!reserve(1)) return;
+        _buffer[_pos++] = value;
+    }
+
+    // Schreibt den Kopf mit der kürzestmöglichen Kodierung des Arguments
+    void writeHeader(uint8_t major, uint32_t value) {
+        uint8_t type = major << 5;
+        if (value < 24) {
+            writeByte(type | (uint8_t)value);
+        } else if (value <= 0xFF) {
+            if (!reserve(2)) return;
+            _buffer[_pos++] = type | 24;
+            _buffer[_pos++] = (uint8_t)value;
+        } else if (value <= 0xFFFF) {
+            if (!reserve(3)) return;
+            _buffer[_pos++] = type | 25;
+            _buffer[_pos++] = (uint8_t)(value >> 8);
+            _buffer[_pos++] = (uint8_t)value;
+        } else {
+            if (!reserve(5)) return;
+            _buffer[_pos++] = type | 26;
+            _buffer[_pos++] = (uint8_t)(value >> 24);
+            _buffer[_pos++] = (uint8_t)(value >> 16);
+            _buffer[_pos++] = (uint8_t)(value >> 8);
+            _buffer[_pos++] = (uint8_t)value;
+        }
+    }
+};
+
+#endif // CBOR_WRITER_H
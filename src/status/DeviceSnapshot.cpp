@@ -0,0 +1,158 @@
+#include "DeviceSnapshot.h"
+#include "CborReader.h"
+
+size_t encodeDeviceSnapshot(const DeviceSnapshot& snapshot, uint8_t* buffer, size_t bufferSize) {
+    CborWriter writer(buffer, bufferSize);
+
+    writer.beginMap(SNAPSHOT_KEY_COUNT);
+
+    writer.writeUint(SNAPSHOT_KEY_VERSION);
+    writer.writeUint(DEVICE_SNAPSHOT_SCHEMA_VERSION);
+
+    writer.writeUint(SNAPSHOT_KEY_UPTIME);
+    writer.writeUint(snapshot.uptimeSec);
+
+    writer.writeUint(SNAPSHOT_KEY_INDOOR);
+    writer.beginArray(2);
+    if (snapshot.indoorValid) {
+        writer.writeFloat(snapshot.indoorTemperature);
+        writer.writeFloat(snapshot.indoorHumidity);
+    } else {
+        writer.writeNull();
+        writer.writeNull();
+    }
+
+    writer.writeUint(SNAPSHOT_KEY_OUTDOOR);
+    writer.beginArray(3);
+    if (snapshot.outdoorValid) {
+        writer.writeFloat(snapshot.outdoorTemperature);
+        writer.writeFloat(snapshot.outdoorHumidity);
+        writer.writeUint(snapshot.weatherType);
+    } else {
+        writer.writeNull();
+        writer.writeNull();
+        writer.writeNull();
+    }
+
+    writer.writeUint(SNAPSHOT_KEY_POLLEN);
+    writer.beginArray(3);
+    writer.writeInt(snapshot.grassPollenLevel);
+    writer.writeInt(snapshot.treePollenLevel);
+    writer.writeInt(snapshot.weedPollenLevel);
+
+    writer.writeUint(SNAPSHOT_KEY_AIR);
+    if (snapshot.airQualityValid) {
+        writer.writeFloat(snapshot.airQualityIndex);
+    } else {
+        writer.writeNull();
+    }
+
+    writer.writeUint(SNAPSHOT_KEY_TIME);
+    writer.beginArray(2);
+    writer.writeBool(snapshot.timeSynced);
+    writer.writeUint(snapshot.epochTime);
+
+    writer.writeUint(SNAPSHOT_KEY_COUNTERS);
+    writer.beginArray(SNAPSHOT_COUNTER_COUNT);
+    for (int i = 0; i < SNAPSHOT_COUNTER_COUNT; i++) {
+        writer.writeUint(snapshot.counters[i]);
+    }
+
+    return writer.hasOverflow() ? 0 : writer.length();
+}
+
+// Liest ein Array mit genau 'expected' Elementen
+static bool readArrayOf(CborReader& reader, uint32_t expected) {
+    uint32_t count;
+    return reader.readArray(count) && count == expected;
+}
+
+bool decodeDeviceSnapshot(const uint8_t* data, size_t length, DeviceSnapshot& snapshot) {
+    CborReader reader(data, length);
+    snapshot = DeviceSnapshot();
+
+    uint32_t entries;
+    if (!reader.readMap(entries)) {
+        return false;
+    }
+
+    bool versionSeen = false;
+    for (uint32_t i = 0; i < entries; i++) {
+        uint32_t key;
+        if (!reader.readUint(key)) {
+            return false;
+        }
+
+        bool isNull;
+        uint32_t value;
+        int32_t signedValue;
+
+        switch (key) {
+            case SNAPSHOT_KEY_VERSION:
+                if (!reader.readUint(value) || value != DEVICE_SNAPSHOT_SCHEMA_VERSION) return false;
+                versionSeen = true;
+                break;
+
+            case SNAPSHOT_KEY_UPTIME:
+                if (!reader.readUint(snapshot.uptimeSec)) return false;
+                break;
+
+            case SNAPSHOT_KEY_INDOOR:
+                if (!readArrayOf(reader, 2)) return false;
+                if (!reader.readFloat(snapshot.indoorTemperature, isNull)) return false;
+                snapshot.indoorValid = !isNull;
+                if (!reader.readFloat(snapshot.indoorHumidity, isNull)) return false;
+                break;
+
+            case SNAPSHOT_KEY_OUTDOOR:
+                if (!readArrayOf(reader, 3)) return false;
+                if (!reader.readFloat(snapshot.outdoorTemperature, isNull)) return false;
+                snapshot.outdoorValid = !isNull;
+                if (!reader.readFloat(snapshot.outdoorHumidity, isNull)) return false;
+                if (!reader.readUint(value, isNull)) return false;
+                snapshot.weatherType = isNull ? 0 : (uint8_t)value;
+                break;
+
+            case SNAPSHOT_KEY_POLLEN:
+                if (!readArrayOf(reader, 3)) return false;
+                if (!reader.readInt(signedValue)) return false;
+                snapshot.grassPollenLevel = (int8_t)signedValue;
+                if (!reader.readInt(signedValue)) return false;
+                snapshot.treePollenLevel = (int8_t)signedValue;
+                if (!reader.readInt(signedValue)) return false;
+                snapshot.weedPollenLevel = (int8_t)signedValue;
+                break;
+
+            case SNAPSHOT_KEY_AIR:
+                if (!reader.readFloat(snapshot.airQualityIndex, isNull)) return false;
+                snapshot.airQualityValid = !isNull;
+                break;
+
+            case SNAPSHOT_KEY_TIME:
+                if (!readArrayOf(reader, 2)) return false;
+                if (!reader.readBool(snapshot.timeSynced)) return false;
+                if (!reader.readUint(snapshot.epochTime)) return false;
+                break;
+
+            case SNAPSHOT_KEY_COUNTERS: {
+                uint32_t count;
+                if (!reader.readArray(count)) return false;
+                // Ältere Sender haben evtl. weniger, neuere mehr Zähler
+                for (uint32_t c = 0; c < count; c++) {
+                    if (c < SNAPSHOT_COUNTER_COUNT) {
+                        if (!reader.readUint(snapshot.counters[c])) return false;
+                    } else if (!reader.skip()) {
+                        return false;
+                    }
+                }
+                break;
+            }
+
+            default:
+                if (!reader.skip()) return false;
+                break;
+        }
+    }
+
+    return versionSeen && !reader.hasError();
+}
@@ -0,0 +1,92 @@
+#ifndef DEVICE_SNAPSHOT_H
+#define DEVICE_SNAPSHOT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "CborWriter.h"
+
+// Version des Snapshot-Schemas. Bei jeder inkompatiblen Änderung erhöhen.
+// Neue Felder dürfen nur mit neuen Schlüsseln angehängt werden, Decoder überspringen unbekannte Schlüssel.
+const uint8_t DEVICE_SNAPSHOT_SCHEMA_VERSION = 1;
+
+// Schlüssel der obersten CBOR-Map (kleine Ganzzahlen statt Text, um Platz zu sparen)
+enum DeviceSnapshotKey : uint8_t {
+    SNAPSHOT_KEY_VERSION  = 0, // uint: Schema-Version
+    SNAPSHOT_KEY_UPTIME   = 1, // uint: Laufzeit in Sekunden
+    SNAPSHOT_KEY_INDOOR   = 2, // [Temperatur °C, Feuchtigkeit %] (float oder null)
+    SNAPSHOT_KEY_OUTDOOR  = 3, // [Temperatur °C, Feuchtigkeit %, WeatherConditionType] (alle drei oder null)
+    SNAPSHOT_KEY_POLLEN   = 4, // [Gras, Baum, Kraut] (0-5, -1 = unbekannt)
+    SNAPSHOT_KEY_AIR      = 5, // IAQ 0-100 (float oder null)
+    SNAPSHOT_KEY_TIME     = 6, // [synchronisiert, Epoch-Zeit in Sekunden]
+    SNAPSHOT_KEY_COUNTERS = 7, // [Zähler gemäss DeviceSnapshotCounter]
+    SNAPSHOT_KEY_COUNT
+};
+
+// Reihenfolge der Zähler im Zähler-Array
+enum DeviceSnapshotCounter : uint8_t {
+    SNAPSHOT_COUNTER_TEMPHUMI_ERRORS = 0,
+    SNAPSHOT_COUNTER_AIRQUALITY_ERRORS,
+    SNAPSHOT_COUNTER_WEATHER_ERRORS,
+    SNAPSHOT_COUNTER_POLLEN_ERRORS,
+    SNAPSHOT_COUNTER_WIFI_LOSSES,
+    SNAPSHOT_COUNTER_COAP_REQUESTS,
+    SNAPSHOT_COUNTER_HTTP_REQUESTS,
+    SNAPSHOT_COUNTER_COUNT
+};
+
+// Typisierter, vollständiger Zustand des Geräts zu einem Zeitpunkt.
+// Reine Daten ohne String-Member, damit er kopiert und ohne Heap kodiert werden kann.
+struct DeviceSnapshot {
+    uint32_t uptimeSec = 0;
+
+    bool indoorValid = false;
+    float indoorTemperature = 0.0f;
+    float indoorHumidity = 0.0f;
+
+    bool outdoorValid = false;
+    float outdoorTemperature = 0.0f;
+    float outdoorHumidity = 0.0f;
+    uint8_t weatherType = 0;            // Wert von WeatherConditionType
+
+    int8_t grassPollenLevel = -1;
+    int8_t treePollenLevel = -1;
+    int8_t weedPollenLevel = -1;
+
+    bool airQualityValid = false;
+    float airQualityIndex = 0.0f;
+
+    bool timeSynced = false;
+    uint32_t epochTime = 0;
+
+    uint32_t counters[SNAPSHOT_COUNTER_COUNT] = {};
+};
+
+// Obere Grenze der kodierten Grösse, vollständig zur Kompilierzeit berechnet. Gezählt wird jeweils die längere
+// Form eines Werts: null (CBOR_SIMPLE_SIZE) ist nie länger als ein Float oder eine Ganzzahl.
+const size_t DEVICE_SNAPSHOT_MAX_ENCODED_SIZE =
+    cborHeaderSize(SNAPSHOT_KEY_COUNT) + SNAPSHOT_KEY_COUNT * cborHeaderSize(SNAPSHOT_KEY_COUNT)   // Map und Schlüssel
+    + cborHeaderSize(0xFF)                                                                           // Version
+    + cborHeaderSize(0xFFFFFFFFULL)                                                                  // Laufzeit
+    + cborHeaderSize(2) + 2 * CBOR_FLOAT32_SIZE                                                      // Innen
+    + cborHeaderSize(3) + 2 * CBOR_FLOAT32_SIZE + cborHeaderSize(0xFF)                               // Aussen
+    + cborHeaderSize(3) + 3 * cborIntSize(-128, 127)                                                 // Pollen
+    + CBOR_FLOAT32_SIZE                                                                              // Luftqualität
+    + cborHeaderSize(2) + CBOR_SIMPLE_SIZE + cborHeaderSize(0xFFFFFFFFULL)                           // Zeit
+    + cborHeaderSize(SNAPSHOT_COUNTER_COUNT) + SNAPSHOT_COUNTER_COUNT * cborHeaderSize(0xFFFFFFFFULL); // Zähler
+
+// Grösse der Puffer, die von den Transporten (CoAP, HTTP, ...) bereitgestellt werden
+const size_t DEVICE_SNAPSHOT_BUFFER_SIZE = 128;
+static_assert(CBOR_SIMPLE_SIZE <= CBOR_FLOAT32_SIZE && CBOR_SIMPLE_SIZE <= cborHeaderSize(0),
+              "Die Grenze setzt voraus, dass null nicht länger als ein Wert ist");
+static_assert(DEVICE_SNAPSHOT_MAX_ENCODED_SIZE <= DEVICE_SNAPSHOT_BUFFER_SIZE,
+              "DEVICE_SNAPSHOT_BUFFER_SIZE ist zu klein für den kodierten Snapshot");
+
+// Kodiert den Snapshot als CBOR in den übergebenen Puffer.
+// Gibt die Anzahl geschriebener Bytes zurück oder 0, wenn der Puffer zu klein ist.
+size_t encodeDeviceSnapshot(const DeviceSnapshot& snapshot, uint8_t* buffer, size_t bufferSize);
+
+// Dekodiert einen CBOR-Snapshot. Unbekannte Schlüssel werden übersprungen.
+// Gibt false zurück, wenn die Daten ungültig sind oder die Schema-Version nicht passt.
+bool decodeDeviceSnapshot(const uint8_t* data, size_t length, DeviceSnapshot& snapshot);
+
+#endif // DEVICE_SNAPSHOT_H
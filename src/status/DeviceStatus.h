@@ -0,0 +1,17 @@
+#ifndef DEVICE_STATUS_H
+#define DEVICE_STATUS_H
+
+#include <Arduino.h>
+
+// Zentraler Zustand und Fehlerzähler des Geräts. Die Messwerte selbst werden über Topics verteilt (siehe events/EventBus.h).
+// Wird vom Hauptprogramm gefüllt und von Netzwerk-Schnittstellen (z.B. CoAP) nur gelesen.
+struct DeviceStatus {
+    // Fehlerzähler (Health)
+    uint32_t tempHumiReadErrors = 0;    // Fehlgeschlagene Lesevorgänge SHT30
+    uint32_t airQualityReadErrors = 0;  // Fehlgeschlagene Lesevorgänge BME680
+    uint32_t weatherApiErrors = 0;      // Fehlgeschlagene Abfragen der Wetter-API
+    uint32_t pollenApiErrors = 0;       // Fehlgeschlagene Abfragen der Pollen-API
+    uint32_t wifiConnectionLosses = 0;  // Anzahl verlorener WLAN-Verbindungen im Normalbetrieb
+};
+
+#endif // DEVICE_STATUS_H
@@ -0,0 +1,71 @@
+#include "WarmBootSnapshot.h"
+#include <Arduino.h>
+#include <string.h>
+
+// "WBST"
+const uint32_t WARM_BOOT_MAGIC = 0x57425354;
+
+struct WarmBootRecord {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    uint32_t sequence;              // Höher = neuer
+    WarmBootState state;
+    uint32_t crc;                   // Über alle vorherigen Bytes des Records
+};
+
+// Bleibt bei einem Reset erhalten und wird beim Start nicht initialisiert
+RTC_NOINIT_ATTR static WarmBootRecord warmBootRecords[2];
+
+static uint32_t recordCrc(const WarmBootRecord& record) {
+    return WarmBootSnapshot::crc32((const uint8_t*)&record, offsetof(WarmBootRecord, crc));
+}
+
+static bool isValid(const WarmBootRecord& record) {
+    return record.magic == WARM_BOOT_MAGIC && record.version == WARM_BOOT_VERSION &&
+           record.size == sizeof(WarmBootState) && record.crc == recordCrc(record);
+}
+
+// Index des neusten gültigen Records, -1 wenn keiner gültig ist
+static int newestRecord() {
+    bool valid0 = isValid(warmBootRecords[0]);
+    bool valid1 = isValid(warmBootRecords[1]);
+    if (valid0 && valid1) {
+        return (int32_t)(warmBootRecords[1].sequence - warmBootRecords[0].sequence) > 0 ? 1 : 0;
+    }
+    return valid0 ? 0 : (valid1 ? 1 : -1);
+}
+
+bool WarmBootSnapshot::load(WarmBootState& state) {
+    int index = newestRecord();
+    if (index < 0) {
+        return false;
+    }
+    memcpy(&state, &warmBootRecords[index].state, sizeof(state));
+    return true;
+}
+
+void WarmBootSnapshot::save(const WarmBootState& state) {
+    int newest = newestRecord();
+    uint32_t sequence = newest >= 0 ? warmBootRecords[newest].sequence + 1 : 1;
+    WarmBootRecord& record = warmBootRecords[newest == 0 ? 1 : 0];
+
+    // Die CRC wird zuletzt geschrieben, ein unterbrochener Schreibvorgang ergibt einen ungültigen Record
+    record.magic = WARM_BOOT_MAGIC;
+    record.version = WARM_BOOT_VERSION;
+    record.size = sizeof(WarmBootState);
+    record.sequence = sequence;
+    memcpy(&record.state, &state, sizeof(state));
+    record.crc = recordCrc(record);
+}
+
+uint32_t WarmBootSnapshot::crc32(const uint8_t* data, size_t length) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
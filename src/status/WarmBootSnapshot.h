@@ -0,0 +1,45 @@
+#ifndef WARM_BOOT_SNAPSHOT_H
+#define WARM_BOOT_SNAPSHOT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../tasks/TaskMessages.h"
+
+// Version des Aufbaus von WarmBootState. Bei jeder Änderung erhöhen, alte Stände werden dann verworfen.
+const uint16_t WARM_BOOT_VERSION = 1;
+
+// Zustand der Anzeige, der einen Neustart (Software-Reset, Watchdog, Brownout) überdauert.
+// Trivialer Typ ohne Strings, wird als Block gespeichert und per CRC geprüft.
+struct WarmBootState {
+    bool timeValid;
+    uint32_t epochTime;             // Lokale Zeit (inkl. Zeitzone) beim Speichern, wie NTPTimeSync::getEpochTime()
+
+    bool weatherValid;
+    float outdoorTemperature;
+    float outdoorHumidity;
+    uint8_t weatherType;            // Wert von WeatherConditionType
+
+    PollenLevels pollen;            // -1 = unbekannt
+
+    bool settingsValid;
+    DisplaySettings settings;
+    uint32_t ipAddress;
+};
+
+// Speichert WarmBootState im RTC-Speicher (RTC_NOINIT), der bei einem Reset erhalten bleibt,
+// aber nicht beim Einschalten. Zwei Speicherplätze werden abwechselnd beschrieben: Wird ein
+// Schreibvorgang durch einen Reset unterbrochen, bleibt der vorherige Stand gültig.
+// Beschädigte oder zufällige Inhalte (z.B. nach dem Einschalten) erkennt die CRC.
+class WarmBootSnapshot {
+public:
+    // Lädt den neusten gültigen Stand. Gibt false zurück, wenn keiner vorhanden ist.
+    static bool load(WarmBootState& state);
+
+    // Speichert den Stand im jeweils älteren Speicherplatz. Darf nur aus einer Task aufgerufen werden.
+    static void save(const WarmBootState& state);
+
+    // CRC-32 (IEEE 802.3), auch für Tests zugänglich
+    static uint32_t crc32(const uint8_t* data, size_t length);
+};
+
+#endif // WARM_BOOT_SNAPSHOT_H
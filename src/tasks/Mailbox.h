@@ -0,0 +1,66 @@
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// Schnappschuss-Puffer für Daten, die zwischen Tasks geteilt werden.
+// Der Schreiber legt jeweils den neusten Stand ab, Leser erhalten immer eine vollständige Kopie
+// (nie einen halb geschriebenen Wert). Geschützt durch einen Mutex statt einer Critical Section,
+// weil T auch Strings enthalten darf (Heap-Zugriff beim Kopieren).
+// Die Sequenznummer erlaubt es einem Leser, nur auf Änderungen zu reagieren.
+template <typename T>
+class Mailbox {
+public:
+    Mailbox() : _sequence(0) {
+        _mutex = xSemaphoreCreateMutex();
+    }
+
+    // Ersetzt den gespeicherten Wert.
+    void publish(const T& value) {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        _value = value;
+        _sequence++;
+        xSemaphoreGive(_mutex);
+    }
+
+    // Ändert einzelne Felder des gespeicherten Werts (z.B. wenn mehrere Tasks verschiedene Felder schreiben).
+    template <typename Function>
+    void update(Function function) {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        function(_value);
+        _sequence++;
+        xSemaphoreGive(_mutex);
+    }
+
+    // Kopiert den aktuellen Wert.
+    T read() const {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        T copy = _value;
+        xSemaphoreGive(_mutex);
+        return copy;
+    }
+
+    // Kopiert den Wert nur, wenn er seit lastSequence geändert wurde. Aktualisiert lastSequence.
+    bool readIfChanged(T& value, uint32_t& lastSequence) const {
+        if (_sequence == lastSequence) {
+            return false;
+        }
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        value = _value;
+        lastSequence = _sequence;
+        xSemaphoreGive(_mutex);
+        return true;
+    }
+
+private:
+    Mailbox(const Mailbox&) = delete;
+    Mailbox& operator=(const Mailbox&) = delete;
+
+    mutable SemaphoreHandle_t _mutex;
+    T _value;
+    volatile uint32_t _sequence;
+};
+
+#endif // MAILBOX_H
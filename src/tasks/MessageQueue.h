@@ -0,0 +1,43 @@
+#ifndef MESSAGE_QUEUE_H
+#define MESSAGE_QUEUE_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+// Begrenzte Warteschlange für Nachrichten zwischen Tasks (dünne Hülle um eine FreeRTOS-Queue).
+// T muss trivial kopierbar sein (keine Strings), da die Queue die Bytes kopiert.
+// Senden blockiert nie: Ist die Queue voll, wird die Nachricht verworfen und gezählt.
+template <typename T, int Length>
+class MessageQueue {
+public:
+    MessageQueue() : _dropped(0) {
+        _queue = xQueueCreate(Length, sizeof(T));
+    }
+
+    // Legt eine Nachricht ab. Gibt false zurück, wenn die Queue voll war.
+    bool send(const T& message) {
+        if (xQueueSend(_queue, &message, 0) != pdTRUE) {
+            _dropped++;
+            return false;
+        }
+        return true;
+    }
+
+    // Holt die nächste Nachricht ohne zu warten. Gibt false zurück, wenn keine vorhanden ist.
+    bool receive(T& message) {
+        return xQueueReceive(_queue, &message, 0) == pdTRUE;
+    }
+
+    uint32_t getDroppedCount() const { return _dropped; }
+    int getWaitingCount() const { return (int)uxQueueMessagesWaiting(_queue); }
+
+private:
+    MessageQueue(const MessageQueue&) = delete;
+    MessageQueue& operator=(const MessageQueue&) = delete;
+
+    QueueHandle_t _queue;
+    volatile uint32_t _dropped;
+};
+
+#endif // MESSAGE_QUEUE_H
@@ -0,0 +1,51 @@
+#include "SchedulerTask.h"
+#include "../logger/Logger.h"
+
+SchedulerTask::SchedulerTask(const char* name, Scheduler& scheduler, uint32_t stackSize, UBaseType_t priority, BaseType_t core)
+  : _name(name), _scheduler(scheduler), _stackSize(stackSize), _priority(priority), _core(core), _handle(nullptr), _wakeJob(SCHEDULER_INVALID_JOB),
+    _loadPermille(0), _stackHighWater(0), _loops(0) {}
+
+bool SchedulerTask::start() {
+    if (_handle != nullptr) {
+        return false;
+    }
+    if (xTaskCreatePinnedToCore(run, _name, _stackSize, this, _priority, &_handle, _core) != pdPASS) {
+        Logger::log(LogLevel::Error, "Task " + String(_name) + " konnte nicht gestartet werden!");
+        _handle = nullptr;
+        return false;
+    }
+    Logger::log(LogLevel::Info, "Task " + String(_name) + " auf Kern " + String(_core) + " gestartet (Priorität " + String(_priority) + ").");
+    return true;
+}
+
+void SchedulerTask::notifyFromIsr() {
+    if (_handle == nullptr) {
+        return;
+    }
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(_handle, &higherPriorityTaskWoken);
+    if (higherPriorityTaskWoken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+void SchedulerTask::sampleStats() {
+    _loadPermille = _scheduler.getLoadPermille();
+    // Auf dem ESP32 liefert FreeRTOS die Stack-Reserve bereits in Bytes
+    _stackHighWater = uxTaskGetStackHighWaterMark(nullptr);
+    _scheduler.resetStats();
+}
+
+void SchedulerTask::run(void* parameter) {
+    SchedulerTask* task = static_cast<SchedulerTask*>(parameter);
+    for (;;) {
+        task->_scheduler.runDue();
+        task->_loops++;
+        // Mindestens einen Tick schlafen, damit niedriger priorisierte Tasks (und der Idle-Task
+        // mit dem Watchdog) auf diesem Kern nicht verhungern.
+        TickType_t ticks = pdMS_TO_TICKS(task->_scheduler.timeUntilNext());
+        if (ulTaskNotifyTake(pdTRUE, ticks > 0 ? ticks : 1) > 0 && task->_wakeJob != SCHEDULER_INVALID_JOB) {
+            task->_scheduler.trigger(task->_wakeJob);
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef SCHEDULER_TASK_H
+#define SCHEDULER_TASK_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../scheduler/Scheduler.h"
+
+// Führt einen Scheduler in einer eigenen FreeRTOS-Task aus, die fest einem Kern zugeordnet ist.
+// Die Task schläft jeweils bis zur nächsten Deadline ihres Schedulers oder bis sie von einem
+// Interrupt geweckt wird (notifyFromIsr()).
+class SchedulerTask {
+public:
+    SchedulerTask(const char* name, Scheduler& scheduler, uint32_t stackSize, UBaseType_t priority, BaseType_t core);
+
+    // Erstellt und startet die Task. Darf nur einmal aufgerufen werden.
+    bool start();
+
+    // Job, der sofort läuft, wenn die Task über notifyFromIsr() geweckt wird (z.B. Tasten auswerten).
+    // Vor start() setzen.
+    void setWakeJob(JobId job) { _wakeJob = job; }
+
+    // Weckt die Task aus einer Interrupt-Routine.
+    void notifyFromIsr();
+
+    // Erfasst CPU-Last und Stack-Reserve und setzt die Job-Statistik des Schedulers zurück.
+    // Muss innerhalb der Task selbst aufgerufen werden (z.B. aus einem Statistik-Job).
+    void sampleStats();
+
+    const char* getName() const { return _name; }
+    Scheduler& getScheduler() { return _scheduler; }
+    uint32_t getLoadPermille() const { return _loadPermille; }        // Zuletzt gemessene CPU-Last
+    uint32_t getStackHighWaterMark() const { return _stackHighWater; } // Minimal freier Stack in Bytes
+    uint32_t getLoopCount() const { return _loops; }                  // Durchläufe der Task (Fortschritt für den Supervisor)
+
+private:
+    const char* _name;
+    Scheduler& _scheduler;
+    uint32_t _stackSize;
+    UBaseType_t _priority;
+    BaseType_t _core;
+    TaskHandle_t _handle;
+    JobId _wakeJob;
+
+    volatile uint32_t _loadPermille;
+    volatile uint32_t _stackHighWater;
+    volatile uint32_t _loops;
+
+    static void run(void* parameter);
+};
+
+#endif // SCHEDULER_TASK_H
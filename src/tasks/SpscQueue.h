@@ -0,0 +1,50 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdint.h>
+#include <atomic>
+
+// Lock-freie Warteschlange für genau einen Schreiber und genau einen Leser,
+// z.B. von einer Interrupt-Routine an eine Task. Es wird weder ein Mutex noch eine
+// Critical Section benötigt, der Schreiber darf deshalb auch ein Interrupt sein.
+// Size muss eine Zweierpotenz sein. Ist die Queue voll, wird der Eintrag verworfen und gezählt.
+// Header-only und ohne Arduino-Abhängigkeit.
+template <typename T, uint32_t Size>
+class SpscQueue {
+    static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "Size muss eine Zweierpotenz sein");
+
+public:
+    // Nur vom Schreiber aufrufen. Gibt false zurück, wenn die Queue voll war.
+    bool push(const T& value) {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) >= Size) {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        _items[head & (Size - 1)] = value;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Nur vom Leser aufrufen. Gibt false zurück, wenn die Queue leer ist.
+    bool pop(T& value) {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = _items[tail & (Size - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool isEmpty() const { return _tail.load(std::memory_order_acquire) == _head.load(std::memory_order_acquire); }
+    uint32_t getDroppedCount() const { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+    T _items[Size];
+    std::atomic<uint32_t> _head{0};     // Nächster Schreibplatz (nur der Schreiber ändert ihn)
+    std::atomic<uint32_t> _tail{0};     // Nächster Leseplatz (nur der Leser ändert ihn)
+    std::atomic<uint32_t> _dropped{0};
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,122 @@
+#ifndef TASK_MESSAGES_H
+#define TASK_MESSAGES_H
+
+#include <stdint.h>
+
+// Nachrichten und Schnappschüsse, die zwischen der Netzwerk-Task und der Anzeige-Task ausgetauscht werden.
+// Alle Typen sind trivial kopierbar, damit sie direkt in eine FreeRTOS-Queue bzw. ein Topic passen.
+// Werte, die über Topics verteilt werden, brauchen operator== (nur Änderungen werden zugestellt).
+
+// Einstellungen, welche die Anzeige-Task selbst anwendet (Topic "settings")
+struct DisplaySettings {
+    uint32_t textColor;         // 0xRRGGBB
+    int brightness;             // 0-100
+    int volume;                 // 0-30
+    int indoorTimeSec;          // Anzeigedauer Innenwerte
+    int outdoorTimeSec;         // Anzeigedauer Aussenwerte
+
+    bool operator==(const DisplaySettings& other) const {
+        return textColor == other.textColor && brightness == other.brightness && volume == other.volume &&
+               indoorTimeSec == other.indoorTimeSec && outdoorTimeSec == other.outdoorTimeSec;
+    }
+};
+
+// Einstellungen der Netzwerkdienste aus der Konfiguration (Topic "service")
+struct ServiceSettings {
+    int weatherUpdateIntervalMin = 0;
+    int pollenUpdateIntervalMin = 0;
+    float latitude = 0.0f;
+    float longitude = 0.0f;
+
+    bool operator==(const ServiceSettings& other) const {
+        return weatherUpdateIntervalMin == other.weatherUpdateIntervalMin && pollenUpdateIntervalMin == other.pollenUpdateIntervalMin &&
+               latitude == other.latitude && longitude == other.longitude;
+    }
+};
+
+// Pollenbelastung 0-5, -1 = unbekannt (Topic "pollen")
+struct PollenLevels {
+    int8_t grass;
+    int8_t tree;
+    int8_t weed;
+
+    bool operator==(const PollenLevels& other) const {
+        return grass == other.grass && tree == other.tree && weed == other.weed;
+    }
+};
+
+// Innenwerte des SHT30, auf die angezeigte Auflösung (0.1) gerundet (Topic "indoor")
+struct IndoorClimate {
+    float temperature = 0.0f;   // °C
+    float humidity = 0.0f;      // %
+
+    bool operator==(const IndoorClimate& other) const {
+        return temperature == other.temperature && humidity == other.humidity;
+    }
+};
+
+// Aktuelles Wetter aus der Wetter-API (Topic "weather")
+struct OutdoorWeather {
+    float temperature = 0.0f;   // °C
+    float humidity = 0.0f;      // %
+    uint8_t weatherType = 0;    // Wert von WeatherConditionType
+
+    bool operator==(const OutdoorWeather& other) const {
+        return temperature == other.temperature && humidity == other.humidity && weatherType == other.weatherType;
+    }
+};
+
+// Angezeigte Uhrzeit (Topic "minute"). Die Wortuhr ändert sich nur jede Minute.
+struct ClockMinute {
+    uint8_t hour = 0;           // 0-23
+    uint8_t minute = 0;         // 0-59
+
+    bool operator==(const ClockMinute& other) const {
+        return hour == other.hour && minute == other.minute;
+    }
+};
+
+enum DisplayMessageType {
+    DISPLAY_MSG_ONLINE,         // Normalbetrieb mit WLAN begonnen oder beendet (online)
+    DISPLAY_MSG_IP_ADDRESS,     // Neue IP-Adresse der Station bzw. des Access Points (ipAddress, für das Menü)
+    DISPLAY_MSG_RECOVER         // Massnahme des Health-Supervisors für ein Subsystem der Anzeige-Task (recover)
+};
+
+// Massnahme des Health-Supervisors, die in der Task des Subsystems ausgeführt werden muss
+struct HealthRecoveryRequest {
+    uint8_t subsystem;          // HealthSubsystem
+    uint8_t action;             // HealthAction
+};
+
+// Nachricht von der Netzwerk-Task an die Anzeige-Task
+struct DisplayMessage {
+    DisplayMessageType type;
+    union {
+        bool online;
+        uint32_t ipAddress;     // Netzwerk-Byte-Reihenfolge wie IPAddress
+        HealthRecoveryRequest recover;
+    };
+};
+
+enum NetworkMessageType {
+    NETWORK_MSG_REFRESH,        // Wetter, Pollen und Zeit sofort aktualisieren
+    NETWORK_MSG_DISPLAY_VALUES, // Im Menü geänderte Helligkeit und Lautstärke speichern (brightness, volume)
+    NETWORK_MSG_RECOVER         // Massnahme des Health-Supervisors für ein Subsystem der Netzwerk-Task (recover)
+};
+
+// Nachricht von der Anzeige-Task (Menü) an die Netzwerk-Task
+struct NetworkMessage {
+    NetworkMessageType type;
+    int brightness;
+    int volume;
+    HealthRecoveryRequest recover;
+};
+
+// Latenz von der Tastenflanke bis zur fertigen Anzeige, von der Anzeige-Task gemessen
+struct InputLatencyStats {
+    uint32_t events = 0;
+    uint64_t totalMicros = 0;
+    uint32_t maxMicros = 0;
+};
+
+#endif // TASK_MESSAGES_H
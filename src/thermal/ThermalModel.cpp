@@ -0,0 +1,124 @@
+#include "ThermalModel.h"
+#include <math.h>
+
+ThermalModel::ThermalModel(const ThermalModelConfig& config)
+  : _idleOffset(config.idleOffset), _timeConstantMs(config.timeConstantMs), _lastLoadMs(0), _loadStarted(false),
+    _observedTemperature(0.0f), _observed(false), _residualSquare(0.0f), _observations(0), _fits(0) {
+    for (int i = 0; i < THERMAL_LOAD_COUNT; i++) {
+        _coefficients[i] = config.coefficients[i];
+        _filtered[i] = 0.0f; // Nach dem Einschalten ist das Gehäuse noch kalt
+        _observedLoad[i] = 0.0f;
+        for (int j = 0; j < THERMAL_LOAD_COUNT; j++) {
+            _covariance[i][j] = i == j ? THERMAL_INITIAL_VARIANCE : 0.0f;
+        }
+    }
+}
+
+void ThermalModel::addLoad(const float (&load)[THERMAL_LOAD_COUNT], unsigned long nowMs) {
+    if (!_loadStarted) {
+        _loadStarted = true;
+        _lastLoadMs = nowMs;
+        return;
+    }
+    float elapsedMs = (float)(unsigned long)(nowMs - _lastLoadMs);
+    _lastLoadMs = nowMs;
+    float weight = elapsedMs / (elapsedMs + (float)_timeConstantMs);
+    for (int i = 0; i < THERMAL_LOAD_COUNT; i++) {
+        float value = load[i] < 0.0f ? 0.0f : (load[i] > 1.0f ? 1.0f : load[i]);
+        _filtered[i] += (value - _filtered[i]) * weight;
+    }
+}
+
+void ThermalModel::observe(float rawTemperature) {
+    if (!_observed) {
+        _observed = true;
+    } else {
+        float change[THERMAL_LOAD_COUNT];
+        float predicted = 0.0f;
+        float excitation = 0.0f;
+        for (int i = 0; i < THERMAL_LOAD_COUNT; i++) {
+            change[i] = _filtered[i] - _observedLoad[i];
+            predicted += _coefficients[i] * change[i];
+            excitation += change[i] * change[i];
+        }
+        float error = (rawTemperature - _observedTemperature) - predicted;
+        _residualSquare += (error * error - _residualSquare) * (_observations == 0 ? 1.0f : THERMAL_RESIDUAL_WEIGHT);
+        _observations++;
+        // Ohne Laständerung enthält die Beobachtung nur Raumtemperatur und Rauschen
+        if (excitation >= THERMAL_MIN_EXCITATION) {
+            fit(change, error);
+        }
+    }
+    _observedTemperature = rawTemperature;
+    for (int i = 0; i < THERMAL_LOAD_COUNT; i++) {
+        _observedLoad[i] = _filtered[i];
+    }
+}
+
+void ThermalModel::fit(const float (&change)[THERMAL_LOAD_COUNT], float error) {
+    // Rekursive kleinste Quadrate: gain = P x / (lambda + x' P x), P = (P - gain x' P) / lambda
+    float px[THERMAL_LOAD_COUNT];
+    float denominator = THERMAL_FORGETTING;
+    for (int i = 0; i < THERMAL_LOAD_COUNT; i++) {
+        px[i] = 0.0f;
+        for (int j = 0; j < THERMAL_LOAD_COUNT; j++) {
+            px[i] += _covariance[i][j] * change[j];
+        }
+        denominator += change[i] * px[i];
+    }
+    for (int i = 0; i < THERMAL_LOAD_COUNT; i++) {
+        float gain = px[i] / denominator;
+        _coefficients[i] += gain * error;
+        if (_coefficients[i] < 0.0f) _coefficients[i] = 0.0f; // Eine Last kann den Sensor nicht kühlen
+        if (_coefficients[i] > THERMAL_MAX_COEFFICIENT) _coefficients[i] = THERMAL_MAX_COEFFICIENT;
+    }
+    float maxVariance = 0.0f;
+    for (int i = 0; i < THERMAL_LOAD_COUNT; i++) {
+        for (int j = 0; j < THERMAL_LOAD_COUNT; j++) {
+            _covariance[i][j] = (_covariance[i][j] - px[i] * px[j] / denominator) / THERMAL_FORGETTING;
+        }
+        if (_covariance[i][i] > maxVariance) maxVariance = _covariance[i][i];
+    }
+    // Selten angeregte Lasten: die Unsicherheit nicht über den Startwert hinaus wachsen lassen
+    if (maxVariance > THERMAL_INITIAL_VARIANCE) {
+        float scale = THERMAL_INITIAL_VARIANCE / maxVariance;
+        for (int i = 0; i < THERMAL_LOAD_COUNT; i++) {
+            for (int j = 0; j < THERMAL_LOAD_COUNT; j++) {
+                _covariance[i][j] *= scale;
+            }
+        }
+    }
+    _fits++;
+}
+
+float ThermalModel::getSelfHeating() const {
+    float selfHeating = _idleOffset;
+    for (int i = 0; i < THERMAL_LOAD_COUNT; i++) {
+        selfHeating += getContribution(i);
+    }
+    return selfHeating;
+}
+
+float ThermalModel::getResidualRms() const {
+    return sqrtf(_residualSquare);
+}
+
+ThermalDecision decideThermalMode(float selfHeating, ThermalMode currentMode, const ThermalPolicyConfig& config) {
+    ThermalMode mode = currentMode;
+    if (selfHeating > config.selfHeatingLimit) {
+        mode = THERMAL_MODE_REDUCED;
+    } else if (selfHeating < config.selfHeatingLimit - config.hysteresis) {
+        mode = THERMAL_MODE_NORMAL;
+    }
+
+    ThermalDecision decision;
+    decision.mode = mode;
+    if (mode == THERMAL_MODE_REDUCED) {
+        decision.airQualityIntervalMs = config.reducedAirQualityIntervalMs;
+        decision.brightnessLimit = config.reducedBrightnessLimit;
+    } else {
+        decision.airQualityIntervalMs = config.airQualityIntervalMs;
+        decision.brightnessLimit = 100;
+    }
+    return decision;
+}
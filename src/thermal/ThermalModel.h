@@ -0,0 +1,104 @@
+#ifndef THERMAL_MODEL_H
+#define THERMAL_MODEL_H
+
+#include <stdint.h>
+
+// Wärmequellen in der Nähe des SHT30
+enum ThermalLoad {
+    THERMAL_LOAD_CPU,       // CPU-Last der Scheduler-Tasks (Anteil beider Kerne)
+    THERMAL_LOAD_LED,       // Strom des LED-Streifens (Anteil aller LEDs weiss bei voller Helligkeit)
+    THERMAL_LOAD_HEATER,    // Einschaltdauer der Gasheizung des BME680
+    THERMAL_LOAD_COUNT
+};
+
+const float THERMAL_MAX_COEFFICIENT = 20.0f;    // Obergrenze eines Koeffizienten in °C bei voller Last
+const float THERMAL_MIN_EXCITATION = 1e-6f;     // Kleinere Laständerungen taugen nicht zur Anpassung
+const float THERMAL_FORGETTING = 0.995f;        // Gewicht früherer Beobachtungen pro Anpassung
+const float THERMAL_INITIAL_VARIANCE = 4.0f;    // Unsicherheit der Startwerte in °C²
+const float THERMAL_RESIDUAL_WEIGHT = 0.05f;    // Glättung des mittleren Restfehlers
+
+// Startwerte des Modells (aus Settings.h)
+struct ThermalModelConfig {
+    float idleOffset;                           // Eigenerwärmung ohne Last in °C (Spannungsregler, WLAN-Empfang)
+    float coefficients[THERMAL_LOAD_COUNT];     // Eigenerwärmung bei voller Last in °C
+    unsigned long timeConstantMs;               // Thermische Zeitkonstante zwischen Last und Sensor
+};
+
+// Schätzt die Eigenerwärmung des Innensensors aus den Lasten der Wärmequellen.
+// Jede Last wirkt über ein Glied erster Ordnung (Zeitkonstante des Gehäuses) mit einem eigenen Koeffizienten
+// auf den Sensor: Rohwert = Raumtemperatur + Grundwert + Summe(Koeffizient * geglättete Last).
+// Die Raumtemperatur ist unbekannt, sie ändert sich aber langsam. Die Koeffizienten werden deshalb aus den
+// Änderungen zwischen zwei Beobachtungen angepasst (rekursive kleinste Quadrate mit Vergessensfaktor):
+// ändert sich eine Last, muss sich der Rohwert um Koeffizient * Änderung der geglätteten Last ändern.
+// Der Grundwert ist so nicht beobachtbar und bleibt beim Startwert.
+// Reine Logik ohne Arduino-Abhängigkeit, die Zeit wird von aussen übergeben.
+class ThermalModel {
+public:
+    explicit ThermalModel(const ThermalModelConfig& config);
+
+    // Lasten (je 0-1, Mittel seit dem letzten Aufruf) über die Zeitkonstante glätten. Der erste Aufruf startet die Zeitmessung.
+    void addLoad(const float (&load)[THERMAL_LOAD_COUNT], unsigned long nowMs);
+
+    // Rohwert des Sensors: Restfehler bestimmen und die Koeffizienten an die Änderung seit der letzten Beobachtung anpassen
+    void observe(float rawTemperature);
+
+    // Geschätzte Eigenerwärmung in °C, vom Rohwert abzuziehen
+    float getSelfHeating() const;
+    float getContribution(int load) const { return _coefficients[load] * _filtered[load]; }
+
+    float getCoefficient(int load) const { return _coefficients[load]; }
+    float getFilteredLoad(int load) const { return _filtered[load]; }
+
+    // Mittlerer Fehler der vorhergesagten Änderungen (RMS) in °C
+    float getResidualRms() const;
+    uint32_t getObservationCount() const { return _observations; }
+    uint32_t getFitCount() const { return _fits; }
+
+private:
+    float _idleOffset;
+    float _coefficients[THERMAL_LOAD_COUNT];
+    float _covariance[THERMAL_LOAD_COUNT][THERMAL_LOAD_COUNT];
+    unsigned long _timeConstantMs;
+
+    float _filtered[THERMAL_LOAD_COUNT];
+    unsigned long _lastLoadMs;
+    bool _loadStarted;
+
+    // Stand bei der letzten Beobachtung
+    float _observedTemperature;
+    float _observedLoad[THERMAL_LOAD_COUNT];
+    bool _observed;
+
+    float _residualSquare;
+    uint32_t _observations;
+    uint32_t _fits;
+
+    void fit(const float (&change)[THERMAL_LOAD_COUNT], float error);
+};
+
+// Zustand des Wärmemanagements
+enum ThermalMode {
+    THERMAL_MODE_NORMAL,    // Gasheizung im Anzeigetakt der Luftqualität, volle Helligkeit
+    THERMAL_MODE_REDUCED    // Eigenerwärmung zu hoch: Gasheizung seltener, Helligkeit begrenzt
+};
+
+// Feste Vorgaben des Wärmemanagements (aus Settings.h)
+struct ThermalPolicyConfig {
+    float selfHeatingLimit;                 // Darüber wird gedrosselt (°C)
+    float hysteresis;                       // Zurück erst unter selfHeatingLimit - hysteresis
+    unsigned long airQualityIntervalMs;     // Messintervall des BME680 im Normalbetrieb
+    unsigned long reducedAirQualityIntervalMs;
+    int reducedBrightnessLimit;             // Höchste Helligkeit (0-100) im gedrosselten Zustand
+};
+
+// Ergebnis des Wärmemanagements
+struct ThermalDecision {
+    ThermalMode mode;
+    unsigned long airQualityIntervalMs;
+    int brightnessLimit;                    // 0-100, 100 = nicht begrenzt
+};
+
+// Bestimmt aus der geschätzten Eigenerwärmung, ob gedrosselt wird. Reine Funktion ohne Hardwarezugriff.
+ThermalDecision decideThermalMode(float selfHeating, ThermalMode currentMode, const ThermalPolicyConfig& config);
+
+#endif // THERMAL_MODEL_H
@@ -1,4 +1,5 @@
 #include "ApiClient.h"
+#include "../../Settings.h"
 #include <ArduinoJson.h> // Stellen Sie sicher, dass dies für JsonDocument enthalten ist
 
 // Hilfsfunktion zum Entfernen der Chunked-Codierung aus einem rohen HTTP-Antwort-Body.
@@ -56,7 +57,7 @@ String stripChunkedEncoding(const String& rawResponse) {
 }
 
 // Konstruktor initialisiert Member
-ApiClient::ApiClient() : _host(nullptr), _apiKey(nullptr) {
+ApiClient::ApiClient() : _host(nullptr), _apiKey(nullptr), _cancelRequested(false) {
     // Root-CA-Zertifikat hier setzen, da es für alle Google APIs gleich sein sollte
     // Gültig bis 2036-06-22
     // Ein Neues Zertifikat kann von: https://pki.goog/repository/ herunter geladen werden
@@ -92,6 +93,17 @@ ApiClient::ApiClient() : _host(nullptr), _apiKey(nullptr) {
                                  "bP6MvPJwNQzcmRk13NfIRmPVNnGuV/u3gm3c\n"
                                  "-----END CERTIFICATE-----\n";
     _client.setCACert(google_root_ca);
+    _client.setHandshakeTimeout(API_HANDSHAKE_TIMEOUT);
+    _client.setTimeout(API_SOCKET_TIMEOUT);
+}
+
+bool ApiClient::cancelled() {
+    if (!_cancelRequested.load()) {
+        return false;
+    }
+    Logger::log(LogLevel::Error, "ApiClient: Abfrage abgebrochen.");
+    _client.stop();
+    return true;
 }
 
 void ApiClient::configure(const char* host, const char* apiKey) {
@@ -115,10 +127,15 @@ bool ApiClient::sendGetRequest(const String& path, JsonDocument& doc) {
 
     Logger::log(LogLevel::Info, "ApiClient: Verbinde mit " + String(_host));
 
-    if (!_client.connect(_host, 443)) { // 443 ist der Standard-HTTPS-Port
+    // Ein Abbruch gilt nur für die laufende Abfrage
+    _cancelRequested.store(false);
+    if (!_client.connect(_host, 443, API_CONNECT_TIMEOUT)) { // 443 ist der Standard-HTTPS-Port
         Logger::log(LogLevel::Error, "ApiClient: Verbindung zum Server fehlgeschlagen!");
         return false;
     }
+    if (cancelled()) {
+        return false;
+    }
 
     // HTTP-Anfrage senden
     _client.print(F("GET "));
@@ -130,8 +147,11 @@ bool ApiClient::sendGetRequest(const String& path, JsonDocument& doc) {
     _client.println(); // Leere Zeile nach den Headern
 
     // Auf die Antwort warten und HTTP-Header lesen
-    unsigned long timeout = millis() + 10000; // 10 Sekunden Timeout
-    while (_client.available() == 0 && millis() < timeout) {
+    unsigned long start = millis();
+    while (_client.available() == 0 && millis() - start < API_RESPONSE_TIMEOUT) {
+        if (cancelled()) {
+            return false;
+        }
         delay(10);
     }
 
@@ -156,6 +176,9 @@ bool ApiClient::sendGetRequest(const String& path, JsonDocument& doc) {
     
     // Alle weiteren Header bis zur leeren Zeile verwerfen
     while (_client.available()) {
+        if (cancelled()) {
+            return false;
+        }
         String line = _client.readStringUntil('\n');
         Logger::log(LogLevel::Debug, "Header: " + line); // Debug: Zeige alle Header
 
@@ -166,6 +189,9 @@ bool ApiClient::sendGetRequest(const String& path, JsonDocument& doc) {
     }
 
     // Den gesamten Body lesen, der Chunk-Informationen enthalten kann
+    if (cancelled()) {
+        return false;
+    }
     String rawResponseBody = _client.readString();
     Logger::log(LogLevel::Debug, "======================================\nRoher API Antwort Body (inkl. Chunk-Info):" + rawResponseBody +"\n======================================");
 
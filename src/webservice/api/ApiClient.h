@@ -2,6 +2,7 @@
 #define API_CLIENT_H
 
 #include <Arduino.h>
+#include <atomic>
 #include <WiFi.h>
 #include <WiFiClientSecure.h>
 #include <ArduinoJson.h>
@@ -18,6 +19,15 @@ public:
     // Wird von den getInstance-Methoden der abgeleiteten Klassen aufgerufen.
     void configure(const char* host, const char* apiKey);
 
+    // Schliesst die Verbindung und verwirft den TLS-Zustand (Wiederherstellung nach wiederholten Fehlern).
+    // Nur aus der Task, welche die Abfragen ausführt.
+    void resetConnection() { _client.stop(); }
+
+    // Fordert den Abbruch einer laufenden Abfrage an (aus jeder Task, z.B. vom Health-Supervisor, wenn die
+    // Netzwerk-Task hängt). Der Client wird hier nicht geschlossen, da die Abfrage den TLS-Zustand gerade
+    // verwenden kann: sie bemerkt den Abbruch spätestens nach dem nächsten Timeout und schliesst ihn selbst.
+    void cancel() { _cancelRequested.store(true); }
+
 protected:
     // Konstruktor ist protected, damit er nur von abgeleiteten Klassen aufgerufen werden kann
     ApiClient();
@@ -29,6 +39,10 @@ protected:
     const char* _host;
     const char* _apiKey;
     WiFiClientSecure _client; // Für HTTPS-Verbindungen
+    std::atomic<bool> _cancelRequested;
+
+    // true, wenn cancel() aufgerufen wurde. Schliesst dann die Verbindung.
+    bool cancelled();
 
     // Gemeinsame Methode zum Senden einer GET-Anfrage und Empfangen der JSON-Antwort
     // Gibt true bei Erfolg zurück, füllt JsonDocument
@@ -0,0 +1,501 @@
+#include "CoapServer.h"
+#include "../../logger/Logger.h"
+
+// CoAP Nachrichtentypen (RFC 7252, Kapitel 3)
+#define COAP_TYPE_CON 0
+#define COAP_TYPE_NON 1
+#define COAP_TYPE_ACK 2
+#define COAP_TYPE_RST 3
+
+// CoAP Codes im Format c.dd -> (c << 5) | dd
+#define COAP_CODE_EMPTY              0x00
+#define COAP_CODE_GET                0x01
+#define COAP_CODE_CONTENT            0x45 // 2.05
+#define COAP_CODE_NOT_FOUND          0x84 // 4.04
+#define COAP_CODE_METHOD_NOT_ALLOWED 0x85 // 4.05
+#define COAP_CODE_INTERNAL_ERROR     0xA0 // 5.00
+
+// CoAP Optionsnummern
+#define COAP_OPTION_OBSERVE        6
+#define COAP_OPTION_URI_PATH       11
+#define COAP_OPTION_CONTENT_FORMAT 12
+
+#define COAP_PAYLOAD_MARKER 0xFF
+
+// Header (4) + Token (8) + Observe (4) + Content-Format (3) + Marker (1) + Nutzdaten
+static_assert(4 + 8 + 4 + 3 + 1 + COAP_PAYLOAD_SIZE <= COAP_BUFFER_SIZE, "COAP_BUFFER_SIZE ist zu klein für COAP_PAYLOAD_SIZE");
+
+CoapServer::CoapServer()
+  : _running(false), _nextMessageId(0), _lastObserveCheck(0), _resourceCount(0), _wellKnownCoreLength(0),
+    _requestCount(0), _errorCount(0), _notificationCount(0), _requestMicrosTotal(0), _requestMicrosMax(0) {
+    for (int i = 0; i < COAP_MAX_OBSERVERS; i++) {
+        _observers[i].active = false;
+    }
+}
+
+bool CoapServer::begin(uint16_t port) {
+    if (_running) {
+        stop();
+    }
+    if (!_udp.begin(port)) {
+        Logger::log(LogLevel::Error, "CoapServer: UDP-Port " + String(port) + " konnte nicht geöffnet werden.");
+        return false;
+    }
+    // Zufällige Start-ID, damit Nachrichten nach einem Neustart nicht als Duplikate gelten
+    _nextMessageId = (uint16_t)esp_random();
+    _running = true;
+    Logger::log(LogLevel::Info, "CoAP-Server auf UDP-Port " + String(port) + " gestartet.");
+    return true;
+}
+
+void CoapServer::stop() {
+    _udp.stop();
+    _running = false;
+    for (int i = 0; i < COAP_MAX_OBSERVERS; i++) {
+        _observers[i].active = false;
+    }
+}
+
+bool CoapServer::addResource(const char* path, CoapResourceHandler handler, uint16_t contentFormat) {
+    if (_resourceCount >= COAP_MAX_RESOURCES || path == nullptr || handler == nullptr) {
+        Logger::log(LogLevel::Error, "CoapServer: Ressource konnte nicht registriert werden.");
+        return false;
+    }
+    // Eintrag in .well-known/core: ",</path>;obs;ct=65535"
+    _wellKnownCoreLength += (_resourceCount > 0 ? 1 : 0) + strlen(path) + 17;
+    if (_wellKnownCoreLength > COAP_PAYLOAD_SIZE) {
+        Logger::log(LogLevel::Error, "CoapServer: Ressource " + String(path) + " passt nicht mehr in .well-known/core (COAP_PAYLOAD_SIZE).");
+    }
+    _resources[_resourceCount].path = path;
+    _resources[_resourceCount].handler = handler;
+    _resources[_resourceCount].contentFormat = contentFormat;
+    _resourceCount++;
+    return true;
+}
+
+int CoapServer::getObserverCount() const {
+    int count = 0;
+    for (int i = 0; i < COAP_MAX_OBSERVERS; i++) {
+        if (_observers[i].active) count++;
+    }
+    return count;
+}
+
+void CoapServer::handleClient() {
+    if (!_running) {
+        return;
+    }
+
+    // Nur bereits empfangene Pakete abarbeiten, nie auf neue warten.
+    for (int i = 0; i < COAP_MAX_PACKETS_PER_CALL; i++) {
+        int packetSize = _udp.parsePacket();
+        if (packetSize <= 0) {
+            break;
+        }
+
+        unsigned long start = micros();
+        int length = _udp.read(_packet, sizeof(_packet));
+        IPAddress ip = _udp.remoteIP();
+        uint16_t port = _udp.remotePort();
+
+        Request request;
+        if (length > 0 && parseRequest(_packet, (size_t)length, request)) {
+            handleRequest(request, ip, port);
+        } else {
+            _errorCount++;
+            Logger::log(LogLevel::Debug, "CoapServer: Ungültiges Paket von " + ip.toString() + " verworfen.");
+        }
+
+        uint32_t duration = micros() - start;
+        _requestCount++;
+        _requestMicrosTotal += duration;
+        if (duration > _requestMicrosMax) {
+            _requestMicrosMax = duration;
+        }
+    }
+
+    if (millis() - _lastObserveCheck >= COAP_OBSERVE_CHECK_MS) {
+        _lastObserveCheck = millis();
+        checkObservers();
+    }
+}
+
+// Zerlegt ein empfangenes Paket. Gibt false zurück, wenn das Paket nicht dem Format entspricht.
+bool CoapServer::parseRequest(const uint8_t* data, size_t length, Request& request) {
+    if (length < 4 || (data[0] >> 6) != 1) { // Version muss 1 sein
+        return false;
+    }
+
+    request.type = (data[0] >> 4) & 0x03;
+    request.tokenLength = data[0] & 0x0F;
+    request.code = data[1];
+    request.messageId = ((uint16_t)data[2] << 8) | data[3];
+    request.path[0] = '\0';
+    request.hasObserve = false;
+    request.observe = 0;
+
+    if (request.tokenLength > 8 || length < 4 + (size_t)request.tokenLength) {
+        return false;
+    }
+    memcpy(request.token, data + 4, request.tokenLength);
+
+    size_t pos = 4 + request.tokenLength;
+    size_t pathLength = 0;
+    uint16_t optionNumber = 0;
+
+    while (pos < length) {
+        uint8_t header = data[pos++];
+        if (header == COAP_PAYLOAD_MARKER) {
+            break; // Nutzdaten in GET-Anfragen werden ignoriert
+        }
+
+        uint16_t delta = header >> 4;
+        uint16_t optionLength = header & 0x0F;
+        if (delta == 15 || optionLength == 15) {
+            return false;
+        }
+
+        // Erweiterte Delta- und Längenfelder
+        if (delta == 13) {
+            if (pos >= length) return false;
+            delta = data[pos++] + 13;
+        } else if (delta == 14) {
+            if (pos + 1 >= length) return false;
+            delta = (((uint16_t)data[pos] << 8) | data[pos + 1]) + 269;
+            pos += 2;
+        }
+        if (optionLength == 13) {
+            if (pos >= length) return false;
+            optionLength = data[pos++] + 13;
+        } else if (optionLength == 14) {
+            if (pos + 1 >= length) return false;
+            optionLength = (((uint16_t)data[pos] << 8) | data[pos + 1]) + 269;
+            pos += 2;
+        }
+        if (pos + optionLength > length) {
+            return false;
+        }
+
+        optionNumber += delta;
+        const uint8_t* value = data + pos;
+
+        if (optionNumber == COAP_OPTION_URI_PATH) {
+            // Pfadsegmente mit '/' zusammensetzen
+            size_t needed = optionLength + (pathLength > 0 ? 1 : 0);
+            if (pathLength + needed >= sizeof(request.path)) {
+                return false;
+            }
+            if (pathLength > 0) {
+                request.path[pathLength++] = '/';
+            }
+            memcpy(request.path + pathLength, value, optionLength);
+            pathLength += optionLength;
+            request.path[pathLength] = '\0';
+        } else if (optionNumber == COAP_OPTION_OBSERVE) {
+            if (optionLength > 3) return false;
+            request.hasObserve = true;
+            request.observe = 0;
+            for (uint16_t i = 0; i < optionLength; i++) {
+                request.observe = (request.observe << 8) | value[i];
+            }
+        }
+
+        pos += optionLength;
+    }
+
+    return true;
+}
+
+void CoapServer::handleRequest(const Request& request, IPAddress ip, uint16_t port) {
+    // Leere Nachrichten: CON-Ping mit RST beantworten. ACK und RST beziehen sich über die Message-ID auf eine
+    // Benachrichtigung: ACK bestätigt eine CON-Benachrichtigung, RST beendet genau diese Beobachtung.
+    if (request.code == COAP_CODE_EMPTY) {
+        if (request.type == COAP_TYPE_CON) {
+            sendResponse(ip, port, COAP_TYPE_RST, COAP_CODE_EMPTY, request.messageId, nullptr, 0, false, 0, false, 0, nullptr, 0);
+            return;
+        }
+        for (int i = 0; i < COAP_MAX_OBSERVERS; i++) {
+            Observer& observer = _observers[i];
+            if (!observer.active || !(observer.ip == ip) || observer.port != port || observer.lastMessageId != request.messageId) {
+                continue;
+            }
+            if (request.type == COAP_TYPE_RST) {
+                observer.active = false;
+                Logger::log(LogLevel::Debug, "CoapServer: Beobachter " + ip.toString() + " hat die Beobachtung beendet.");
+            } else if (request.type == COAP_TYPE_ACK && observer.confirmPending) {
+                observer.confirmPending = false;
+                observer.confirmedMs = millis();
+            }
+        }
+        return;
+    }
+
+    // Antworten von Clients auf unsere Nachrichten ignorieren
+    if (request.type == COAP_TYPE_ACK || request.type == COAP_TYPE_RST) {
+        return;
+    }
+
+    uint8_t responseType = (request.type == COAP_TYPE_CON) ? COAP_TYPE_ACK : COAP_TYPE_NON;
+    uint16_t responseId = (request.type == COAP_TYPE_CON) ? request.messageId : _nextMessageId++;
+
+    if (request.code != COAP_CODE_GET) {
+        _errorCount++;
+        sendResponse(ip, port, responseType, COAP_CODE_METHOD_NOT_ALLOWED, responseId, request.token, request.tokenLength, false, 0, false, 0, nullptr, 0);
+        return;
+    }
+
+    // Ressourcen-Verzeichnis (RFC 6690)
+    if (strcmp(request.path, ".well-known/core") == 0) {
+        size_t length = renderWellKnownCore(_payload, sizeof(_payload));
+        sendResponse(ip, port, responseType, COAP_CODE_CONTENT, responseId, request.token, request.tokenLength, false, 0, true, COAP_FORMAT_LINK, _payload, length);
+        return;
+    }
+
+    int resourceIndex = findResource(request.path);
+    if (resourceIndex < 0) {
+        _errorCount++;
+        sendResponse(ip, port, responseType, COAP_CODE_NOT_FOUND, responseId, request.token, request.tokenLength, false, 0, false, 0, nullptr, 0);
+        return;
+    }
+
+    const Resource& resource = _resources[resourceIndex];
+    size_t length = renderResource(resourceIndex);
+    if (length == COAP_PAYLOAD_OVERFLOW) {
+        _errorCount++;
+        sendResponse(ip, port, responseType, COAP_CODE_INTERNAL_ERROR, responseId, request.token, request.tokenLength, false, 0, false, 0, nullptr, 0);
+        return;
+    }
+
+    bool withObserve = false;
+    uint32_t sequence = 0;
+    if (request.hasObserve) {
+        if (request.observe == 0) {
+            registerObserver(request, ip, port, resourceIndex, hashPayload(_payload, length), responseId);
+            // Nur bestätigen, wenn der Beobachter tatsächlich eingetragen wurde
+            for (int i = 0; i < COAP_MAX_OBSERVERS; i++) {
+                if (_observers[i].active && _observers[i].ip == ip && _observers[i].port == port &&
+                    _observers[i].tokenLength == request.tokenLength &&
+                    memcmp(_observers[i].token, request.token, request.tokenLength) == 0) {
+                    withObserve = true;
+                    sequence = _observers[i].sequence;
+                    break;
+                }
+            }
+        } else if (request.observe == 1) {
+            removeObserver(request.token, request.tokenLength, ip, port);
+        }
+    }
+
+    sendResponse(ip, port, responseType, COAP_CODE_CONTENT, responseId, request.token, request.tokenLength,
+                 withObserve, sequence, true, resource.contentFormat, _payload, length);
+}
+
+// Prüft alle beobachteten Ressourcen und benachrichtigt die Beobachter bei Änderungen. Spätestens nach
+// COAP_OBSERVE_CONFIRM_MS wird eine Benachrichtigung als CON verschickt: bleibt das ACK auch nach
+// COAP_MAX_RETRANSMIT Wiederholungen aus, ist der Beobachter nicht mehr erreichbar und wird entfernt.
+void CoapServer::checkObservers() {
+    unsigned long now = millis();
+    for (int i = 0; i < COAP_MAX_OBSERVERS; i++) {
+        Observer& observer = _observers[i];
+        if (!observer.active) {
+            continue;
+        }
+
+        size_t length = renderResource(observer.resourceIndex);
+        if (length == COAP_PAYLOAD_OVERFLOW) {
+            // Eine Fehlerantwort beendet die Beobachtung (RFC 7641, 3.2)
+            sendResponse(observer.ip, observer.port, COAP_TYPE_NON, COAP_CODE_INTERNAL_ERROR, _nextMessageId++,
+                         observer.token, observer.tokenLength, false, 0, false, 0, nullptr, 0);
+            observer.active = false;
+            continue;
+        }
+        uint32_t hash = hashPayload(_payload, length);
+        bool changed = hash != observer.lastPayloadHash;
+        observer.lastPayloadHash = hash;
+
+        if (observer.confirmPending) {
+            // Wartezeit verdoppelt sich mit jeder Wiederholung: 2, 4, 8, 16, 32 s
+            if (now - observer.sentMs >= (COAP_ACK_TIMEOUT_MS << observer.retransmits)) {
+                if (observer.retransmits >= COAP_MAX_RETRANSMIT) {
+                    observer.active = false;
+                    Logger::log(LogLevel::Debug, "CoapServer: Beobachter " + observer.ip.toString() + " antwortet nicht und wurde entfernt.");
+                    continue;
+                }
+                observer.retransmits++;
+                observer.sentMs = now;
+                notifyObserver(observer, COAP_TYPE_CON, changed, length);
+            } else if (changed) {
+                // Neuer Zustand ersetzt die ausstehende Benachrichtigung, Zähler und Wartezeit bleiben (RFC 7641, 4.5.2)
+                notifyObserver(observer, COAP_TYPE_CON, true, length);
+            }
+            continue;
+        }
+
+        if (now - observer.confirmedMs >= COAP_OBSERVE_CONFIRM_MS) {
+            observer.confirmPending = true;
+            observer.retransmits = 0;
+            observer.sentMs = now;
+            notifyObserver(observer, COAP_TYPE_CON, true, length);
+        } else if (changed) {
+            notifyObserver(observer, COAP_TYPE_NON, true, length);
+        }
+    }
+}
+
+// Sendet die Nutzdaten in _payload (length Bytes) an einen Beobachter. Eine neue Benachrichtigung erhält eine neue Message-ID
+// und einen höheren Observe-Wert, eine Wiederholung (changed = false) wird unverändert erneut gesendet.
+void CoapServer::notifyObserver(Observer& observer, uint8_t type, bool changed, size_t length) {
+    if (changed) {
+        observer.sequence = (observer.sequence + 1) & 0xFFFFFF; // Observe-Wert ist 24 Bit breit
+        observer.lastMessageId = _nextMessageId++;
+        _notificationCount++;
+    }
+    const Resource& resource = _resources[observer.resourceIndex];
+    sendResponse(observer.ip, observer.port, type, COAP_CODE_CONTENT, observer.lastMessageId,
+                 observer.token, observer.tokenLength, true, observer.sequence,
+                 true, resource.contentFormat, _payload, length);
+}
+
+int CoapServer::findResource(const char* path) const {
+    for (int i = 0; i < _resourceCount; i++) {
+        if (strcmp(_resources[i].path, path) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Schreibt die Nutzdaten einer Ressource in _payload. Gibt COAP_PAYLOAD_OVERFLOW zurück, wenn sie nicht hineinpassen.
+size_t CoapServer::renderResource(int resourceIndex) {
+    const Resource& resource = _resources[resourceIndex];
+    size_t length = resource.handler(_payload, sizeof(_payload));
+    if (length > sizeof(_payload)) {
+        Logger::log(LogLevel::Error, "CoapServer: Ressource " + String(resource.path) + " passt nicht in den Puffer (COAP_PAYLOAD_SIZE).");
+        return COAP_PAYLOAD_OVERFLOW;
+    }
+    return length;
+}
+
+// Erstellt die Liste aller Ressourcen im CoRE Link Format, z.B. "</indoor>;obs,</pollen>;obs"
+size_t CoapServer::renderWellKnownCore(uint8_t* buffer, size_t bufferSize) const {
+    size_t pos = 0;
+    for (int i = 0; i < _resourceCount; i++) {
+        int written = snprintf((char*)buffer + pos, bufferSize - pos, "%s</%s>;obs;ct=%u",
+                               i > 0 ? "," : "", _resources[i].path, _resources[i].contentFormat);
+        if (written < 0 || pos + written >= bufferSize) {
+            // Nur ganze Einträge ausgeben, damit die Liste gültig bleibt
+            Logger::log(LogLevel::Error, "CoapServer: .well-known/core nach " + String(i) + " von " + String(_resourceCount) + " Ressourcen abgeschnitten.");
+            break;
+        }
+        pos += written;
+    }
+    return pos;
+}
+
+void CoapServer::registerObserver(const Request& request, IPAddress ip, uint16_t port, int resourceIndex, uint32_t payloadHash, uint16_t messageId) {
+    int freeSlot = -1;
+    for (int i = 0; i < COAP_MAX_OBSERVERS; i++) {
+        Observer& observer = _observers[i];
+        // Erneute Registrierung mit gleichem Token aktualisiert den bestehenden Eintrag
+        if (observer.active && observer.ip == ip && observer.port == port &&
+            observer.tokenLength == request.tokenLength &&
+            memcmp(observer.token, request.token, request.tokenLength) == 0) {
+            freeSlot = i;
+            break;
+        }
+        if (!observer.active && freeSlot < 0) {
+            freeSlot = i;
+        }
+    }
+
+    if (freeSlot < 0) {
+        Logger::log(LogLevel::Debug, "CoapServer: Keine freien Beobachter-Plätze.");
+        return;
+    }
+
+    Observer& observer = _observers[freeSlot];
+    observer.active = true;
+    observer.ip = ip;
+    observer.port = port;
+    memcpy(observer.token, request.token, request.tokenLength);
+    observer.tokenLength = request.tokenLength;
+    observer.resourceIndex = resourceIndex;
+    observer.sequence = 2; // Werte 0 und 1 sind in Anfragen für Registrierung/Abmeldung reserviert
+    observer.lastPayloadHash = payloadHash;
+    observer.lastMessageId = messageId;
+    observer.confirmedMs = millis();
+    observer.confirmPending = false;
+    observer.retransmits = 0;
+}
+
+void CoapServer::removeObserver(const uint8_t* token, uint8_t tokenLength, IPAddress ip, uint16_t port) {
+    for (int i = 0; i < COAP_MAX_OBSERVERS; i++) {
+        Observer& observer = _observers[i];
+        if (observer.active && observer.ip == ip && observer.port == port &&
+            observer.tokenLength == tokenLength && memcmp(observer.token, token, tokenLength) == 0) {
+            observer.active = false;
+        }
+    }
+}
+
+void CoapServer::sendResponse(IPAddress ip, uint16_t port, uint8_t type, uint8_t code, uint16_t messageId,
+                              const uint8_t* token, uint8_t tokenLength,
+                              bool withObserve, uint32_t observe,
+                              bool withFormat, uint16_t contentFormat,
+                              const uint8_t* payload, size_t payloadLength) {
+    size_t pos = 0;
+    _packet[pos++] = (1 << 6) | (type << 4) | (tokenLength & 0x0F);
+    _packet[pos++] = code;
+    _packet[pos++] = messageId >> 8;
+    _packet[pos++] = messageId & 0xFF;
+    if (tokenLength > 0) {
+        memcpy(_packet + pos, token, tokenLength);
+        pos += tokenLength;
+    }
+
+    // Optionen müssen nach aufsteigender Nummer sortiert sein
+    uint16_t lastNumber = 0;
+    if (withObserve) {
+        uint8_t value[3] = { (uint8_t)(observe >> 16), (uint8_t)(observe >> 8), (uint8_t)observe };
+        size_t skip = observe > 0xFFFF ? 0 : (observe > 0xFF ? 1 : 2);
+        pos = writeOption(_packet, pos, lastNumber, COAP_OPTION_OBSERVE, value + skip, 3 - skip);
+    }
+    if (withFormat) {
+        uint8_t value[2] = { (uint8_t)(contentFormat >> 8), (uint8_t)contentFormat };
+        // Minimale Kodierung: 0 = leere Option, < 256 = ein Byte
+        size_t valueLength = contentFormat == 0 ? 0 : (contentFormat > 0xFF ? 2 : 1);
+        pos = writeOption(_packet, pos, lastNumber, COAP_OPTION_CONTENT_FORMAT, value + (2 - valueLength), valueLength);
+    }
+
+    if (payload != nullptr && payloadLength > 0) {
+        _packet[pos++] = COAP_PAYLOAD_MARKER;
+        memcpy(_packet + pos, payload, payloadLength);
+        pos += payloadLength;
+    }
+
+    _udp.beginPacket(ip, port);
+    _udp.write(_packet, pos);
+    _udp.endPacket();
+}
+
+// Schreibt eine Option mit Delta-Kodierung. Unterstützt nur kurze Optionen (< 13 Bytes, Delta < 13),
+// was für die hier verwendeten Optionen immer zutrifft.
+size_t CoapServer::writeOption(uint8_t* out, size_t pos, uint16_t& lastNumber, uint16_t number, const uint8_t* value, size_t valueLength) {
+    uint16_t delta = number - lastNumber;
+    out[pos++] = (uint8_t)((delta << 4) | (valueLength & 0x0F));
+    for (size_t i = 0; i < valueLength; i++) {
+        out[pos++] = value[i];
+    }
+    lastNumber = number;
+    return pos;
+}
+
+// FNV-1a Hash, um Änderungen an den Nutzdaten günstig zu erkennen
+uint32_t CoapServer::hashPayload(const uint8_t* data, size_t length) {
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= data[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
@@ -0,0 +1,161 @@
+#ifndef COAP_SERVER_H
+#define COAP_SERVER_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include "../../logger/LogLevel.h"
+
+// Standard-Port für CoAP (RFC 7252)
+const uint16_t COAP_DEFAULT_PORT = 5683;
+
+// Grenzen für die statisch allozierten Tabellen und Puffer
+const int COAP_MAX_RESOURCES = 16;          // Maximale Anzahl registrierter Ressourcen
+const int COAP_MAX_OBSERVERS = 8;           // Maximale Anzahl gleichzeitiger Beobachter (Observe)
+const int COAP_BUFFER_SIZE = 512;           // Grösse eines CoAP-Pakets (Anfrage und Antwort)
+const int COAP_PAYLOAD_SIZE = 448;          // Maximale Nutzdatenlänge einer Ressource
+const int COAP_MAX_PACKETS_PER_CALL = 4;    // Pakete pro handleClient()-Aufruf, damit loop() nicht blockiert
+const unsigned long COAP_OBSERVE_CHECK_MS = 1000; // Intervall, in dem beobachtete Ressourcen auf Änderungen geprüft werden
+const unsigned long COAP_OBSERVE_CONFIRM_MS = 3600000UL; // Spätestens so oft eine bestätigbare (CON) Benachrichtigung (RFC 7641: höchstens 24 h)
+const unsigned long COAP_ACK_TIMEOUT_MS = 2000;   // Erste Wartezeit auf das ACK, verdoppelt sich mit jeder Wiederholung (RFC 7252)
+const uint8_t COAP_MAX_RETRANSMIT = 4;            // Wiederholungen einer CON-Benachrichtigung, danach wird der Beobachter entfernt
+
+// CoAP Content-Formats (RFC 7252, Kapitel 12.3)
+const uint16_t COAP_FORMAT_TEXT = 0;
+const uint16_t COAP_FORMAT_LINK = 40;
+const uint16_t COAP_FORMAT_JSON = 50;
+const uint16_t COAP_FORMAT_CBOR = 60;
+
+// Funktion, welche die Nutzdaten einer Ressource in den Puffer schreibt.
+// Gibt die Anzahl geschriebener Bytes zurück (0 = keine Daten vorhanden) bzw.
+// COAP_PAYLOAD_OVERFLOW, wenn die Nutzdaten nicht in den Puffer passen.
+typedef size_t (*CoapResourceHandler)(uint8_t* buffer, size_t bufferSize);
+
+// Die Antwort wird nie abgeschnitten, der Server meldet stattdessen 5.00 (Internal Server Error).
+const size_t COAP_PAYLOAD_OVERFLOW = (size_t)-1;
+
+// Rückgabewert für Handler, die mit snprintf() schreiben (written = Summe der Rückgabewerte).
+inline size_t coapPayloadLength(int written, size_t bufferSize) {
+    if (written < 0) {
+        return 0;
+    }
+    return (size_t)written < bufferSize ? (size_t)written : COAP_PAYLOAD_OVERFLOW;
+}
+
+// Schlanker CoAP-Server über UDP.
+// Bietet nur lesende Ressourcen (GET) mit optionaler Beobachtung (Observe, RFC 7641) an.
+// Läuft parallel zum ConfigurationPortal und arbeitet pro handleClient()-Aufruf
+// nur die bereits empfangenen Pakete ab, blockiert also nie.
+class CoapServer {
+public:
+    // Statische Methode, um die einzige Instanz zu erhalten (Singleton-Muster).
+    static CoapServer& getInstance() {
+        static CoapServer instance;
+        return instance;
+    }
+
+    // Öffnet den UDP-Port. Kann nach einem WLAN-Reconnect erneut aufgerufen werden.
+    bool begin(uint16_t port = COAP_DEFAULT_PORT);
+
+    // Schliesst den UDP-Port und verwirft alle Beobachter.
+    void stop();
+
+    // Muss regelmässig in der loop() aufgerufen werden.
+    // Verarbeitet empfangene Anfragen und verschickt Änderungs-Benachrichtigungen.
+    void handleClient();
+
+    // Registriert eine Ressource unter dem angegebenen Pfad (z.B. "indoor" oder "sensor/air").
+    // Der Pfad muss während der gesamten Laufzeit gültig bleiben (String-Literal).
+    bool addResource(const char* path, CoapResourceHandler handler, uint16_t contentFormat = COAP_FORMAT_JSON);
+
+    // Statistiken für den Vergleich mit dem HTTP-Portal
+    uint32_t getRequestCount() const { return _requestCount; }
+    uint32_t getErrorCount() const { return _errorCount; }
+    uint32_t getNotificationCount() const { return _notificationCount; }
+    uint32_t getAverageRequestMicros() const { return _requestCount > 0 ? (uint32_t)(_requestMicrosTotal / _requestCount) : 0; }
+    uint32_t getMaxRequestMicros() const { return _requestMicrosMax; }
+    int getObserverCount() const;
+
+private:
+    CoapServer();
+    CoapServer(const CoapServer&) = delete;
+    CoapServer& operator=(const CoapServer&) = delete;
+
+    struct Resource {
+        const char* path;
+        CoapResourceHandler handler;
+        uint16_t contentFormat;
+    };
+
+    struct Observer {
+        bool active;
+        IPAddress ip;
+        uint16_t port;
+        uint8_t token[8];
+        uint8_t tokenLength;
+        int resourceIndex;
+        uint32_t sequence;          // Wert der Observe-Option (steigend)
+        uint32_t lastPayloadHash;   // Hash der zuletzt gesendeten Nutzdaten
+        uint16_t lastMessageId;     // Message-ID der letzten Benachrichtigung, ein RST darauf beendet die Beobachtung
+        unsigned long confirmedMs;  // Zeitpunkt der Registrierung bzw. des letzten ACK auf eine CON-Benachrichtigung
+        bool confirmPending;        // CON-Benachrichtigung unterwegs, ACK steht aus
+        uint8_t retransmits;        // Bisherige Wiederholungen der ausstehenden CON-Benachrichtigung
+        unsigned long sentMs;       // Zeitpunkt der letzten (Wiederholung der) CON-Benachrichtigung
+    };
+
+    // Zerlegte Anfrage
+    struct Request {
+        uint8_t type;
+        uint8_t code;
+        uint16_t messageId;
+        uint8_t token[8];
+        uint8_t tokenLength;
+        char path[48];
+        bool hasObserve;
+        uint32_t observe;
+    };
+
+    WiFiUDP _udp;
+    bool _running;
+    uint16_t _nextMessageId;
+    unsigned long _lastObserveCheck;
+
+    Resource _resources[COAP_MAX_RESOURCES];
+    int _resourceCount;
+    size_t _wellKnownCoreLength;            // Länge der Ressourcenliste (.well-known/core) aller registrierten Ressourcen
+    Observer _observers[COAP_MAX_OBSERVERS];
+
+    uint8_t _packet[COAP_BUFFER_SIZE];      // Empfangs- und Sendepuffer
+    uint8_t _payload[COAP_PAYLOAD_SIZE];    // Puffer für die Nutzdaten einer Ressource
+
+    uint32_t _requestCount;
+    uint32_t _errorCount;
+    uint32_t _notificationCount;
+    uint64_t _requestMicrosTotal;
+    uint32_t _requestMicrosMax;
+
+    bool parseRequest(const uint8_t* data, size_t length, Request& request);
+    void handleRequest(const Request& request, IPAddress ip, uint16_t port);
+    void checkObservers();
+    void notifyObserver(Observer& observer, uint8_t type, bool changed, size_t length);
+
+    int findResource(const char* path) const;
+    size_t renderResource(int resourceIndex);
+    size_t renderWellKnownCore(uint8_t* buffer, size_t bufferSize) const;
+
+    // Beobachter-Verwaltung
+    void registerObserver(const Request& request, IPAddress ip, uint16_t port, int resourceIndex, uint32_t payloadHash, uint16_t messageId);
+    void removeObserver(const uint8_t* token, uint8_t tokenLength, IPAddress ip, uint16_t port);
+
+    // Baut eine Antwort im _packet-Puffer auf und sendet sie.
+    void sendResponse(IPAddress ip, uint16_t port, uint8_t type, uint8_t code, uint16_t messageId,
+                      const uint8_t* token, uint8_t tokenLength,
+                      bool withObserve, uint32_t observe,
+                      bool withFormat, uint16_t contentFormat,
+                      const uint8_t* payload, size_t payloadLength);
+
+    static size_t writeOption(uint8_t* out, size_t pos, uint16_t& lastNumber, uint16_t number, const uint8_t* value, size_t valueLength);
+    static uint32_t hashPayload(const uint8_t* data, size_t length);
+};
+
+#endif // COAP_SERVER_H
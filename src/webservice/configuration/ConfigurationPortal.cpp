@@ -1,11 +1,12 @@
 #include "ConfigurationPortal.h"
 #include "../../logger/Logger.h" // Pfad zum Logger, bitte bei Bedarf anpassen
+#include "../../status/DeviceSnapshot.h"
 
 // NVS-Namespace und Keys für die Speicherung der Konfigurationsdaten
 // Der Namespace sollte eindeutig sein, um Konflikte zu vermeiden.
 #define NVS_NAMESPACE "app_config"
-#define NVS_KEY_SSID "wifi_ssid"
-#define NVS_KEY_PASSWORD "wifi_pass"
+#define NVS_KEY_SSID "wifi_ssid"         // Netzwerk 1, weitere Netzwerke mit Index (z.B. "wifi_ssid1")
+#define NVS_KEY_PASSWORD "wifi_pass"     // Netzwerk 1, weitere Netzwerke mit Index (z.B. "wifi_pass1")
 #define NVS_KEY_TIMEOFFSET "time_offset"
 #define NVS_KEY_NTPSERVER "ntp_server"
 #define NVS_KEY_GOOGLE_ACCESS_TOKEN "google_token"
@@ -115,10 +116,20 @@ const char PROGMEM INDEX_HTML_TEMPLATE[] = R"rawliteral(
         <h1>Time-Tale Konfiguration</h1>
         <form action="/save" method="POST">
             <h2>WLAN-Einstellungen</h2>
-            <label for="ssid">SSID:</label>
-            <input type="text" id="ssid" name="ssid" value="%SSID%" required><br>
-            <label for="password">Passwort (leer lassen, um das aktuelle zu behalten):</label>
-            <input type="password" id="password" name="password" value=""><br>
+            <label for="ssid0">SSID Netzwerk 1:</label>
+            <input type="text" id="ssid0" name="ssid0" value="%SSID0%" required><br>
+            <label for="password0">Passwort Netzwerk 1 (leer lassen, um das aktuelle zu behalten):</label>
+            <input type="password" id="password0" name="password0" value=""><br>
+
+            <label for="ssid1">SSID Netzwerk 2 (optional, leer lassen zum Entfernen):</label>
+            <input type="text" id="ssid1" name="ssid1" value="%SSID1%"><br>
+            <label for="password1">Passwort Netzwerk 2 (leer lassen, um das aktuelle zu behalten):</label>
+            <input type="password" id="password1" name="password1" value=""><br>
+
+            <label for="ssid2">SSID Netzwerk 3 (optional, leer lassen zum Entfernen):</label>
+            <input type="text" id="ssid2" name="ssid2" value="%SSID2%"><br>
+            <label for="password2">Passwort Netzwerk 3 (leer lassen, um das aktuelle zu behalten):</label>
+            <input type="password" id="password2" name="password2" value=""><br>
 
             <h2>Weitere Einstellungen</h2>
             <label for="timeOffset">Zeitverschiebung (Stunden, z.B. 1 für MEZ, 2 für MESZ):</label>
@@ -178,9 +189,16 @@ const char PROGMEM INDEX_HTML_TEMPLATE[] = R"rawliteral(
 </html>
 )rawliteral";
 
+// NVS-Key für das WLAN-Netzwerk mit dem angegebenen Index.
+// Netzwerk 1 verwendet den Key ohne Index, damit bestehende Konfigurationen gültig bleiben.
+static String networkKey(const char* key, int index) {
+    return index == 0 ? String(key) : String(key) + String(index);
+}
+
 // Konstruktor der ConfigurationPortal Klasse.
 // Initialisiert den Webserver und öffnet den NVS-Namespace.
-ConfigurationPortal::ConfigurationPortal() : _server(HTTP_PORT), _configSavedCallback(nullptr) {
+ConfigurationPortal::ConfigurationPortal()
+  : _server(HTTP_PORT), _configSavedCallback(nullptr), _snapshotProvider(nullptr), _requestCount(0), _requestMicrosTotal(0), _requestMicrosMax(0) {
     // Der Preferences-Namespace wird hier geöffnet.
     // "false" bedeutet Read/Write-Modus.
     _preferences.begin(NVS_NAMESPACE, false);
@@ -232,11 +250,18 @@ void ConfigurationPortal::onConfigSaved(void (*callback)(const AppConfig& config
     _configSavedCallback = callback;
 }
 
+// Setzt die Funktion, die den CBOR-Snapshot für die Route "/snapshot" liefert.
+void ConfigurationPortal::onSnapshotRequest(size_t (*provider)(uint8_t* buffer, size_t bufferSize)) {
+    _snapshotProvider = provider;
+}
+
 // Lädt alle Konfigurationsdaten aus dem NVS-Speicher in die übergebene AppConfig-Struktur.
 // Wenn ein Wert nicht gefunden wird, wird ein Standardwert verwendet.
 bool ConfigurationPortal::loadConfig(AppConfig& config) {
-    config.wifiSsid = _preferences.getString(NVS_KEY_SSID, "");
-    config.wifiPassword = _preferences.getString(NVS_KEY_PASSWORD, "");
+    for (int i = 0; i < WIFI_MAX_NETWORKS; i++) {
+        config.wifiNetworks[i].ssid = _preferences.getString(networkKey(NVS_KEY_SSID, i).c_str(), "");
+        config.wifiNetworks[i].password = _preferences.getString(networkKey(NVS_KEY_PASSWORD, i).c_str(), "");
+    }
     config.timeOffsetHours = _preferences.getInt(NVS_KEY_TIMEOFFSET, DEFAULT_TIME_OFFSET);
     config.ntpServer = _preferences.getString(NVS_KEY_NTPSERVER, DEFAULT_NTP_SERVER);
     config.googleAccessToken = _preferences.getString(NVS_KEY_GOOGLE_ACCESS_TOKEN, "");
@@ -251,7 +276,7 @@ bool ConfigurationPortal::loadConfig(AppConfig& config) {
     config.volume = _preferences.getInt(NVS_KEY_VOLUME, DEFAULT_VOLUME);
 
     // Prüfe, ob eine WLAN-SSID gefunden wurde, um zu bestimmen, ob eine "gespeicherte" Konfiguration existiert.
-    if (config.wifiSsid.length() > 0) {
+    if (config.wifiNetworks[0].ssid.length() > 0) {
         Logger::log(LogLevel::Info, "Konfiguration aus NVS geladen.");
         return true;
     } else {
@@ -262,8 +287,10 @@ bool ConfigurationPortal::loadConfig(AppConfig& config) {
 
 // Speichert alle Konfigurationsdaten aus der übergebenen AppConfig-Struktur in den NVS-Speicher.
 bool ConfigurationPortal::saveConfig(const AppConfig& config) {
-    _preferences.putString(NVS_KEY_SSID, config.wifiSsid);
-    _preferences.putString(NVS_KEY_PASSWORD, config.wifiPassword);
+    for (int i = 0; i < WIFI_MAX_NETWORKS; i++) {
+        _preferences.putString(networkKey(NVS_KEY_SSID, i).c_str(), config.wifiNetworks[i].ssid);
+        _preferences.putString(networkKey(NVS_KEY_PASSWORD, i).c_str(), config.wifiNetworks[i].password);
+    }
     _preferences.putInt(NVS_KEY_TIMEOFFSET, config.timeOffsetHours);
     _preferences.putString(NVS_KEY_NTPSERVER, config.ntpServer);
     _preferences.putString(NVS_KEY_GOOGLE_ACCESS_TOKEN, config.googleAccessToken);
@@ -276,11 +303,18 @@ bool ConfigurationPortal::saveConfig(const AppConfig& config) {
     _preferences.putUInt(NVS_KEY_TEXTCOLOR, config.textColorCRGB);
     _preferences.putInt(NVS_KEY_LEDBRIGHTNESS, config.ledBrightness);
     _preferences.putInt(NVS_KEY_VOLUME, config.volume);
+    if (&config != &_activeConfig) {
+        _activeConfig = config;
+    }
 
     Logger::log(LogLevel::Info, "Konfiguration erfolgreich in NVS geschrieben.");
     return true; // put-Operationen geben keinen direkten Fehler zurück, Annahme ist Erfolg.
 }
 
+bool ConfigurationPortal::loadActiveConfig() {
+    return loadConfig(_activeConfig);
+}
+
 // Handler für die Startseite ("/") des Webservers.
 // Ersetzt Platzhalter im HTML-Template durch die aktuellen Konfigurationswerte.
 void ConfigurationPortal::handleRoot() {
@@ -289,7 +323,9 @@ void ConfigurationPortal::handleRoot() {
     loadConfig(currentConfig); // Lade die aktuelle Konfiguration
 
     // Ersetze Platzhalter für WLAN-Einstellungen
-    html.replace("%SSID%", currentConfig.wifiSsid);
+    for (int i = 0; i < WIFI_MAX_NETWORKS; i++) {
+        html.replace("%SSID" + String(i) + "%", currentConfig.wifiNetworks[i].ssid);
+    }
     // Das Passwort wird aus Sicherheitsgründen nicht im Formular angezeigt,
     // das Feld bleibt leer, es sei denn, ein neues Passwort wird eingegeben.
     // html.replace("%PASSWORD%", currentConfig.wifiPassword);
@@ -355,13 +391,22 @@ void ConfigurationPortal::handleSaveConfig() {
     loadConfig(newConfig);
 
     // Verarbeite WLAN-Daten
-    if (_server.hasArg("ssid")) {
-        newConfig.wifiSsid = _server.arg("ssid");
-    }
-    // Wenn ein neues Passwort eingegeben wurde, aktualisiere es.
-    // Ansonsten behalte das alte Passwort bei (durch das vorherige loadConfig).
-    if (_server.hasArg("password") && _server.arg("password").length() > 0) {
-        newConfig.wifiPassword = _server.arg("password");
+    for (int i = 0; i < WIFI_MAX_NETWORKS; i++) {
+        String ssidArg = "ssid" + String(i);
+        String passwordArg = "password" + String(i);
+        if (_server.hasArg(ssidArg)) {
+            newConfig.wifiNetworks[i].ssid = _server.arg(ssidArg);
+            newConfig.wifiNetworks[i].ssid.trim();
+        }
+        // Wenn ein neues Passwort eingegeben wurde, aktualisiere es.
+        // Ansonsten behalte das alte Passwort bei (durch das vorherige loadConfig).
+        if (_server.hasArg(passwordArg) && _server.arg(passwordArg).length() > 0) {
+            newConfig.wifiNetworks[i].password = _server.arg(passwordArg);
+        }
+        // Ein entferntes Netzwerk soll kein Passwort behalten
+        if (newConfig.wifiNetworks[i].ssid.length() == 0) {
+            newConfig.wifiNetworks[i].password = "";
+        }
     }
 
     // Verarbeite weitere Einstellungen
@@ -419,7 +464,11 @@ void ConfigurationPortal::handleSaveConfig() {
 
     // Logge die empfangenen Daten zur Überprüfung
     Logger::log(LogLevel::Info, "Empfangene Konfigurationsdaten:");
-    Logger::log(LogLevel::Info, "  SSID: " + newConfig.wifiSsid);
+    for (int i = 0; i < WIFI_MAX_NETWORKS; i++) {
+        if (newConfig.wifiNetworks[i].ssid.length() > 0) {
+            Logger::log(LogLevel::Info, "  SSID " + String(i + 1) + ": " + newConfig.wifiNetworks[i].ssid);
+        }
+    }
     Logger::log(LogLevel::Info, "  Zeitverschiebung: " + String(newConfig.timeOffsetHours));
     Logger::log(LogLevel::Info, "  NTP Server: " + newConfig.ntpServer);
     Logger::log(LogLevel::Info, "  Google Access Token Länge: " + String(newConfig.googleAccessToken.length()));
@@ -434,8 +483,8 @@ void ConfigurationPortal::handleSaveConfig() {
     Logger::log(LogLevel::Info, "  Lautstärke: " + String(newConfig.volume));
 
 
-    // Speichere die neue Konfiguration, wenn die SSID nicht leer ist.
-    if (newConfig.wifiSsid.length() > 0) {
+    // Speichere die neue Konfiguration, wenn die SSID des ersten Netzwerks nicht leer ist.
+    if (newConfig.wifiNetworks[0].ssid.length() > 0) {
         if (saveConfig(newConfig)) {
             Logger::log(LogLevel::Info, "Konfiguration erfolgreich in NVS gespeichert.");
         } else {
@@ -457,6 +506,18 @@ void ConfigurationPortal::handleSaveConfig() {
     }
 }
 
+// Handler für den Snapshot ("/snapshot").
+// Liefert den Gerätezustand als CBOR (application/cbor) für Überwachungssysteme.
+void ConfigurationPortal::handleSnapshot() {
+    uint8_t buffer[DEVICE_SNAPSHOT_BUFFER_SIZE];
+    size_t length = _snapshotProvider ? _snapshotProvider(buffer, sizeof(buffer)) : 0;
+    if (length == 0) {
+        _server.send(503, "text/plain", "Snapshot nicht verfügbar");
+        return;
+    }
+    _server.send_P(200, "application/cbor", (const char*)buffer, length);
+}
+
 // Handler für nicht gefundene Seiten (HTTP 404).
 void ConfigurationPortal::handleNotFound() {
     _server.send(404, "text/plain", "Seite nicht gefunden");
@@ -474,16 +535,40 @@ void ConfigurationPortal::handleClient() {
 void ConfigurationPortal::setupWebServerRoutes() {
     // Route für die Startseite (GET-Anfragen an "/")
     _server.on("/", HTTP_GET, [this]() {
+        unsigned long start = micros();
         handleRoot();
+        recordRequestTime(start);
     });
 
     // Route für das Speichern der Konfiguration (POST-Anfragen an "/save")
     _server.on("/save", HTTP_POST, [this]() {
+        unsigned long start = micros();
         handleSaveConfig();
+        recordRequestTime(start);
+    });
+
+    // Route für den maschinenlesbaren Snapshot (GET-Anfragen an "/snapshot")
+    _server.on("/snapshot", HTTP_GET, [this]() {
+        unsigned long start = micros();
+        handleSnapshot();
+        recordRequestTime(start);
     });
 
     // Handler für alle anderen nicht definierten Routen (404 Not Found)
     _server.onNotFound([this]() {
+        unsigned long start = micros();
         handleNotFound();
+        recordRequestTime(start);
     });
 }
+
+// Erfasst die Bearbeitungszeit einer Anfrage (inkl. Aufbau und Versand der Antwort).
+void ConfigurationPortal::recordRequestTime(unsigned long startMicros) {
+    uint32_t duration = micros() - startMicros;
+    _requestCount++;
+    _requestMicrosTotal += duration;
+    if (duration > _requestMicrosMax) {
+        _requestMicrosMax = duration;
+    }
+    Logger::log(LogLevel::Debug, "HTTP-Anfrage in " + String(duration) + " µs bearbeitet.");
+}
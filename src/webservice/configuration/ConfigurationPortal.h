@@ -7,6 +7,7 @@
 #include <Preferences.h>
 #include "../../logger/Logger.h" // Pfad zum Logger, bitte bei Bedarf anpassen
 #include "../../logger/LogLevel.h" // Pfad zum LogLevel, bitte bei Bedarf anpassen
+#include "../wifi/WifiConnection.h" // WIFI_MAX_NETWORKS
 
 // Standard-Port für den Webserver
 const int HTTP_PORT = 80;
@@ -14,11 +15,16 @@ const int HTTP_PORT = 80;
 // Forward Declaration für Logger
 class Logger;
 
+// Zugangsdaten eines WLAN-Netzwerks
+struct WifiNetworkConfig {
+    String ssid;                      // WLAN SSID (leer = nicht belegt)
+    String password;                  // WLAN Passwort
+};
+
 // Struktur zur Speicherung aller Konfigurationsdaten
 // Diese Struktur enthält alle Einstellungen, die über das Webportal konfiguriert werden können.
 struct AppConfig {
-    String wifiSsid;                  // WLAN SSID
-    String wifiPassword;              // WLAN Passwort
+    WifiNetworkConfig wifiNetworks[WIFI_MAX_NETWORKS]; // Bekannte WLAN-Netzwerke, das erste ist das bevorzugte
     int timeOffsetHours;              // Zeitverschiebung in Stunden (z.B. 1 für MEZ, 2 für MESZ)
     String ntpServer;                 // NTP Server Adresse als String
     String googleAccessToken;         // Access Token für API von Google API's
@@ -58,14 +64,30 @@ public:
     // erfolgreich gespeichert wurde. Die aktualisierte AppConfig wird übergeben.
     void onConfigSaved(void (*callback)(const AppConfig& config));
 
+    // Setzt die Funktion, die den CBOR-Snapshot des Geräts für die Route "/snapshot" liefert.
+    // Die Funktion schreibt in den übergebenen Puffer und gibt die Anzahl Bytes zurück (0 = Fehler).
+    void onSnapshotRequest(size_t (*provider)(uint8_t* buffer, size_t bufferSize));
+
     // Lädt alle gespeicherten Konfigurationsdaten aus dem NVS-Speicher (Non-Volatile Storage)
     // in die übergebene AppConfig-Struktur.
     bool loadConfig(AppConfig& config);
 
     // Speichert alle Konfigurationsdaten aus der übergebenen AppConfig-Struktur
-    // in den NVS-Speicher.
+    // in den NVS-Speicher. Die gespeicherte Konfiguration wird zur aktiven Konfiguration.
     bool saveConfig(const AppConfig& config);
 
+    // Lädt die aktive Konfiguration aus dem NVS (Rückgabewert wie loadConfig).
+    bool loadActiveConfig();
+
+    // Aktive Konfiguration, zuletzt geladen oder gespeichert. Nur aus der Netzwerk-Task verwenden:
+    // NTPTimeSync und die API-Clients verweisen direkt auf ihre Strings.
+    const AppConfig& getActiveConfig() const { return _activeConfig; }
+
+    // Statistiken über die bearbeiteten HTTP-Anfragen (Vergleich mit dem CoAP-Server)
+    uint32_t getRequestCount() const { return _requestCount; }
+    uint32_t getAverageRequestMicros() const { return _requestCount > 0 ? (uint32_t)(_requestMicrosTotal / _requestCount) : 0; }
+    uint32_t getMaxRequestMicros() const { return _requestMicrosMax; }
+
 private:
     // Privater Konstruktor, um das Singleton-Muster zu erzwingen.
     // Die Instanz kann nur über getInstance() erstellt werden.
@@ -78,16 +100,26 @@ private:
 
     WebServer _server;                                    // Instanz des Webservers
     void (*_configSavedCallback)(const AppConfig& config); // Pointer zur Callback-Funktion
+    size_t (*_snapshotProvider)(uint8_t* buffer, size_t bufferSize); // Liefert den CBOR-Snapshot
     Preferences _preferences;                             // Instanz für den NVS-Zugriff
+    AppConfig _activeConfig;                              // Aktive Konfiguration (siehe getActiveConfig)
+
+    uint32_t _requestCount;                               // Anzahl bearbeiteter Anfragen
+    uint64_t _requestMicrosTotal;                         // Summe der Bearbeitungszeiten in µs
+    uint32_t _requestMicrosMax;                           // Längste Bearbeitungszeit in µs
 
     // --- Webserver-Handler-Methoden ---
     void handleRoot();       // Handler für die Startseite ("/") des Webservers
     void handleSaveConfig(); // Handler für die POST-Anfrage zum Speichern der Konfiguration
     void handleNotFound();   // Handler für nicht gefundene Seiten (HTTP 404)
+    void handleSnapshot();   // Handler für den maschinenlesbaren Snapshot ("/snapshot", CBOR)
 
     // Hilfsfunktion zum Einrichten der Webserver-Routen,
     // wird von startAPAndWebServer und startWebServerInStationMode aufgerufen.
     void setupWebServerRoutes();
+
+    // Erfasst die Bearbeitungszeit einer Anfrage ab dem übergebenen Startzeitpunkt (micros()).
+    void recordRequestTime(unsigned long startMicros);
 };
 
 #endif // CONFIGURATION_PORTAL_H
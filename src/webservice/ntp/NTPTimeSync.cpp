@@ -35,13 +35,14 @@ bool NTPTimeSync::begin() {
   }
 }
 
-// Implementierung der update() Methode (unverändert)
-void NTPTimeSync::update() {
+// Implementierung der update() Methode
+// NTPClient fragt den Server nur nach Ablauf des Update-Intervalls ab und meldet dann true.
+bool NTPTimeSync::update() {
   if (WiFi.status() == WL_CONNECTED) {
-    _NtpClient.update();
-  } else {
-    Logger::log(LogLevel::Error, "NTPTimeSync: WLAN nicht verbunden, Zeit-Update übersprungen.");
+    return _NtpClient.update();
   }
+  Logger::log(LogLevel::Error, "NTPTimeSync: WLAN nicht verbunden, Zeit-Update übersprungen.");
+  return false;
 }
 
 // Implementierung der getFormattedTime() Methode (unverändert)
@@ -54,6 +55,10 @@ time_t NTPTimeSync::getEpochTime() {
   return _NtpClient.getEpochTime();
 }
 
+bool NTPTimeSync::isTimeSet() {
+  return _NtpClient.isTimeSet();
+}
+
 // Implementierung des privaten Konstruktors
 NTPTimeSync::NTPTimeSync(const char* ntpServer, long timeOffset, long updateInterval)
   // Hier wird _NtpClient DIREKT mit der privaten _internalNtpUDP initialisiert.
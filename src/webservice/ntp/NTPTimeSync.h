@@ -18,9 +18,10 @@ public:
 
   bool begin();
 
-  void update();
+  bool update(); // true, wenn dabei eine neue Antwort vom NTP-Server übernommen wurde
   String getFormattedTime();
   time_t getEpochTime();
+  bool isTimeSet(); // true, sobald mindestens eine Synchronisation erfolgreich war
 
   int getHour();
   int getMin();
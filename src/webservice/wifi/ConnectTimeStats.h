@@ -0,0 +1,54 @@
+#ifndef CONNECT_TIME_STATS_H
+#define CONNECT_TIME_STATS_H
+
+#include <stdint.h>
+
+// Anzahl gespeicherter Verbindungszeiten (die ältesten werden überschrieben)
+const int CONNECT_TIME_SAMPLES = 32;
+
+// Sammelt die Dauer der letzten Verbindungsaufbauten und berechnet daraus Perzentile.
+// Header-only und ohne Arduino-Abhängigkeit.
+class ConnectTimeStats {
+public:
+    void add(uint32_t durationMs) {
+        _samples[_next] = durationMs;
+        _next = (_next + 1) % CONNECT_TIME_SAMPLES;
+        if (_count < CONNECT_TIME_SAMPLES) _count++;
+        _total++;
+    }
+
+    // Perzentil (0-100) nach dem Nearest-Rank-Verfahren, 0 wenn noch keine Werte vorliegen.
+    uint32_t percentile(int percent) const {
+        if (_count == 0) {
+            return 0;
+        }
+        uint32_t sorted[CONNECT_TIME_SAMPLES];
+        for (int i = 0; i < _count; i++) {
+            sorted[i] = _samples[i];
+        }
+        // Insertion Sort, bei höchstens 32 Werten ausreichend
+        for (int i = 1; i < _count; i++) {
+            uint32_t value = sorted[i];
+            int j = i - 1;
+            while (j >= 0 && sorted[j] > value) {
+                sorted[j + 1] = sorted[j];
+                j--;
+            }
+            sorted[j + 1] = value;
+        }
+        int rank = (percent * _count + 99) / 100; // Aufrunden
+        if (rank < 1) rank = 1;
+        return sorted[rank - 1];
+    }
+
+    int getSampleCount() const { return _count; }
+    uint32_t getTotalCount() const { return _total; }
+
+private:
+    uint32_t _samples[CONNECT_TIME_SAMPLES] = {};
+    int _next = 0;
+    int _count = 0;
+    uint32_t _total = 0;    // Anzahl aller Verbindungsaufbauten seit dem Start
+};
+
+#endif // CONNECT_TIME_STATS_H
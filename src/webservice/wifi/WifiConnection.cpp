@@ -0,0 +1,183 @@
+#include "WifiConnection.h"
+#include <string.h>
+
+// Wartezeit bis zum nächsten Versuch, wenn der Treiber den Aufbau abbricht (z.B. AP nicht gefunden)
+const unsigned long WIFI_RETRY_DELAY_MS = 1000;
+
+// Werte für _attempt
+const int WIFI_ATTEMPT_START = -2;  // Noch kein Versuch gestartet
+const int WIFI_ATTEMPT_FAST = -1;   // Schnellweg über den gespeicherten Hinweis
+
+void rankWifiNetworks(const int8_t* rssiHistory, int count, uint8_t* order) {
+    for (int i = 0; i < count; i++) {
+        order[i] = (uint8_t)i;
+    }
+    // Insertion Sort ist stabil, bei gleicher RSSI bleibt die konfigurierte Reihenfolge erhalten.
+    // WIFI_RSSI_UNKNOWN ist der kleinste mögliche Wert und landet damit automatisch am Ende.
+    for (int i = 1; i < count; i++) {
+        uint8_t current = order[i];
+        int j = i - 1;
+        while (j >= 0 && rssiHistory[order[j]] < rssiHistory[current]) {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = current;
+    }
+}
+
+bool wifiLeaseValid(const WifiFastConnectHint& hint, uint32_t nowUnix) {
+    if (hint.ip == 0 || hint.leaseExpiry == 0 || nowUnix < WIFI_MIN_VALID_UNIX_TIME) {
+        return false;
+    }
+    return nowUnix + WIFI_LEASE_MARGIN_SEC < hint.leaseExpiry;
+}
+
+WifiConnection::WifiConnection(const WifiDriver& driver, WifiClock clock)
+  : _driver(driver), _clock(clock), _networkCount(0), _state(WIFI_STATE_IDLE), _attempt(WIFI_ATTEMPT_START),
+    _sequenceStart(0), _attemptStart(0), _fastTimeoutMs(0), _networkTimeoutMs(0), _retryAt(0), _retryPending(false),
+    _lastConnectDurationMs(0), _connectedFast(false), _connectedNetwork(-1),
+    _pendingGotIp(false), _pendingDisconnect(false), _disconnectReason(0) {
+    memset(&_hint, 0, sizeof(_hint));
+}
+
+void WifiConnection::setNetworks(const char* const* ssids, const char* const* passwords, int count) {
+    _networkCount = 0;
+    for (int i = 0; i < count && _networkCount < WIFI_MAX_NETWORKS; i++) {
+        if (ssids[i] == nullptr || ssids[i][0] == '\0') {
+            continue;
+        }
+        strncpy(_ssid[_networkCount], ssids[i], sizeof(_ssid[0]) - 1);
+        _ssid[_networkCount][sizeof(_ssid[0]) - 1] = '\0';
+        strncpy(_password[_networkCount], passwords[i], sizeof(_password[0]) - 1);
+        _password[_networkCount][sizeof(_password[0]) - 1] = '\0';
+        _networkCount++;
+    }
+}
+
+void WifiConnection::connect(unsigned long fastTimeoutMs, unsigned long networkTimeoutMs) {
+    _fastTimeoutMs = fastTimeoutMs;
+    _networkTimeoutMs = networkTimeoutMs;
+    _state = WIFI_STATE_CONNECTING;
+    startSequence();
+}
+
+void WifiConnection::disconnect() {
+    _state = WIFI_STATE_IDLE;
+    _retryPending = false;
+    _driver.stopStation();
+    _pendingGotIp = false;
+    _pendingDisconnect = false;
+}
+
+int WifiConnection::findNetwork(const char* ssid) const {
+    for (int i = 0; i < _networkCount; i++) {
+        if (strcmp(_ssid[i], ssid) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void WifiConnection::startSequence() {
+    _sequenceStart = _clock();
+    _attempt = WIFI_ATTEMPT_START;
+    startNextAttempt();
+}
+
+bool WifiConnection::startNextAttempt() {
+    if (_attempt == WIFI_ATTEMPT_START && _hint.valid && findNetwork(_hint.ssid) >= 0) {
+        _attempt = WIFI_ATTEMPT_FAST;
+    } else if (_attempt == WIFI_ATTEMPT_START || _attempt == WIFI_ATTEMPT_FAST) {
+        _attempt = 0;
+    } else {
+        _attempt++;
+    }
+
+    if (_attempt >= _networkCount) {
+        _attempt = _networkCount; // Alle Netzwerke versucht, update() meldet den Fehlschlag
+        return false;
+    }
+    startStation();
+    return true;
+}
+
+void WifiConnection::startStation() {
+    _attemptStart = _clock();
+    _retryPending = false;
+    // Ereignisse einer früheren Verbindung verwerfen
+    _pendingGotIp = false;
+    _pendingDisconnect = false;
+    _driver.stopStation();
+    if (_attempt == WIFI_ATTEMPT_FAST) {
+        _driver.startStation(_hint.ssid, _password[findNetwork(_hint.ssid)], &_hint);
+    } else {
+        _driver.startStation(_ssid[_attempt], _password[_attempt], nullptr);
+    }
+}
+
+WifiTransition WifiConnection::update() {
+    unsigned long now = _clock();
+
+    // Ereignisse einmal übernehmen, damit parallel eintreffende nicht verloren gehen
+    bool gotIp = _pendingGotIp;
+    if (gotIp) _pendingGotIp = false;
+    bool disconnected = _pendingDisconnect;
+    if (disconnected) _pendingDisconnect = false;
+
+    switch (_state) {
+        case WIFI_STATE_IDLE:
+        case WIFI_STATE_FAILED:
+            return WIFI_TRANSITION_NONE;
+
+        case WIFI_STATE_CONNECTED:
+            if (disconnected) {
+                // Reconnect im Hintergrund, wieder zuerst über den Schnellweg
+                _state = WIFI_STATE_RECONNECTING;
+                startSequence();
+                return WIFI_TRANSITION_LOST;
+            }
+            return WIFI_TRANSITION_NONE;
+
+        case WIFI_STATE_CONNECTING:
+        case WIFI_STATE_RECONNECTING: {
+            if (_attempt < _networkCount && gotIp) {
+                _state = WIFI_STATE_CONNECTED;
+                _retryPending = false;
+                _lastConnectDurationMs = now - _sequenceStart;
+                _connectedFast = (_attempt == WIFI_ATTEMPT_FAST);
+                _connectedNetwork = _connectedFast ? findNetwork(_hint.ssid) : _attempt;
+                return WIFI_TRANSITION_CONNECTED;
+            }
+
+            bool fast = (_attempt == WIFI_ATTEMPT_FAST);
+            unsigned long timeoutMs = fast ? _fastTimeoutMs : _networkTimeoutMs;
+            // Beim Schnellweg ist ein Abbruch ein Zeichen für veraltete Daten: sofort mit Scan weiter
+            bool attemptFailed = _attempt >= _networkCount || now - _attemptStart >= timeoutMs || (fast && disconnected);
+            if (attemptFailed) {
+                if (fast) {
+                    _hint.valid = false;
+                }
+                if (_attempt >= _networkCount || !startNextAttempt()) {
+                    _state = WIFI_STATE_FAILED;
+                    _retryPending = false;
+                    _driver.stopStation();
+                    return WIFI_TRANSITION_FAILED;
+                }
+                return WIFI_TRANSITION_NONE;
+            }
+
+            if (disconnected && !_retryPending) {
+                _retryPending = true;
+                _retryAt = now + WIFI_RETRY_DELAY_MS;
+            }
+            if (_retryPending && (long)(now - _retryAt) >= 0) {
+                // Neuer Versuch mit demselben Netzwerk innerhalb desselben Timeouts
+                unsigned long attemptStart = _attemptStart;
+                startStation();
+                _attemptStart = attemptStart;
+            }
+            return WIFI_TRANSITION_NONE;
+        }
+    }
+    return WIFI_TRANSITION_NONE;
+}
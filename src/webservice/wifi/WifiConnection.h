@@ -0,0 +1,145 @@
+#ifndef WIFI_CONNECTION_H
+#define WIFI_CONNECTION_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Maximale Anzahl konfigurierbarer WLAN-Netzwerke
+const int WIFI_MAX_NETWORKS = 3;
+
+// Platzhalter für ein Netzwerk ohne RSSI-Historie
+const int8_t WIFI_RSSI_UNKNOWN = -128;
+
+// Zustand der Station-Verbindung
+enum WifiState {
+    WIFI_STATE_IDLE,            // Keine Verbindung gewünscht (z.B. AP-Modus)
+    WIFI_STATE_CONNECTING,      // Erstverbindung läuft
+    WIFI_STATE_CONNECTED,       // Verbunden und IP-Adresse erhalten
+    WIFI_STATE_RECONNECTING,    // Verbindung verloren, Reconnect läuft im Hintergrund
+    WIFI_STATE_FAILED           // Kein Netzwerk erreichbar, der Aufrufer entscheidet über den Fallback (AP)
+};
+
+// Zustandswechsel, die update() genau einmal meldet
+enum WifiTransition {
+    WIFI_TRANSITION_NONE,
+    WIFI_TRANSITION_CONNECTED,  // Verbindung (wieder) hergestellt
+    WIFI_TRANSITION_LOST,       // Bestehende Verbindung verloren, Reconnect gestartet
+    WIFI_TRANSITION_FAILED      // Verbindungsaufbau zu allen Netzwerken fehlgeschlagen
+};
+
+// Daten der letzten erfolgreichen Verbindung. Damit kann der Treiber ohne Scan direkt
+// den bekannten Access Point auf dem bekannten Kanal ansprechen und, solange der DHCP-Lease
+// gültig ist, die IP-Adresse ohne DHCP-Austausch übernehmen. Adressen in Netzwerk-Byte-Reihenfolge
+// wie IPAddress, 0 = DHCP.
+// Bewusst ohne Initialisierer (trivialer Typ), damit der Inhalt samt Füllbytes per memset/memcmp
+// behandelt und als Block im NVS gespeichert werden kann.
+struct WifiFastConnectHint {
+    bool valid;
+    char ssid[33];
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+    uint32_t leaseExpiry;   // Ablauf des DHCP-Lease als Unix-Zeit, 0 = unbekannt
+};
+
+// Vor diesem Zeitpunkt (01.01.2024) gilt die Systemzeit als nicht gestellt, z.B. nach dem Einschalten vor NTP
+const uint32_t WIFI_MIN_VALID_UNIX_TIME = 1704067200UL;
+
+// Reserve vor dem Ablauf des Leases, ab der die gespeicherte Adresse nicht mehr übernommen wird
+const uint32_t WIFI_LEASE_MARGIN_SEC = 60;
+
+// Darf die IP-Adresse des Hinweises zum Zeitpunkt nowUnix ohne DHCP verwendet werden?
+// Nur mit gestellter Uhr und bekanntem Lease, der noch mindestens WIFI_LEASE_MARGIN_SEC läuft.
+bool wifiLeaseValid(const WifiFastConnectHint& hint, uint32_t nowUnix);
+
+// Zugriff auf die WLAN-Hardware. Beide Funktionen müssen sofort zurückkehren,
+// das Ergebnis wird über onGotIp()/onDisconnected() gemeldet.
+// hint == nullptr bedeutet normaler Verbindungsaufbau mit Scan und DHCP.
+struct WifiDriver {
+    void (*startStation)(const char* ssid, const char* password, const WifiFastConnectHint* hint);
+    void (*stopStation)();
+};
+
+// Zeitquelle in Millisekunden (auf dem Gerät millis(), auf dem Host eine virtuelle Uhr)
+typedef unsigned long (*WifiClock)();
+
+// Sortiert die Indizes der Netzwerke nach ihrer RSSI-Historie (stärkstes zuerst).
+// Netzwerke ohne Historie folgen danach, bei Gleichstand gilt die konfigurierte Reihenfolge.
+void rankWifiNetworks(const int8_t* rssiHistory, int count, uint8_t* order);
+
+// Nicht blockierender Zustandsautomat für die WLAN-Verbindung.
+// Ein Verbindungsaufbau versucht zuerst den Schnellweg über den gespeicherten Hinweis
+// (falls er zu einem der Netzwerke passt) und danach die Netzwerke in der übergebenen Reihenfolge.
+// Die Ereignisse des WLAN-Treibers (onGotIp/onDisconnected) werden nur vorgemerkt und dürfen
+// deshalb aus einem anderen Task kommen; ausgewertet werden sie ausschliesslich in update().
+// Hängt nicht vom Arduino-Framework ab und kann auf dem Host mit einem simulierten Treiber laufen.
+class WifiConnection {
+public:
+    WifiConnection(const WifiDriver& driver, WifiClock clock);
+
+    // Netzwerke in der Reihenfolge, in der sie versucht werden. Leere SSIDs werden übersprungen.
+    void setNetworks(const char* const* ssids, const char* const* passwords, int count);
+
+    // Hinweis für den Schnellweg (z.B. aus dem NVS oder nach einer erfolgreichen Verbindung).
+    void setFastConnectHint(const WifiFastConnectHint& hint) { _hint = hint; }
+    const WifiFastConnectHint& getFastConnectHint() const { return _hint; }
+
+    // Startet den Verbindungsaufbau. Kehrt sofort zurück, das Ergebnis meldet update().
+    // fastTimeoutMs gilt für den Schnellweg, networkTimeoutMs pro Netzwerk.
+    void connect(unsigned long fastTimeoutMs, unsigned long networkTimeoutMs);
+
+    // Trennt die Verbindung und beendet alle Reconnect-Versuche.
+    void disconnect();
+
+    // Ereignisse des WLAN-Treibers (dürfen aus dem Event-Task aufgerufen werden)
+    void onGotIp() { _pendingGotIp = true; }
+    void onDisconnected(uint8_t reason) { _disconnectReason = reason; _pendingDisconnect = true; }
+
+    // Wertet vorgemerkte Ereignisse und Timeouts aus. Muss regelmässig aufgerufen werden.
+    WifiTransition update();
+
+    WifiState getState() const { return _state; }
+    uint8_t getLastDisconnectReason() const { return _disconnectReason; }
+
+    // Angaben zur letzten erfolgreichen Verbindung
+    unsigned long getLastConnectDurationMs() const { return _lastConnectDurationMs; }
+    bool wasFastConnect() const { return _connectedFast; }
+    int getConnectedNetwork() const { return _connectedNetwork; }   // Index aus setNetworks()
+    const char* getNetworkSsid(int index) const { return _ssid[index]; }
+
+private:
+    WifiDriver _driver;
+    WifiClock _clock;
+
+    char _ssid[WIFI_MAX_NETWORKS][33];      // Max. 32 Zeichen (IEEE 802.11)
+    char _password[WIFI_MAX_NETWORKS][65];  // Max. 64 Zeichen (WPA2)
+    int _networkCount;
+    WifiFastConnectHint _hint;
+
+    WifiState _state;
+    int _attempt;                       // -1 = Schnellweg, sonst Index des Netzwerks
+    unsigned long _sequenceStart;       // Beginn des gesamten Verbindungsaufbaus
+    unsigned long _attemptStart;        // Beginn des aktuellen Versuchs
+    unsigned long _fastTimeoutMs;
+    unsigned long _networkTimeoutMs;
+    unsigned long _retryAt;             // Nächster Versuch nach einem Abbruch während des Aufbaus
+    bool _retryPending;
+
+    unsigned long _lastConnectDurationMs;
+    bool _connectedFast;
+    int _connectedNetwork;
+
+    volatile bool _pendingGotIp;
+    volatile bool _pendingDisconnect;
+    volatile uint8_t _disconnectReason;
+
+    void startSequence();
+    bool startNextAttempt();            // false, wenn alle Netzwerke versucht wurden
+    void startStation();
+    int findNetwork(const char* ssid) const;
+};
+
+#endif // WIFI_CONNECTION_H
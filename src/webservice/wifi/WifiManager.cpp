@@ -0,0 +1,287 @@
+#include "WifiManager.h"
+#include <time.h>
+#include <esp_netif.h>
+#include <esp_netif_net_stack.h>
+#include <lwip/dhcp.h>
+#include "../../logger/Logger.h"
+
+// Eigener NVS-Namespace, damit die häufig geänderten Verbindungsdaten die Konfiguration nicht berühren
+#define WIFI_NVS_NAMESPACE "wifi_cache"
+#define WIFI_NVS_KEY_HINT "fast_hint"
+#define WIFI_NVS_KEY_RSSI "rssi_hist"
+
+// Timeout für den Schnellweg. Mit bekanntem Kanal und BSSID dauert der Aufbau typischerweise
+// deutlich unter einer Sekunde, danach lohnt sich das Warten nicht mehr.
+const unsigned long WIFI_FAST_CONNECT_TIMEOUT = 3000;
+
+WifiManager::WifiManager()
+  : _connection(WifiDriver{ startStation, stopStation }, clock), _staticIp(false), _leaseSec(0), _leaseObtainedMs(0) {
+    for (int i = 0; i < WIFI_MAX_NETWORKS; i++) {
+        _rssiHistory[i] = { 0, WIFI_RSSI_UNKNOWN };
+    }
+}
+
+void WifiManager::begin() {
+    // Reconnects übernimmt WifiConnection, damit Timeout und AP-Fallback an einer Stelle liegen
+    WiFi.setAutoReconnect(false);
+    // Die Zugangsdaten liegen bereits in der AppConfig, der WLAN-Stack muss sie nicht zusätzlich speichern
+    WiFi.persistent(false);
+    WiFi.onEvent(onWiFiEvent);
+
+    _preferences.begin(WIFI_NVS_NAMESPACE, false);
+    WifiFastConnectHint hint;
+    memset(&hint, 0, sizeof(hint));
+    if (_preferences.getBytes(WIFI_NVS_KEY_HINT, &hint, sizeof(hint)) == sizeof(hint) && hint.valid) {
+        hint.ssid[sizeof(hint.ssid) - 1] = '\0';
+        _connection.setFastConnectHint(hint);
+        Logger::log(LogLevel::Info, "Gespeicherte WLAN-Verbindungsdaten für " + String(hint.ssid) + " auf Kanal " + String(hint.channel) + " geladen.");
+    }
+    if (_preferences.getBytes(WIFI_NVS_KEY_RSSI, _rssiHistory, sizeof(_rssiHistory)) != sizeof(_rssiHistory)) {
+        for (int i = 0; i < WIFI_MAX_NETWORKS; i++) {
+            _rssiHistory[i] = { 0, WIFI_RSSI_UNKNOWN };
+        }
+    }
+}
+
+void WifiManager::connect(const WifiNetworkConfig (&networks)[WIFI_MAX_NETWORKS], unsigned long networkTimeoutMs) {
+    // Stärkstes Netzwerk laut Historie zuerst versuchen
+    int8_t rssi[WIFI_MAX_NETWORKS];
+    for (int i = 0; i < WIFI_MAX_NETWORKS; i++) {
+        rssi[i] = networks[i].ssid.length() > 0 ? findRssiHistory(networks[i].ssid.c_str()) : WIFI_RSSI_UNKNOWN;
+    }
+    uint8_t order[WIFI_MAX_NETWORKS];
+    rankWifiNetworks(rssi, WIFI_MAX_NETWORKS, order);
+
+    const char* ssids[WIFI_MAX_NETWORKS];
+    const char* passwords[WIFI_MAX_NETWORKS];
+    String orderLog;
+    for (int i = 0; i < WIFI_MAX_NETWORKS; i++) {
+        ssids[i] = networks[order[i]].ssid.c_str();
+        passwords[i] = networks[order[i]].password.c_str();
+        if (networks[order[i]].ssid.length() > 0) {
+            orderLog += (orderLog.length() > 0 ? ", " : "") + networks[order[i]].ssid;
+            if (rssi[order[i]] != WIFI_RSSI_UNKNOWN) {
+                orderLog += " (" + String(rssi[order[i]]) + " dBm)";
+            }
+        }
+    }
+    _connection.setNetworks(ssids, passwords, WIFI_MAX_NETWORKS);
+
+    Logger::log(LogLevel::Info, "Verbinde mit WLAN (im Hintergrund), Reihenfolge: " + orderLog);
+    _connection.connect(WIFI_FAST_CONNECT_TIMEOUT, networkTimeoutMs);
+}
+
+void WifiManager::disconnect() {
+    _connection.disconnect();
+}
+
+WifiTransition WifiManager::update() {
+    WifiTransition transition = _connection.update();
+    if (_connection.getState() == WIFI_STATE_CONNECTED) {
+        checkLease();
+    }
+    switch (transition) {
+        case WIFI_TRANSITION_CONNECTED:
+            onConnected();
+            break;
+        case WIFI_TRANSITION_LOST:
+            Logger::log(LogLevel::Error, "WLAN-Verbindung verloren (Grund " + String(_connection.getLastDisconnectReason()) +
+                        "), Reconnect läuft im Hintergrund.");
+            break;
+        case WIFI_TRANSITION_FAILED:
+            Logger::log(LogLevel::Error, "WLAN-Verbindung fehlgeschlagen (Grund " + String(_connection.getLastDisconnectReason()) + ").");
+            break;
+        default:
+            break;
+    }
+    return transition;
+}
+
+// Merkt sich die Daten der neuen Verbindung für den nächsten Schnellweg und erfasst die Verbindungszeit.
+void WifiManager::onConnected() {
+    unsigned long durationMs = _connection.getLastConnectDurationMs();
+    const char* ssid = _connection.getNetworkSsid(_connection.getConnectedNetwork());
+    bool fast = _connection.wasFastConnect();
+    (fast ? _fastStats : _scanStats).add(durationMs);
+
+    int8_t rssi = (int8_t)WiFi.RSSI();
+    Logger::log(LogLevel::Info, "WLAN " + String(ssid) + " verbunden nach " + String(durationMs) + " ms (" +
+                (fast ? "Schnellweg" : "Scan") + ", " + String(rssi) + " dBm), IP-Adresse: " + WiFi.localIP().toString());
+
+    const WifiFastConnectHint& previous = _connection.getFastConnectHint();
+    WifiFastConnectHint hint;
+    memset(&hint, 0, sizeof(hint)); // Auch die Füllbytes, damit der Vergleich in saveFastConnectHint() stimmt
+    hint.valid = true;
+    strncpy(hint.ssid, ssid, sizeof(hint.ssid) - 1);
+    memcpy(hint.bssid, WiFi.BSSID(), sizeof(hint.bssid));
+    hint.channel = (uint8_t)WiFi.channel();
+    _leaseSec = 0;
+    if (_staticIp) {
+        // Adresse ohne DHCP übernommen: der Lease wurde nicht erneuert und läuft zum gespeicherten Zeitpunkt ab
+        hint.ip = previous.ip;
+        hint.gateway = previous.gateway;
+        hint.subnet = previous.subnet;
+        hint.dns = previous.dns;
+        hint.leaseExpiry = previous.leaseExpiry;
+    } else {
+        hint.ip = (uint32_t)WiFi.localIP();
+        hint.gateway = (uint32_t)WiFi.gatewayIP();
+        hint.subnet = (uint32_t)WiFi.subnetMask();
+        hint.dns = (uint32_t)WiFi.dnsIP();
+        // Ohne gestellte Uhr (nach dem Einschalten vor NTP) wird der Ablauf in checkLease() nachgetragen
+        _leaseSec = dhcpLeaseSeconds();
+        _leaseObtainedMs = millis();
+        hint.leaseExpiry = leaseExpiryFrom(_leaseSec, _leaseObtainedMs);
+        if (hint.leaseExpiry != 0) {
+            _leaseSec = 0;
+        }
+    }
+    _connection.setFastConnectHint(hint);
+    saveFastConnectHint(hint);
+
+    updateRssiHistory(ssid, rssi);
+}
+
+// Läuft bei bestehender Verbindung. Trägt den Ablauf eines über DHCP erhaltenen Leases nach, sobald die Uhr
+// gestellt ist, und wechselt von einer ohne DHCP übernommenen Adresse auf DHCP, bevor deren Lease abläuft.
+void WifiManager::checkLease() {
+    if (_leaseSec != 0) {
+        uint32_t expiry = leaseExpiryFrom(_leaseSec, _leaseObtainedMs);
+        if (expiry != 0) {
+            _leaseSec = 0;
+            WifiFastConnectHint hint = _connection.getFastConnectHint();
+            hint.leaseExpiry = expiry;
+            _connection.setFastConnectHint(hint);
+            saveFastConnectHint(hint);
+        }
+    }
+    if (_staticIp && !wifiLeaseValid(_connection.getFastConnectHint(), (uint32_t)time(nullptr))) {
+        Logger::log(LogLevel::Info, "DHCP-Lease der übernommenen IP-Adresse läuft ab, wechsle auf DHCP.");
+        _staticIp = false;
+        // Ab jetzt gilt die Adresse nicht mehr als Abkürzung, bis DHCP beim nächsten Aufbau einen neuen Lease liefert
+        WifiFastConnectHint hint = _connection.getFastConnectHint();
+        hint.ip = 0;
+        hint.leaseExpiry = 0;
+        _connection.setFastConnectHint(hint);
+        saveFastConnectHint(hint);
+        // 0.0.0.0 startet den DHCP-Client, die Verbindung zum Access Point bleibt bestehen
+        WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));
+    }
+}
+
+// Ablauf des Leases als Unix-Zeit, 0 wenn der Lease unbekannt oder die Uhr noch nicht gestellt ist.
+uint32_t WifiManager::leaseExpiryFrom(uint32_t leaseSec, unsigned long obtainedMs) {
+    uint32_t now = (uint32_t)time(nullptr);
+    if (leaseSec == 0 || now < WIFI_MIN_VALID_UNIX_TIME) {
+        return 0;
+    }
+    return now - (uint32_t)((millis() - obtainedMs) / 1000) + leaseSec;
+}
+
+// Dauer des aktuellen DHCP-Leases der Station in Sekunden, 0 wenn unbekannt.
+uint32_t WifiManager::dhcpLeaseSeconds() {
+    esp_netif_t* netif = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
+    if (netif == nullptr) {
+        return 0;
+    }
+    struct netif* lwipNetif = (struct netif*)esp_netif_get_netif_impl(netif);
+    struct dhcp* dhcp = lwipNetif != nullptr ? netif_dhcp_data(lwipNetif) : nullptr;
+    return dhcp != nullptr ? dhcp->offered_t0_lease : 0;
+}
+
+// Schreibt den Hinweis nur bei Änderungen, um den Flash zu schonen.
+void WifiManager::saveFastConnectHint(const WifiFastConnectHint& hint) {
+    WifiFastConnectHint stored;
+    if (_preferences.getBytes(WIFI_NVS_KEY_HINT, &stored, sizeof(stored)) == sizeof(stored) &&
+        memcmp(&stored, &hint, sizeof(hint)) == 0) {
+        return;
+    }
+    _preferences.putBytes(WIFI_NVS_KEY_HINT, &hint, sizeof(hint));
+}
+
+int8_t WifiManager::findRssiHistory(const char* ssid) const {
+    uint32_t hash = hashSsid(ssid);
+    for (int i = 0; i < WIFI_MAX_NETWORKS; i++) {
+        if (_rssiHistory[i].ssidHash == hash) {
+            return _rssiHistory[i].rssi;
+        }
+    }
+    return WIFI_RSSI_UNKNOWN;
+}
+
+// Gleitender Mittelwert (3/4 alt, 1/4 neu), damit einzelne Ausreisser die Reihenfolge nicht kippen.
+void WifiManager::updateRssiHistory(const char* ssid, int8_t rssi) {
+    uint32_t hash = hashSsid(ssid);
+    int slot = -1;
+    for (int i = 0; i < WIFI_MAX_NETWORKS && slot < 0; i++) {
+        if (_rssiHistory[i].ssidHash == hash) slot = i;
+    }
+    if (slot < 0) {
+        // Freien Eintrag oder den mit dem schwächsten Empfang ersetzen
+        slot = 0;
+        for (int i = 1; i < WIFI_MAX_NETWORKS; i++) {
+            if (_rssiHistory[i].rssi < _rssiHistory[slot].rssi) slot = i;
+        }
+        _rssiHistory[slot] = { hash, rssi };
+    } else {
+        _rssiHistory[slot].rssi = (int8_t)((3 * _rssiHistory[slot].rssi + rssi) / 4);
+    }
+    _preferences.putBytes(WIFI_NVS_KEY_RSSI, _rssiHistory, sizeof(_rssiHistory));
+}
+
+// FNV-1a, reicht zur Unterscheidung weniger SSIDs
+uint32_t WifiManager::hashSsid(const char* ssid) {
+    uint32_t hash = 2166136261UL;
+    while (*ssid) {
+        hash ^= (uint8_t)*ssid++;
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+// Läuft im Event-Task des WLAN-Stacks: nur vormerken, keine Logs und keine Zustandswechsel.
+void WifiManager::onWiFiEvent(arduino_event_id_t event, arduino_event_info_t info) {
+    WifiConnection& connection = getInstance()._connection;
+    switch (event) {
+        case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+            connection.onGotIp();
+            break;
+        case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+            connection.onDisconnected(info.wifi_sta_disconnected.reason);
+            break;
+        default:
+            break;
+    }
+}
+
+void WifiManager::startStation(const char* ssid, const char* password, const WifiFastConnectHint* hint) {
+    // Beende den SoftAP, falls er noch läuft und wir im STA-Modus sein wollen
+    if (WiFi.getMode() == WIFI_AP || WiFi.getMode() == WIFI_AP_STA) {
+        WiFi.softAPdisconnect(true);
+    }
+    WiFi.mode(WIFI_STA);
+
+    // Die letzte IP-Adresse wird nur übernommen, solange ihr Lease gültig ist. Sonst DHCP
+    // (0.0.0.0 setzt eine zuvor übernommene Adresse zurück).
+    bool staticIp = hint != nullptr && wifiLeaseValid(*hint, (uint32_t)time(nullptr));
+    getInstance()._staticIp = staticIp;
+    if (staticIp) {
+        WiFi.config(IPAddress(hint->ip), IPAddress(hint->gateway), IPAddress(hint->subnet), IPAddress(hint->dns));
+    } else {
+        WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));
+    }
+
+    if (hint != nullptr) {
+        // Schnellweg: den bekannten AP auf dem bekannten Kanal ohne Scan ansprechen
+        WiFi.begin(ssid, password, hint->channel, hint->bssid, true); // Kehrt sofort zurück
+    } else {
+        // Normaler Aufbau mit Scan
+        WiFi.begin(ssid, password); // Kehrt sofort zurück
+    }
+}
+
+void WifiManager::stopStation() {
+    if (WiFi.getMode() == WIFI_STA) {
+        WiFi.disconnect(false);
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef WIFI_MANAGER_H
+#define WIFI_MANAGER_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <Preferences.h>
+#include "WifiConnection.h"
+#include "ConnectTimeStats.h"
+#include "../configuration/ConfigurationPortal.h"
+
+// Anbindung von WifiConnection an den WLAN-Stack des ESP32.
+// Die Ereignisse kommen über WiFi.onEvent() aus dem Event-Task, alle Zustandswechsel
+// passieren in update() im Kontext der loop(). Kein Aufruf blockiert.
+// BSSID, Kanal und IP-Lease der letzten Verbindung sowie die RSSI-Historie der Netzwerke
+// werden im NVS abgelegt, damit auch nach einem Neustart der Schnellweg möglich ist.
+// Die IP-Adresse wird nur bis zum Ablauf ihres DHCP-Leases ohne DHCP übernommen.
+class WifiManager {
+public:
+    // Statische Methode, um die einzige Instanz zu erhalten (Singleton-Muster).
+    static WifiManager& getInstance() {
+        static WifiManager instance;
+        return instance;
+    }
+
+    // Registriert die WLAN-Ereignisse und lädt die gespeicherten Verbindungsdaten. Einmal in setup() aufrufen.
+    void begin();
+
+    // Startet den Verbindungsaufbau im Hintergrund. Die Netzwerke werden nach ihrer RSSI-Historie sortiert.
+    void connect(const WifiNetworkConfig (&networks)[WIFI_MAX_NETWORKS], unsigned long networkTimeoutMs);
+
+    // Trennt die Station-Verbindung (z.B. vor dem Wechsel in den AP-Modus).
+    void disconnect();
+
+    // Wertet Ereignisse und Timeouts aus und meldet Zustandswechsel.
+    WifiTransition update();
+
+    WifiState getState() const { return _connection.getState(); }
+    bool isConnected() const { return _connection.getState() == WIFI_STATE_CONNECTED; }
+
+    // Verbindungszeiten getrennt nach Schnellweg und normalem Aufbau (Scan + DHCP)
+    const ConnectTimeStats& getFastConnectStats() const { return _fastStats; }
+    const ConnectTimeStats& getScanConnectStats() const { return _scanStats; }
+
+private:
+    WifiManager();
+    WifiManager(const WifiManager&) = delete;
+    WifiManager& operator=(const WifiManager&) = delete;
+
+    // Gespeicherte RSSI-Historie eines Netzwerks (über den Hash der SSID zugeordnet)
+    struct RssiHistoryEntry {
+        uint32_t ssidHash;
+        int8_t rssi;
+    };
+
+    WifiConnection _connection;
+    Preferences _preferences;
+    RssiHistoryEntry _rssiHistory[WIFI_MAX_NETWORKS];
+    ConnectTimeStats _fastStats;
+    ConnectTimeStats _scanStats;
+    bool _staticIp;                     // Aktuelle Verbindung nutzt die gespeicherte Adresse ohne DHCP
+    uint32_t _leaseSec;                 // DHCP-Lease, dessen Ablauf noch nicht bestimmt werden konnte (Uhr nicht gestellt)
+    unsigned long _leaseObtainedMs;     // millis() beim Erhalt dieses Leases
+
+    void onConnected();
+    void checkLease();
+    void saveFastConnectHint(const WifiFastConnectHint& hint);
+    int8_t findRssiHistory(const char* ssid) const;
+    void updateRssiHistory(const char* ssid, int8_t rssi);
+
+    static uint32_t leaseExpiryFrom(uint32_t leaseSec, unsigned long obtainedMs);
+    static uint32_t dhcpLeaseSeconds();
+    static uint32_t hashSsid(const char* ssid);
+    static void onWiFiEvent(arduino_event_id_t event, arduino_event_info_t info);
+    static void startStation(const char* ssid, const char* password, const WifiFastConnectHint* hint);
+    static void stopStation();
+    static unsigned long clock() { return millis(); }
+};
+
+#endif // WIFI_MANAGER_H
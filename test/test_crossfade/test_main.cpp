@@ -0,0 +1,120 @@
+// Überblendung (display/Crossfade.h): Endpunkte, Mitte, Neustart aus einer laufenden Überblendung und
+// sofort gesetzte Kanäle. Die Zeit wird vorgegeben.
+//
+//   pio test -e native -f test_crossfade
+
+#include <unity.h>
+#include "display/Crossfade.h"
+
+void setUp() {}
+void tearDown() {}
+
+const unsigned long DURATION_MS = 600;
+
+static const uint8_t BLACK[4] = { 0, 0, 0, 0 };
+static const uint8_t WHITE[4] = { 255, 255, 255, 255 };
+static const uint8_t MIXED[4] = { 0, 255, 100, 200 };
+
+void test_endpoints() {
+    Crossfade<4> fade;
+    uint8_t out[4];
+    TEST_ASSERT_FALSE(fade.isActive());
+    TEST_ASSERT_EQUAL(CROSSFADE_ONE, fade.alphaAt(0));
+
+    fade.start(BLACK, MIXED, DURATION_MS, 1000);
+    TEST_ASSERT_TRUE(fade.isActive());
+    TEST_ASSERT_EQUAL(0, fade.alphaAt(1000));
+    TEST_ASSERT_TRUE(fade.blend(1000, out));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(BLACK, out, 4);
+
+    // Kurz vor dem Ende noch nicht ganz am Ziel, ab dem Ende genau das Ziel und die Überblendung ist vorbei
+    TEST_ASSERT_TRUE(fade.blend(1000 + DURATION_MS - 1, out));
+    TEST_ASSERT_TRUE(out[1] < 255);
+    TEST_ASSERT_FALSE(fade.blend(1000 + DURATION_MS, out));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(MIXED, out, 4);
+    TEST_ASSERT_FALSE(fade.isActive());
+}
+
+void test_late_frame_ends_on_time() {
+    // Fällt das Frame am Ende aus, liefert das nächste direkt das Ziel
+    Crossfade<4> fade;
+    uint8_t out[4];
+    fade.start(WHITE, BLACK, DURATION_MS, 1000);
+    TEST_ASSERT_FALSE(fade.blend(1000 + 5 * DURATION_MS, out));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(BLACK, out, 4);
+}
+
+void test_midpoint() {
+    Crossfade<4> fade;
+    uint8_t out[4];
+    fade.start(BLACK, WHITE, DURATION_MS, 1000);
+    TEST_ASSERT_EQUAL(CROSSFADE_ONE / 2, fade.alphaAt(1000 + DURATION_MS / 2));
+    fade.blend(1000 + DURATION_MS / 2, out);
+    for (uint8_t value : out) {
+        TEST_ASSERT_EQUAL(127, value);
+    }
+
+    // Abwärts und gemischt: from + (to - from) * 1/2, auf ganze Stufen abgerundet
+    fade.start(WHITE, MIXED, DURATION_MS, 0);
+    fade.blend(DURATION_MS / 2, out);
+    TEST_ASSERT_EQUAL(127, out[0]);
+    TEST_ASSERT_EQUAL(255, out[1]);
+    TEST_ASSERT_EQUAL(177, out[2]);
+    TEST_ASSERT_EQUAL(227, out[3]);
+}
+
+void test_restart_from_blend() {
+    // Ein neues Ziel während der Überblendung startet beim gerade gezeigten Zwischenbild, ohne Sprung
+    Crossfade<4> fade;
+    uint8_t out[4];
+    fade.start(BLACK, WHITE, DURATION_MS, 0);
+    fade.blend(DURATION_MS / 4, out);
+    uint8_t shown[4];
+    memcpy(shown, out, sizeof(shown));
+    TEST_ASSERT_EQUAL(63, shown[0]);
+
+    // from ist hier der Ausgabepuffer selbst, wie in UpdateDisplay::showFrame()
+    fade.start(out, MIXED, DURATION_MS, DURATION_MS / 4);
+    TEST_ASSERT_TRUE(fade.blend(DURATION_MS / 4, out));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(shown, out, 4);
+    TEST_ASSERT_FALSE(fade.blend(DURATION_MS / 4 + DURATION_MS, out));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(MIXED, out, 4);
+}
+
+void test_zero_duration_is_instant() {
+    Crossfade<4> fade;
+    uint8_t out[4];
+    fade.start(BLACK, MIXED, 0, 1000);
+    TEST_ASSERT_FALSE(fade.isActive());
+    TEST_ASSERT_FALSE(fade.blend(1000, out));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(MIXED, out, 4);
+}
+
+void test_set_channels_during_fade() {
+    // Marker sofort setzen: diese Kanäle springen, die übrigen blenden unverändert weiter
+    Crossfade<4> fade;
+    uint8_t out[4];
+    fade.start(BLACK, WHITE, DURATION_MS, 0);
+    static const uint8_t marker[2] = { 10, 20 };
+    fade.setChannels(2, 2, marker);
+    TEST_ASSERT_TRUE(fade.isActive());
+    fade.blend(DURATION_MS / 2, out);
+    TEST_ASSERT_EQUAL(127, out[0]);
+    TEST_ASSERT_EQUAL(127, out[1]);
+    TEST_ASSERT_EQUAL(10, out[2]);
+    TEST_ASSERT_EQUAL(20, out[3]);
+    fade.blend(DURATION_MS, out);
+    TEST_ASSERT_EQUAL(255, out[0]);
+    TEST_ASSERT_EQUAL(20, out[3]);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_endpoints);
+    RUN_TEST(test_late_frame_ends_on_time);
+    RUN_TEST(test_midpoint);
+    RUN_TEST(test_restart_from_blend);
+    RUN_TEST(test_zero_duration_is_instant);
+    RUN_TEST(test_set_channels_during_fade);
+    return UNITY_END();
+}
@@ -0,0 +1,121 @@
+// Snapshot des Geräts (status/DeviceSnapshot.h): Kodierung als CBOR und zurück, fehlende Werte als null und
+// die Grösse gegenüber der berechneten Obergrenze.
+//
+//   pio test -e native -f test_device_snapshot
+
+#include <unity.h>
+#include "status/DeviceSnapshot.h"
+#include "status/CborReader.h"
+
+void setUp() {}
+void tearDown() {}
+
+// Alle Werte gesetzt und so gross wie möglich
+static DeviceSnapshot fullSnapshot() {
+    DeviceSnapshot snapshot;
+    snapshot.uptimeSec = 0xFFFFFFFF;
+    snapshot.indoorValid = true;
+    snapshot.indoorTemperature = 21.5f;
+    snapshot.indoorHumidity = 40.0f;
+    snapshot.outdoorValid = true;
+    snapshot.outdoorTemperature = -3.5f;
+    snapshot.outdoorHumidity = 85.0f;
+    snapshot.weatherType = 200;
+    snapshot.grassPollenLevel = -128;
+    snapshot.treePollenLevel = 127;
+    snapshot.weedPollenLevel = 5;
+    snapshot.airQualityValid = true;
+    snapshot.airQualityIndex = 77.0f;
+    snapshot.timeSynced = true;
+    snapshot.epochTime = 0xFFFFFFFF;
+    for (uint32_t& counter : snapshot.counters) {
+        counter = 0xFFFFFFFF;
+    }
+    return snapshot;
+}
+
+// Position des Werts zu key in der obersten Map, 0 wenn er fehlt
+static size_t findKey(const uint8_t* data, size_t length, uint32_t key) {
+    CborReader reader(data, length);
+    uint32_t entries;
+    if (!reader.readMap(entries)) return 0;
+    for (uint32_t i = 0; i < entries; i++) {
+        uint32_t current;
+        if (!reader.readUint(current)) return 0;
+        if (current == key) return reader.position();
+        if (!reader.skip()) return 0;
+    }
+    return 0;
+}
+
+void test_full_snapshot_round_trip() {
+    DeviceSnapshot snapshot = fullSnapshot();
+    uint8_t buffer[DEVICE_SNAPSHOT_BUFFER_SIZE];
+    size_t length = encodeDeviceSnapshot(snapshot, buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(length > 0);
+    TEST_ASSERT_LESS_OR_EQUAL(DEVICE_SNAPSHOT_MAX_ENCODED_SIZE, length);
+
+    DeviceSnapshot decoded;
+    TEST_ASSERT_TRUE(decodeDeviceSnapshot(buffer, length, decoded));
+    TEST_ASSERT_TRUE(decoded.indoorValid);
+    TEST_ASSERT_TRUE(decoded.outdoorValid);
+    TEST_ASSERT_TRUE(decoded.outdoorTemperature == -3.5f);
+    TEST_ASSERT_TRUE(decoded.outdoorHumidity == 85.0f);
+    TEST_ASSERT_EQUAL(200, decoded.weatherType);
+    TEST_ASSERT_EQUAL(-128, decoded.grassPollenLevel);
+    TEST_ASSERT_EQUAL(127, decoded.treePollenLevel);
+    TEST_ASSERT_TRUE(decoded.airQualityValid);
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFF, decoded.epochTime);
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFF, decoded.counters[SNAPSHOT_COUNTER_HTTP_REQUESTS]);
+}
+
+void test_missing_values_are_null() {
+    // Vor dem ersten Abruf des Wetters: keine Aussenwerte statt 0 °C, 0 % und Wettertyp 0
+    DeviceSnapshot snapshot = fullSnapshot();
+    snapshot.indoorValid = false;
+    snapshot.outdoorValid = false;
+    snapshot.airQualityValid = false;
+    uint8_t buffer[DEVICE_SNAPSHOT_BUFFER_SIZE];
+    size_t length = encodeDeviceSnapshot(snapshot, buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(length > 0);
+
+    size_t outdoor = findKey(buffer, length, SNAPSHOT_KEY_OUTDOOR);
+    TEST_ASSERT_TRUE(outdoor > 0);
+    static const uint8_t NULL_ARRAY[] = { 0x83, CBOR_NULL, CBOR_NULL, CBOR_NULL };
+    TEST_ASSERT_EQUAL_MEMORY(NULL_ARRAY, buffer + outdoor, sizeof(NULL_ARRAY));
+
+    DeviceSnapshot decoded = fullSnapshot();
+    TEST_ASSERT_TRUE(decodeDeviceSnapshot(buffer, length, decoded));
+    TEST_ASSERT_FALSE(decoded.indoorValid);
+    TEST_ASSERT_FALSE(decoded.outdoorValid);
+    TEST_ASSERT_FALSE(decoded.airQualityValid);
+    TEST_ASSERT_EQUAL(0, decoded.weatherType);
+    TEST_ASSERT_EQUAL(5, decoded.weedPollenLevel);
+}
+
+void test_buffer_too_small() {
+    DeviceSnapshot snapshot = fullSnapshot();
+    uint8_t buffer[DEVICE_SNAPSHOT_BUFFER_SIZE];
+    size_t length = encodeDeviceSnapshot(snapshot, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(0, encodeDeviceSnapshot(snapshot, buffer, length - 1));
+}
+
+void test_other_schema_version_is_rejected() {
+    DeviceSnapshot snapshot = fullSnapshot();
+    uint8_t buffer[DEVICE_SNAPSHOT_BUFFER_SIZE];
+    size_t length = encodeDeviceSnapshot(snapshot, buffer, sizeof(buffer));
+    size_t version = findKey(buffer, length, SNAPSHOT_KEY_VERSION);
+    TEST_ASSERT_EQUAL(DEVICE_SNAPSHOT_SCHEMA_VERSION, buffer[version]);
+    buffer[version] = DEVICE_SNAPSHOT_SCHEMA_VERSION - 1;
+    DeviceSnapshot decoded;
+    TEST_ASSERT_FALSE(decodeDeviceSnapshot(buffer, length, decoded));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_full_snapshot_round_trip);
+    RUN_TEST(test_missing_values_are_null);
+    RUN_TEST(test_buffer_too_small);
+    RUN_TEST(test_other_schema_version_is_rejected);
+    return UNITY_END();
+}
@@ -0,0 +1,196 @@
+// Tabellen der LED-Farben: Gammakurve der Helligkeit und Dithering (led/led_strip/LedTables.h) sowie die
+// Farbverläufe der Anzeige (display/DisplayPalettes.h) gegen die frühere Berechnung mit map(). Dazu eine
+// Messung der Kosten pro Frame auf dem PC (Ausgabe im Testprotokoll).
+//
+//   pio test -e native -f test_led_tables
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <chrono>
+#include "led/led_strip/LedTables.h"
+#include "display/DisplayPalettes.h"
+
+void setUp() {}
+void tearDown() {}
+
+const int FRAME_LEDS = 123;                     // LEDs des Streifens (Wortuhr und Anzeigen)
+const int BENCHMARK_FRAMES = 20000;
+
+// Arduino map() mit long, wie es der frühere Renderer mit float-Werten aufgerufen hat (abgeschnitten)
+static long arduinoMap(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// Früherer Verlauf der Luftqualität in UpdateDisplay::updateAirQuality()
+static PaletteColor oldAirQualityColor(float airQuality) {
+    if (airQuality <= 50.0) return { 255, 0, 0 };
+    if (airQuality >= 96.0) return { 0, 255, 0 };
+    if (airQuality <= 73.0) return { 255, (uint8_t)arduinoMap(airQuality, 50, 73, 0, 255), 0 };
+    return { (uint8_t)arduinoMap(airQuality, 73, 96, 255, 0), 255, 0 };
+}
+
+// Zugriff wie im Renderer
+static const PaletteColor& airQualityColor(float airQuality) {
+    int iaq = airQuality <= 0.0f ? 0 : (airQuality >= 255.0f ? 255 : (int)airQuality);
+    return AIR_QUALITY_PALETTE.colors[iaq];
+}
+
+static double microsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+// --- Helligkeit ---
+
+void test_brightness_follows_gamma() {
+    TEST_ASSERT_EQUAL(0, LED_BRIGHTNESS_TABLE.scale[0]);
+    TEST_ASSERT_EQUAL(65535, LED_BRIGHTNESS_TABLE.scale[100]);
+    for (int percent = 1; percent <= 100; percent++) {
+        TEST_ASSERT_TRUE(LED_BRIGHTNESS_TABLE.scale[percent] >= LED_BRIGHTNESS_TABLE.scale[percent - 1]);
+        long expected = lround(pow(percent / 100.0, 2.2) * 65535.0);
+        if (expected < LED_MIN_SCALE) {
+            TEST_ASSERT_EQUAL(LED_MIN_SCALE, LED_BRIGHTNESS_TABLE.scale[percent]);
+        } else {
+            TEST_ASSERT_INT_WITHIN(1, expected, LED_BRIGHTNESS_TABLE.scale[percent]);
+        }
+    }
+}
+
+void test_lowest_brightness_lights_full_color() {
+    // Die kleinste Stufe lässt einen vollen Kanal noch leuchten, schwächere Kanäle nur mit Dithering
+    TEST_ASSERT_EQUAL(1, ledScale(255, LED_BRIGHTNESS_TABLE.scale[1], 255));
+    TEST_ASSERT_EQUAL(0, ledScale(128, LED_BRIGHTNESS_TABLE.scale[1], 255));
+}
+
+void test_scale_endpoints() {
+    for (int value = 0; value <= 255; value++) {
+        TEST_ASSERT_EQUAL(value, ledScale(value, 65535, 255));
+        TEST_ASSERT_EQUAL(0, ledScale(value, 0, 255));
+        for (uint8_t threshold : LED_DITHER_THRESHOLDS) {
+            TEST_ASSERT_EQUAL(value, ledScale(value, 65535, threshold));
+        }
+    }
+}
+
+void test_dithering_averages_fraction() {
+    // Über LED_DITHER_STEPS Frames gemittelt liegt der Kanal höchstens eine Stufe/8 neben dem genauen Wert
+    for (int percent = 1; percent <= 50; percent++) {
+        uint16_t scale = LED_BRIGHTNESS_TABLE.scale[percent];
+        for (int value = 0; value <= 255; value += 5) {
+            double exact = value * (scale + 1) / 65536.0;
+            int sum = 0;
+            for (uint8_t threshold : LED_DITHER_THRESHOLDS) {
+                uint8_t result = ledScale(value, scale, threshold);
+                TEST_ASSERT_TRUE(result == (int)exact || result == (int)exact + 1);
+                sum += result;
+            }
+            TEST_ASSERT_FLOAT_WITHIN(1.0 / LED_DITHER_STEPS + 0.01, exact, (double)sum / LED_DITHER_STEPS);
+        }
+    }
+}
+
+// --- Farbverläufe ---
+
+void test_encode_grb_order() {
+    struct { uint8_t r, g, b; } leds[2] = { { 10, 20, 30 }, { 255, 0, 128 } };
+    uint8_t out[6];
+    ledEncodeGrb(leds, 2, 65535, 255, out);
+    const uint8_t expected[6] = { 20, 10, 30, 0, 255, 128 };
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, out, 6);
+}
+
+void test_air_quality_palette_matches_map() {
+    for (int tenth = 0; tenth <= 2550; tenth++) {
+        float airQuality = tenth / 10.0f;
+        PaletteColor expected = oldAirQualityColor(airQuality);
+        const PaletteColor& actual = airQualityColor(airQuality);
+        if (actual.r != expected.r || actual.g != expected.g || actual.b != expected.b) {
+            char message[64];
+            snprintf(message, sizeof(message), "IAQ %.1f: %d,%d,%d statt %d,%d,%d", airQuality, actual.r, actual.g,
+                     actual.b, expected.r, expected.g, expected.b);
+            TEST_FAIL_MESSAGE(message);
+        }
+    }
+    // Werte ausserhalb 0-255 (Sensor noch nicht kalibriert) bleiben am Rand der Tabelle
+    TEST_ASSERT_EQUAL(255, airQualityColor(-3.0f).r);
+    TEST_ASSERT_EQUAL(255, airQualityColor(500.0f).g);
+}
+
+void test_pollen_palette_matches_map() {
+    for (int level = 0; level <= POLLEN_LEVEL_MAX; level++) {
+        TEST_ASSERT_EQUAL(arduinoMap(level, 0, 5, 0, 255), POLLEN_PALETTE.colors[level].r);
+        TEST_ASSERT_EQUAL(arduinoMap(level, 0, 5, 255, 0), POLLEN_PALETTE.colors[level].g);
+        TEST_ASSERT_EQUAL(0, POLLEN_PALETTE.colors[level].b);
+    }
+}
+
+// --- Kosten pro Frame ---
+
+void test_benchmark_frame_encoding() {
+    // Wie CRGB von FastLED
+    struct { uint8_t r, g, b; } leds[FRAME_LEDS];
+    for (int i = 0; i < FRAME_LEDS; i++) {
+        leds[i] = { (uint8_t)(i * 2), (uint8_t)(255 - i), (uint8_t)(i * 7) };
+    }
+    static uint8_t buffer[FRAME_LEDS * 3];
+    uint16_t scale = LED_BRIGHTNESS_TABLE.scale[20];
+    uint32_t checksum = 0;
+
+    // Kodierung von RmtLedOutput::write(): GRB mit Helligkeit und Dithering
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < BENCHMARK_FRAMES; frame++) {
+        ledEncodeGrb(leds, FRAME_LEDS, scale, LED_DITHER_THRESHOLDS[frame % LED_DITHER_STEPS], buffer);
+        checksum += buffer[frame % sizeof(buffer)];
+    }
+    double frameMicros = microsSince(start) / BENCHMARK_FRAMES;
+
+    char message[96];
+    snprintf(message, sizeof(message), "Frame mit %d LEDs kodieren: %.3f us (Prüfsumme %u)", FRAME_LEDS, frameMicros,
+             (unsigned)checksum);
+    TEST_MESSAGE(message);
+    // Grosszügige Grenze, damit langsame Rechner nicht scheitern: ein Frame dauert am Streifen 3.7 ms
+    TEST_ASSERT_TRUE(frameMicros < 100.0);
+}
+
+void test_benchmark_palette_lookup() {
+    const int values = 2560;
+    uint32_t checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < BENCHMARK_FRAMES / 100; round++) {
+        for (int tenth = 0; tenth < values; tenth++) {
+            const PaletteColor& color = airQualityColor(tenth / 10.0f + round * 1e-4f);
+            checksum += color.r + color.g;
+        }
+    }
+    double lookupNanos = microsSince(start) * 1000.0 / (BENCHMARK_FRAMES / 100 * values);
+
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < BENCHMARK_FRAMES / 100; round++) {
+        for (int tenth = 0; tenth < values; tenth++) {
+            PaletteColor color = oldAirQualityColor(tenth / 10.0f + round * 1e-4f);
+            checksum += color.r + color.g;
+        }
+    }
+    double mapNanos = microsSince(start) * 1000.0 / (BENCHMARK_FRAMES / 100 * values);
+
+    char message[96];
+    snprintf(message, sizeof(message), "Luftqualität: Tabelle %.2f ns, map() %.2f ns (Prüfsumme %u)", lookupNanos,
+             mapNanos, (unsigned)checksum);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(lookupNanos < 1000.0);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_brightness_follows_gamma);
+    RUN_TEST(test_lowest_brightness_lights_full_color);
+    RUN_TEST(test_scale_endpoints);
+    RUN_TEST(test_dithering_averages_fraction);
+    RUN_TEST(test_encode_grb_order);
+    RUN_TEST(test_air_quality_palette_matches_map);
+    RUN_TEST(test_pollen_palette_matches_map);
+    RUN_TEST(test_benchmark_frame_encoding);
+    RUN_TEST(test_benchmark_palette_lookup);
+    return UNITY_END();
+}
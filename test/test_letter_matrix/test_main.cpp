@@ -0,0 +1,226 @@
+// Text auf dem Buchstabenraster: Zuordnung Zeile/Spalte -> LED (display/LetterMatrix.h), Rasterung des
+// Zeichensatzes (display/MatrixFont.h) und Ausschnitte des Lauftexts (display/MatrixText.h).
+//
+//   pio test -e native -f test_letter_matrix
+
+#include <unity.h>
+#include <string.h>
+#include "display/MatrixText.h"
+
+void setUp() {}
+void tearDown() {}
+
+// Zeilen eines Bilds ('#' = an) aus einer Maske, zum Vergleich mit erwarteten Bildern
+static void maskRows(const LedMask& mask, char rows[LETTER_MATRIX_ROWS][LETTER_MATRIX_COLUMNS + 1]) {
+    for (int row = 0; row < LETTER_MATRIX_ROWS; row++) {
+        for (int column = 0; column < LETTER_MATRIX_COLUMNS; column++) {
+            rows[row][column] = mask.test(LETTER_MATRIX.leds[row][column]) ? '#' : '.';
+        }
+        rows[row][LETTER_MATRIX_COLUMNS] = '\0';
+    }
+}
+
+// --- Raster ---
+
+void test_serpentine_mapping() {
+    // Zeile 0 läuft von rechts nach links, Zeile 1 von links nach rechts, ...
+    for (int row = 0; row < LETTER_MATRIX_ROWS; row++) {
+        int first = WORD_CLOCK_FIRST_LED + row * LETTER_MATRIX_COLUMNS;
+        for (int column = 0; column < LETTER_MATRIX_COLUMNS; column++) {
+            int expected = row % 2 == 0 ? first + LETTER_MATRIX_COLUMNS - 1 - column : first + column;
+            TEST_ASSERT_EQUAL(expected, LETTER_MATRIX.leds[row][column]);
+        }
+    }
+    TEST_ASSERT_EQUAL(22, LETTER_MATRIX.leds[0][0]);
+    TEST_ASSERT_EQUAL(12, LETTER_MATRIX.leds[0][10]);
+    TEST_ASSERT_EQUAL(23, LETTER_MATRIX.leds[1][0]);
+    TEST_ASSERT_EQUAL(121, LETTER_MATRIX.leds[9][10]);
+}
+
+void test_mapping_is_bijective() {
+    LedMask used;
+    for (int row = 0; row < LETTER_MATRIX_ROWS; row++) {
+        for (int column = 0; column < LETTER_MATRIX_COLUMNS; column++) {
+            uint8_t led = LETTER_MATRIX.leds[row][column];
+            TEST_ASSERT_FALSE(used.test(led));
+            used.set(led);
+        }
+    }
+    TEST_ASSERT_TRUE(used == LedMask::range(WORD_CLOCK_FIRST_LED, LETTER_MATRIX_ROWS * LETTER_MATRIX_COLUMNS));
+}
+
+void test_words_read_left_to_right() {
+    // "ES" steht oben links, "ISCH" ab Spalte 3: der erste Buchstabe liegt in Zeile 0 auf der höchsten LED
+    TEST_ASSERT_EQUAL(WORD_CLOCK_WORDS[WORD_ES].first + 1, LETTER_MATRIX.leds[0][0]);
+    TEST_ASSERT_EQUAL(WORD_CLOCK_WORDS[WORD_ES].first, LETTER_MATRIX.leds[0][1]);
+    TEST_ASSERT_EQUAL(WORD_CLOCK_WORDS[WORD_ISCH].first + 3, LETTER_MATRIX.leds[0][3]);
+    // Zeile 1 läuft vorwärts: "ZÄÄ" beginnt mit Spalte 0
+    TEST_ASSERT_EQUAL(WORD_CLOCK_WORDS[WORD_ZAEAE].first, LETTER_MATRIX.leds[1][0]);
+}
+
+void test_text_area_rows() {
+    int count = 0;
+    for (int row = 0; row < LETTER_MATRIX_ROWS; row++) {
+        for (int column = 0; column < LETTER_MATRIX_COLUMNS; column++) {
+            bool inside = row >= MATRIX_TEXT_TOP && row < MATRIX_TEXT_TOP + MATRIX_FONT_HEIGHT;
+            TEST_ASSERT_EQUAL(inside, MATRIX_TEXT_AREA.test(LETTER_MATRIX.leds[row][column]));
+            count += inside;
+        }
+    }
+    TEST_ASSERT_EQUAL(MATRIX_FONT_HEIGHT * LETTER_MATRIX_COLUMNS, count);
+}
+
+// --- Zeichensatz ---
+
+void test_every_glyph_matches_its_rows() {
+    for (const MatrixGlyph& glyph : MATRIX_GLYPHS) {
+        size_t width = strlen(glyph.rows[0]);
+        TEST_ASSERT_EQUAL(width, matrixGlyphWidth(glyph.character));
+        for (size_t column = 0; column < width; column++) {
+            uint8_t bits = matrixGlyphColumn(glyph.character, column);
+            for (int row = 0; row < MATRIX_FONT_HEIGHT; row++) {
+                TEST_ASSERT_EQUAL(glyph.rows[row][column] == '#', (bits >> row) & 1);
+            }
+            TEST_ASSERT_EQUAL(0, bits >> MATRIX_FONT_HEIGHT);
+        }
+    }
+}
+
+void test_lowercase_and_fallback() {
+    for (char c = 'a'; c <= 'z'; c++) {
+        TEST_ASSERT_EQUAL(matrixFontIndex(c - 'a' + 'A'), matrixFontIndex(c));
+    }
+    TEST_ASSERT_EQUAL(matrixFontIndex('?'), matrixFontIndex('~'));
+    TEST_ASSERT_EQUAL(matrixFontIndex('?'), matrixFontIndex('\t'));
+    TEST_ASSERT_EQUAL(matrixFontIndex('?'), matrixFontIndex((char)0xC3));
+}
+
+void test_text_width_and_columns() {
+    TEST_ASSERT_EQUAL(0, matrixTextWidth(""));
+    TEST_ASSERT_EQUAL(5, matrixTextWidth("A"));
+    TEST_ASSERT_EQUAL(9, matrixTextWidth("21"));
+    TEST_ASSERT_EQUAL(0, matrixTextColumn("21.4", 0));
+    TEST_ASSERT_EQUAL(12, matrixTextColumn("21.4", 3));
+}
+
+// --- Lauftext ---
+
+void test_narrow_text_is_centered() {
+    MatrixText text;
+    text.setText("21");
+    text.start(1000, 120);
+    TEST_ASSERT_FALSE(text.scrolls());
+    TEST_ASSERT_EQUAL(-1, text.offsetAt(99999));
+    TEST_ASSERT_EQUAL(0, text.waitAt(1000));
+
+    char rows[LETTER_MATRIX_ROWS][LETTER_MATRIX_COLUMNS + 1];
+    maskRows(text.mask(text.offsetAt(1000)), rows);
+    static const char* const EXPECTED[LETTER_MATRIX_ROWS] = {
+        "...........",
+        "..###...#..",
+        ".#...#.##..",
+        ".....#..#..",
+        "....#...#..",
+        "...#....#..",
+        "..#.....#..",
+        ".#####.###.",
+        "...........",
+        "...........",
+    };
+    for (int row = 0; row < LETTER_MATRIX_ROWS; row++) {
+        TEST_ASSERT_EQUAL_STRING(EXPECTED[row], rows[row]);
+    }
+}
+
+void test_scroll_offset_follows_time() {
+    MatrixText text;
+    text.setText("HALLO");
+    text.start(1000, 120);
+    size_t period = text.width() + MATRIX_TEXT_GAP;
+    TEST_ASSERT_TRUE(text.scrolls());
+    TEST_ASSERT_EQUAL(matrixTextWidth("HALLO"), text.width());
+    TEST_ASSERT_EQUAL(0, text.offsetAt(1000));
+    TEST_ASSERT_EQUAL(0, text.offsetAt(1119));
+    TEST_ASSERT_EQUAL(1, text.offsetAt(1120));
+    TEST_ASSERT_EQUAL(120, text.waitAt(1000));
+    TEST_ASSERT_EQUAL(110, text.waitAt(1130));
+    // Ausgefallene Frames: der Text springt weiter statt langsamer zu werden
+    TEST_ASSERT_EQUAL(7, text.offsetAt(1000 + 7 * 120));
+    TEST_ASSERT_EQUAL(0, text.offsetAt(1000 + period * 120));
+
+    text.start(1000, 120, 6);
+    TEST_ASSERT_EQUAL(6, text.offsetAt(1000));
+    text.start(1000, 0, 6);
+    TEST_ASSERT_FALSE(text.scrolls());
+    TEST_ASSERT_EQUAL(6, text.offsetAt(5000));
+}
+
+// Spalten eines Texts direkt aus den Zeilenbildern von MATRIX_GLYPHS, ohne MATRIX_FONT
+static size_t referenceColumns(const char* text, uint8_t* columns) {
+    size_t width = 0;
+    for (size_t i = 0; text[i] != '\0'; i++) {
+        const MatrixGlyph* glyph = nullptr;
+        for (const MatrixGlyph& candidate : MATRIX_GLYPHS) {
+            if (candidate.character == text[i]) glyph = &candidate;
+        }
+        TEST_ASSERT_NOT_NULL(glyph);
+        if (i > 0) columns[width++] = 0;
+        for (size_t column = 0; glyph->rows[0][column] != '\0'; column++) {
+            uint8_t bits = 0;
+            for (int row = 0; row < MATRIX_FONT_HEIGHT; row++) {
+                if (glyph->rows[row][column] == '#') bits |= 1 << row;
+            }
+            columns[width++] = bits;
+        }
+    }
+    return width;
+}
+
+void test_scroll_window_and_wrap() {
+    uint8_t reference[64];
+    size_t width = referenceColumns("HALLO", reference);
+    MatrixText text;
+    text.setText("HALLO");
+    text.start(0, 120);
+    TEST_ASSERT_EQUAL(width, text.width());
+    int period = width + MATRIX_TEXT_GAP;
+    for (int offset = 0; offset < period; offset++) {
+        LedMask mask = text.mask(offset);
+        TEST_ASSERT_TRUE((mask & MATRIX_TEXT_AREA) == mask);
+        // Spalte c des Fensters zeigt die Textspalte (offset + c) mod Periode, in der Lücke ist sie dunkel
+        for (int column = 0; column < LETTER_MATRIX_COLUMNS; column++) {
+            size_t textColumn = (offset + column) % period;
+            uint8_t expected = textColumn < width ? reference[textColumn] : 0;
+            for (int row = 0; row < MATRIX_FONT_HEIGHT; row++) {
+                bool lit = mask.test(LETTER_MATRIX.leds[MATRIX_TEXT_TOP + row][column]);
+                TEST_ASSERT_EQUAL((expected >> row) & 1, lit);
+            }
+        }
+    }
+}
+
+void test_long_text_is_truncated() {
+    char longText[200];
+    memset(longText, 'W', sizeof(longText) - 1);
+    longText[sizeof(longText) - 1] = '\0';
+    MatrixText text;
+    text.setText(longText);
+    TEST_ASSERT_LESS_OR_EQUAL(MATRIX_TEXT_MAX_COLUMNS, text.width());
+    TEST_ASSERT_EQUAL(32 * 6 - 1, text.width()); // 32 ganze Zeichen
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_serpentine_mapping);
+    RUN_TEST(test_mapping_is_bijective);
+    RUN_TEST(test_words_read_left_to_right);
+    RUN_TEST(test_text_area_rows);
+    RUN_TEST(test_every_glyph_matches_its_rows);
+    RUN_TEST(test_lowercase_and_fallback);
+    RUN_TEST(test_text_width_and_columns);
+    RUN_TEST(test_narrow_text_is_centered);
+    RUN_TEST(test_scroll_offset_follows_time);
+    RUN_TEST(test_scroll_window_and_wrap);
+    RUN_TEST(test_long_text_is_truncated);
+    return UNITY_END();
+}
@@ -0,0 +1,172 @@
+// Lokale Uhr (clock/LocalClock.h): Synchronisation, Weiterlaufen ohne NTP, Messung der Gangabweichung und
+// Sprünge. Die Zeit von millis() und die wahre Zeit werden vorgegeben, NTP liefert ganze Sekunden.
+//
+//   pio test -e native -f test_local_clock
+
+#include <unity.h>
+#include "clock/LocalClock.h"
+
+void setUp() {}
+void tearDown() {}
+
+const uint32_t EPOCH = 1760000000;              // Beliebige Startzeit (ganze Sekunde)
+const uint32_t HOUR_MS = 3600UL * 1000UL;
+
+// millis() mit einer Gangabweichung gegenüber der wahren Zeit: trueMs(localMs) liefert die wahre Zeit in ms
+// seit EPOCH, wenn millis() localMs zeigt (positiv = millis() läuft zu langsam, wie driftPpm in ClockQuality)
+struct DriftingMillis {
+    int32_t driftPpm;
+    uint64_t trueMs(uint32_t localMs) const {
+        return localMs + (int64_t)localMs * driftPpm / 1000000;
+    }
+    // NTP liefert die abgeschnittene Sekunde der wahren Zeit
+    uint32_t ntpSeconds(uint32_t localMs) const {
+        return EPOCH + (uint32_t)(trueMs(localMs) / 1000);
+    }
+};
+
+static int64_t clockErrorMs(const LocalClock& clock, const DriftingMillis& millis, uint32_t localMs) {
+    return (int64_t)clock.nowEpochMs(localMs) - (int64_t)((uint64_t)EPOCH * 1000 + millis.trueMs(localMs));
+}
+
+// Angezeigte Wörter wie in der Anzeige-Task: die Wortuhr wechselt alle fünf Minuten
+static uint32_t faceAt(uint32_t epochTime) {
+    return epochTime % 86400 / 300;
+}
+
+void test_first_sync_sets_clock() {
+    LocalClock clock;
+    TEST_ASSERT_FALSE(clock.isValid());
+    TEST_ASSERT_FALSE(clock.getQuality(0).valid);
+
+    TEST_ASSERT_EQUAL(0, clock.sync(EPOCH, 1000));
+    TEST_ASSERT_TRUE(clock.isValid());
+    TEST_ASSERT_TRUE(clock.isSynced());
+    // Die wahre Zeit liegt in der abgeschnittenen Sekunde, angenommen wird deren Mitte
+    TEST_ASSERT_EQUAL_UINT64((uint64_t)EPOCH * 1000 + LOCAL_CLOCK_SYNC_ERROR_MS, clock.nowEpochMs(1000));
+    TEST_ASSERT_EQUAL(EPOCH + 10, clock.now(11000));
+
+    ClockQuality quality = clock.getQuality(11000);
+    TEST_ASSERT_TRUE(quality.synced);
+    TEST_ASSERT_FALSE(quality.driftMeasured);
+    TEST_ASSERT_EQUAL(10, quality.secondsSinceSync);
+    TEST_ASSERT_EQUAL(LOCAL_CLOCK_SYNC_ERROR_MS + 10000LL * LOCAL_CLOCK_UNKNOWN_DRIFT_PPB / 1000000000LL,
+                      quality.estimatedErrorMs);
+}
+
+void test_face_keeps_advancing_through_outage() {
+    // millis() läuft 30 ppm zu langsam, NTP fällt nach der ersten Synchronisation für 8 Stunden aus
+    DriftingMillis millis = { 30 };
+    LocalClock clock;
+    clock.sync(millis.ntpSeconds(0), 0);
+
+    int faceChanges = 0;
+    uint32_t shown = faceAt(clock.now(0));
+    for (uint32_t localMs = 0; localMs <= 8 * HOUR_MS; localMs += 1000) {
+        ClockQuality quality = clock.getQuality(localMs);
+        int64_t errorMs = clockErrorMs(clock, millis, localMs);
+        // Die Uhr läuft weiter und bleibt innerhalb ihres geschätzten Fehlers
+        TEST_ASSERT_TRUE(quality.valid);
+        TEST_ASSERT_LESS_OR_EQUAL(quality.estimatedErrorMs, errorMs < 0 ? -errorMs : errorMs);
+
+        uint32_t face = faceAt(clock.now(localMs));
+        if (face != shown) {
+            faceChanges++;
+            shown = face;
+        }
+    }
+    // Alle fünf Minuten neue Wörter: 8 Stunden = 96 Wechsel (±1 je nach Lage der Startzeit)
+    TEST_ASSERT_INT_WITHIN(1, 96, faceChanges);
+
+    // Der geschätzte Fehler wächst mit der Zeit ohne Synchronisation
+    ClockQuality quality = clock.getQuality(8 * HOUR_MS);
+    TEST_ASSERT_EQUAL(8 * 3600, quality.secondsSinceSync);
+    TEST_ASSERT_EQUAL(LOCAL_CLOCK_SYNC_ERROR_MS + 8 * 3600 * (LOCAL_CLOCK_UNKNOWN_DRIFT_PPB / 1000) / 1000,
+                      quality.estimatedErrorMs);
+}
+
+void test_drift_measured_after_window() {
+    // millis() läuft 150 ppm zu langsam, NTP alle 10 Minuten
+    DriftingMillis millis = { 150 };
+    LocalClock clock;
+    uint32_t localMs = 0;
+    for (; localMs < LOCAL_CLOCK_DRIFT_WINDOW_MS; localMs += 600000) {
+        clock.sync(millis.ntpSeconds(localMs), localMs);
+        TEST_ASSERT_FALSE(clock.getQuality(localMs).driftMeasured);
+    }
+    clock.sync(millis.ntpSeconds(localMs), localMs);
+
+    ClockQuality quality = clock.getQuality(localMs);
+    TEST_ASSERT_TRUE(quality.driftMeasured);
+    // ±0.5 s an beiden Enden des Messfensters von 6 h: höchstens ±46 ppm
+    TEST_ASSERT_FLOAT_WITHIN(47.0f, 150.0f, quality.driftPpm);
+
+    // Danach 4 Stunden ohne NTP: innerhalb des geschätzten Fehlers und genauer als unkorrigiert (150 ppm = 2.16 s)
+    uint32_t outageEndMs = localMs + 4 * HOUR_MS;
+    int64_t errorMs = clockErrorMs(clock, millis, outageEndMs);
+    quality = clock.getQuality(outageEndMs);
+    TEST_ASSERT_LESS_OR_EQUAL(quality.estimatedErrorMs, errorMs < 0 ? -errorMs : errorMs);
+    TEST_ASSERT_LESS_THAN(2160, errorMs < 0 ? -errorMs : errorMs);
+}
+
+void test_small_correction_is_eased() {
+    LocalClock clock;
+    clock.sync(EPOCH, 0);
+    // NTP meldet 1 s mehr als erwartet: unter der Schwelle, die Hälfte wird übernommen
+    uint32_t localMs = 60000;
+    uint64_t before = clock.nowEpochMs(localMs);
+    int32_t correction = clock.sync(EPOCH + 62, localMs + 1000);
+    TEST_ASSERT_EQUAL(1000, correction);
+    TEST_ASSERT_EQUAL_UINT64(before + 1000 + correction / 2, clock.nowEpochMs(localMs + 1000));
+}
+
+void test_large_correction_steps() {
+    DriftingMillis millis = { 150 };
+    LocalClock clock;
+    uint32_t localMs = 0;
+    for (; localMs <= LOCAL_CLOCK_DRIFT_WINDOW_MS; localMs += 600000) {
+        clock.sync(millis.ntpSeconds(localMs), localMs);
+    }
+    TEST_ASSERT_TRUE(clock.getQuality(localMs).driftMeasured);
+
+    // Eine Stunde Sprung (z.B. Sommerzeit): über der Schwelle, übernommen und die Messung verworfen
+    uint32_t ntp = millis.ntpSeconds(localMs) + 3600;
+    int32_t correction = clock.sync(ntp, localMs);
+    TEST_ASSERT_INT_WITHIN(LOCAL_CLOCK_STEP_THRESHOLD_MS, 3600000, correction);
+    TEST_ASSERT_EQUAL_UINT64((uint64_t)ntp * 1000 + LOCAL_CLOCK_SYNC_ERROR_MS, clock.nowEpochMs(localMs));
+    ClockQuality quality = clock.getQuality(localMs);
+    TEST_ASSERT_FALSE(quality.driftMeasured);
+    TEST_ASSERT_EQUAL(0, (int)quality.driftPpm);
+
+    // Knapp über der Schwelle von 2 s springt die Uhr ebenfalls, knapp darunter nicht
+    LocalClock small;
+    small.sync(EPOCH, 0);
+    TEST_ASSERT_EQUAL(2000, small.sync(EPOCH + 12, 10000));
+    TEST_ASSERT_EQUAL_UINT64((uint64_t)(EPOCH + 11) * 1000 + LOCAL_CLOCK_SYNC_ERROR_MS, small.nowEpochMs(10000));
+    LocalClock large;
+    large.sync(EPOCH, 0);
+    TEST_ASSERT_EQUAL(3000, large.sync(EPOCH + 13, 10000));
+    TEST_ASSERT_EQUAL_UINT64((uint64_t)(EPOCH + 13) * 1000 + LOCAL_CLOCK_SYNC_ERROR_MS, large.nowEpochMs(10000));
+}
+
+void test_seed_then_sync() {
+    // Warmstart: Zeit mit grossem Anfangsfehler, die erste Synchronisation übernimmt ohne Schwelle
+    LocalClock clock;
+    clock.seed(EPOCH, 0, 60000);
+    TEST_ASSERT_TRUE(clock.isValid());
+    TEST_ASSERT_FALSE(clock.isSynced());
+    TEST_ASSERT_EQUAL(60000, clock.getQuality(0).estimatedErrorMs);
+    TEST_ASSERT_EQUAL(-20000 + (int32_t)LOCAL_CLOCK_SYNC_ERROR_MS, clock.sync(EPOCH - 10, 10000));
+    TEST_ASSERT_TRUE(clock.isSynced());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_sync_sets_clock);
+    RUN_TEST(test_face_keeps_advancing_through_outage);
+    RUN_TEST(test_drift_measured_after_window);
+    RUN_TEST(test_small_correction_is_eased);
+    RUN_TEST(test_large_correction_steps);
+    RUN_TEST(test_seed_then_sync);
+    return UNITY_END();
+}
@@ -0,0 +1,121 @@
+// Energie-Policy (power/PowerPolicy.h): Wechsel zwischen aktiv, bereit und Light-Sleep je nach Gerätezustand,
+// das Nachlaufen nach einer Client-Anfrage (kein Schlaf, kurzes Abfrageintervall) und die Zeiterfassung je Zustand.
+//
+//   pio test -e native -f test_power_policy
+
+#include <unity.h>
+#include "power/PowerPolicy.h"
+
+static const PowerPolicyConfig CONFIG = { 30000, 10, 100, true };
+
+// Verbunden, nichts zu tun, noch keine Client-Anfrage
+static PowerInputs idleStation() {
+    PowerInputs inputs;
+    inputs.stationConnected = true;
+    inputs.wifiConnecting = false;
+    inputs.accessPointActive = false;
+    inputs.apiRequestActive = false;
+    inputs.msSinceClientRequest = ULONG_MAX;
+    return inputs;
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_idle_station_sleeps() {
+    PowerDecision decision = decidePowerMode(idleStation(), CONFIG);
+    TEST_ASSERT_EQUAL(POWER_MODE_LIGHT_SLEEP, decision.mode);
+    TEST_ASSERT_TRUE(decision.modemSleep);
+    TEST_ASSERT_EQUAL(100, decision.clientPollMs);
+
+    // Ohne Light-Sleep in der Plattform nur bereit, Modem-Sleep bleibt
+    PowerPolicyConfig noLightSleep = CONFIG;
+    noLightSleep.lightSleepSupported = false;
+    decision = decidePowerMode(idleStation(), noLightSleep);
+    TEST_ASSERT_EQUAL(POWER_MODE_IDLE, decision.mode);
+    TEST_ASSERT_TRUE(decision.modemSleep);
+
+    // Ohne Station kein Modem-Sleep
+    PowerInputs offline = idleStation();
+    offline.stationConnected = false;
+    TEST_ASSERT_FALSE(decidePowerMode(offline, CONFIG).modemSleep);
+}
+
+void test_network_work_is_active() {
+    // API-Abfrage und Verbindungsaufbau gehen jedem anderen Zustand vor
+    PowerInputs inputs = idleStation();
+    inputs.apiRequestActive = true;
+    inputs.accessPointActive = true;
+    inputs.msSinceClientRequest = 0;
+    PowerDecision decision = decidePowerMode(inputs, CONFIG);
+    TEST_ASSERT_EQUAL(POWER_MODE_ACTIVE, decision.mode);
+    TEST_ASSERT_FALSE(decision.modemSleep);
+
+    inputs = idleStation();
+    inputs.stationConnected = false;
+    inputs.wifiConnecting = true;
+    decision = decidePowerMode(inputs, CONFIG);
+    TEST_ASSERT_EQUAL(POWER_MODE_ACTIVE, decision.mode);
+    TEST_ASSERT_FALSE(decision.modemSleep);
+}
+
+void test_access_point_stays_awake() {
+    PowerInputs inputs = idleStation();
+    inputs.stationConnected = false;
+    inputs.accessPointActive = true;
+    PowerDecision decision = decidePowerMode(inputs, CONFIG);
+    TEST_ASSERT_EQUAL(POWER_MODE_IDLE, decision.mode);
+    TEST_ASSERT_FALSE(decision.modemSleep);
+    // Das Portal wird auch ohne vorherige Anfrage schnell bedient
+    TEST_ASSERT_EQUAL(10, decision.clientPollMs);
+}
+
+void test_client_request_holds_off_sleep() {
+    // Nach einer Anfrage bleibt das Gerät clientActiveMs lang reaktionsschnell, danach schläft es wieder
+    PowerInputs inputs = idleStation();
+    const unsigned long since[] = { 0, 1, 15000, CONFIG.clientActiveMs - 1 };
+    for (unsigned long ms : since) {
+        inputs.msSinceClientRequest = ms;
+        PowerDecision decision = decidePowerMode(inputs, CONFIG);
+        TEST_ASSERT_EQUAL(POWER_MODE_IDLE, decision.mode);
+        TEST_ASSERT_FALSE(decision.modemSleep);
+        TEST_ASSERT_EQUAL(10, decision.clientPollMs);
+    }
+
+    inputs.msSinceClientRequest = CONFIG.clientActiveMs;
+    PowerDecision decision = decidePowerMode(inputs, CONFIG);
+    TEST_ASSERT_EQUAL(POWER_MODE_LIGHT_SLEEP, decision.mode);
+    TEST_ASSERT_TRUE(decision.modemSleep);
+    TEST_ASSERT_EQUAL(100, decision.clientPollMs);
+}
+
+void test_state_times_follow_transitions() {
+    PowerStateTimes times;
+    times.enter(POWER_MODE_ACTIVE, false, 1000);
+    times.enter(POWER_MODE_LIGHT_SLEEP, true, 1500);
+    times.enter(POWER_MODE_IDLE, false, 4500);
+    TEST_ASSERT_EQUAL(2, times.getTransitionCount());
+
+    // Die laufende Phase zählt mit
+    TEST_ASSERT_EQUAL(500, (int)times.getTimeMs(POWER_MODE_ACTIVE, 5000));
+    TEST_ASSERT_EQUAL(3000, (int)times.getTimeMs(POWER_MODE_LIGHT_SLEEP, 5000));
+    TEST_ASSERT_EQUAL(500, (int)times.getTimeMs(POWER_MODE_IDLE, 5000));
+    TEST_ASSERT_EQUAL(3000, (int)times.getModemSleepTimeMs(5000));
+
+    // Über den Überlauf von millis() hinweg
+    PowerStateTimes wrapped;
+    wrapped.enter(POWER_MODE_LIGHT_SLEEP, true, ULONG_MAX - 99);
+    TEST_ASSERT_EQUAL(300, (int)wrapped.getTimeMs(POWER_MODE_LIGHT_SLEEP, 200));
+    TEST_ASSERT_EQUAL(0, (int)wrapped.getTimeMs(POWER_MODE_ACTIVE, 200));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_idle_station_sleeps);
+    RUN_TEST(test_network_work_is_active);
+    RUN_TEST(test_access_point_stays_awake);
+    RUN_TEST(test_client_request_holds_off_sleep);
+    RUN_TEST(test_state_times_follow_transitions);
+    return UNITY_END();
+}
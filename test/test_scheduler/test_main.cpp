@@ -0,0 +1,83 @@
+// Scheduler (scheduler/Scheduler.h) mit einer vorgegebenen Uhr: Reihenfolge und Taktung der Jobs, beendete Jobs
+// sowie zu kurze Intervalle.
+//
+//   pio test -e native -f test_scheduler
+
+#include <unity.h>
+#include "scheduler/Scheduler.h"
+
+static unsigned long nowMs;
+static int fastRuns;
+static int slowRuns;
+static int oneShotRuns;
+
+static unsigned long virtualMillis() { return nowMs; }
+
+static void fastJob() { fastRuns++; }
+static void slowJob() { slowRuns++; }
+static void oneShotJob() { oneShotRuns++; }
+
+void setUp() {
+    nowMs = 1000;
+    fastRuns = 0;
+    slowRuns = 0;
+    oneShotRuns = 0;
+}
+
+void tearDown() {}
+
+// runDue() wie die loop(), jede Millisekunde
+static void runFor(Scheduler& scheduler, unsigned long durationMs) {
+    unsigned long end = nowMs + durationMs;
+    while (nowMs < end) {
+        nowMs++;
+        scheduler.runDue();
+    }
+}
+
+void test_periodic_jobs_keep_their_interval() {
+    Scheduler scheduler(virtualMillis);
+    scheduler.addPeriodic("fast", 10, fastJob);
+    JobId slow = scheduler.addPeriodic("slow", 100, slowJob, 50);
+    runFor(scheduler, 1000);
+    TEST_ASSERT_EQUAL(101, fastRuns);
+    TEST_ASSERT_EQUAL(10, slowRuns);
+    TEST_ASSERT_EQUAL(10, (int)scheduler.getStats(slow)->runs);
+}
+
+void test_cancelled_and_finished_jobs_stay_off() {
+    Scheduler scheduler(virtualMillis);
+    JobId fast = scheduler.addPeriodic("fast", 10, fastJob);
+    scheduler.addOneShot("once", 5, oneShotJob);
+    runFor(scheduler, 50);
+    scheduler.cancel(fast);
+    int runs = fastRuns;
+    runFor(scheduler, 100);
+    TEST_ASSERT_EQUAL(runs, fastRuns);
+    TEST_ASSERT_EQUAL(1, oneShotRuns);
+}
+
+void test_zero_interval_is_clamped() {
+    // Ein Intervall von 0 (z.B. aus einer leeren Eingabe) darf runDue() nicht endlos wiederholen
+    Scheduler scheduler(virtualMillis);
+    JobId zero = scheduler.addPeriodic("zero", 0, fastJob);
+    TEST_ASSERT_NOT_EQUAL(SCHEDULER_INVALID_JOB, zero);
+    TEST_ASSERT_EQUAL(1, scheduler.runDue());
+    TEST_ASSERT_EQUAL(0, scheduler.runDue());
+    runFor(scheduler, 100);
+    TEST_ASSERT_EQUAL(1 + 100 / SCHEDULER_MIN_INTERVAL_MS, fastRuns);
+
+    // setInterval() hebt 0 ebenso an, statt den Aufruf zu ignorieren
+    JobId slow = scheduler.addPeriodic("slow", 100, slowJob);
+    scheduler.setInterval(slow, 0);
+    runFor(scheduler, 100);
+    TEST_ASSERT_EQUAL(100 / SCHEDULER_MIN_INTERVAL_MS, slowRuns);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_periodic_jobs_keep_their_interval);
+    RUN_TEST(test_cancelled_and_finished_jobs_stay_off);
+    RUN_TEST(test_zero_interval_is_clamped);
+    return UNITY_END();
+}
@@ -0,0 +1,315 @@
+// WLAN-Aufbau (webservice/wifi/WifiConnection.h) mit einem simulierten Treiber und einer vorgegebenen Zeit:
+// Verbinden, Trennen, Schnellweg mit veralteten Daten, neuer Versuch nach Abbruch und Fehlschlag, nach dem
+// der Aufrufer in den Konfigurations-AP wechselt.
+//
+//   pio test -e native -f test_wifi_connection
+
+#include <unity.h>
+#include <string.h>
+#include "webservice/wifi/WifiConnection.h"
+
+const unsigned long FAST_TIMEOUT_MS = 3000;
+const unsigned long NETWORK_TIMEOUT_MS = 10000;
+
+// Simulierter Treiber: merkt sich die Aufrufe, verbindet aber nie selbst
+static unsigned long nowMs;
+static int clockReads;
+static int starts;
+static int stops;
+static char lastSsid[33];
+static bool lastWithHint;
+
+static unsigned long fakeClock() {
+    clockReads++;
+    return nowMs;
+}
+
+static void fakeStartStation(const char* ssid, const char*, const WifiFastConnectHint* hint) {
+    starts++;
+    strncpy(lastSsid, ssid, sizeof(lastSsid) - 1);
+    lastWithHint = hint != nullptr;
+}
+
+static void fakeStopStation() {
+    stops++;
+}
+
+static const WifiDriver FAKE_DRIVER = { fakeStartStation, fakeStopStation };
+
+static const char* const SSIDS[] = { "Wohnung", "", "Werkstatt" };
+static const char* const PASSWORDS[] = { "geheim1", "", "geheim2" };
+
+void setUp() {
+    nowMs = 1000;
+    clockReads = 0;
+    starts = 0;
+    stops = 0;
+    lastSsid[0] = '\0';
+    lastWithHint = false;
+}
+
+void tearDown() {}
+
+static WifiFastConnectHint hintFor(const char* ssid) {
+    WifiFastConnectHint hint;
+    memset(&hint, 0, sizeof(hint));
+    hint.valid = true;
+    strncpy(hint.ssid, ssid, sizeof(hint.ssid) - 1);
+    hint.channel = 6;
+    return hint;
+}
+
+// update() im Takt des Netzwerk-Jobs bis zu einem Übergang oder bis zum Ablauf von durationMs aufrufen
+static WifiTransition runFor(WifiConnection& wifi, unsigned long durationMs, unsigned long stepMs = 100) {
+    unsigned long end = nowMs + durationMs;
+    while (nowMs < end) {
+        nowMs += stepMs;
+        WifiTransition transition = wifi.update();
+        if (transition != WIFI_TRANSITION_NONE) {
+            return transition;
+        }
+    }
+    return WIFI_TRANSITION_NONE;
+}
+
+void test_connect_and_disconnect() {
+    WifiConnection wifi(FAKE_DRIVER, fakeClock);
+    wifi.setNetworks(SSIDS, PASSWORDS, 3);
+    TEST_ASSERT_EQUAL(WIFI_STATE_IDLE, wifi.getState());
+    TEST_ASSERT_EQUAL_STRING("Werkstatt", wifi.getNetworkSsid(1));
+
+    wifi.connect(FAST_TIMEOUT_MS, NETWORK_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL(WIFI_STATE_CONNECTING, wifi.getState());
+    TEST_ASSERT_EQUAL(1, starts);
+    TEST_ASSERT_EQUAL_STRING("Wohnung", lastSsid);
+    TEST_ASSERT_FALSE(lastWithHint);
+
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_NONE, runFor(wifi, 1500));
+    wifi.onGotIp();
+    nowMs += 100;
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_CONNECTED, wifi.update());
+    TEST_ASSERT_EQUAL(WIFI_STATE_CONNECTED, wifi.getState());
+    TEST_ASSERT_EQUAL(1600, wifi.getLastConnectDurationMs());
+    TEST_ASSERT_FALSE(wifi.wasFastConnect());
+    TEST_ASSERT_EQUAL(0, wifi.getConnectedNetwork());
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_NONE, runFor(wifi, 60000));
+
+    wifi.disconnect();
+    TEST_ASSERT_EQUAL(WIFI_STATE_IDLE, wifi.getState());
+    // Ein Ereignis nach dem Trennen ändert nichts mehr
+    wifi.onDisconnected(8);
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_NONE, runFor(wifi, 60000));
+    TEST_ASSERT_EQUAL(WIFI_STATE_IDLE, wifi.getState());
+    TEST_ASSERT_EQUAL(1, starts);
+}
+
+void test_fast_connect_with_hint() {
+    WifiConnection wifi(FAKE_DRIVER, fakeClock);
+    wifi.setNetworks(SSIDS, PASSWORDS, 3);
+    wifi.setFastConnectHint(hintFor("Werkstatt"));
+    wifi.connect(FAST_TIMEOUT_MS, NETWORK_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL_STRING("Werkstatt", lastSsid);
+    TEST_ASSERT_TRUE(lastWithHint);
+
+    nowMs += 300;
+    wifi.onGotIp();
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_CONNECTED, wifi.update());
+    TEST_ASSERT_TRUE(wifi.wasFastConnect());
+    TEST_ASSERT_EQUAL(1, wifi.getConnectedNetwork());
+    TEST_ASSERT_EQUAL(300, wifi.getLastConnectDurationMs());
+}
+
+void test_stale_hint_falls_back_to_networks() {
+    WifiConnection wifi(FAKE_DRIVER, fakeClock);
+    wifi.setNetworks(SSIDS, PASSWORDS, 3);
+    wifi.setFastConnectHint(hintFor("Werkstatt"));
+    wifi.connect(FAST_TIMEOUT_MS, NETWORK_TIMEOUT_MS);
+    TEST_ASSERT_TRUE(lastWithHint);
+
+    // Schnellweg läuft in den Timeout: weiter mit dem ersten Netzwerk, normal über DHCP
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_NONE, runFor(wifi, FAST_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL(2, starts);
+    TEST_ASSERT_EQUAL_STRING("Wohnung", lastSsid);
+    TEST_ASSERT_FALSE(lastWithHint);
+
+    wifi.onGotIp();
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_CONNECTED, runFor(wifi, 100));
+    TEST_ASSERT_FALSE(wifi.wasFastConnect());
+    TEST_ASSERT_EQUAL(0, wifi.getConnectedNetwork());
+
+    // Der verworfene Hinweis wird beim Reconnect nicht mehr verwendet
+    wifi.onDisconnected(201);
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_LOST, runFor(wifi, 100));
+    TEST_ASSERT_EQUAL(WIFI_STATE_RECONNECTING, wifi.getState());
+    TEST_ASSERT_EQUAL_STRING("Wohnung", lastSsid);
+    TEST_ASSERT_FALSE(lastWithHint);
+}
+
+void test_fast_path_abort_skips_timeout() {
+    WifiConnection wifi(FAKE_DRIVER, fakeClock);
+    wifi.setNetworks(SSIDS, PASSWORDS, 3);
+    wifi.setFastConnectHint(hintFor("Wohnung"));
+    wifi.connect(FAST_TIMEOUT_MS, NETWORK_TIMEOUT_MS);
+
+    // Ein Abbruch auf dem Schnellweg (z.B. Kanal geändert) wartet nicht auf den Timeout
+    wifi.onDisconnected(201);
+    nowMs += 100;
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_NONE, wifi.update());
+    TEST_ASSERT_EQUAL(2, starts);
+    TEST_ASSERT_EQUAL_STRING("Wohnung", lastSsid);
+    TEST_ASSERT_FALSE(lastWithHint);
+}
+
+void test_abort_retries_same_network() {
+    WifiConnection wifi(FAKE_DRIVER, fakeClock);
+    wifi.setNetworks(SSIDS, PASSWORDS, 3);
+    wifi.connect(FAST_TIMEOUT_MS, NETWORK_TIMEOUT_MS);
+
+    // AP nicht gefunden: nach der Wartezeit ein neuer Versuch mit demselben Netzwerk
+    wifi.onDisconnected(201);
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_NONE, runFor(wifi, 900));
+    TEST_ASSERT_EQUAL(1, starts);
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_NONE, runFor(wifi, 200));
+    TEST_ASSERT_EQUAL(2, starts);
+    TEST_ASSERT_EQUAL_STRING("Wohnung", lastSsid);
+
+    // Der neue Versuch verlängert den Timeout nicht: nach 10 s seit dem ersten Start kommt das nächste Netzwerk
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_NONE, runFor(wifi, NETWORK_TIMEOUT_MS - 1100));
+    TEST_ASSERT_EQUAL(3, starts);
+    TEST_ASSERT_EQUAL_STRING("Werkstatt", lastSsid);
+
+    wifi.onGotIp();
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_CONNECTED, runFor(wifi, 100));
+    TEST_ASSERT_EQUAL(1, wifi.getConnectedNetwork());
+}
+
+void test_all_networks_fail() {
+    WifiConnection wifi(FAKE_DRIVER, fakeClock);
+    wifi.setNetworks(SSIDS, PASSWORDS, 3);
+    wifi.setFastConnectHint(hintFor("Werkstatt"));
+    wifi.connect(FAST_TIMEOUT_MS, NETWORK_TIMEOUT_MS);
+
+    // Schnellweg und beide Netzwerke laufen in den Timeout, dann meldet update() den Fehlschlag einmal
+    unsigned long start = nowMs;
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_FAILED, runFor(wifi, 60000));
+    TEST_ASSERT_EQUAL(FAST_TIMEOUT_MS + 2 * NETWORK_TIMEOUT_MS, nowMs - start);
+    TEST_ASSERT_EQUAL(3, starts);
+    TEST_ASSERT_EQUAL(WIFI_STATE_FAILED, wifi.getState());
+    // Der Treiber ist gestoppt, damit der Aufrufer den Konfigurations-AP starten kann
+    int stopsAtFailure = stops;
+    TEST_ASSERT_TRUE(stopsAtFailure > 0);
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_NONE, runFor(wifi, 60000));
+    TEST_ASSERT_EQUAL(3, starts);
+    TEST_ASSERT_EQUAL(stopsAtFailure, stops);
+
+    // Ein neuer Aufbau aus dem AP heraus beginnt wieder von vorne
+    wifi.connect(FAST_TIMEOUT_MS, NETWORK_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL(WIFI_STATE_CONNECTING, wifi.getState());
+    TEST_ASSERT_EQUAL_STRING("Wohnung", lastSsid);
+}
+
+void test_no_networks_fails_at_once() {
+    static const char* const EMPTY[] = { "" };
+    WifiConnection wifi(FAKE_DRIVER, fakeClock);
+    wifi.setNetworks(EMPTY, EMPTY, 1);
+    wifi.connect(FAST_TIMEOUT_MS, NETWORK_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL(0, starts);
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_FAILED, wifi.update());
+}
+
+void test_lost_connection_reconnects() {
+    WifiConnection wifi(FAKE_DRIVER, fakeClock);
+    wifi.setNetworks(SSIDS, PASSWORDS, 3);
+    wifi.connect(FAST_TIMEOUT_MS, NETWORK_TIMEOUT_MS);
+    wifi.onGotIp();
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_CONNECTED, runFor(wifi, 100));
+
+    wifi.onDisconnected(8);
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_LOST, runFor(wifi, 100));
+    TEST_ASSERT_EQUAL(WIFI_STATE_RECONNECTING, wifi.getState());
+    TEST_ASSERT_EQUAL(2, starts);
+
+    wifi.onGotIp();
+    nowMs += 2500;
+    TEST_ASSERT_EQUAL(WIFI_TRANSITION_CONNECTED, wifi.update());
+    TEST_ASSERT_EQUAL(2500, wifi.getLastConnectDurationMs());
+}
+
+void test_update_never_blocks() {
+    // update() wartet nie: die Zeit steht während des Aufrufs, sie wird nur wenige Male gelesen (kein Abfragen
+    // in einer Schleife) und der Treiber wird höchstens einmal gestartet, was den Aufbau nur anstösst
+    WifiConnection wifi(FAKE_DRIVER, fakeClock);
+    wifi.setNetworks(SSIDS, PASSWORDS, 3);
+    wifi.setFastConnectHint(hintFor("Werkstatt"));
+    wifi.connect(FAST_TIMEOUT_MS, NETWORK_TIMEOUT_MS);
+
+    for (int step = 0; step < 500; step++) {
+        if (step == 37) wifi.onDisconnected(201);
+        if (step == 120) wifi.onDisconnected(201);
+        if (step == 300) wifi.onGotIp();
+        if (step == 400) wifi.onDisconnected(8);
+
+        nowMs += 100;
+        int readsBefore = clockReads;
+        int startsBefore = starts;
+        unsigned long before = nowMs;
+        wifi.update();
+        TEST_ASSERT_LESS_OR_EQUAL(3, clockReads - readsBefore);
+        TEST_ASSERT_LESS_OR_EQUAL(1, starts - startsBefore);
+        TEST_ASSERT_EQUAL(before, nowMs);
+    }
+}
+
+void test_rank_networks_by_rssi() {
+    int8_t rssi[] = { -70, WIFI_RSSI_UNKNOWN, -55 };
+    uint8_t order[3];
+    rankWifiNetworks(rssi, 3, order);
+    TEST_ASSERT_EQUAL(2, order[0]);
+    TEST_ASSERT_EQUAL(0, order[1]);
+    TEST_ASSERT_EQUAL(1, order[2]);
+
+    // Gleiche RSSI: konfigurierte Reihenfolge bleibt
+    int8_t same[] = { -60, -60, -60 };
+    rankWifiNetworks(same, 3, order);
+    TEST_ASSERT_EQUAL(0, order[0]);
+    TEST_ASSERT_EQUAL(1, order[1]);
+    TEST_ASSERT_EQUAL(2, order[2]);
+}
+
+void test_lease_limits_static_ip() {
+    const uint32_t now = 1760000000UL;
+    WifiFastConnectHint hint = hintFor("Wohnung");
+    hint.ip = 0x0A01A8C0;
+    hint.leaseExpiry = now + 3600;
+    TEST_ASSERT_TRUE(wifiLeaseValid(hint, now));
+
+    // Kurz vor und nach dem Ablauf wieder DHCP
+    TEST_ASSERT_FALSE(wifiLeaseValid(hint, now + 3600 - WIFI_LEASE_MARGIN_SEC));
+    TEST_ASSERT_FALSE(wifiLeaseValid(hint, now + 7200));
+
+    // Ohne gestellte Uhr lässt sich der Lease nicht prüfen
+    TEST_ASSERT_FALSE(wifiLeaseValid(hint, 120));
+
+    // Unbekannter Lease oder keine gespeicherte Adresse
+    hint.leaseExpiry = 0;
+    TEST_ASSERT_FALSE(wifiLeaseValid(hint, now));
+    hint.leaseExpiry = now + 3600;
+    hint.ip = 0;
+    TEST_ASSERT_FALSE(wifiLeaseValid(hint, now));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_connect_and_disconnect);
+    RUN_TEST(test_fast_connect_with_hint);
+    RUN_TEST(test_stale_hint_falls_back_to_networks);
+    RUN_TEST(test_fast_path_abort_skips_timeout);
+    RUN_TEST(test_abort_retries_same_network);
+    RUN_TEST(test_all_networks_fail);
+    RUN_TEST(test_no_networks_fails_at_once);
+    RUN_TEST(test_lost_connection_reconnects);
+    RUN_TEST(test_update_never_blocks);
+    RUN_TEST(test_rank_networks_by_rssi);
+    RUN_TEST(test_lease_limits_static_ip);
+    return UNITY_END();
+}
@@ -0,0 +1,90 @@
+// Wortuhr (display/WordClockLayout.h): alle 1440 Minuten gegen die Masken des früheren Renderers in
+// UpdateDisplay::updateTime(), der die LED-Bereiche mit if/else direkt gesetzt hat.
+//
+//   pio test -e native -f test_word_clock
+
+#include <unity.h>
+#include <stdio.h>
+#include "display/WordClockLayout.h"
+
+void setUp() {}
+void tearDown() {}
+
+// Früherer Renderer mit seinen LED-Bereichen, unverändert übernommen
+static LedMask goldenMask(int hour, int min) {
+    LedMask mask = LedMask::range(21, 2) | LedMask::range(16, 4); // ES ISCH
+
+    if ((min >= 5 && min <= 9) || (min >= 25 && min <= 29) || (min >= 35 && min <= 39) || (min >= 55 && min <= 59)) {
+        mask = mask | LedMask::range(12, 3);    // FÜF
+    } else if ((min >= 10 && min <= 14) || (min >= 50 && min <= 54)) {
+        mask = mask | LedMask::range(23, 3);    // ZÄÄ
+    } else if ((min >= 15 && min <= 19) || (min >= 45 && min <= 49)) {
+        mask = mask | LedMask::range(27, 6);    // VIERTU
+    } else if ((min >= 20 && min <= 24) || (min >= 40 && min <= 44)) {
+        mask = mask | LedMask::range(38, 6);    // ZWÄNZG
+    }
+    if (min >= 25 && min <= 39) {
+        mask = mask | LedMask::range(50, 5);    // HAUBI
+    }
+    if ((min >= 5 && min <= 24) || (min >= 35 && min <= 39)) {
+        mask = mask | LedMask::range(34, 2);    // AB
+    } else if ((min >= 25 && min <= 29) || (min >= 40 && min <= 59)) {
+        mask = mask | LedMask::range(45, 3);    // VOR
+    }
+
+    // Ab der 25. Minute die nachfolgende Stunde, 0 Uhr als 12 Uhr
+    if (min >= 25) hour += 1;
+    if (hour > 12) hour -= 12;
+    if (hour > 12) hour -= 12;
+    if (hour == 0) hour = 12;
+
+    static const uint8_t HOURS[12][2] = {
+        { 59, 3 }, { 63, 4 }, { 56, 3 }, { 72, 5 }, { 67, 4 }, { 78, 6 },
+        { 84, 5 }, { 95, 5 }, { 91, 4 }, { 101, 4 }, { 106, 4 }, { 115, 6 },
+    };
+    return mask | LedMask::range(HOURS[hour - 1][0], HOURS[hour - 1][1]);
+}
+
+void test_all_minutes_match_golden_masks() {
+    int checked = 0;
+    for (int hour = 0; hour < 24; hour++) {
+        for (int min = 0; min < 60; min++) {
+            LedMask expected = goldenMask(hour, min);
+            const LedMask& actual = wordClockMask(hour, min);
+            if (actual != expected) {
+                char message[96];
+                snprintf(message, sizeof(message), "%02d:%02d: %016llx%016llx statt %016llx%016llx", hour, min,
+                         (unsigned long long)actual.bits[1], (unsigned long long)actual.bits[0],
+                         (unsigned long long)expected.bits[1], (unsigned long long)expected.bits[0]);
+                TEST_FAIL_MESSAGE(message);
+            }
+            checked++;
+        }
+    }
+    TEST_ASSERT_EQUAL(1440, checked);
+}
+
+void test_masks_stay_inside_word_clock() {
+    LedMask area = LedMask::range(WORD_CLOCK_FIRST_LED, WORD_CLOCK_LED_COUNT);
+    for (int hour = 0; hour < 24; hour++) {
+        for (int min = 0; min < 60; min += 5) {
+            TEST_ASSERT_TRUE((wordClockMask(hour, min) & area) == wordClockMask(hour, min));
+        }
+    }
+}
+
+void test_display_hour() {
+    TEST_ASSERT_EQUAL(12, wordClockHour(0, 0));
+    TEST_ASSERT_EQUAL(12, wordClockHour(12, 24));
+    TEST_ASSERT_EQUAL(1, wordClockHour(12, 25));
+    TEST_ASSERT_EQUAL(7, wordClockHour(6, 35));
+    TEST_ASSERT_EQUAL(12, wordClockHour(23, 59));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_all_minutes_match_golden_masks);
+    RUN_TEST(test_masks_stay_inside_word_clock);
+    RUN_TEST(test_display_hour);
+    return UNITY_END();
+}